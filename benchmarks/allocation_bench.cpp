@@ -0,0 +1,163 @@
+// BSD 3-Clause License
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file allocation_bench.cpp
+ * @brief Heap allocations per message on the async logger path
+ *
+ * Replaces the global operator new with a counting version and reports
+ * allocs_per_log for logger::log() in async mode, counting every thread
+ * (callers and the collector worker). Each run logs a warm-up burst first so
+ * that queue storage, spill-block pools and batch arenas have reached their
+ * working size, then measures steady state.
+ *
+ * Variants:
+ * - Queue: mutex record_ring (default) and lock-free MPMC ring
+ * - Message size: inline (64 B), spilled to a pooled block (1 KiB) and
+ *   larger than a spill block (8 KiB, heap allocated by design)
+ *
+ * Expected results:
+ * - allocs_per_log == 0 for 64 B messages
+ * - allocs_per_log == 0 for 1 KiB messages: the queued payload reuses a
+ *   pooled spill block and log_entry::message takes its heap buffer from
+ *   string_pool
+ * - allocs_per_log of about 1 for 8 KiB messages: the payload is larger than
+ *   a spill block, and a 128-entry batch holds more message blocks than the
+ *   string pool keeps for that size class
+ *
+ * Kept in its own executable because the replaced operator new would add an
+ * atomic increment to every allocation in the other benchmarks.
+ */
+
+#include <benchmark/benchmark.h>
+#include <kcenon/logger/core/logger.h>
+#include <kcenon/logger/core/logger_config.h>
+#include <kcenon/logger/interfaces/log_writer_interface.h>
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+
+namespace {
+std::atomic<std::uint64_t> g_allocations{0};
+}
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+using namespace kcenon::logger;
+using log_level = kcenon::common::interfaces::log_level;
+
+namespace {
+
+/**
+ * @brief Writer that consumes batches without allocating
+ */
+class discard_writer : public log_writer_interface {
+public:
+    kcenon::common::VoidResult write(const log_entry& entry) override {
+        bytes_.fetch_add(entry.message.size(), std::memory_order_relaxed);
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult write_batch(std::span<const log_entry> entries) override {
+        for (const auto& entry : entries) {
+            bytes_.fetch_add(entry.message.size(), std::memory_order_relaxed);
+        }
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult flush() override {
+        return kcenon::common::ok();
+    }
+
+    std::string get_name() const override {
+        return "discard";
+    }
+
+    bool is_healthy() const override {
+        return true;
+    }
+
+private:
+    std::atomic<std::uint64_t> bytes_{0};
+};
+
+void run_async_log(benchmark::State& state, bool lock_free) {
+    constexpr std::int64_t flush_interval = 256;
+
+    logger_config config;
+    config.async = true;
+    config.buffer_size = 4096;
+    config.batch_size = 128;
+    config.use_lock_free = lock_free;
+
+    logger log(config);
+    log.add_writer(std::make_unique<discard_writer>());
+    log.start();
+
+    const std::string message(static_cast<std::size_t>(state.range(0)), 'x');
+    const std::string_view view(message);
+
+    // Warm-up: let queue storage, spill pools and the worker arena grow
+    for (int round = 0; round < 8; ++round) {
+        for (std::int64_t i = 0; i < flush_interval; ++i) {
+            log.log(log_level::info, view);
+        }
+        log.flush();
+    }
+
+    const auto before = g_allocations.load(std::memory_order_relaxed);
+    std::int64_t logged = 0;
+    for (auto _ : state) {
+        log.log(log_level::info, view);
+        if (++logged % flush_interval == 0) {
+            // Keeps the queue from overflowing so no message is dropped
+            log.flush();
+        }
+    }
+    log.flush();
+    const auto allocations = g_allocations.load(std::memory_order_relaxed) - before;
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs_per_log"] =
+        static_cast<double>(allocations) / static_cast<double>(state.iterations());
+
+    log.stop();
+}
+
+} // namespace
+
+static void BM_Allocations_AsyncLog_Mutex(benchmark::State& state) {
+    run_async_log(state, false);
+}
+BENCHMARK(BM_Allocations_AsyncLog_Mutex)
+    ->Arg(64)
+    ->Arg(1024)
+    ->Arg(8192);
+
+static void BM_Allocations_AsyncLog_LockFree(benchmark::State& state) {
+    run_async_log(state, true);
+}
+BENCHMARK(BM_Allocations_AsyncLog_LockFree)
+    ->Arg(64)
+    ->Arg(1024)
+    ->Arg(8192);
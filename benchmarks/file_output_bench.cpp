@@ -0,0 +1,160 @@
+// BSD 3-Clause License
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file file_output_bench.cpp
+ * @brief file_writer throughput by output backend
+ *
+ * Each iteration writes one batch of 256 pre-built entries (about 120 B each
+ * once formatted) through file_writer::write_batch, or entry by entry
+ * through write(), which is what the collector and the synchronous logger
+ * path do. Throughput is reported in bytes per second of formatted output.
+ *
+ * Backends compared (first argument):
+ * - 0: std::ofstream with its default buffering (the behaviour before 4.1.0)
+ * - 1: raw file descriptor behind a 1 MiB user-space buffer
+ * - 2: two 1 MiB buffers submitted through io_uring (direct where unavailable)
+ * - 3: memcpy into a shared mapping of 64 MiB preallocated extents
+ *
+ * The second argument picks the formatter: 0 is the default
+ * timestamp_formatter, 1 copies the message only, which leaves the output
+ * path as the dominant cost.
+ *
+ * The file lives in the system temporary directory and is truncated before
+ * every run. Page cache absorbs the writes, so the numbers reflect user-space
+ * and syscall cost rather than device bandwidth.
+ *
+ * Expected results: with the timestamp formatter both backends are bound by
+ * timestamp formatting (localtime_r per record) and stay within about 10%.
+ * With the message-only formatter the direct backend is ahead, most for
+ * single-entry writes (about 1.6x on page cache), since the stream hands
+ * every record to its streambuf and issues a write(2) every few KiB where
+ * the direct backend issues one per MiB. The io_uring backend moves the
+ * copy into the page cache to a kernel worker, so the caller's CPU time
+ * (and bytes_per_second, which is derived from it) improves most; wall time
+ * only improves when a spare core runs that worker. The mmap backend makes
+ * no system call per buffer at all; its cost is one page fault per 4 KiB
+ * of new output, an fallocate() per extent and an ftruncate() per MiB of
+ * visible size.
+ */
+
+#include <benchmark/benchmark.h>
+#include <kcenon/logger/interfaces/log_formatter_interface.h>
+#include <kcenon/logger/writers/file_writer.h>
+
+#include <filesystem>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace kcenon::logger;
+
+namespace {
+
+constexpr std::size_t batch_entries = 256;
+
+std::vector<log_entry> make_entries() {
+    std::vector<log_entry> entries;
+    entries.reserve(batch_entries);
+    for (std::size_t i = 0; i < batch_entries; ++i) {
+        entries.emplace_back(log_level::info,
+                             "request " + std::to_string(i) +
+                                 " served in 12 ms by worker pool shard with status 200 OK");
+    }
+    return entries;
+}
+
+/**
+ * @brief Formatter that copies the message only
+ */
+class message_formatter : public log_formatter_interface {
+public:
+    std::string format(const log_entry& entry) const override {
+        return entry.message.to_string();
+    }
+    void format_to(const log_entry& entry, std::pmr::string& out) const override {
+        out += std::string_view(entry.message);
+    }
+    std::string get_name() const override {
+        return "message_formatter";
+    }
+};
+
+std::unique_ptr<log_formatter_interface> formatter_for(std::int64_t arg) {
+    if (arg == 1) {
+        return std::make_unique<message_formatter>();
+    }
+    return nullptr;
+}
+
+file_output_options output_for(std::int64_t arg) {
+    file_output_options output;
+    output.mode = arg == 0 ? file_output_mode::stream
+                : arg == 1 ? file_output_mode::direct
+                : arg == 2 ? file_output_mode::io_uring
+                           : file_output_mode::mmap;
+    return output;
+}
+
+const char* mode_name(file_output_mode mode) {
+    switch (mode) {
+        case file_output_mode::stream:
+            return "stream";
+        case file_output_mode::direct:
+            return "direct";
+        case file_output_mode::io_uring:
+            return "io_uring";
+        case file_output_mode::mmap:
+            return "mmap";
+    }
+    return "unknown";
+}
+
+std::string bench_path() {
+    return (std::filesystem::temp_directory_path() / "logger_file_output_bench.log").string();
+}
+
+} // namespace
+
+static void BM_FileWriter_WriteBatch(benchmark::State& state) {
+    const auto entries = make_entries();
+    file_writer writer(bench_path(), false, formatter_for(state.range(1)),
+                       output_for(state.range(0)));
+    state.SetLabel(mode_name(writer.get_output_mode()));
+
+    std::size_t start = writer.get_file_size();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(writer.write_batch(entries));
+    }
+    writer.flush();
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(writer.get_file_size() - start));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_entries));
+    writer.close();
+    std::filesystem::remove(bench_path());
+}
+BENCHMARK(BM_FileWriter_WriteBatch)->ArgsProduct({{0, 1, 2, 3}, {0, 1}});
+
+static void BM_FileWriter_WriteSingle(benchmark::State& state) {
+    const auto entries = make_entries();
+    file_writer writer(bench_path(), false, formatter_for(state.range(1)),
+                       output_for(state.range(0)));
+    state.SetLabel(mode_name(writer.get_output_mode()));
+
+    std::size_t start = writer.get_file_size();
+    for (auto _ : state) {
+        for (const auto& entry : entries) {
+            benchmark::DoNotOptimize(writer.write(entry));
+        }
+    }
+    writer.flush();
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(writer.get_file_size() - start));
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(batch_entries));
+    writer.close();
+    std::filesystem::remove(bench_path());
+}
+BENCHMARK(BM_FileWriter_WriteSingle)->ArgsProduct({{0, 1, 2, 3}, {0, 1}});
@@ -0,0 +1,306 @@
+// BSD 3-Clause License
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file log_collector_bench.cpp
+ * @brief Producer-scaling benchmarks for the async log collector queue
+ *
+ * This benchmark compares:
+ * 1. Mutex-backed record_ring (log_collector default)
+ * 2. Bounded lock-free MPMC ring (logger_config::use_lock_free)
+ * 3. Per-thread SPSC staging rings (logger_config::use_thread_local_buffers)
+ * 4. Per-CPU MPMC rings (logger_config::use_per_cpu_buffers)
+ * 5. Eager vs deferred (logger::logf) formatting on the producer side
+ * 6. First burst into a freshly started 64K-entry lock-free ring, with heap,
+ *    huge-page and huge-page + mlock() storage (logger_config::queue_huge_pages)
+ *
+ * Each variant is run with 1 to 64 producer threads enqueueing into a single
+ * collector whose worker drains into a no-op writer, so the numbers reflect
+ * queue contention rather than I/O.
+ *
+ * Expected results:
+ * - Single thread: Similar performance
+ * - Many producers: lock-free ring keeps scaling while the mutex saturates;
+ *   per-thread rings avoid the shared enqueue counter entirely; per-CPU
+ *   rings come close while keeping memory proportional to the core count
+ */
+
+#include <benchmark/benchmark.h>
+#include <kcenon/logger/core/log_collector.h>
+#include <kcenon/logger/core/logger_config.h>
+#include <kcenon/logger/interfaces/log_writer_interface.h>
+#include "../src/impl/async/lockfree_queue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+
+using namespace kcenon::logger;
+
+namespace {
+
+/**
+ * @brief Writer that discards entries
+ */
+class discard_writer : public log_writer_interface {
+public:
+    kcenon::common::VoidResult write(const log_entry&) override {
+        written_.fetch_add(1, std::memory_order_relaxed);
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult flush() override {
+        return kcenon::common::ok();
+    }
+
+    std::string get_name() const override {
+        return "discard";
+    }
+
+    bool is_healthy() const override {
+        return true;
+    }
+
+private:
+    std::atomic<std::uint64_t> written_{0};
+};
+
+std::unique_ptr<log_collector> g_collector;
+std::shared_ptr<discard_writer> g_writer;
+
+enum class queue_mode { mutex, lock_free, per_thread, per_cpu };
+
+void setup_collector(queue_mode mode) {
+    logger_config config;
+    config.buffer_size = 65536;
+    config.batch_size = 512;
+    config.use_lock_free = mode == queue_mode::lock_free;
+    config.use_thread_local_buffers = mode == queue_mode::per_thread;
+    config.use_per_cpu_buffers = mode == queue_mode::per_cpu;
+
+    g_collector = std::make_unique<log_collector>(config);
+    g_writer = std::make_shared<discard_writer>();
+    g_collector->add_writer(g_writer);
+    g_collector->start();
+}
+
+void teardown_collector() {
+    g_collector->stop();
+    g_collector.reset();
+    g_writer.reset();
+}
+
+void run_collector_enqueue(benchmark::State& state, queue_mode mode) {
+    if (state.thread_index() == 0) {
+        setup_collector(mode);
+    }
+
+    const std::string message = "Benchmark message with moderate payload for queue testing";
+    const auto timestamp = std::chrono::system_clock::now();
+    std::int64_t accepted = 0;
+
+    for (auto _ : state) {
+        if (g_collector->enqueue(kcenon::common::interfaces::log_level::info, message, "", 0, "", timestamp)) {
+            ++accepted;
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["accepted"] = benchmark::Counter(
+        static_cast<double>(accepted), benchmark::Counter::kAvgThreads);
+
+    if (state.thread_index() == 0) {
+        teardown_collector();
+    }
+}
+
+} // namespace
+
+//==============================================================================
+// Benchmark 1: log_collector enqueue - mutex queue vs lock-free rings
+//==============================================================================
+
+static void BM_LogCollector_Enqueue_Mutex(benchmark::State& state) {
+    run_collector_enqueue(state, queue_mode::mutex);
+}
+BENCHMARK(BM_LogCollector_Enqueue_Mutex)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_LogCollector_Enqueue_LockFree(benchmark::State& state) {
+    run_collector_enqueue(state, queue_mode::lock_free);
+}
+BENCHMARK(BM_LogCollector_Enqueue_LockFree)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_LogCollector_Enqueue_PerThread(benchmark::State& state) {
+    run_collector_enqueue(state, queue_mode::per_thread);
+}
+BENCHMARK(BM_LogCollector_Enqueue_PerThread)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_LogCollector_Enqueue_PerCpu(benchmark::State& state) {
+    run_collector_enqueue(state, queue_mode::per_cpu);
+}
+BENCHMARK(BM_LogCollector_Enqueue_PerCpu)->ThreadRange(1, 64)->UseRealTime();
+
+//==============================================================================
+// Benchmark 2: Raw queue round trip - std::queue + mutex vs MPMC ring
+//==============================================================================
+
+namespace {
+
+struct payload {
+    char data[64];
+};
+
+std::mutex g_mutex;
+std::queue<payload> g_mutex_queue;
+std::unique_ptr<async::lockfree_mpmc_queue<payload>> g_mpmc_queue;
+
+} // namespace
+
+static void BM_MutexQueue_RoundTrip(benchmark::State& state) {
+    payload item{};
+
+    for (auto _ : state) {
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            g_mutex_queue.push(item);
+        }
+        {
+            std::lock_guard<std::mutex> lock(g_mutex);
+            if (!g_mutex_queue.empty()) {
+                item = g_mutex_queue.front();
+                g_mutex_queue.pop();
+            }
+        }
+        benchmark::DoNotOptimize(item);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MutexQueue_RoundTrip)->ThreadRange(1, 64)->UseRealTime();
+
+static void BM_MPMCQueue_RoundTrip(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        g_mpmc_queue = std::make_unique<async::lockfree_mpmc_queue<payload>>(4096);
+    }
+
+    payload item{};
+
+    for (auto _ : state) {
+        g_mpmc_queue->enqueue(item);
+        g_mpmc_queue->dequeue(item);
+        benchmark::DoNotOptimize(item);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        g_mpmc_queue.reset();
+    }
+}
+BENCHMARK(BM_MPMCQueue_RoundTrip)->ThreadRange(1, 64)->UseRealTime();
+
+//==============================================================================
+// Benchmark 3: Caller-side cost of logf - eager vs deferred formatting
+//==============================================================================
+
+static void BM_LogCollector_Enqueue_EagerFormat(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        setup_collector(queue_mode::lock_free);
+    }
+
+    const auto timestamp = std::chrono::system_clock::now();
+    const std::string user = "alice";
+    int request = 0;
+
+    for (auto _ : state) {
+        // Format on the calling thread, then enqueue the text
+        std::string text =
+            make_deferred_message("request {} for {} took {} us", request++, user, 12.5).render();
+        g_collector->enqueue(kcenon::common::interfaces::log_level::info, text, "", 0, "", timestamp);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        teardown_collector();
+    }
+}
+BENCHMARK(BM_LogCollector_Enqueue_EagerFormat)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_LogCollector_Enqueue_DeferredFormat(benchmark::State& state) {
+    if (state.thread_index() == 0) {
+        setup_collector(queue_mode::lock_free);
+    }
+
+    const auto timestamp = std::chrono::system_clock::now();
+    const std::string user = "alice";
+    int request = 0;
+
+    for (auto _ : state) {
+        // Only the format pointer and argument bytes are captured
+        g_collector->enqueue(kcenon::common::interfaces::log_level::info,
+                             make_deferred_message("request {} for {} took {} us", request++, user, 12.5),
+                             nullptr, timestamp);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0) {
+        teardown_collector();
+    }
+}
+BENCHMARK(BM_LogCollector_Enqueue_DeferredFormat)->ThreadRange(1, 8)->UseRealTime();
+
+//==============================================================================
+// Benchmark 4: First burst into a freshly started lock-free ring
+//==============================================================================
+
+/**
+ * @brief Enqueue latency of the first burst after start()
+ *
+ * Arg 0: heap cells; 1: huge pages; 2: huge pages + mlock(). Every
+ * iteration builds and starts a new 64K-entry collector, so the burst always
+ * lands in ring memory nothing has used yet. Only the burst is timed;
+ * worst_ns is the slowest single enqueue.
+ */
+static void BM_LogCollector_FirstBurst(benchmark::State& state) {
+    constexpr std::size_t burst = 65536;
+    const auto mode = state.range(0);
+    const std::string message = "Benchmark message with moderate payload for queue testing";
+    const auto timestamp = std::chrono::system_clock::now();
+    std::chrono::nanoseconds worst{0};
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        logger_config config;
+        config.buffer_size = burst;
+        config.batch_size = 512;
+        config.use_lock_free = true;
+        config.queue_huge_pages = mode >= 1;
+        config.queue_lock_memory = mode == 2;
+        auto collector = std::make_unique<log_collector>(config);
+        collector->add_writer(std::make_shared<discard_writer>());
+        collector->start();
+        state.ResumeTiming();
+
+        for (std::size_t i = 0; i < burst; ++i) {
+            const auto start = std::chrono::steady_clock::now();
+            collector->enqueue(kcenon::common::interfaces::log_level::info, message, "", 0, "", timestamp);
+            worst = std::max(worst, std::chrono::steady_clock::now() - start);
+        }
+
+        state.PauseTiming();
+        collector->stop();
+        collector.reset();
+        state.ResumeTiming();
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(burst));
+    state.counters["worst_ns"] = static_cast<double>(worst.count());
+}
+BENCHMARK(BM_LogCollector_FirstBurst)->Arg(0)->Arg(1)->Arg(2)->Iterations(10)->Unit(benchmark::kMillisecond);
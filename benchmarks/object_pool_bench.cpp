@@ -11,10 +11,13 @@
  * This benchmark compares:
  * 1. Original object_pool (mutex on every acquire/release)
  * 2. thread_local_object_pool (thread-local cache + batch transfers)
+ * 3. object_pool with pool_strategy::lock_free (ABA-tagged Treiber stacks)
  *
  * Expected results:
  * - Single thread: Similar performance
  * - Multi-threaded: 2-5x improvement with thread_local_object_pool
+ * - Multi-threaded: lock_free object_pool keeps scaling up to 16 threads
+ *   where the mutex variant collapses
  */
 
 #include <benchmark/benchmark.h>
@@ -98,6 +101,7 @@ BENCHMARK(BM_ObjectPool_MultiThread)
     ->Threads(2)
     ->Threads(4)
     ->Threads(8)
+    ->Threads(16)
     ->UseRealTime();
 
 //==============================================================================
@@ -129,6 +133,61 @@ BENCHMARK(BM_ThreadLocalObjectPool_MultiThread)
     ->Threads(8)
     ->UseRealTime();
 
+//==============================================================================
+// Benchmark 4b: Lock-free object_pool - Multi-threaded
+//==============================================================================
+
+static object_pool<test_object>& lock_free_pool() {
+    static object_pool<test_object> pool([] {
+        object_pool<test_object>::config cfg;
+        cfg.strategy = pool_strategy::lock_free;
+        return cfg;
+    }());
+    return pool;
+}
+
+static void BM_LockFreeObjectPool_SingleThread(benchmark::State& state) {
+    object_pool<test_object>::config cfg;
+    cfg.strategy = pool_strategy::lock_free;
+    object_pool<test_object> pool(cfg);
+
+    for (auto _ : state) {
+        auto obj = pool.acquire();
+        benchmark::DoNotOptimize(obj);
+        pool.release(std::move(obj));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * sizeof(test_object));
+}
+BENCHMARK(BM_LockFreeObjectPool_SingleThread);
+
+static void BM_LockFreeObjectPool_MultiThread(benchmark::State& state) {
+    auto& pool = lock_free_pool();
+
+    for (auto _ : state) {
+        auto obj = pool.acquire();
+        benchmark::DoNotOptimize(obj);
+
+        // Simulate some work
+        if (obj) {
+            obj->id = static_cast<int>(state.iterations());
+        }
+
+        pool.release(std::move(obj));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * sizeof(test_object));
+}
+BENCHMARK(BM_LockFreeObjectPool_MultiThread)
+    ->Threads(1)
+    ->Threads(2)
+    ->Threads(4)
+    ->Threads(8)
+    ->Threads(16)
+    ->UseRealTime();
+
 //==============================================================================
 // Benchmark 5: Stress test - High contention scenario
 //==============================================================================
@@ -187,6 +246,34 @@ BENCHMARK(BM_ThreadLocalObjectPool_HighContention)
     ->Threads(8)
     ->UseRealTime();
 
+static void BM_LockFreeObjectPool_HighContention(benchmark::State& state) {
+    auto& pool = lock_free_pool();
+
+    for (auto _ : state) {
+        // Acquire multiple objects
+        std::vector<std::unique_ptr<test_object>> objects;
+        objects.reserve(10);
+
+        for (int i = 0; i < 10; ++i) {
+            objects.push_back(pool.acquire());
+        }
+
+        benchmark::DoNotOptimize(objects);
+
+        // Release all
+        for (auto& obj : objects) {
+            pool.release(std::move(obj));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * 10);
+}
+BENCHMARK(BM_LockFreeObjectPool_HighContention)
+    ->Threads(4)
+    ->Threads(8)
+    ->Threads(16)
+    ->UseRealTime();
+
 //==============================================================================
 // Benchmark 6: Cache efficiency test
 //==============================================================================
@@ -0,0 +1,156 @@
+// BSD 3-Clause License
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file segment_compression_bench.cpp
+ * @brief Compression ratio and CPU cost of rotated segment compression
+ *
+ * The corpus is a 16 MiB segment written once by file_writer with the
+ * default timestamp formatter: a fixed-seed mix of access, database, cache
+ * and error records with varying ids, paths, users and latencies, which is
+ * what rotating_file_writer hands to the compression threads. Each
+ * iteration compresses the whole segment with compress_file().
+ *
+ * BM_CompressSegment takes the codec (1: gzip, 2: zstd) and the level, with
+ * cpu_budget at 1 so CPU time is the codec's own cost. It reports
+ * bytes_per_second of input and a ratio counter (input size over output
+ * size). Codecs not built in are skipped.
+ *
+ * BM_CompressSegment_Budget runs gzip at the default level with the
+ * default budget of 0.5 and with 0.25: CPU time stays the same while wall
+ * time grows by 1 / budget, which is how the compression threads stay out
+ * of the loggers' way.
+ *
+ * Expected results (x86-64, zlib 1.2.13): gzip level 1 gives about 6.3x
+ * at 145 MB/s of CPU, level 6 (the default) about 9x at 60 MB/s, and
+ * level 9 under 10x at 22 MB/s, so a 100 MiB segment costs under two CPU
+ * seconds at the default level. zstd, where built in, usually reaches
+ * gzip 6's ratio at level 1 to 3 for several times less CPU.
+ */
+
+#include <benchmark/benchmark.h>
+#include <kcenon/logger/writers/file_writer.h>
+#include <kcenon/logger/writers/segment_compression.h>
+
+#include <filesystem>
+#include <random>
+#include <string>
+
+using namespace kcenon::logger;
+
+namespace {
+
+constexpr std::size_t corpus_size = 16 * 1024 * 1024;
+
+std::filesystem::path bench_dir() {
+    return std::filesystem::temp_directory_path() / "logger_segment_compression_bench";
+}
+
+/**
+ * @brief The corpus file, removed with its directory at exit
+ */
+struct corpus_file {
+    std::string path;
+    ~corpus_file() {
+        std::error_code ec;
+        std::filesystem::remove_all(bench_dir(), ec);
+    }
+};
+
+/**
+ * @brief Write the corpus once per process and return its path
+ */
+const std::string& corpus_path() {
+    static const corpus_file corpus{[] {
+        std::filesystem::create_directories(bench_dir());
+        const auto file = (bench_dir() / "segment.log").string();
+
+        file_writer writer(file, false);
+        std::mt19937 rng(42);
+        const char* methods[] = {"GET", "POST", "PUT", "DELETE"};
+        const char* paths[] = {"/api/v1/orders", "/api/v1/users", "/api/v1/cart/items",
+                               "/health", "/api/v2/search", "/static/app.js"};
+        const char* tables[] = {"orders", "users", "inventory", "sessions"};
+        const int statuses[] = {200, 200, 200, 200, 201, 204, 304, 400, 404, 500};
+
+        while (writer.get_file_size() < corpus_size) {
+            const auto pick = rng() % 100;
+            const auto id = rng() % 1'000'000;
+            if (pick < 70) {
+                writer.write(log_entry(log_level::info,
+                    std::string("request ") + methods[rng() % 4] + " " + paths[rng() % 6] +
+                    " user=" + std::to_string(rng() % 5000) +
+                    " status=" + std::to_string(statuses[rng() % 10]) +
+                    " latency_ms=" + std::to_string(rng() % 900) +
+                    " request_id=" + std::to_string(id)));
+            } else if (pick < 85) {
+                writer.write(log_entry(log_level::debug,
+                    std::string("db query on ") + tables[rng() % 4] + " rows=" +
+                    std::to_string(rng() % 200) + " took " + std::to_string(rng() % 50) +
+                    "ms plan=index_scan"));
+            } else if (pick < 95) {
+                writer.write(log_entry(log_level::trace,
+                    "cache " + std::string(rng() % 3 == 0 ? "miss" : "hit") + " key=session:" +
+                    std::to_string(id)));
+            } else {
+                writer.write(log_entry(log_level::error,
+                    "upstream timeout after 3000ms calling payment-service attempt=" +
+                    std::to_string(rng() % 3 + 1) + " request_id=" + std::to_string(id)));
+            }
+        }
+        writer.close();
+        return file;
+    }()};
+    return corpus.path;
+}
+
+void compress_corpus(benchmark::State& state, const segment_compression_options& options) {
+    if (!is_compression_available(options.codec)) {
+        state.SkipWithError("codec not built in");
+        return;
+    }
+
+    const auto& source = corpus_path();
+    const auto destination = source + compression_extension(options.codec);
+    const auto input = std::filesystem::file_size(source);
+
+    for (auto _ : state) {
+        auto result = compress_file(source, destination, options);
+        if (result.is_err()) {
+            state.SkipWithError(result.error().message.c_str());
+            return;
+        }
+    }
+
+    const auto output = std::filesystem::file_size(destination);
+    state.counters["ratio"] = static_cast<double>(input) / static_cast<double>(output);
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(input));
+    std::filesystem::remove(destination);
+}
+
+} // namespace
+
+static void BM_CompressSegment(benchmark::State& state) {
+    segment_compression_options options;
+    options.codec = state.range(0) == 1 ? compression_codec::gzip : compression_codec::zstd;
+    options.level = static_cast<int>(state.range(1));
+    options.cpu_budget = 1.0;
+    state.SetLabel(compression_extension(options.codec));
+    compress_corpus(state, options);
+}
+BENCHMARK(BM_CompressSegment)
+    ->Args({1, 1})->Args({1, 6})->Args({1, 9})
+    ->Args({2, 1})->Args({2, 3})->Args({2, 9})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_CompressSegment_Budget(benchmark::State& state) {
+    segment_compression_options options;
+    options.codec = compression_codec::gzip;
+    options.cpu_budget = static_cast<double>(state.range(0)) / 100.0;
+    compress_corpus(state, options);
+}
+BENCHMARK(BM_CompressSegment_Budget)
+    ->Arg(50)->Arg(25)
+    ->Iterations(2)
+    ->Unit(benchmark::kMillisecond);
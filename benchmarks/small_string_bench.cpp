@@ -0,0 +1,77 @@
+// BSD 3-Clause License
+// Copyright (c) 2021-2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file small_string_bench.cpp
+ * @brief Heap-fallback cost of small_string by allocator and message size
+ *
+ * Each iteration builds a small_string_256-sized string from a message and
+ * destroys it, which is what a log_entry does with every message. Messages
+ * of 64 B stay inline; 512 B, 4 KiB and 64 KiB take the heap fallback.
+ *
+ * Allocators compared:
+ * - std::allocator<char>: global new/delete (the behaviour before 4.1.0)
+ * - string_pool_allocator<char>: thread-cached size-class pools (default)
+ * - pmr_small_string over std::pmr::synchronized_pool_resource
+ *
+ * The multi-threaded variants run every thread against the same allocator,
+ * which is where the global heap's locks show up.
+ *
+ * Expected results:
+ * - 64 B: identical, no allocation
+ * - 512 B to 64 KiB: string_pool_allocator at or below std::allocator on
+ *   one thread and scaling with thread count where malloc does not
+ */
+
+#include <benchmark/benchmark.h>
+#include <kcenon/logger/core/small_string.h>
+
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+using namespace kcenon::logger;
+
+namespace {
+
+template<typename String, typename... Args>
+void run_assign(benchmark::State& state, Args&&... args) {
+    const std::string message(static_cast<std::size_t>(state.range(0)), 'x');
+
+    for (auto _ : state) {
+        String text(message, args...);
+        benchmark::DoNotOptimize(text.data());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+
+std::pmr::synchronized_pool_resource& shared_pmr_pool() {
+    static std::pmr::synchronized_pool_resource pool;
+    return pool;
+}
+
+} // namespace
+
+static void BM_SmallString_StdAllocator(benchmark::State& state) {
+    run_assign<small_string<256, std::allocator<char>>>(state);
+}
+BENCHMARK(BM_SmallString_StdAllocator)
+    ->Arg(64)->Arg(512)->Arg(4096)->Arg(65536)
+    ->Threads(1)->Threads(4)->Threads(8);
+
+static void BM_SmallString_StringPool(benchmark::State& state) {
+    run_assign<small_string<256>>(state);
+}
+BENCHMARK(BM_SmallString_StringPool)
+    ->Arg(64)->Arg(512)->Arg(4096)->Arg(65536)
+    ->Threads(1)->Threads(4)->Threads(8);
+
+static void BM_SmallString_PmrSynchronizedPool(benchmark::State& state) {
+    run_assign<pmr_small_string<256>>(state, &shared_pmr_pool());
+}
+BENCHMARK(BM_SmallString_PmrSynchronizedPool)
+    ->Arg(64)->Arg(512)->Arg(4096)->Arg(65536)
+    ->Threads(1)->Threads(4)->Threads(8);
@@ -15,13 +15,26 @@ function(logger_find_compression)
     # Try to find zlib for compression
     find_package(ZLIB QUIET)
     if(ZLIB_FOUND)
-        message(STATUS "Found ZLIB for compression support: ${ZLIB_VERSION}")
+        message(STATUS "Found ZLIB for compression support: ${ZLIB_VERSION_STRING}")
         set(LOGGER_HAS_COMPRESSION TRUE PARENT_SCOPE)
     else()
-        message(WARNING "ZLIB not found - compression support disabled")
-        set(LOGGER_USE_COMPRESSION OFF PARENT_SCOPE)
         set(LOGGER_HAS_COMPRESSION FALSE PARENT_SCOPE)
     endif()
+
+    # zstd is optional on top of zlib and only used for rotated segments
+    find_path(LOGGER_ZSTD_INCLUDE_DIR zstd.h)
+    find_library(LOGGER_ZSTD_LIBRARY NAMES zstd)
+    if(LOGGER_ZSTD_INCLUDE_DIR AND LOGGER_ZSTD_LIBRARY)
+        message(STATUS "Found zstd for segment compression: ${LOGGER_ZSTD_LIBRARY}")
+        set(LOGGER_HAS_ZSTD TRUE PARENT_SCOPE)
+    else()
+        set(LOGGER_HAS_ZSTD FALSE PARENT_SCOPE)
+    endif()
+
+    if(NOT ZLIB_FOUND AND NOT (LOGGER_ZSTD_INCLUDE_DIR AND LOGGER_ZSTD_LIBRARY))
+        message(WARNING "Neither zlib nor zstd found - compression support disabled")
+        set(LOGGER_USE_COMPRESSION OFF PARENT_SCOPE)
+    endif()
 endfunction()
 
 # Function to find encryption libraries (OpenSSL 3.0+ required)
@@ -134,6 +147,9 @@ function(logger_find_all_dependencies)
 
     # Optional dependencies (thread_system handled by UnifiedDependencies)
     logger_find_compression()
+    set(LOGGER_HAS_COMPRESSION ${LOGGER_HAS_COMPRESSION} PARENT_SCOPE)
+    set(LOGGER_HAS_ZSTD ${LOGGER_HAS_ZSTD} PARENT_SCOPE)
+    set(LOGGER_USE_COMPRESSION ${LOGGER_USE_COMPRESSION} PARENT_SCOPE)
     logger_find_encryption()
     logger_find_test_dependencies()
     logger_find_benchmark_dependencies()
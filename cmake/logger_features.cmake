@@ -11,7 +11,7 @@ option(LOGGER_USE_EXTERNAL_DI "Use external DI container if available" OFF)
 option(LOGGER_FORCE_LIGHTWEIGHT "Force lightweight implementations only" ON)
 option(LOGGER_ENABLE_SANITIZERS "Enable address and thread sanitizers" OFF)
 option(LOGGER_ENABLE_COVERAGE "Enable code coverage" OFF)
-option(LOGGER_USE_COMPRESSION "Enable log compression support" OFF)
+option(LOGGER_USE_COMPRESSION "Enable log compression support (zlib, and zstd when found)" ON)
 option(LOGGER_USE_ENCRYPTION "Enable log encryption support" OFF)
 option(LOGGER_ENABLE_CRASH_HANDLER "Enable crash handler integration" ON)
 option(LOGGER_ENABLE_STRUCTURED_LOGGING "Enable structured logging (JSON)" OFF)
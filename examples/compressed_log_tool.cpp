@@ -0,0 +1,149 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file compressed_log_tool.cpp
+ * @brief Inspect, search and slice compressed log files
+ *
+ * @example compressed_log_tool.cpp
+ * Files written with file_output_options::compression are plain multi-member
+ * gzip, so zcat and zgrep read them; this tool uses compressed_log_reader to
+ * go straight to the frames it needs instead:
+ *
+ *   compressed_log_tool app.log.gz index            frame table
+ *   compressed_log_tool app.log.gz grep <text>      matching lines, frame by frame
+ *   compressed_log_tool app.log.gz tail [bytes]     last bytes (default 4096)
+ *   compressed_log_tool app.log.gz read <pos> <n>   n bytes from an uncompressed position
+ *
+ * Without arguments it writes a small demo file first and runs each command
+ * on it.
+ */
+
+#include <kcenon/logger/interfaces/log_entry.h>
+#include <kcenon/logger/writers/compressed_log_reader.h>
+#include <kcenon/logger/writers/file_writer.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+using namespace kcenon::logger;
+namespace ci = kcenon::common::interfaces;
+
+namespace {
+
+void print_index(const compressed_log_reader& reader) {
+    std::cout << "frame  file offset  compressed  position  size\n";
+    for (std::size_t i = 0; i < reader.frames().size(); ++i) {
+        const auto& frame = reader.frames()[i];
+        std::cout << i << "  " << frame.offset << "  " << frame.member_size << "  "
+                  << frame.position << "  " << frame.size << "\n";
+    }
+    std::cout << reader.frames().size() << " frames, " << reader.size()
+              << " bytes uncompressed, " << reader.skipped_bytes() << " bytes skipped\n";
+}
+
+/**
+ * @brief Print lines containing text; frames end on record boundaries
+ */
+int grep(compressed_log_reader& reader, const std::string& text) {
+    std::size_t matches = 0;
+    for (std::size_t i = 0; i < reader.frames().size(); ++i) {
+        auto frame = reader.read_frame(i);
+        if (!frame) {
+            std::cerr << frame.error_message() << "\n";
+            return 1;
+        }
+        const auto& data = frame.value();
+        for (std::size_t begin = 0; begin < data.size();) {
+            auto end = data.find('\n', begin);
+            end = end == std::string::npos ? data.size() : end;
+            const std::string_view line(data.data() + begin, end - begin);
+            if (line.find(text) != std::string_view::npos) {
+                std::cout << line << "\n";
+                ++matches;
+            }
+            begin = end + 1;
+        }
+    }
+    return matches > 0 ? 0 : 1;
+}
+
+int print_range(compressed_log_reader& reader, std::uint64_t position, std::size_t length) {
+    auto text = reader.read(position, length);
+    if (!text) {
+        std::cerr << text.error_message() << "\n";
+        return 1;
+    }
+    std::cout << text.value();
+    return 0;
+}
+
+int run(const std::string& path, const std::string& command, int argc, char** argv) {
+    compressed_log_reader reader;
+    if (auto opened = reader.open(path); opened.is_err()) {
+        std::cerr << opened.error().message << "\n";
+        return 1;
+    }
+
+    if (command == "index") {
+        print_index(reader);
+        return 0;
+    }
+    if (command == "grep" && argc > 0) {
+        return grep(reader, argv[0]);
+    }
+    if (command == "tail") {
+        const std::uint64_t bytes = argc > 0 ? std::strtoull(argv[0], nullptr, 10) : 4096;
+        const auto start = reader.size() > bytes ? reader.size() - bytes : 0;
+        return print_range(reader, start, static_cast<std::size_t>(bytes));
+    }
+    if (command == "read" && argc > 1) {
+        return print_range(reader, std::strtoull(argv[0], nullptr, 10),
+                           static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)));
+    }
+    std::cerr << "usage: compressed_log_tool <file> index | grep <text> | tail [bytes] | "
+                 "read <position> <length>\n";
+    return 2;
+}
+
+int demo() {
+    if (!is_compression_available(compression_codec::gzip)) {
+        std::cerr << "built without zlib\n";
+        return 1;
+    }
+
+    const std::string path = "logs/compressed_demo.log.gz";
+    {
+        file_output_options output;
+        output.compression = compression_codec::gzip;
+        output.frame_size = 64 * 1024;
+        file_writer writer(path, false, nullptr, output);
+        for (int i = 0; i < 10000; ++i) {
+            writer.write(log_entry(i % 1000 == 999 ? ci::log_level::error : ci::log_level::info,
+                                   "demo request " + std::to_string(i) + " served"));
+        }
+    }
+
+    char error_text[] = "[ERROR]";
+    char* grep_args[] = {error_text};
+    char tail_bytes[] = "200";
+    char* tail_args[] = {tail_bytes};
+
+    std::cout << "=== index ===\n";
+    run(path, "index", 0, nullptr);
+    std::cout << "\n=== grep [ERROR] ===\n";
+    run(path, "grep", 1, grep_args);
+    std::cout << "\n=== tail 200 ===\n";
+    return run(path, "tail", 1, tail_args);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        return demo();
+    }
+    return run(argv[1], argc > 2 ? argv[2] : "index", argc - 3 > 0 ? argc - 3 : 0, argv + 3);
+}
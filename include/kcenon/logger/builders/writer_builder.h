@@ -46,6 +46,7 @@
 #include "../interfaces/log_writer_interface.h"
 #include "../interfaces/log_filter_interface.h"
 #include "../interfaces/log_formatter_interface.h"
+#include "../writers/file_output.h"
 #include <kcenon/logger/logger_export.h>
 
 #include <chrono>
@@ -116,13 +117,15 @@ public:
      *
      * @param filename Path to the log file
      * @param append Whether to append to existing file (default: true)
+     * @param output Output backend, e.g. file_output_mode::direct (default: std::ofstream)
      * @return Reference to this builder for chaining
      *
      * @throws std::logic_error if a core writer is already set
      *
      * @since 4.1.0
      */
-    writer_builder& file(const std::string& filename, bool append = true);
+    writer_builder& file(const std::string& filename, bool append = true,
+                         const file_output_options& output = {});
 
     /**
      * @brief Set a console writer as the core writer
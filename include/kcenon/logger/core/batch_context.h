@@ -0,0 +1,133 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file batch_context.h
+ * @brief Per-batch monotonic arena shared by the collector and writers
+ * @since 4.1.0
+ *
+ * @details The async collector owns one batch_context per worker thread and
+ * makes it current while a drained batch is dispatched. Everything allocated
+ * from resource() during the batch (the log_entry vector, writer output
+ * buffers, formatter output) is released at once by reset().
+ *
+ * The arena starts from a single pre-allocated block. When a batch overflows
+ * it, the extra memory comes from the default heap and reset() grows the
+ * block to cover that high-water mark, so steady-state batches do not touch
+ * the heap at all.
+ *
+ * @code
+ * // In a writer's write_batch()
+ * std::pmr::string buffer(batch_context::current_resource());
+ * for (const auto& entry : entries) {
+ *     formatter->format_to(entry, buffer);
+ *     buffer += '\n';
+ * }
+ * @endcode
+ */
+
+#include <kcenon/logger/logger_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+
+namespace kcenon::logger {
+
+/**
+ * @class batch_context
+ * @brief Monotonic arena that is reset after every collector batch
+ *
+ * @note Not thread-safe; a context belongs to the thread that dispatches
+ * the batch. Memory from resource() must not outlive the next reset().
+ */
+class LOGGER_SYSTEM_API batch_context {
+public:
+    /// Initial arena block size
+    static constexpr std::size_t default_initial_bytes = 64 * 1024;
+
+    /**
+     * @brief Create an arena with a pre-allocated block
+     * @param initial_bytes Size of the first block
+     */
+    explicit batch_context(std::size_t initial_bytes = default_initial_bytes);
+
+    ~batch_context();
+
+    batch_context(const batch_context&) = delete;
+    batch_context& operator=(const batch_context&) = delete;
+
+    /**
+     * @brief Memory resource backed by the arena
+     */
+    [[nodiscard]] std::pmr::memory_resource* resource() noexcept;
+
+    /**
+     * @brief Release everything allocated since the last reset
+     *
+     * If the batch spilled past the block, the block is regrown to fit it.
+     */
+    void reset();
+
+    /**
+     * @brief Current size of the pre-allocated block
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept;
+
+    /**
+     * @brief Number of resets that had to grow the block
+     */
+    [[nodiscard]] std::uint64_t grow_count() const noexcept;
+
+    /**
+     * @brief Context active on the calling thread, or nullptr
+     */
+    [[nodiscard]] static batch_context* current() noexcept;
+
+    /**
+     * @brief Arena of current(), or std::pmr::get_default_resource() outside a batch
+     */
+    [[nodiscard]] static std::pmr::memory_resource* current_resource() noexcept;
+
+    /**
+     * @brief RAII guard that makes a context current on this thread
+     */
+    class LOGGER_SYSTEM_API scope {
+    public:
+        explicit scope(batch_context& context) noexcept;
+        ~scope();
+
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+    private:
+        batch_context* previous_;
+    };
+
+private:
+    /**
+     * @brief Upstream for the arena that records how much spilled to the heap
+     */
+    class spill_resource : public std::pmr::memory_resource {
+    public:
+        std::size_t spilled = 0;
+
+    private:
+        void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+        void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override;
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+    };
+
+    std::unique_ptr<std::byte[]> block_;
+    std::size_t capacity_;
+    std::uint64_t grow_count_ = 0;
+    spill_resource spill_;
+    std::optional<std::pmr::monotonic_buffer_resource> arena_;
+};
+
+} // namespace kcenon::logger
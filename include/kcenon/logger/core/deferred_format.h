@@ -0,0 +1,316 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file deferred_format.h
+ * @brief Deferred formatting: capture format string and arguments, format later
+ * @since 4.1.0
+ *
+ * @details A deferred_message stores a pointer to a format string with static
+ * storage duration, the arguments serialised into a flat byte buffer and a
+ * type-specific decoder. The caller only copies bytes; the std::format-style
+ * expansion happens when render() is called, which the async collector does
+ * on its worker thread.
+ *
+ * Argument encoding:
+ * - Strings (std::string, std::string_view, const char*, char arrays) are
+ *   stored as a 32-bit length prefix followed by the characters
+ * - Other trivially copyable types (integers, floating point, bool, char,
+ *   const void*) are stored as raw bytes
+ *
+ * @code
+ * auto msg = make_deferred_message("user {} logged in from {}", user_id, ip);
+ * std::string text = msg.render();  // "user 42 logged in from 10.0.0.1"
+ * @endcode
+ */
+
+#include <kcenon/common/interfaces/logger_interface.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#if defined(__cpp_lib_format)
+#define LOGGER_DEFERRED_HAS_STD_FORMAT 1
+#else
+#define LOGGER_DEFERRED_HAS_STD_FORMAT 0
+#include <sstream>
+#endif
+
+namespace kcenon::logger {
+
+/**
+ * @brief Static metadata for one logging call site
+ *
+ * The LOGGER_* macros emit one `static constexpr` instance per call site and
+ * pass it by pointer, so file, function and format strings are never copied
+ * on the calling thread. The first record from the site stores the intern
+ * table ids of file and function in it, so later records skip the lookup.
+ *
+ * @since 4.1.0
+ */
+struct log_site {
+    const char* file;
+    int line;
+    const char* function;
+    common::interfaces::log_level level;
+    const char* format;
+
+    /// intern_table id of file; 0 until the first record interns it
+    mutable std::atomic<std::uint32_t> file_id{0};
+    /// intern_table id of function; 0 until the first record interns it
+    mutable std::atomic<std::uint32_t> function_id{0};
+};
+
+/**
+ * @brief Flat byte buffer holding serialised format arguments
+ *
+ * Small argument lists live in an inline array so capturing them never
+ * allocates; larger ones spill to the heap.
+ */
+class format_arg_buffer {
+public:
+    /// Bytes stored inline before spilling to the heap
+    static constexpr std::size_t inline_capacity = 128;
+
+    void append(const void* bytes, std::size_t count) {
+        if (overflow_.empty() && size_ + count <= inline_capacity) {
+            std::memcpy(inline_.data() + size_, bytes, count);
+        } else {
+            if (overflow_.empty()) {
+                overflow_.assign(inline_.begin(), inline_.begin() + static_cast<std::ptrdiff_t>(size_));
+            }
+            const auto* first = static_cast<const std::byte*>(bytes);
+            overflow_.insert(overflow_.end(), first, first + count);
+        }
+        size_ += count;
+    }
+
+    [[nodiscard]] const std::byte* data() const noexcept {
+        return overflow_.empty() ? inline_.data() : overflow_.data();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+private:
+    std::array<std::byte, inline_capacity> inline_{};
+    std::vector<std::byte> overflow_;
+    std::size_t size_ = 0;
+};
+
+namespace detail {
+
+template<typename T>
+using deferred_arg_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+template<typename T>
+inline constexpr bool is_deferred_string_v =
+    std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> ||
+    std::is_same_v<T, const char*> || std::is_same_v<T, char*> ||
+    (std::is_array_v<T> && std::is_same_v<std::remove_extent_t<T>, char>) ||
+    (std::is_array_v<T> && std::is_same_v<std::remove_extent_t<T>, const char>);
+
+/**
+ * @brief Type a captured argument decodes to on the formatting thread
+ */
+template<typename T>
+using deferred_decoded_t = std::conditional_t<is_deferred_string_v<T>, std::string_view, T>;
+
+template<typename T>
+void encode_deferred_arg(format_arg_buffer& buffer, const T& value) {
+    if constexpr (is_deferred_string_v<T>) {
+        const std::string_view text(value);
+        const auto length = static_cast<std::uint32_t>(text.size());
+        buffer.append(&length, sizeof(length));
+        buffer.append(text.data(), text.size());
+    } else {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Deferred format arguments must be strings or trivially copyable");
+        static_assert(!std::is_pointer_v<T> || std::is_same_v<T, const void*> ||
+                          std::is_same_v<T, void*>,
+                      "Only void pointers can be captured; the pointee may not outlive the call");
+        buffer.append(&value, sizeof(T));
+    }
+}
+
+template<typename T>
+deferred_decoded_t<T> decode_deferred_arg(const std::byte*& cursor) {
+    if constexpr (is_deferred_string_v<T>) {
+        std::uint32_t length = 0;
+        std::memcpy(&length, cursor, sizeof(length));
+        cursor += sizeof(length);
+        std::string_view text(reinterpret_cast<const char*>(cursor), length);
+        cursor += length;
+        return text;
+    } else {
+        T value;
+        std::memcpy(&value, cursor, sizeof(T));
+        cursor += sizeof(T);
+        return value;
+    }
+}
+
+#if !LOGGER_DEFERRED_HAS_STD_FORMAT
+/**
+ * @brief Minimal "{}" substitution for standard libraries without <format>
+ *
+ * Supports positional "{}" placeholders and "{{" / "}}" escapes only.
+ */
+template<typename... Values>
+std::string substitute_placeholders(std::string_view fmt, const Values&... values) {
+    std::ostringstream out;
+    std::size_t index = 0;
+    auto emit_arg = [&out, &index, &values...]() {
+        std::size_t current = 0;
+        ((current++ == index ? static_cast<void>(out << values) : static_cast<void>(0)), ...);
+        ++index;
+    };
+    for (std::size_t i = 0; i < fmt.size(); ++i) {
+        if (fmt[i] == '{' && i + 1 < fmt.size() && fmt[i + 1] == '{') {
+            out << '{';
+            ++i;
+        } else if (fmt[i] == '}' && i + 1 < fmt.size() && fmt[i + 1] == '}') {
+            out << '}';
+            ++i;
+        } else if (fmt[i] == '{') {
+            const auto close = fmt.find('}', i);
+            if (close == std::string_view::npos) {
+                out << fmt.substr(i);
+                break;
+            }
+            emit_arg();
+            i = close;
+        } else {
+            out << fmt[i];
+        }
+    }
+    return out.str();
+}
+#endif
+
+/**
+ * @brief Decode the captured arguments and expand the format string
+ */
+template<typename... Args>
+std::string render_deferred(std::string_view fmt, const std::byte* data) {
+    [[maybe_unused]] const std::byte* cursor = data;  // Unread without arguments
+    // Braced initialisation guarantees left-to-right decoding
+    std::tuple<deferred_decoded_t<Args>...> values{decode_deferred_arg<Args>(cursor)...};
+    return std::apply(
+        [fmt](const auto&... decoded) {
+#if LOGGER_DEFERRED_HAS_STD_FORMAT
+            return std::vformat(fmt, std::make_format_args(decoded...));
+#else
+            return substitute_placeholders(fmt, decoded...);
+#endif
+        },
+        values);
+}
+
+} // namespace detail
+
+#if LOGGER_DEFERRED_HAS_STD_FORMAT
+/**
+ * @brief Compile-time checked format string for deferred formatting
+ */
+template<typename... Args>
+using deferred_format_string = std::format_string<Args...>;
+#else
+template<typename... Args>
+using deferred_format_string = std::string_view;
+#endif
+
+/**
+ * @brief A message whose formatting has been deferred
+ *
+ * Holds the format string (which must have static storage duration, e.g. a
+ * string literal), the serialised arguments and the decoder instantiated for
+ * the argument types. Cheap to move; render() may be called on any thread.
+ */
+class deferred_message {
+public:
+    using render_fn = std::string (*)(std::string_view, const std::byte*);
+
+    deferred_message() = default;
+
+    deferred_message(std::string_view fmt, render_fn renderer_fn, format_arg_buffer args)
+        : fmt_(fmt), render_(renderer_fn), args_(std::move(args)) {}
+
+    /**
+     * @brief Expand the format string with the captured arguments
+     */
+    [[nodiscard]] std::string render() const {
+        return render_ ? render_(fmt_, args_.data()) : std::string(fmt_);
+    }
+
+    /**
+     * @brief The captured format string
+     */
+    [[nodiscard]] std::string_view format() const noexcept {
+        return fmt_;
+    }
+
+    /**
+     * @brief Size of the serialised arguments in bytes
+     */
+    [[nodiscard]] std::size_t payload_size() const noexcept {
+        return args_.size();
+    }
+
+    /**
+     * @brief The serialised arguments
+     */
+    [[nodiscard]] const std::byte* payload() const noexcept {
+        return args_.data();
+    }
+
+    /**
+     * @brief Decoder instantiated for the argument types
+     */
+    [[nodiscard]] render_fn renderer() const noexcept {
+        return render_;
+    }
+
+private:
+    std::string_view fmt_;
+    render_fn render_ = nullptr;
+    format_arg_buffer args_;
+};
+
+/**
+ * @brief Capture a format string and its arguments without formatting
+ * @param fmt Format string with static storage duration
+ * @param args Arguments (strings are copied, other values stored by value)
+ * @return Deferred message to be rendered later
+ */
+template<typename... Args>
+deferred_message make_deferred_message(deferred_format_string<Args...> fmt, const Args&... args) {
+    format_arg_buffer buffer;
+    (detail::encode_deferred_arg<detail::deferred_arg_t<Args>>(buffer, args), ...);
+#if LOGGER_DEFERRED_HAS_STD_FORMAT
+    const std::string_view text = fmt.get();
+#else
+    const std::string_view text = fmt;
+#endif
+    return deferred_message(text, &detail::render_deferred<detail::deferred_arg_t<Args>...>,
+                            std::move(buffer));
+}
+
+} // namespace kcenon::logger
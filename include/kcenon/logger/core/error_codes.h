@@ -239,6 +239,7 @@ enum class logger_error_code {
     file_write_failed = 1101,
     file_rotation_failed = 1102,
     file_permission_denied = 1103,
+    file_compression_failed = 1104,
     
     // Network errors (1200-1299)
     network_connection_failed = 1200,
@@ -331,6 +332,8 @@ inline std::string logger_error_to_string(logger_error_code code) {
             return "File rotation failed";
         case logger_error_code::file_permission_denied:
             return "File permission denied";
+        case logger_error_code::file_compression_failed:
+            return "File compression failed";
             
         // Network errors
         case logger_error_code::network_connection_failed:
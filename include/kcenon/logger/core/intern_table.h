@@ -0,0 +1,268 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file intern_table.h
+ * @brief Process-wide string intern table and the interned_string handle
+ * @since 4.1.0
+ *
+ * @details Source file paths, function names and categories repeat across
+ * millions of entries but come from a few thousand distinct strings. The
+ * intern table stores each distinct string once and hands out a 32-bit id;
+ * log_entry and queued records carry the id instead of a copy.
+ *
+ * Lookups and id resolution never lock. Inserting a new string takes a
+ * mutex, which only happens the first time a string is seen. Strings are
+ * never removed, so a resolved std::string_view stays valid for the life of
+ * the process.
+ *
+ * @code
+ * interned_string file("src/server.cpp");   // Interned once
+ * auto id = file.id();                      // 4 bytes to queue or store
+ * std::string_view text = interned_string::from_id(id);
+ * @endcode
+ */
+
+#include <kcenon/logger/core/small_string.h>
+#include <kcenon/logger/logger_export.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kcenon::logger {
+
+/**
+ * @class intern_table
+ * @brief Append-only string table with lock-free lookup and resolution
+ */
+class LOGGER_SYSTEM_API intern_table {
+public:
+    using id_type = std::uint32_t;
+
+    /// Id of the empty string; also returned when the table is full
+    static constexpr id_type empty_id = 0;
+
+    /// Maximum number of distinct strings
+    static constexpr std::size_t max_entries = std::size_t{1} << 22;
+
+    /// Maximum number of strings intern_category() adds to the table
+    static constexpr std::size_t max_categories = std::size_t{1} << 16;
+
+    /**
+     * @brief Get the process-wide table (never destroyed)
+     */
+    static intern_table& instance();
+
+    /**
+     * @brief Get the id of a string, adding it on first use
+     * @return Id that resolves to an equal string, or empty_id if the text is
+     *         empty or the table already holds max_entries strings
+     */
+    id_type intern(std::string_view text);
+
+    /**
+     * @brief Get the id of a category, adding it only within max_categories
+     *
+     * Categories may be built from runtime data, and the table never
+     * shrinks, so new ones are refused once max_categories have been added
+     * this way. Strings already in the table are always found.
+     * @return Id of the text, or empty_id if it is empty or was refused;
+     *         refusals are counted in category_overflow_count()
+     */
+    id_type intern_category(std::string_view text);
+
+    /**
+     * @brief Get the string for an id returned by intern()
+     * @return Null-terminated view valid for the life of the process
+     */
+    [[nodiscard]] std::string_view resolve(id_type id) const noexcept;
+
+    /**
+     * @brief Number of distinct strings, including the empty string
+     */
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    /**
+     * @brief Bytes held by string storage, id slots and the hash index
+     */
+    [[nodiscard]] std::size_t memory_usage() const noexcept;
+
+    /**
+     * @brief Number of intern() calls rejected because the table was full
+     */
+    [[nodiscard]] std::uint64_t overflow_count() const noexcept;
+
+    /**
+     * @brief Number of intern_category() calls refused for a new category
+     */
+    [[nodiscard]] std::uint64_t category_overflow_count() const noexcept;
+
+    intern_table(const intern_table&) = delete;
+    intern_table& operator=(const intern_table&) = delete;
+
+private:
+    struct entry {
+        const char* data;
+        std::uint32_t size;
+        std::uint32_t hash;
+    };
+
+    struct hash_index {
+        explicit hash_index(std::size_t capacity);
+
+        std::size_t mask;
+        std::unique_ptr<std::atomic<id_type>[]> slots;
+    };
+
+    static constexpr std::size_t segment_bits = 12;
+    static constexpr std::size_t segment_size = std::size_t{1} << segment_bits;
+    static constexpr std::size_t segment_count = max_entries / segment_size;
+    static constexpr std::size_t chunk_size = 64 * 1024;
+
+    intern_table();
+    ~intern_table() = default;
+
+    static std::uint64_t hash(std::string_view text) noexcept;
+
+    [[nodiscard]] const entry& entry_at(id_type id) const noexcept;
+    [[nodiscard]] id_type find(const hash_index& index, std::string_view text,
+                               std::uint64_t h) const noexcept;
+    id_type find_or_add(std::string_view text, bool category);
+    const char* store(std::string_view text);
+    void insert(hash_index& index, id_type id, std::uint64_t h) noexcept;
+    void grow_index();
+
+    std::atomic<hash_index*> index_;
+    std::atomic<entry*> segments_[segment_count] = {};
+    std::atomic<std::size_t> count_{1};
+    std::atomic<std::size_t> storage_bytes_{0};
+    std::atomic<std::uint64_t> overflow_{0};
+    std::atomic<std::uint64_t> category_overflow_{0};
+
+    // Guarded by insert_mutex_
+    mutable std::mutex insert_mutex_;
+    std::vector<std::unique_ptr<hash_index>> indexes_;  ///< Retired ones stay alive for readers
+    std::vector<std::unique_ptr<entry[]>> segment_storage_;
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    std::size_t chunk_used_ = chunk_size;
+    std::size_t categories_ = 0;  ///< Strings added by intern_category()
+};
+
+/**
+ * @class interned_string
+ * @brief Four-byte handle to a string in the intern table
+ *
+ * @details Offers the read-only part of the small_string interface, so code
+ * written against small_string fields keeps working. Equality between
+ * handles is an id comparison.
+ */
+class LOGGER_SYSTEM_API interned_string {
+public:
+    using id_type = intern_table::id_type;
+
+    interned_string() noexcept = default;
+
+    interned_string(const char* text)
+        : id_(text ? intern_table::instance().intern(text) : intern_table::empty_id) {}
+
+    interned_string(std::string_view text)
+        : id_(intern_table::instance().intern(text)) {}
+
+    interned_string(const std::string& text)
+        : interned_string(std::string_view(text)) {}
+
+    template<std::size_t N, typename A>
+    interned_string(const small_string<N, A>& text)
+        : interned_string(std::string_view(text)) {}
+
+    /**
+     * @brief Handle to a category, empty if intern_table refused it
+     * @see intern_table::intern_category()
+     */
+    [[nodiscard]] static interned_string category(std::string_view text) {
+        return from_id(intern_table::instance().intern_category(text));
+    }
+
+    /**
+     * @brief Wrap an id previously returned by intern_table::intern()
+     */
+    [[nodiscard]] static interned_string from_id(id_type id) noexcept {
+        interned_string result;
+        result.id_ = id;
+        return result;
+    }
+
+    [[nodiscard]] id_type id() const noexcept {
+        return id_;
+    }
+
+    [[nodiscard]] std::string_view view() const noexcept {
+        return intern_table::instance().resolve(id_);
+    }
+
+    operator std::string_view() const noexcept {
+        return view();
+    }
+
+    [[nodiscard]] const char* data() const noexcept {
+        return view().data();
+    }
+
+    [[nodiscard]] const char* c_str() const noexcept {
+        return data();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return view().size();
+    }
+
+    [[nodiscard]] std::size_t length() const noexcept {
+        return size();
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return id_ == intern_table::empty_id;
+    }
+
+    [[nodiscard]] std::string to_string() const {
+        return std::string(view());
+    }
+
+    void assign(const char* text, std::size_t length) {
+        id_ = intern_table::instance().intern(std::string_view(text, length));
+    }
+
+    void clear() noexcept {
+        id_ = intern_table::empty_id;
+    }
+
+    bool operator==(const interned_string& other) const noexcept {
+        return id_ == other.id_;
+    }
+
+    bool operator==(std::string_view text) const noexcept {
+        return view() == text;
+    }
+
+    bool operator==(const std::string& text) const noexcept {
+        return view() == text;
+    }
+
+    bool operator==(const char* text) const noexcept {
+        return text && view() == std::string_view(text);
+    }
+
+private:
+    id_type id_ = intern_table::empty_id;
+};
+
+} // namespace kcenon::logger
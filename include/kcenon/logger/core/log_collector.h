@@ -15,21 +15,95 @@
  */
 
 #include <kcenon/common/interfaces/logger_interface.h>
+#include <kcenon/logger/core/deferred_format.h>
+#include <kcenon/logger/core/logger_config.h>
 #include <kcenon/logger/interfaces/log_writer_interface.h>
 #include <kcenon/logger/logger_export.h>
 
 #include <atomic>
 #include <chrono>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace kcenon::logger {
 
+/**
+ * @brief Snapshot of a collector's queue-overflow counters
+ * @since 4.1.0
+ */
+struct queue_overflow_stats {
+    logger_config::overflow_policy policy = logger_config::overflow_policy::drop_newest; ///< Effective policy
+    std::uint64_t dropped_newest = 0;         ///< Entries rejected because the queue was full
+    std::uint64_t evicted_oldest = 0;         ///< Queued entries discarded to make room (drop_oldest)
+    std::uint64_t blocked_enqueues = 0;       ///< Enqueues that waited for space (block)
+    std::uint64_t block_timeouts = 0;         ///< Blocked enqueues that gave up; also counted in dropped_newest
+    std::chrono::nanoseconds blocked_time{0}; ///< Total time producers spent waiting for space
+    std::uint64_t growth_events = 0;          ///< Capacity doublings (grow)
+    std::size_t capacity = 0;                 ///< Current queue capacity
+};
+
+/**
+ * @brief Snapshot of one writer dispatch lane's counters
+ * @since 4.1.0
+ */
+struct writer_lane_stats {
+    std::vector<std::string> writers;          ///< Names of the writers served by the lane
+    std::uint64_t batches_written = 0;         ///< Batches handed to the lane's writers
+    std::uint64_t entries_written = 0;         ///< Entries in those batches
+    std::uint64_t entries_dropped = 0;         ///< Entries discarded because the lane queue was full
+    std::chrono::nanoseconds total_latency{0}; ///< Sum of post-to-written latency over all batches
+    std::chrono::nanoseconds max_latency{0};   ///< Worst post-to-written latency of a batch
+    std::size_t queued_entries = 0;            ///< Entries currently waiting in the lane
+    std::size_t capacity = 0;                  ///< Lane queue capacity in entries
+};
+
 /**
  * @brief Asynchronous log collector for high-performance logging
  * 
- * Collects log entries in a queue (mutex/condition-variable backed)
- * and processes them in a background thread to minimize logging overhead.
+ * Collects log entries in a queue and processes them in a background thread
+ * to minimize logging overhead. The queue is either mutex/condition-variable
+ * backed (default) or a bounded lock-free MPMC ring when
+ * logger_config::use_lock_free is set, in which case producers never take
+ * a lock on the hot path.
+ *
+ * With logger_config::use_thread_local_buffers each logging thread gets its
+ * own SPSC staging ring (registered lazily on its first log call) and the
+ * worker drains the rings round-robin, so producers share no cache line at
+ * all. Entries from one thread are always written in enqueue order;
+ * logger_config::merge_by_timestamp additionally interleaves threads by
+ * timestamp within each drained batch.
+ *
+ * With logger_config::use_per_cpu_buffers there is instead one bounded MPMC
+ * ring per CPU, and a producer pushes to the ring of the CPU it is running
+ * on (read from the thread's rseq area where available, else
+ * sched_getcpu()). Memory scales with the number of cores rather than the
+ * number of threads, and a ring is only contended by threads sharing a CPU.
+ * A thread that migrates may leave entries in two rings, so entries are
+ * only guaranteed to be in timestamp order within a batch with
+ * logger_config::merge_by_timestamp.
+ *
+ * When the queue is full, logger_config::queue_overflow_policy decides what
+ * happens to a new entry:
+ * - drop_newest: the new entry is rejected (default)
+ * - drop_oldest: the oldest queued entry is discarded to make room
+ * - block: the producer waits for space for at most
+ *   logger_config::overflow_block_timeout, then the entry is dropped
+ * - grow: the queue capacity doubles (mutex-backed queue only)
+ *
+ * With logger_config::writer_thread_count > 1 the worker no longer calls the
+ * writers itself. It converts each batch once and posts it to that many
+ * dispatch lanes, each with its own bounded queue and thread; writers are
+ * assigned to the lane serving the fewest writers. A slow writer then only
+ * delays the writers on its own lane, and a lane that falls behind drops
+ * batches instead of stalling the collector.
+ *
+ * Per-thread staging rings only have one consumer, so producers cannot evict
+ * from them; drop_oldest behaves like drop_newest there. grow is rejected by
+ * logger_config::validate() for the lock-free queues and falls back to
+ * drop_newest if used anyway.
  */
 class LOGGER_SYSTEM_API log_collector {
 public:
@@ -41,7 +115,20 @@ public:
      *                   Lower values reduce latency but may decrease throughput
      */
     explicit log_collector(std::size_t buffer_size = 8192, std::size_t batch_size = 100);
-    
+
+    /**
+     * @brief Constructor from logger configuration
+     * @param config Logger configuration; buffer_size, batch_size,
+     *               use_lock_free, use_thread_local_buffers,
+     *               use_per_cpu_buffers and merge_by_timestamp select the queue size and implementation,
+     *               queue_overflow_policy and overflow_block_timeout what
+     *               happens when it is full, writer_thread_count the number
+     *               of writer dispatch lanes, queue_huge_pages and
+     *               queue_lock_memory how lock-free rings are allocated
+     * @since 4.1.0
+     */
+    explicit log_collector(const logger_config& config);
+
     /**
      * @brief Destructor
      */
@@ -55,22 +142,48 @@ public:
      * @param line Source line
      * @param function Function name
      * @param timestamp Log timestamp
+     *
+     * @details The text is copied into the queued record before returning,
+     * so the views only need to stay valid for the duration of the call.
      */
     bool enqueue(common::interfaces::log_level level,
-                 const std::string& message,
-                 const std::string& file,
+                 std::string_view message,
+                 std::string_view file,
                  int line,
-                 const std::string& function,
+                 std::string_view function,
+                 const std::chrono::system_clock::time_point& timestamp);
+
+    /**
+     * @brief Enqueue a log entry whose message is formatted by the worker
+     * @param level Log level
+     * @param message Captured format string and arguments
+     * @param site Static call-site metadata, or nullptr; the source location
+     *             is filled in from it on the worker thread
+     * @param timestamp Log timestamp
+     * @since 4.1.0
+     */
+    bool enqueue(common::interfaces::log_level level,
+                 deferred_message&& message,
+                 const log_site* site,
                  const std::chrono::system_clock::time_point& timestamp);
     
     /**
      * @brief Add a writer
      * @param writer Shared pointer to writer
      *
-     * The collector stores a weak reference to prevent circular dependencies
-     * and ensure safe access even if the writer is destroyed.
+     * Writers are kept in an immutable snapshot that the worker reads without
+     * locking; adding or removing a writer publishes a new snapshot. The
+     * collector shares ownership until the writer is removed or cleared.
      */
     void add_writer(std::shared_ptr<log_writer_interface> writer);
+
+    /**
+     * @brief Remove a previously added writer
+     * @param writer Writer to remove
+     * @return true if the writer was registered and has been removed
+     * @since 4.1.0
+     */
+    bool remove_writer(const std::shared_ptr<log_writer_interface>& writer);
     
     /**
      * @brief Clear all writers
@@ -97,6 +210,20 @@ public:
      * @return Pair of (current_size, max_capacity)
      */
     std::pair<size_t, size_t> get_queue_metrics() const;
+
+    /**
+     * @brief Get queue-overflow counters
+     * @return Snapshot of the per-policy counters and current capacity
+     * @since 4.1.0
+     */
+    queue_overflow_stats get_overflow_stats() const;
+
+    /**
+     * @brief Get per-lane dispatch counters
+     * @return One entry per lane; empty when writer_thread_count is 1
+     * @since 4.1.0
+     */
+    std::vector<writer_lane_stats> get_lane_stats() const;
     
 private:
     class impl;
@@ -0,0 +1,102 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file log_macros.h
+ * @brief Call-site logging macros with a compile-time level floor
+ * @since 4.1.0
+ *
+ * @details Each LOGGER_<LEVEL>(logger, fmt, args...) call site owns a
+ * `static constexpr` log_site record (file, line, function, level, format)
+ * that is passed to logger::logf by pointer, so nothing about the location is
+ * copied on the calling thread.
+ *
+ * Levels below LOGGER_ACTIVE_LEVEL expand to nothing: neither the format
+ * string nor the arguments are evaluated. Enabled levels still check the
+ * logger's runtime level before evaluating the arguments.
+ *
+ * @code
+ * // Compile out trace and debug statements in release builds
+ * #define LOGGER_ACTIVE_LEVEL LOGGER_LEVEL_INFO
+ * #include <kcenon/logger/core/log_macros.h>
+ *
+ * LOGGER_DEBUG(log, "cache state {}", dump_cache());  // never evaluated
+ * LOGGER_INFO(log, "request {} took {} ms", id, elapsed_ms);
+ * @endcode
+ */
+
+#include "logger.h"
+
+#define LOGGER_LEVEL_TRACE 0
+#define LOGGER_LEVEL_DEBUG 1
+#define LOGGER_LEVEL_INFO 2
+#define LOGGER_LEVEL_WARNING 3
+#define LOGGER_LEVEL_ERROR 4
+#define LOGGER_LEVEL_CRITICAL 5
+#define LOGGER_LEVEL_OFF 6
+
+/**
+ * @brief Lowest level compiled into the binary (default: everything)
+ */
+#ifndef LOGGER_ACTIVE_LEVEL
+#define LOGGER_ACTIVE_LEVEL LOGGER_LEVEL_TRACE
+#endif
+
+/**
+ * @brief Emit a log statement with a static call-site record
+ * @note Implementation detail of the LOGGER_<LEVEL> macros
+ */
+#define LOGGER_LOG_AT_SITE(logger_ref, site_level, fmt, ...)                              \
+    do {                                                                                  \
+        static constexpr ::kcenon::logger::log_site kcenon_logger_site_{                  \
+            __FILE__, __LINE__, __func__, site_level, fmt};                               \
+        auto& kcenon_logger_ref_ = (logger_ref);                                          \
+        if (kcenon_logger_ref_.is_enabled(kcenon_logger_site_.level)) {                   \
+            kcenon_logger_ref_.logf(&kcenon_logger_site_, fmt __VA_OPT__(, ) __VA_ARGS__); \
+        }                                                                                 \
+    } while (0)
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_TRACE
+#define LOGGER_TRACE(logger_ref, fmt, ...) \
+    LOGGER_LOG_AT_SITE(logger_ref, ::kcenon::common::interfaces::log_level::trace, fmt __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define LOGGER_TRACE(logger_ref, fmt, ...) ((void)0)
+#endif
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_DEBUG
+#define LOGGER_DEBUG(logger_ref, fmt, ...) \
+    LOGGER_LOG_AT_SITE(logger_ref, ::kcenon::common::interfaces::log_level::debug, fmt __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define LOGGER_DEBUG(logger_ref, fmt, ...) ((void)0)
+#endif
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_INFO
+#define LOGGER_INFO(logger_ref, fmt, ...) \
+    LOGGER_LOG_AT_SITE(logger_ref, ::kcenon::common::interfaces::log_level::info, fmt __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define LOGGER_INFO(logger_ref, fmt, ...) ((void)0)
+#endif
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_WARNING
+#define LOGGER_WARNING(logger_ref, fmt, ...) \
+    LOGGER_LOG_AT_SITE(logger_ref, ::kcenon::common::interfaces::log_level::warning, fmt __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define LOGGER_WARNING(logger_ref, fmt, ...) ((void)0)
+#endif
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_ERROR
+#define LOGGER_ERROR(logger_ref, fmt, ...) \
+    LOGGER_LOG_AT_SITE(logger_ref, ::kcenon::common::interfaces::log_level::error, fmt __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define LOGGER_ERROR(logger_ref, fmt, ...) ((void)0)
+#endif
+
+#if LOGGER_ACTIVE_LEVEL <= LOGGER_LEVEL_CRITICAL
+#define LOGGER_CRITICAL(logger_ref, fmt, ...) \
+    LOGGER_LOG_AT_SITE(logger_ref, ::kcenon::common::interfaces::log_level::critical, fmt __VA_OPT__(, ) __VA_ARGS__)
+#else
+#define LOGGER_CRITICAL(logger_ref, fmt, ...) ((void)0)
+#endif
@@ -67,7 +67,10 @@
 // Use common_system's ILogger interface for standardized logging
 #include <kcenon/common/interfaces/logger_interface.h>
 
+#include "deferred_format.h"
 #include "error_codes.h"
+#include "log_collector.h"
+#include "logger_config.h"
 #include "metrics/logger_metrics.h"
 #include "../backends/integration_backend.h"
 #include <kcenon/logger/interfaces/logger_types.h>
@@ -176,6 +179,20 @@ public:
      */
     explicit logger(bool async = true, std::size_t buffer_size = 8192,
                    std::unique_ptr<backends::integration_backend> backend = nullptr);
+
+    /**
+     * @brief Constructor from a full logger configuration
+     * @param config Validated logger configuration
+     * @param backend Integration backend for level conversion (default: auto-detect)
+     *
+     * @details Like the (async, buffer_size) constructor, but also forwards the
+     * queue-related settings (batch_size, use_lock_free) to the async collector.
+     * This is the constructor used by logger_builder::build().
+     *
+     * @since 4.1.0
+     */
+    explicit logger(const logger_config& config,
+                   std::unique_ptr<backends::integration_backend> backend = nullptr);
     
     /**
      * @brief Destructor - ensures all logs are flushed
@@ -380,6 +397,13 @@ public:
      * @return Result containing metrics or error
      */
     result<metrics::logger_performance_stats> get_current_metrics() const;
+
+    /**
+     * @brief Get the async queue's overflow counters
+     * @return Per-policy counters, or an error in synchronous mode
+     * @since 4.1.0
+     */
+    result<queue_overflow_stats> get_queue_overflow_stats() const;
     
     /**
      * @brief Get metrics history for a specific duration
@@ -456,6 +480,76 @@ public:
      */
     bool has_filter() const;
 
+    // =========================================================================
+    // Deferred formatting
+    // =========================================================================
+
+    /**
+     * @brief Log a formatted message, deferring the formatting work
+     * @param level Log level
+     * @param fmt Format string with static storage duration (e.g. a literal)
+     * @param args Format arguments (strings or trivially copyable values)
+     * @return VoidResult indicating success or error
+     *
+     * @details In async mode the caller only copies the format string pointer
+     * and the raw argument bytes into the queue; std::format runs on the
+     * collector thread. Filters, samplers and sync mode need the final text,
+     * so in those cases the message is rendered on the calling thread.
+     *
+     * @example
+     * @code
+     * logger.logf(log_level::info, "request {} took {} ms", request_id, elapsed_ms);
+     * @endcode
+     *
+     * @since 4.1.0
+     */
+    template<typename... Args>
+    common::VoidResult logf(common::interfaces::log_level level,
+                            deferred_format_string<Args...> fmt,
+                            const Args&... args) {
+        if (!is_enabled(level)) {
+            return common::ok();
+        }
+        return log_deferred(level, make_deferred_message<Args...>(fmt, args...));
+    }
+
+    /**
+     * @brief Log a formatted message from a static call site
+     * @param site Call-site record with static storage duration; its level
+     *             is used and its location is attached to the entry
+     * @param fmt Format string (normally the same literal as site->format)
+     * @param args Format arguments (strings or trivially copyable values)
+     * @return VoidResult indicating success or error
+     *
+     * @note Normally reached through the LOGGER_TRACE ... LOGGER_CRITICAL
+     * macros in log_macros.h, which create the record and skip argument
+     * evaluation for disabled levels.
+     *
+     * @since 4.1.0
+     */
+    template<typename... Args>
+    common::VoidResult logf(const log_site* site,
+                            deferred_format_string<Args...> fmt,
+                            const Args&... args) {
+        if (!is_enabled(site->level)) {
+            return common::ok();
+        }
+        return log_deferred(site->level, make_deferred_message<Args...>(fmt, args...), site);
+    }
+
+    /**
+     * @brief Log a message captured by make_deferred_message()
+     * @param level Log level
+     * @param message Format string and serialised arguments
+     * @param site Static call-site record, or nullptr for no source location
+     * @return VoidResult indicating success or error
+     *
+     * @since 4.1.0
+     */
+    common::VoidResult log_deferred(common::interfaces::log_level level,
+                                    deferred_message&& message,
+                                    const log_site* site = nullptr);
+
     // =========================================================================
     // Routing system
     // =========================================================================
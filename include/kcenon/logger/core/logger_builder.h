@@ -257,6 +257,49 @@ public:
         config_.use_lock_free = enable;
         return *this;
     }
+
+    /**
+     * @brief Enable per-thread staging buffers
+     * @param enable Enable/disable per-thread SPSC rings with fan-in collection
+     * @param merge_by_timestamp Merge entries from different threads by
+     *                           timestamp within each drained batch
+     * @return Reference to builder for chaining
+     * @since 4.1.0
+     */
+    logger_builder& with_thread_local_buffers(bool enable = true, bool merge_by_timestamp = false) {
+        config_.use_thread_local_buffers = enable;
+        config_.merge_by_timestamp = merge_by_timestamp;
+        return *this;
+    }
+
+    /**
+     * @brief Enable per-CPU staging buffers
+     * @param enable Enable/disable per-CPU rings indexed by the producer's CPU
+     * @param merge_by_timestamp Merge entries from different CPUs by
+     *                           timestamp within each drained batch
+     * @return Reference to builder for chaining
+     * @since 4.1.0
+     */
+    logger_builder& with_per_cpu_buffers(bool enable = true, bool merge_by_timestamp = false) {
+        config_.use_per_cpu_buffers = enable;
+        config_.merge_by_timestamp = merge_by_timestamp;
+        return *this;
+    }
+
+    /**
+     * @brief Choose how lock-free collector rings are allocated
+     * @param huge_pages Map the rings with huge pages where available and
+     *                   prefault them when the collector starts
+     * @param lock_memory mlock() the rings so they are never paged out
+     * @return Reference to builder for chaining
+     * @note Only affects use_lock_free and use_per_cpu_buffers queues
+     * @since 4.1.0
+     */
+    logger_builder& with_queue_memory(bool huge_pages = true, bool lock_memory = false) {
+        config_.queue_huge_pages = huge_pages;
+        config_.queue_lock_memory = lock_memory;
+        return *this;
+    }
     
     /**
      * @brief Enable metrics collection
@@ -297,6 +340,17 @@ public:
         config_.queue_overflow_policy = policy;
         return *this;
     }
+
+    /**
+     * @brief Set the maximum producer wait under overflow_policy::block
+     * @param timeout Wait bound; the entry is dropped when it expires
+     * @return Reference to builder for chaining
+     * @since 4.1.0
+     */
+    logger_builder& with_overflow_block_timeout(std::chrono::milliseconds timeout) {
+        config_.overflow_block_timeout = timeout;
+        return *this;
+    }
     
     /**
      * @brief Set max queue size
@@ -975,7 +1029,7 @@ public:
         }
 
         // Create logger with validated configuration
-        auto logger_instance = std::make_unique<logger>(config_.async, config_.buffer_size, std::move(backend_));
+        auto logger_instance = std::make_unique<logger>(config_, std::move(backend_));
 
         // Apply configuration settings
         logger_instance->set_level(config_.min_level);
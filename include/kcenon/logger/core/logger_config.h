@@ -45,6 +45,9 @@ struct logger_config {
     std::size_t batch_size = 100;                   ///< Number of messages per batch write.
     std::chrono::milliseconds flush_interval{1000}; ///< Interval between automatic flushes.
     bool use_lock_free = false;                     ///< Use lock-free queue implementation.
+    bool use_thread_local_buffers = false;          ///< Stage entries in per-thread SPSC rings drained by the collector (overrides use_lock_free).
+    bool use_per_cpu_buffers = false;               ///< Stage entries in per-CPU rings indexed by the producer's current CPU (overrides use_thread_local_buffers and use_lock_free).
+    bool merge_by_timestamp = false;                ///< Merge per-thread runs by timestamp within each drained batch.
     std::size_t max_writers = 10;                   ///< Maximum number of concurrent writers.
     bool enable_batch_writing = false;              ///< Enable batch writing mode.
     /// @}
@@ -73,6 +76,9 @@ struct logger_config {
         grow            ///< Dynamically grow the queue (use with caution).
     };
     overflow_policy queue_overflow_policy = overflow_policy::drop_newest; ///< Active overflow policy.
+    std::chrono::milliseconds overflow_block_timeout{100}; ///< Longest a producer waits under overflow_policy::block before the entry is dropped.
+    bool queue_huge_pages = false;                   ///< Map lock-free collector rings (use_lock_free, use_per_cpu_buffers) with huge pages where available and prefault them at start().
+    bool queue_lock_memory = false;                  ///< mlock() lock-free collector rings at start() so they are never paged out.
     /// @}
 
     /// @name File output settings
@@ -94,7 +100,7 @@ struct logger_config {
     /// @name Performance tuning
     /// @{
     std::size_t writer_thread_count = 1;             ///< Number of dedicated writer threads.
-    bool enable_compression = false;                 ///< Enable log compression.
+    bool enable_compression = false;                 ///< Compress rotated log files (see segment_compression_options).
     
     /**
      * @brief Validate the configuration
@@ -201,12 +207,27 @@ struct logger_config {
                             "Writer thread count too large (max 32)");
         }
 
+        if (overflow_block_timeout.count() < 0) {
+            return make_logger_void_result(logger_error_code::invalid_configuration,
+                            "Overflow block timeout must be non-negative");
+        }
+
         // Validate feature combinations
         if (use_lock_free && queue_overflow_policy == overflow_policy::grow) {
             return make_logger_void_result(logger_error_code::invalid_configuration,
                             "Lock-free queue cannot use grow overflow policy");
         }
 
+        if (use_thread_local_buffers && queue_overflow_policy == overflow_policy::grow) {
+            return make_logger_void_result(logger_error_code::invalid_configuration,
+                            "Thread-local buffers cannot use grow overflow policy");
+        }
+
+        if (use_per_cpu_buffers && queue_overflow_policy == overflow_policy::grow) {
+            return make_logger_void_result(logger_error_code::invalid_configuration,
+                            "Per-CPU buffers cannot use grow overflow policy");
+        }
+
         if (!async && batch_size > 1) {
             return make_logger_void_result(logger_error_code::invalid_configuration,
                             "Batch processing requires async mode");
@@ -288,6 +288,17 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Set the maximum producer wait under overflow_policy::block
+     * @param timeout Wait bound; the entry is dropped when it expires
+     * @return Reference to builder for chaining
+     * @since 4.1.0
+     */
+    logger_config_builder& set_overflow_block_timeout(std::chrono::milliseconds timeout) {
+        config_.overflow_block_timeout = timeout;
+        return *this;
+    }
+
     // =========================================================================
     // File Output Settings
     // =========================================================================
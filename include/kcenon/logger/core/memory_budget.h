@@ -0,0 +1,220 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file memory_budget.h
+ * @brief Process-wide byte budget shared by every queueing component
+ * @since 4.1.0
+ *
+ * @details Each queue in the logger (the collector queue, async_writer,
+ * batch_writer, buffered_writer, network_writer and otlp_writer) bounds its
+ * own entry count, but none of them bounds bytes and nothing bounds their
+ * sum. memory_budget keeps one atomic byte counter for the whole process.
+ * Every queueing component owns a budget_consumer, reserves an entry's
+ * bytes before queueing it and releases them once the entry has been
+ * written or discarded.
+ *
+ * With no limit configured (the default) only the per-consumer counters are
+ * kept, split per CPU so producers never share a cache line; the metrics
+ * sum them when read. Bytes admitted then do not count against a limit set
+ * later. Once a limit is set, an entry
+ * that does not fit is handled by the configured budget_policy:
+ * - drop_by_level: each level may only fill part of the budget (trace 50%,
+ *   debug 60%, info 75%, warning 85%, error 95%, critical 100%), so low
+ *   levels are shed first and the rest is kept for errors
+ * - block: the producer waits up to block_timeout for other entries to be
+ *   released, then drops
+ * - spill: the entry is appended to spill_path on the producer's thread
+ *   instead of being queued (dropped if no spill path is set)
+ *
+ * @code
+ * memory_budget::config cfg;
+ * cfg.limit_bytes = 64 * 1024 * 1024;
+ * cfg.policy = budget_policy::drop_by_level;
+ * memory_budget::instance().configure(cfg);
+ *
+ * for (const auto& stats : memory_budget::instance().get_consumer_stats()) {
+ *     std::cout << stats.name << ": " << stats.held_bytes << " bytes\n";
+ * }
+ * @endcode
+ */
+
+#include <kcenon/logger/interfaces/log_entry.h>
+#include <kcenon/logger/logger_export.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace kcenon::logger {
+
+/**
+ * @brief What to do with an entry that does not fit in the budget
+ */
+enum class budget_policy : std::uint8_t {
+    drop_by_level,  ///< Reserve headroom for higher levels; drop what does not fit
+    block,          ///< Wait up to block_timeout for bytes to be released
+    spill           ///< Append the entry to the spill file instead of queueing it
+};
+
+/**
+ * @brief Outcome of budget_consumer::admit()
+ */
+enum class budget_decision : std::uint8_t {
+    admitted,  ///< Bytes reserved; queue the entry and release them later
+    dropped,   ///< Over budget; discard the entry
+    spill      ///< Over budget; pass the entry to budget_consumer::spill()
+};
+
+/**
+ * @brief Accounting snapshot of one budget consumer
+ */
+struct budget_consumer_stats {
+    std::string name;
+    std::size_t held_bytes = 0;   ///< Bytes currently reserved
+    std::size_t peak_bytes = 0;   ///< Highest held_bytes seen
+    std::uint64_t admitted = 0;   ///< Entries admitted
+    std::uint64_t dropped = 0;    ///< Entries rejected by the budget
+    std::uint64_t blocked = 0;    ///< Admissions that had to wait (block policy)
+    std::uint64_t spilled = 0;    ///< Entries written to the spill file
+};
+
+class budget_consumer;
+
+/**
+ * @class memory_budget
+ * @brief Process-wide byte limit for queued log entries
+ */
+class LOGGER_SYSTEM_API memory_budget {
+public:
+    struct config {
+        /// Byte limit across all consumers; 0 accounts without limiting
+        std::size_t limit_bytes = 0;
+        budget_policy policy = budget_policy::drop_by_level;
+        /// Longest a producer waits under budget_policy::block
+        std::chrono::milliseconds block_timeout{100};
+        /// Append-only file for budget_policy::spill
+        std::string spill_path;
+    };
+
+    /**
+     * @brief Get the process-wide budget (never destroyed)
+     */
+    static memory_budget& instance();
+
+    /**
+     * @brief Replace the limit and policy
+     * @note Bytes already reserved stay reserved; a lower limit only
+     *       affects new admissions
+     */
+    void configure(const config& cfg);
+
+    [[nodiscard]] config get_config() const;
+
+    /**
+     * @brief Bytes currently reserved by all consumers
+     */
+    [[nodiscard]] std::size_t used_bytes() const noexcept;
+
+    /**
+     * @brief Highest used_bytes() seen while a limit was set
+     */
+    [[nodiscard]] std::size_t peak_bytes() const noexcept;
+
+    /**
+     * @brief Snapshot of every live consumer
+     */
+    [[nodiscard]] std::vector<budget_consumer_stats> get_consumer_stats() const;
+
+    /**
+     * @brief Share of the limit (percent) a level may fill under drop_by_level
+     */
+    [[nodiscard]] static std::size_t level_share_percent(log_level level) noexcept;
+
+    memory_budget(const memory_budget&) = delete;
+    memory_budget& operator=(const memory_budget&) = delete;
+
+private:
+    friend class budget_consumer;
+
+    memory_budget();
+    ~memory_budget();
+
+    class impl;
+    std::unique_ptr<impl> pimpl_;
+};
+
+/**
+ * @class budget_consumer
+ * @brief One queue's account with the process-wide memory_budget
+ *
+ * @details Call admit() before queueing an entry (and outside the queue's
+ * own lock, since the block policy waits for other threads to release),
+ * and release() with the same byte count when the entry leaves the queue.
+ * Bytes still held on destruction are released.
+ */
+class LOGGER_SYSTEM_API budget_consumer {
+public:
+    /**
+     * @param name Label reported in budget_consumer_stats
+     */
+    explicit budget_consumer(std::string name);
+    ~budget_consumer();
+
+    budget_consumer(const budget_consumer&) = delete;
+    budget_consumer& operator=(const budget_consumer&) = delete;
+
+    /**
+     * @brief Reserve bytes for an entry of the given level
+     */
+    budget_decision admit(log_level level, std::size_t bytes);
+
+    /**
+     * @brief Reserve bytes only if they fit right now
+     *
+     * Never waits, spills or counts a drop. Lets a consumer that can free
+     * its own bytes (by flushing) do so before falling back to admit().
+     * @return true if the bytes were reserved
+     */
+    bool try_admit(log_level level, std::size_t bytes) noexcept;
+
+    /**
+     * @brief Return bytes reserved by admit() or try_admit()
+     */
+    void release(std::size_t bytes) noexcept;
+
+    /**
+     * @brief Write an entry to the spill file (after budget_decision::spill)
+     */
+    void spill(const log_entry& entry);
+
+    /**
+     * @brief Write a message to the spill file (after budget_decision::spill)
+     */
+    void spill(log_level level,
+               std::chrono::system_clock::time_point timestamp,
+               std::string_view message);
+
+    [[nodiscard]] std::size_t held_bytes() const noexcept;
+
+    [[nodiscard]] budget_consumer_stats get_stats() const;
+
+    /**
+     * @brief Bytes a queued copy of entry occupies (object plus heap buffers)
+     */
+    [[nodiscard]] static std::size_t entry_bytes(const log_entry& entry) noexcept;
+
+    struct state;
+
+private:
+    std::shared_ptr<state> state_;
+};
+
+} // namespace kcenon::logger
@@ -6,15 +6,22 @@
  * @file small_string.h
  * @brief Small String Optimization (SSO) for short log messages.
  *
+ * @details Strings that outgrow the inline buffer take their heap block from
+ * the allocator parameter. The default, string_pool_allocator, serves them
+ * from thread-cached size-class pools (see string_pool.h); any standard
+ * allocator, including std::pmr::polymorphic_allocator, can be used instead.
  */
 
 #pragma once
 
+#include "string_pool.h"
+
 #include <cstring>
 #include <string>
 #include <string_view>
 #include <algorithm>
 #include <memory>
+#include <memory_resource>
 #include <utility>
 
 namespace kcenon::logger {
@@ -24,26 +31,40 @@ namespace kcenon::logger {
  * 
  * This class implements a string with Small String Optimization.
  * Strings smaller than SSO_CAPACITY are stored inline, avoiding heap allocation.
- * Larger strings use heap allocation like std::string.
+ * Larger strings use a block from Allocator like std::string.
  * 
  * @tparam SSO_SIZE Size threshold for SSO (default 256 bytes)
+ * @tparam Allocator Allocator for the heap fallback (since 4.1.0)
  */
-template<size_t SSO_SIZE = 256>
+template<size_t SSO_SIZE = 256, typename Allocator = string_pool_allocator<char>>
 class small_string {
+    using alloc_traits = std::allocator_traits<Allocator>;
+
 public:
     static constexpr size_t SSO_CAPACITY = SSO_SIZE - 1; // Reserve 1 byte for null terminator
+
+    using allocator_type = Allocator;
     
     /**
      * @brief Default constructor
      */
-    small_string() noexcept : size_(0), is_small_(true) {
+    small_string() noexcept(noexcept(Allocator())) : size_(0), is_small_(true) {
+        data_.small[0] = '\0';
+    }
+
+    /**
+     * @brief Construct an empty string with an allocator
+     * @since 4.1.0
+     */
+    explicit small_string(const Allocator& alloc) noexcept
+        : alloc_(alloc), size_(0), is_small_(true) {
         data_.small[0] = '\0';
     }
     
     /**
      * @brief Construct from C-string
      */
-    small_string(const char* str) : small_string() {
+    small_string(const char* str, const Allocator& alloc = Allocator()) : small_string(alloc) {
         if (str) {
             assign(str, std::strlen(str));
         }
@@ -52,21 +73,22 @@ public:
     /**
      * @brief Construct from std::string
      */
-    small_string(const std::string& str) : small_string() {
+    small_string(const std::string& str, const Allocator& alloc = Allocator()) : small_string(alloc) {
         assign(str.data(), str.size());
     }
     
     /**
      * @brief Construct from string_view
      */
-    small_string(std::string_view str) : small_string() {
+    small_string(std::string_view str, const Allocator& alloc = Allocator()) : small_string(alloc) {
         assign(str.data(), str.size());
     }
     
     /**
      * @brief Copy constructor
      */
-    small_string(const small_string& other) : small_string() {
+    small_string(const small_string& other)
+        : small_string(alloc_traits::select_on_container_copy_construction(other.alloc_)) {
         if (other.is_small_) {
             std::memcpy(data_.small, other.data_.small, other.size_ + 1);
             size_ = other.size_;
@@ -80,7 +102,7 @@ public:
      * @brief Move constructor
      */
     small_string(small_string&& other) noexcept 
-        : size_(other.size_), is_small_(other.is_small_) {
+        : alloc_(std::move(other.alloc_)), size_(other.size_), is_small_(other.is_small_) {
         if (is_small_) {
             std::memcpy(data_.small, other.data_.small, size_ + 1);
         } else {
@@ -89,6 +111,7 @@ public:
             other.data_.heap.ptr = nullptr;
             other.size_ = 0;
             other.is_small_ = true;
+            other.data_.small[0] = '\0';
         }
     }
     
@@ -96,9 +119,7 @@ public:
      * @brief Destructor
      */
     ~small_string() {
-        if (!is_small_ && data_.heap.ptr) {
-            delete[] data_.heap.ptr;
-        }
+        release_heap();
     }
     
     /**
@@ -106,6 +127,13 @@ public:
      */
     small_string& operator=(const small_string& other) {
         if (this != &other) {
+            if constexpr (alloc_traits::propagate_on_container_copy_assignment::value) {
+                if (alloc_ != other.alloc_) {
+                    release_heap();
+                    is_small_ = true;
+                }
+                alloc_ = other.alloc_;
+            }
             assign(other.data(), other.size());
         }
         return *this;
@@ -114,11 +142,23 @@ public:
     /**
      * @brief Move assignment
      */
-    small_string& operator=(small_string&& other) noexcept {
+    small_string& operator=(small_string&& other) noexcept(
+        alloc_traits::propagate_on_container_move_assignment::value ||
+        alloc_traits::is_always_equal::value) {
         if (this != &other) {
+            if constexpr (!alloc_traits::propagate_on_container_move_assignment::value &&
+                          !alloc_traits::is_always_equal::value) {
+                if (alloc_ != other.alloc_) {
+                    // Cannot adopt a block from a different allocator
+                    assign(other.data(), other.size());
+                    return *this;
+                }
+            }
+
             // Clean up current heap allocation if any
-            if (!is_small_ && data_.heap.ptr) {
-                delete[] data_.heap.ptr;
+            release_heap();
+            if constexpr (alloc_traits::propagate_on_container_move_assignment::value) {
+                alloc_ = std::move(other.alloc_);
             }
             
             size_ = other.size_;
@@ -132,6 +172,7 @@ public:
                 other.data_.heap.ptr = nullptr;
                 other.size_ = 0;
                 other.is_small_ = true;
+                other.data_.small[0] = '\0';
             }
         }
         return *this;
@@ -143,9 +184,7 @@ public:
     void assign(const char* str, size_t len) {
         if (len <= SSO_CAPACITY) {
             // Use small string optimization
-            if (!is_small_ && data_.heap.ptr) {
-                delete[] data_.heap.ptr;
-            }
+            release_heap();
             std::memcpy(data_.small, str, len);
             data_.small[len] = '\0';
             size_ = len;
@@ -154,12 +193,10 @@ public:
             // Use heap allocation
             if (is_small_ || data_.heap.capacity < len + 1) {
                 // Need to allocate new buffer
-                if (!is_small_ && data_.heap.ptr) {
-                    delete[] data_.heap.ptr;
-                }
+                release_heap();
                 
                 size_t new_capacity = calculate_capacity(len);
-                data_.heap.ptr = new char[new_capacity];
+                data_.heap.ptr = alloc_traits::allocate(alloc_, new_capacity);
                 data_.heap.capacity = new_capacity;
                 is_small_ = false;
             }
@@ -246,15 +283,13 @@ public:
         
         // Need heap allocation
         size_t actual_capacity = calculate_capacity(new_capacity);
-        char* new_ptr = new char[actual_capacity];
+        char* new_ptr = alloc_traits::allocate(alloc_, actual_capacity);
         
         // Copy existing data
         std::memcpy(new_ptr, data(), size_ + 1);
         
         // Clean up old allocation
-        if (!is_small_ && data_.heap.ptr) {
-            delete[] data_.heap.ptr;
-        }
+        release_heap();
         
         data_.heap.ptr = new_ptr;
         data_.heap.capacity = actual_capacity;
@@ -277,7 +312,7 @@ public:
             if (is_small_ || data_.heap.capacity < new_size + 1) {
                 // Need to reallocate
                 size_t new_capacity = calculate_capacity(new_size);
-                char* new_ptr = new char[new_capacity];
+                char* new_ptr = alloc_traits::allocate(alloc_, new_capacity);
                 
                 // Copy existing data
                 std::memcpy(new_ptr, data(), size_);
@@ -286,9 +321,7 @@ public:
                 new_ptr[new_size] = '\0';
                 
                 // Clean up old allocation
-                if (!is_small_ && data_.heap.ptr) {
-                    delete[] data_.heap.ptr;
-                }
+                release_heap();
                 
                 data_.heap.ptr = new_ptr;
                 data_.heap.capacity = new_capacity;
@@ -325,6 +358,14 @@ public:
         return *this;
     }
     
+    /**
+     * @brief Get the allocator used for the heap fallback
+     * @since 4.1.0
+     */
+    allocator_type get_allocator() const noexcept {
+        return alloc_;
+    }
+
     /**
      * @brief Convert to std::string
      */
@@ -388,12 +429,30 @@ private:
      * @brief Calculate capacity for heap allocation
      */
     static size_t calculate_capacity(size_t required) {
-        // Round up to next power of 2 for better allocation patterns
         size_t capacity = required + 1; // +1 for null terminator
+
+        // Size classes are already spaced geometrically; use the whole
+        // class block instead of adding growth headroom on top
+        if constexpr (requires { Allocator::good_size(capacity); }) {
+            return Allocator::good_size((capacity + 15) & ~size_t{15});
+        }
+
+        // Round up to next power of 2 for better allocation patterns
         capacity = capacity * 3 / 2; // 1.5x growth factor
         
         // Align to 16 bytes for better memory alignment
-        return (capacity + 15) & ~15;
+        return (capacity + 15) & ~size_t{15};
+    }
+
+    /**
+     * @brief Return the heap block, if any, to the allocator
+     * @note Leaves is_small_ unchanged; callers reset it or install a new block
+     */
+    void release_heap() noexcept {
+        if (!is_small_ && data_.heap.ptr) {
+            alloc_traits::deallocate(alloc_, data_.heap.ptr, data_.heap.capacity);
+            data_.heap.ptr = nullptr;
+        }
     }
     
     // Data storage
@@ -409,6 +468,8 @@ private:
         
         data_union() : small{} {}
     } data_;
+
+    [[no_unique_address]] Allocator alloc_;
     
     size_t size_;
     bool is_small_;
@@ -420,4 +481,11 @@ using small_string_128 = small_string<128>;
 using small_string_256 = small_string<256>;
 using small_string_512 = small_string<512>;
 
+/**
+ * @brief small_string whose heap fallback uses a std::pmr memory resource
+ * @since 4.1.0
+ */
+template<size_t SSO_SIZE = 256>
+using pmr_small_string = small_string<SSO_SIZE, std::pmr::polymorphic_allocator<char>>;
+
 } // namespace kcenon::logger
\ No newline at end of file
@@ -0,0 +1,121 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file string_pool.h
+ * @brief Size-class block pools behind small_string's heap fallback
+ * @since 4.1.0
+ *
+ * @details Messages that outgrow small_string's inline buffer (stack traces,
+ * JSON payloads) used to go through new[] and delete[] on every entry. The
+ * string pool keeps freed blocks in size classes and hands them back out, so
+ * a steady stream of long messages reuses the same blocks.
+ *
+ * Each thread caches a few blocks per class and touches no shared state
+ * while its cache can serve the request. Caches exchange blocks with a
+ * shared per-class depot in batches, which covers blocks allocated on one
+ * thread and freed on another (producer to collector worker). Requests
+ * above max_pooled_size go straight to the global heap.
+ *
+ * @code
+ * // small_string uses the pool by default
+ * small_string_256 message(std::string(4000, 'x'));
+ *
+ * // Direct use
+ * void* block = string_pool::allocate(1000);     // Served from the 1 KiB class
+ * string_pool::deallocate(block, 1000);
+ * @endcode
+ */
+
+#include <kcenon/logger/logger_export.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kcenon::logger {
+
+/**
+ * @class string_pool
+ * @brief Process-wide, thread-cached size-class pool for string buffers
+ */
+class LOGGER_SYSTEM_API string_pool {
+public:
+    /// Largest request served from a size class
+    static constexpr std::size_t max_pooled_size = 128 * 1024;
+
+    /**
+     * @brief Pool counters
+     */
+    struct statistics {
+        std::uint64_t fresh_allocations = 0;  ///< Blocks taken from the global heap for a class
+        std::uint64_t released_blocks = 0;    ///< Blocks returned to the heap because the depot was full
+        std::uint64_t oversize_allocations = 0;  ///< Requests above max_pooled_size
+        std::size_t depot_bytes = 0;          ///< Bytes currently parked in shared depots
+    };
+
+    /**
+     * @brief Allocate at least bytes bytes
+     * @return Block aligned to alignof(std::max_align_t)
+     */
+    static void* allocate(std::size_t bytes);
+
+    /**
+     * @brief Return a block from allocate()
+     * @param bytes The size passed to allocate() (or any size with the same good_size())
+     */
+    static void deallocate(void* block, std::size_t bytes) noexcept;
+
+    /**
+     * @brief Usable size of a block allocated for bytes
+     *
+     * Callers that track capacity can use the whole block; deallocate()
+     * accepts either the requested or the rounded size.
+     */
+    [[nodiscard]] static std::size_t good_size(std::size_t bytes) noexcept;
+
+    /**
+     * @brief Snapshot of the shared counters
+     */
+    [[nodiscard]] static statistics get_statistics() noexcept;
+};
+
+/**
+ * @class string_pool_allocator
+ * @brief Stateless allocator over string_pool, the default for small_string
+ * @tparam T Element type
+ */
+template<typename T>
+class string_pool_allocator {
+public:
+    using value_type = T;
+
+    string_pool_allocator() noexcept = default;
+
+    template<typename U>
+    string_pool_allocator(const string_pool_allocator<U>&) noexcept {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+        return static_cast<T*>(string_pool::allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        string_pool::deallocate(p, n * sizeof(T));
+    }
+
+    /**
+     * @brief Element count that fills the block serving n elements
+     */
+    [[nodiscard]] static std::size_t good_size(std::size_t n) noexcept {
+        return string_pool::good_size(n * sizeof(T)) / sizeof(T);
+    }
+
+    template<typename U>
+    bool operator==(const string_pool_allocator<U>&) const noexcept {
+        return true;
+    }
+};
+
+} // namespace kcenon::logger
@@ -168,6 +168,7 @@ public:
      * @brief Set the category for the log entry
      * @param cat Category string
      * @return Reference to this builder for chaining
+     * @note Dropped if intern_table::max_categories have already been added
      */
     structured_log_builder& category(const std::string& cat) {
         category_ = cat;
@@ -192,8 +193,8 @@ public:
             entry.fields = std::move(fields_);
         }
 
-        if (!category_.empty()) {
-            entry.category = small_string_128(category_);
+        if (auto cat = interned_string::category(category_); !cat.empty()) {
+            entry.category = cat;
         }
 
         callback_(std::move(entry));
@@ -19,6 +19,7 @@
 #include <functional>
 #include <chrono>
 
+#include "../core/logger_config.h"
 #include "../writers/base_writer.h"
 #include "../writers/console_writer.h"
 #include "../writers/file_writer.h"
@@ -70,7 +71,9 @@ public:
         bool append = true,
         std::size_t buffer_size = 8192
     ) {
-        return std::make_unique<file_writer>(filename, append, buffer_size);
+        file_output_options output;
+        output.buffer_size = buffer_size;
+        return std::make_unique<file_writer>(filename, append, nullptr, output);
     }
 
     /**
@@ -107,7 +110,28 @@ public:
         std::size_t check_interval = 100
     ) {
         return std::make_unique<rotating_file_writer>(
-            filename, type, max_files, check_interval
+            filename, type, max_files, check_interval, file_output_options{}
+        );
+    }
+
+    /**
+     * @brief Create a size-based rotating file writer from a logger configuration
+     * @param config Supplies log_directory, log_file_prefix, max_file_size,
+     *        max_file_count and enable_compression
+     * @return Unique pointer to a rotating file writer for
+     *         `<log_directory>/<log_file_prefix>.log` that gzip-compresses
+     *         rotated segments when enable_compression is set
+     * @since 4.1.0
+     */
+    static log_writer_ptr create_rotating_file(const logger_config& config) {
+        segment_compression_options compression;
+        if (config.enable_compression) {
+            compression.codec = compression_codec::gzip;
+        }
+        return std::make_unique<rotating_file_writer>(
+            config.log_directory + "/" + config.log_file_prefix + ".log",
+            config.max_file_size, config.max_file_count, 100,
+            file_output_options{}, compression
         );
     }
 
@@ -181,6 +205,18 @@ public:
         return create_batch(std::move(rotating), 200, std::chrono::milliseconds(2000));
     }
 
+    /**
+     * @brief Create a production preset writer from a logger configuration
+     * @param config Supplies the file settings of create_rotating_file(const logger_config&)
+     *        plus batch_size and flush_interval
+     * @return Batched rotating file writer
+     * @since 4.1.0
+     */
+    static log_writer_ptr create_production(const logger_config& config) {
+        return create_batch(create_rotating_file(config), config.batch_size,
+                            config.flush_interval);
+    }
+
     /**
      * @brief Create a high-performance preset writer
      * @param filename Log file path
@@ -189,7 +225,9 @@ public:
     static log_writer_ptr create_high_performance(
         const std::string& filename = "./logs/app.log"
     ) {
-        auto file = std::make_unique<file_writer>(filename, true, 65536);
+        file_output_options output;
+        output.buffer_size = 65536;
+        auto file = std::make_unique<file_writer>(filename, true, nullptr, output);
         return create_batch(std::move(file), 500, std::chrono::milliseconds(5000));
     }
 
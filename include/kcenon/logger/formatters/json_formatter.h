@@ -9,7 +9,9 @@
 #include "../utils/time_utils.h"
 #include "../utils/string_utils.h"
 #include <sstream>
+#include <cstdio>
 #include <iomanip>
+#include <string_view>
 #include <type_traits>
 #include <variant>
 
@@ -99,120 +101,169 @@ public:
      * @since 1.2.0
      */
     std::string format(const log_entry& entry) const override {
-        std::ostringstream oss;
+        std::string out;
+        append_formatted(entry, out);
+        return out;
+    }
+
+    /**
+     * @brief Append the JSON object to @p out without temporary strings
+     *
+     * @since 4.1.0
+     */
+    void format_to(const log_entry& entry, std::pmr::string& out) const override {
+        append_formatted(entry, out);
+    }
+
+    /**
+     * @brief Get formatter name
+     * @return "json_formatter"
+     *
+     * @since 1.2.0
+     */
+    std::string get_name() const override {
+        return "json_formatter";
+    }
+
+private:
+    template<typename String>
+    void append_formatted(const log_entry& entry, String& out) const {
+        using utils::string_utils;
         const char* indent = options_.pretty_print ? "  " : "";
         const char* newline = options_.pretty_print ? "\n" : "";
 
-        oss << "{" << newline;
+        out += '{';
+        out += newline;
 
         bool first = true;
+        auto begin_key = [&]() {
+            if (!first) {
+                out += ',';
+                out += newline;
+            }
+            first = false;
+            out += indent;
+            out += '"';
+        };
+        auto begin_field = [&](std::string_view key) {
+            begin_key();
+            out += key;
+            out += "\":";
+        };
+        auto append_string_field = [&](std::string_view key, std::string_view value) {
+            begin_field(key);
+            out += '"';
+            string_utils::append_json_escaped(out, value);
+            out += '"';
+        };
 
         // Timestamp (ISO 8601)
         if (options_.include_timestamp) {
-            if (!first) oss << "," << newline;
-            oss << indent << "\"timestamp\":\"" << utils::time_utils::format_iso8601(entry.timestamp) << "\"";
-            first = false;
+            char timestamp[utils::time_utils::timestamp_buffer_size];
+            begin_field("timestamp");
+            out += '"';
+            out.append(timestamp, utils::time_utils::write_iso8601(entry.timestamp, timestamp));
+            out += '"';
         }
 
         // Level
         if (options_.include_level) {
-            if (!first) oss << "," << newline;
-            oss << indent << "\"level\":\"" << utils::string_utils::level_to_string(entry.level) << "\"";
-            first = false;
+            begin_field("level");
+            out += '"';
+            out += string_utils::level_to_string(entry.level);
+            out += '"';
         }
 
         // Thread ID
         if (options_.include_thread_id && entry.thread_id) {
-            if (!first) oss << "," << newline;
-            oss << indent << "\"thread_id\":\"" << utils::string_utils::escape_json(entry.thread_id->to_string()) << "\"";
-            first = false;
+            append_string_field("thread_id", std::string_view(*entry.thread_id));
         }
 
         // Message (always include)
-        if (!first) oss << "," << newline;
-        oss << indent << "\"message\":\"" << utils::string_utils::escape_json(entry.message.to_string()) << "\"";
-        first = false;
+        append_string_field("message", std::string_view(entry.message));
 
         // Source location
         if (options_.include_source_location && entry.location) {
-            std::string file_path = entry.location->file.to_string();
+            const std::string_view file_path(entry.location->file);
             if (!file_path.empty()) {
-                oss << "," << newline << indent << "\"file\":\"" << utils::string_utils::escape_json(file_path) << "\"";
+                append_string_field("file", file_path);
             }
 
             if (entry.location->line > 0) {
-                oss << "," << newline << indent << "\"line\":" << entry.location->line;
+                begin_field("line");
+                append_number(out, "%d", entry.location->line);
             }
 
-            std::string func = entry.location->function.to_string();
+            const std::string_view func(entry.location->function);
             if (!func.empty()) {
-                oss << "," << newline << indent << "\"function\":\"" << utils::string_utils::escape_json(func) << "\"";
+                append_string_field("function", func);
             }
         }
 
         // Category (if present)
         if (entry.category) {
-            std::string cat = entry.category->to_string();
+            const std::string_view cat(*entry.category);
             if (!cat.empty()) {
-                oss << "," << newline << indent << "\"category\":\"" << utils::string_utils::escape_json(cat) << "\"";
+                append_string_field("category", cat);
             }
         }
 
         // OpenTelemetry context (if present)
         if (entry.otel_ctx && entry.otel_ctx->is_valid()) {
             if (!entry.otel_ctx->trace_id.empty()) {
-                oss << "," << newline << indent << "\"trace_id\":\"" << utils::string_utils::escape_json(entry.otel_ctx->trace_id) << "\"";
+                append_string_field("trace_id", entry.otel_ctx->trace_id);
             }
             if (!entry.otel_ctx->span_id.empty()) {
-                oss << "," << newline << indent << "\"span_id\":\"" << utils::string_utils::escape_json(entry.otel_ctx->span_id) << "\"";
+                append_string_field("span_id", entry.otel_ctx->span_id);
             }
             if (!entry.otel_ctx->trace_flags.empty()) {
-                oss << "," << newline << indent << "\"trace_flags\":\"" << utils::string_utils::escape_json(entry.otel_ctx->trace_flags) << "\"";
+                append_string_field("trace_flags", entry.otel_ctx->trace_flags);
             }
         }
 
         // Structured fields (if present)
         if (entry.fields && !entry.fields->empty()) {
             for (const auto& [key, value] : *entry.fields) {
-                oss << "," << newline << indent << "\"" << utils::string_utils::escape_json(key) << "\":";
-                format_value(oss, value);
+                begin_key();
+                string_utils::append_json_escaped(out, key);
+                out += "\":";
+                append_value(out, value);
             }
         }
 
-        oss << newline << "}";
-
-        return oss.str();
+        out += newline;
+        out += '}';
     }
 
     /**
-     * @brief Get formatter name
-     * @return "json_formatter"
-     *
-     * @since 1.2.0
+     * @brief Append a printf-formatted number
      */
-    std::string get_name() const override {
-        return "json_formatter";
+    template<typename String, typename T>
+    static void append_number(String& out, const char* pattern, T value) {
+        char buffer[64];
+        const int length = std::snprintf(buffer, sizeof(buffer), pattern, value);
+        out.append(buffer, static_cast<std::size_t>(length > 0 ? length : 0));
     }
 
-private:
     /**
-     * @brief Format a log_value to JSON
-     * @param oss Output stream
+     * @brief Append a log_value as JSON
+     * @param out Output string
      * @param value Value to format
      */
-    static void format_value(std::ostringstream& oss, const log_value& value) {
-        std::visit([&oss](const auto& v) {
+    template<typename String>
+    static void append_value(String& out, const log_value& value) {
+        std::visit([&out](const auto& v) {
             using T = std::decay_t<decltype(v)>;
             if constexpr (std::is_same_v<T, std::string>) {
-                oss << "\"" << utils::string_utils::escape_json(v) << "\"";
+                out += '"';
+                utils::string_utils::append_json_escaped(out, v);
+                out += '"';
             } else if constexpr (std::is_same_v<T, bool>) {
-                oss << (v ? "true" : "false");
+                out += v ? "true" : "false";
             } else if constexpr (std::is_same_v<T, int64_t>) {
-                oss << v;
+                append_number(out, "%lld", static_cast<long long>(v));
             } else if constexpr (std::is_same_v<T, double>) {
-                oss << std::fixed << std::setprecision(6) << v;
-            } else {
-                oss << v;
+                append_number(out, "%.6f", v);
             }
         }, value);
     }
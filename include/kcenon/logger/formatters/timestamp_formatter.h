@@ -9,7 +9,9 @@
 #include "../utils/string_utils.h"
 #include <sstream>
 #include <iomanip>
+#include <cstdio>
 #include <ctime>
+#include <string_view>
 
 // Use common_system's standard interface
 #include <kcenon/common/interfaces/logger_interface.h>
@@ -79,66 +81,89 @@ public:
      * @since 1.2.0
      */
     std::string format(const log_entry& entry) const override {
-        std::ostringstream oss;
+        std::string out;
+        append_formatted(entry, out);
+        return out;
+    }
+
+    /**
+     * @brief Append the formatted entry to @p out without temporary strings
+     *
+     * @since 4.1.0
+     */
+    void format_to(const log_entry& entry, std::pmr::string& out) const override {
+        append_formatted(entry, out);
+    }
 
+    /**
+     * @brief Get formatter name
+     * @return "timestamp_formatter"
+     *
+     * @since 1.2.0
+     */
+    std::string get_name() const override {
+        return "timestamp_formatter";
+    }
+
+private:
+    template<typename String>
+    void append_formatted(const log_entry& entry, String& out) const {
         // Timestamp
         if (options_.include_timestamp) {
-            oss << "[" << utils::time_utils::format_timestamp(entry.timestamp) << "] ";
+            char timestamp[utils::time_utils::timestamp_buffer_size];
+            out += '[';
+            out.append(timestamp, utils::time_utils::write_timestamp(entry.timestamp, timestamp));
+            out += "] ";
         }
 
         // Level (with color)
         if (options_.include_level) {
             if (options_.use_colors) {
-                oss << utils::string_utils::level_to_color(entry.level, true);
+                out += utils::string_utils::level_to_color(entry.level, true);
             }
-            oss << "[" << utils::string_utils::level_to_string(entry.level) << "] ";
+            out += '[';
+            out += utils::string_utils::level_to_string(entry.level);
+            out += "] ";
             if (options_.use_colors) {
-                oss << utils::string_utils::color_reset();
+                out += utils::string_utils::color_reset();
             }
         }
 
         // Thread ID
         if (options_.include_thread_id && entry.thread_id) {
-            oss << "[thread:" << entry.thread_id->to_string() << "] ";
+            out += "[thread:";
+            out += std::string_view(*entry.thread_id);
+            out += "] ";
         }
 
         // Message
-        oss << entry.message.to_string();
+        out += std::string_view(entry.message);
 
         // Source location
         if (options_.include_source_location && entry.location) {
-            oss << " [";
+            out += " [";
 
             // Extract filename from path
-            std::string file_path = entry.location->file.to_string();
+            const std::string_view file_path(entry.location->file);
             if (!file_path.empty()) {
-                std::string filename = utils::string_utils::extract_filename(file_path);
-                oss << filename << ":" << entry.location->line;
+                char line[16];
+                const int length = std::snprintf(line, sizeof(line), ":%d", entry.location->line);
+                out += utils::string_utils::filename_view(file_path);
+                out.append(line, static_cast<std::size_t>(length > 0 ? length : 0));
             }
 
             // Function name
-            std::string func = entry.location->function.to_string();
+            const std::string_view func(entry.location->function);
             if (!func.empty()) {
-                oss << " in " << func << "()";
+                out += " in ";
+                out += func;
+                out += "()";
             }
 
-            oss << "]";
+            out += ']';
         }
-
-        return oss.str();
-    }
-
-    /**
-     * @brief Get formatter name
-     * @return "timestamp_formatter"
-     *
-     * @since 1.2.0
-     */
-    std::string get_name() const override {
-        return "timestamp_formatter";
     }
 
-private:
     // Note: Formatting functions moved to utils::time_utils and utils::string_utils (Phase 3.4)
     // This reduces code duplication and improves maintainability.
 };
@@ -44,6 +44,7 @@
 #include <unordered_map>
 #include <variant>
 #include <cstdint>
+#include "../core/intern_table.h"
 #include "../core/small_string.h"
 
 // Use common_system's standard interface
@@ -82,20 +83,21 @@ using log_fields = std::unordered_map<std::string, log_value>;
  * a log message originated. This information is invaluable for debugging
  * and tracing issues in production.
  * 
- * The structure uses small string optimization (SSO) to avoid heap allocations
- * for typical file paths and function names.
- * 
- * @note File paths up to 256 characters and function names up to 128 characters
- * are stored without heap allocation.
+ * File and function names are interned (see intern_table), so each field is
+ * a 4-byte id and copying a location never copies the strings.
+ *
+ * @note Since 4.1.0 the fields are interned_string rather than small_string;
+ * the read-only small_string interface (data(), size(), to_string(), ...)
+ * is unchanged.
  * 
  * @since 1.0.0
  */
 struct source_location {
     /**
      * @brief Source file path
-     * @details Uses small_string_256 for efficient storage of file paths
+     * @details Interned; copying the location copies only the id
      */
-    small_string_256 file;
+    interned_string file;
     
     /**
      * @brief Line number in the source file
@@ -105,9 +107,9 @@ struct source_location {
     
     /**
      * @brief Function or method name
-     * @details Uses small_string_128 for efficient storage of function names
+     * @details Interned; copying the location copies only the id
      */
-    small_string_128 function;
+    interned_string function;
     
     /**
      * @brief Construct source location from std::string
@@ -129,6 +131,13 @@ struct source_location {
      */
     source_location(const char* f = "", int l = 0, const char* func = "")
         : file(f), line(l), function(func) {}
+
+    /**
+     * @brief Construct source location from already interned strings
+     * @since 4.1.0
+     */
+    source_location(interned_string f, int l, interned_string func) noexcept
+        : file(f), line(l), function(func) {}
 };
 
 /**
@@ -192,9 +201,11 @@ struct log_entry {
     /**
      * @brief Optional category for log filtering and routing
      * @details Allows grouping related log messages (e.g., "database", "network", "security")
-     * @note Categories are stored efficiently using small_string_128
+     * @note Categories are interned, so the field is a 4-byte id. Set
+     * categories derived from runtime data through interned_string::category(),
+     * which bounds how many of them the process-wide table keeps.
      */
-    std::optional<small_string_128> category;
+    std::optional<interned_string> category;
 
     /**
      * @brief Optional OpenTelemetry context for trace correlation
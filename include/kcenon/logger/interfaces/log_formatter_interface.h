@@ -18,6 +18,7 @@
 
 #include <string>
 #include <memory>
+#include <memory_resource>
 #include <functional>
 
 namespace kcenon::logger {
@@ -90,6 +91,24 @@ public:
      */
     virtual std::string format(const log_entry& entry) const = 0;
 
+    /**
+     * @brief Append a formatted log entry to a caller-provided string
+     * @param entry The log entry to format
+     * @param out String receiving the formatted text (not cleared)
+     *
+     * @details Lets writers format a whole batch into one buffer backed by
+     * the collector's per-batch arena (see batch_context). The default
+     * implementation appends the result of format(); formatters override
+     * it to write directly into @p out without temporary strings.
+     *
+     * @note This method must be thread-safe.
+     *
+     * @since 4.1.0
+     */
+    virtual void format_to(const log_entry& entry, std::pmr::string& out) const {
+        out += format(entry);
+    }
+
     /**
      * @brief Set formatting options
      * @param opts Configuration options for formatting
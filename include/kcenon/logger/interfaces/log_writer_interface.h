@@ -14,14 +14,13 @@
 #include <string>
 #include <chrono>
 #include <memory>
+#include <span>
 #include <kcenon/common/patterns/result.h>
 #include <kcenon/logger/core/error_codes.h>
+#include <kcenon/logger/interfaces/log_entry.h>
 
 namespace kcenon::logger {
 
-// Forward declaration
-struct log_entry;
-
 /**
  * @interface log_writer_interface
  * @brief Base interface for all log writers and decorators
@@ -46,6 +45,7 @@ struct log_entry;
  *
  * @since 1.0.0
  * @since 4.0.0 Added close() and is_open() for Decorator pattern support
+ * @since 4.1.0 Added write_batch() for per-batch locking and I/O
  */
 class log_writer_interface {
 public:
@@ -65,6 +65,29 @@ public:
      */
     virtual common::VoidResult write(const log_entry& entry) = 0;
 
+    /**
+     * @brief Write several log entries in order
+     * @param entries Entries to write
+     * @return common::VoidResult with the first error encountered, if any
+     *
+     * @details Called by the async collector and batching decorators with
+     * each drained batch. The default implementation calls write() for every
+     * entry and keeps going after a failure. Writers override it to take
+     * their lock once, format into one buffer and issue one I/O call.
+     *
+     * @since 4.1.0
+     */
+    virtual common::VoidResult write_batch(std::span<const log_entry> entries) {
+        common::VoidResult first_error = common::ok();
+        for (const auto& entry : entries) {
+            auto result = write(entry);
+            if (result.is_err() && first_error.is_ok()) {
+                first_error = result;
+            }
+        }
+        return first_error;
+    }
+
     /**
      * @brief Flush any buffered data
      * @return common::VoidResult indicating success or failure
@@ -12,7 +12,9 @@
 
 #include <string>
 #include <sstream>
+#include <cstdio>
 #include <iomanip>
+#include <string_view>
 
 // Use common_system's standard interface
 #include <kcenon/common/interfaces/logger_interface.h>
@@ -112,30 +114,45 @@ public:
      * @note Compatible with JSON parsers and log aggregation systems.
      */
     static std::string escape_json(const std::string& str) {
-        std::ostringstream oss;
+        std::string result;
+        result.reserve(str.size());
+        append_json_escaped(result, str);
+        return result;
+    }
+
+    /**
+     * @brief Append JSON-escaped text to a string of any allocator
+     * @tparam String std::string, std::pmr::string or similar
+     * @param out Destination string
+     * @param str Text to escape (same rules as escape_json)
+     *
+     * @note Allocates only if out has to grow.
+     * @since 4.1.0
+     */
+    template<typename String>
+    static void append_json_escaped(String& out, std::string_view str) {
         for (char c : str) {
             switch (c) {
-                case '"':  oss << "\\\""; break;
-                case '\\': oss << "\\\\"; break;
-                case '/':  oss << "\\/"; break;
-                case '\b': oss << "\\b"; break;
-                case '\f': oss << "\\f"; break;
-                case '\n': oss << "\\n"; break;
-                case '\r': oss << "\\r"; break;
-                case '\t': oss << "\\t"; break;
+                case '"':  out += "\\\""; break;
+                case '\\': out += "\\\\"; break;
+                case '/':  out += "\\/"; break;
+                case '\b': out += "\\b"; break;
+                case '\f': out += "\\f"; break;
+                case '\n': out += "\\n"; break;
+                case '\r': out += "\\r"; break;
+                case '\t': out += "\\t"; break;
                 default:
                     // Handle control characters
                     if (c >= 0 && c < 0x20) {
-                        oss << "\\u"
-                            << std::hex << std::setw(4) << std::setfill('0')
-                            << static_cast<int>(c);
+                        char escaped[8];
+                        std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<int>(c));
+                        out += escaped;
                     } else {
-                        oss << c;
+                        out += c;
                     }
                     break;
             }
         }
-        return oss.str();
     }
 
     /**
@@ -181,12 +198,18 @@ public:
      * @note Thread-safe.
      */
     static std::string extract_filename(const std::string& file_path) {
-        if (file_path.empty()) {
-            return file_path;
-        }
+        return std::string(filename_view(file_path));
+    }
 
+    /**
+     * @brief Non-allocating variant of extract_filename
+     * @param file_path Full path to file
+     * @return View of the filename part of file_path
+     * @since 4.1.0
+     */
+    static std::string_view filename_view(std::string_view file_path) {
         size_t pos = file_path.find_last_of("/\\");
-        if (pos != std::string::npos) {
+        if (pos != std::string_view::npos) {
             return file_path.substr(pos + 1);
         }
 
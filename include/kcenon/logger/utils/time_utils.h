@@ -14,6 +14,8 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <cstddef>
+#include <cstdio>
 #include <ctime>
 
 namespace kcenon::logger::utils {
@@ -26,17 +28,21 @@ namespace kcenon::logger::utils {
  */
 class time_utils {
 public:
+    /// Buffer size that fits every write_timestamp()/write_iso8601() result
+    static constexpr std::size_t timestamp_buffer_size = 32;
+
     /**
-     * @brief Format timestamp to human-readable format (YYYY-MM-DD HH:MM:SS.mmm)
+     * @brief Write a human-readable timestamp (YYYY-MM-DD HH:MM:SS.mmm) into a buffer
      * @param tp Time point to format
-     * @return Formatted timestamp string with millisecond precision
-     *
-     * Output format: "2025-11-03 14:30:15.123"
+     * @param out Destination of at least timestamp_buffer_size bytes
+     * @return Number of characters written (not NUL-terminated in the count)
      *
-     * @note Thread-safe. Uses platform-specific thread-safe time conversion.
+     * @note Does not allocate; used by formatters writing into arena strings.
+     * @since 4.1.0
      */
-    static std::string format_timestamp(
-        const std::chrono::system_clock::time_point& tp
+    static std::size_t write_timestamp(
+        const std::chrono::system_clock::time_point& tp,
+        char* out
     ) {
         auto time_t = std::chrono::system_clock::to_time_t(tp);
         std::tm tm_buf{};
@@ -47,34 +53,21 @@ public:
         localtime_r(&time_t, &tm_buf);  // POSIX thread-safe version
 #endif
 
-        // Format base timestamp
-        char buffer[32];
-        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm_buf);
-
-        // Add milliseconds
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            tp.time_since_epoch()
-        ) % 1000;
-
-        std::ostringstream oss;
-        oss << buffer << "."
-            << std::setfill('0') << std::setw(3) << ms.count();
-
-        return oss.str();
+        return write_with_millis(tp, tm_buf, "%Y-%m-%d %H:%M:%S", "", out);
     }
 
     /**
-     * @brief Format timestamp to ISO 8601 / RFC 3339 format with UTC timezone
+     * @brief Write an ISO 8601 UTC timestamp (YYYY-MM-DDTHH:MM:SS.mmmZ) into a buffer
      * @param tp Time point to format
-     * @return ISO 8601 formatted timestamp string
-     *
-     * Output format: "2025-11-03T14:30:15.123Z"
+     * @param out Destination of at least timestamp_buffer_size bytes
+     * @return Number of characters written
      *
-     * @note Thread-safe. Always outputs in UTC (Z timezone indicator).
-     * @note Compatible with JSON parsers and log aggregation systems (ELK, Splunk, etc.)
+     * @note Does not allocate.
+     * @since 4.1.0
      */
-    static std::string format_iso8601(
-        const std::chrono::system_clock::time_point& tp
+    static std::size_t write_iso8601(
+        const std::chrono::system_clock::time_point& tp,
+        char* out
     ) {
         auto time_t = std::chrono::system_clock::to_time_t(tp);
         std::tm tm_buf{};
@@ -85,21 +78,40 @@ public:
         gmtime_r(&time_t, &tm_buf);  // POSIX thread-safe version (UTC)
 #endif
 
-        // Format base timestamp (ISO 8601)
-        char buffer[32];
-        std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &tm_buf);
-
-        // Add milliseconds
-        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-            tp.time_since_epoch()
-        ) % 1000;
+        return write_with_millis(tp, tm_buf, "%Y-%m-%dT%H:%M:%S", "Z", out);
+    }
 
-        std::ostringstream oss;
-        oss << buffer << "."
-            << std::setfill('0') << std::setw(3) << ms.count()
-            << "Z";  // UTC timezone indicator
+    /**
+     * @brief Format timestamp to human-readable format (YYYY-MM-DD HH:MM:SS.mmm)
+     * @param tp Time point to format
+     * @return Formatted timestamp string with millisecond precision
+     *
+     * Output format: "2025-11-03 14:30:15.123"
+     *
+     * @note Thread-safe. Uses platform-specific thread-safe time conversion.
+     */
+    static std::string format_timestamp(
+        const std::chrono::system_clock::time_point& tp
+    ) {
+        char buffer[timestamp_buffer_size];
+        return std::string(buffer, write_timestamp(tp, buffer));
+    }
 
-        return oss.str();
+    /**
+     * @brief Format timestamp to ISO 8601 / RFC 3339 format with UTC timezone
+     * @param tp Time point to format
+     * @return ISO 8601 formatted timestamp string
+     *
+     * Output format: "2025-11-03T14:30:15.123Z"
+     *
+     * @note Thread-safe. Always outputs in UTC (Z timezone indicator).
+     * @note Compatible with JSON parsers and log aggregation systems (ELK, Splunk, etc.)
+     */
+    static std::string format_iso8601(
+        const std::chrono::system_clock::time_point& tp
+    ) {
+        char buffer[timestamp_buffer_size];
+        return std::string(buffer, write_iso8601(tp, buffer));
     }
 
     /**
@@ -185,6 +197,26 @@ public:
     static std::chrono::system_clock::time_point now() {
         return std::chrono::system_clock::now();
     }
+
+private:
+    static std::size_t write_with_millis(
+        const std::chrono::system_clock::time_point& tp,
+        const std::tm& tm_buf,
+        const char* pattern,
+        const char* suffix,
+        char* out
+    ) {
+        std::size_t length = std::strftime(out, timestamp_buffer_size, pattern, &tm_buf);
+
+        // Add milliseconds
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            tp.time_since_epoch()
+        ) % 1000;
+
+        const int written = std::snprintf(out + length, timestamp_buffer_size - length,
+                                          ".%03d%s", static_cast<int>(ms.count()), suffix);
+        return length + static_cast<std::size_t>(written > 0 ? written : 0);
+    }
 };
 
 } // namespace kcenon::logger::utils
@@ -213,6 +213,7 @@ private:
                 // Unlock while writing
                 lock.unlock();
                 wrapped().write(entry);
+                release_entry(entry);
                 lock.lock();
             }
 
@@ -230,6 +231,7 @@ private:
             auto entry = std::move(queue_.front());
             queue_.pop();
             wrapped().write(entry);
+            release_entry(entry);
         }
         wrapped().flush();
     }
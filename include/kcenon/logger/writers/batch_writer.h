@@ -79,6 +79,14 @@ public:
      */
     common::VoidResult write(const log_entry& entry) override;
 
+    /**
+     * @brief Append several log entries to the batch under one lock
+     * @param entries Entries to batch in order
+     * @return common::VoidResult indicating success or error
+     * @since 4.1.0
+     */
+    common::VoidResult write_batch(std::span<const log_entry> entries) override;
+
     /**
      * @brief Flush the batch to the underlying writer
      * @return common::VoidResult indicating success or error
@@ -133,6 +141,18 @@ public:
     
 private:
 
+    /**
+     * @brief Charge a copy to the memory budget (caller must not hold lock)
+     *
+     * Flushes the batch first when the budget is short, since queued
+     * entries are bytes this writer can give back itself, and only then
+     * lets the budget policy wait, spill or drop.
+     *
+     * @return admitted if the copy should be queued; spill if it was
+     *         written to the spill file instead; dropped otherwise
+     */
+    budget_decision reserve_entry(const log_entry& copy);
+
     /**
      * @brief Flush batch without locking (caller must hold lock)
      * @return common::VoidResult indicating success or error
@@ -38,6 +38,7 @@
  */
 
 #include "decorator_writer_base.h"
+#include "../core/memory_budget.h"
 #include "../interfaces/log_entry.h"
 
 #include <kcenon/logger/logger_export.h>
@@ -141,6 +142,19 @@ public:
      */
     common::VoidResult write(const log_entry& entry) override;
 
+    /**
+     * @brief Write several log entries to the buffer under one lock
+     *
+     * @param entries Entries to buffer in order
+     * @return common::VoidResult Success on buffering, error if a flush fails
+     *
+     * @details Buffered entries reach the wrapped writer through its
+     * write_batch(), so a full buffer costs one downstream call.
+     *
+     * @since 4.1.0
+     */
+    common::VoidResult write_batch(std::span<const log_entry> entries) override;
+
     /**
      * @brief Flush all buffered entries to the wrapped writer
      *
@@ -191,6 +205,7 @@ public:
         std::atomic<uint64_t> flush_on_full{0};
         std::atomic<uint64_t> flush_on_interval{0};
         std::atomic<uint64_t> manual_flushes{0};
+        std::atomic<uint64_t> flush_on_budget{0};  ///< Flushes to free memory budget (since 4.1.0)
     };
 
     /**
@@ -209,6 +224,13 @@ public:
      */
     void reset_stats();
 
+    /**
+     * @brief Memory budget accounting for the buffer
+     *
+     * @since 4.1.0
+     */
+    budget_consumer_stats get_budget_stats() const;
+
 private:
     /**
      * @brief Flush buffer without acquiring mutex (caller must hold lock)
@@ -232,11 +254,25 @@ private:
      */
     static log_entry copy_entry(const log_entry& entry);
 
+    /**
+     * @brief Charge a copy to the memory budget (caller must not hold lock)
+     *
+     * Flushes the buffer first when the budget is short, since buffered
+     * entries are bytes this writer can give back itself, and only then
+     * lets the budget policy wait, spill or drop.
+     *
+     * @return admitted if the copy should be buffered; spill if it was
+     *         written to the spill file instead; dropped otherwise
+     */
+    budget_decision reserve_entry(const log_entry& copy, size_t bytes);
+
     size_t max_entries_;
     std::chrono::milliseconds flush_interval_;
 
     mutable std::mutex mutex_;
     std::vector<log_entry> buffer_;
+    size_t buffered_bytes_ = 0;
+    budget_consumer budget_{"buffered_writer"};
     std::chrono::steady_clock::time_point last_flush_time_;
 
     mutable stats stats_;
@@ -0,0 +1,117 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file compressed_log_reader.h
+ * @brief Random access to log files written with file_output_options::compression
+ * @since 4.1.0
+ *
+ * @details A compressed log file is a sequence of gzip members, one per
+ * frame, each carrying its own sizes in its header; a writer that closes
+ * cleanly appends an index of its frames. open() reads that index, walks
+ * the member headers of whatever it does not cover (earlier sessions, or a
+ * session that crashed) and skips the torn tail a crash leaves behind, so
+ * only complete frames are listed. Reading a range then decompresses just
+ * the frames that hold it.
+ *
+ * @code
+ * compressed_log_reader reader;
+ * if (reader.open("app.log.gz").is_ok()) {
+ *     auto tail = reader.read(reader.size() > 4096 ? reader.size() - 4096 : 0, 4096);
+ *     if (tail) {
+ *         std::cout << tail.value();
+ *     }
+ * }
+ * @endcode
+ */
+
+#include <kcenon/common/patterns/result.h>
+#include <kcenon/logger/core/error_codes.h>
+#include <kcenon/logger/logger_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace kcenon::logger {
+
+/**
+ * @struct compressed_frame
+ * @brief One independently decodable frame of a compressed log file
+ */
+struct compressed_frame {
+    std::uint64_t offset = 0;       ///< File offset of the frame's gzip member
+    std::uint32_t member_size = 0;  ///< Compressed bytes, header and trailer included
+    std::uint64_t position = 0;     ///< Offset of its first byte in the uncompressed log
+    std::uint32_t size = 0;         ///< Uncompressed bytes
+};
+
+/**
+ * @class compressed_log_reader
+ * @brief Seeks and decompresses frames of a compressed log file
+ *
+ * @details Not thread-safe. Decompression needs zlib; without it open()
+ * still lists the frames but reading them fails.
+ */
+class LOGGER_SYSTEM_API compressed_log_reader {
+public:
+    /**
+     * @brief Open a file and build its frame list
+     * @return file_open_failed or file_read_failed
+     */
+    common::VoidResult open(const std::string& path);
+
+    [[nodiscard]] const std::vector<compressed_frame>& frames() const noexcept {
+        return frames_;
+    }
+
+    /**
+     * @brief Uncompressed size of all complete frames
+     */
+    [[nodiscard]] std::uint64_t size() const noexcept;
+
+    /**
+     * @brief File bytes that belong to no complete frame, e.g. a frame torn by a crash
+     */
+    [[nodiscard]] std::uint64_t skipped_bytes() const noexcept {
+        return skipped_bytes_;
+    }
+
+    /**
+     * @brief Index of the frame holding an uncompressed position
+     * @return frames().size() past the end
+     */
+    [[nodiscard]] std::size_t frame_at(std::uint64_t position) const noexcept;
+
+    /**
+     * @brief Decompress one frame
+     * @return file_read_failed if the frame does not decode to its recorded size
+     */
+    result<std::string> read_frame(std::size_t index);
+
+    /**
+     * @brief Decompress length uncompressed bytes starting at position
+     *
+     * The range is cut short at the end of the log.
+     */
+    result<std::string> read(std::uint64_t position, std::size_t length);
+
+private:
+    bool read_at(std::uint64_t offset, char* data, std::size_t size);
+    bool read_footer();
+    void walk(std::uint64_t from, std::uint64_t to);
+    std::uint64_t find_member(std::uint64_t from, std::uint64_t to);
+    void add_frame(std::uint64_t offset, std::uint32_t member_size, std::uint32_t size);
+
+    std::ifstream file_;
+    std::uint64_t file_size_ = 0;
+    std::uint64_t skipped_bytes_ = 0;
+    std::vector<compressed_frame> frames_;
+};
+
+} // namespace kcenon::logger
@@ -47,10 +47,13 @@
 #include <kcenon/logger/logger_export.h>
 
 #include <atomic>
+#include <condition_variable>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <fstream>
 #include <functional>
+#include <vector>
 
 namespace kcenon::logger {
 
@@ -79,6 +82,29 @@ struct critical_writer_config {
 
     /// Timeout for critical write operations in milliseconds (0 = no timeout)
     uint32_t critical_write_timeout_ms = 5000;
+
+    /**
+     * @brief Let concurrent critical writes share one sync (default: true)
+     *
+     * Writes that reach the wrapped writer while a sync is running are
+     * made durable together by the next one instead of each paying for
+     * its own. A write still returns only after a sync that started after
+     * it was flushed has completed.
+     *
+     * @since 4.1.0
+     */
+    bool group_commit = true;
+
+    /**
+     * @brief Longest the sync leader waits for more writes to join its
+     * sync, in microseconds (default: 0)
+     *
+     * The wait ends early once no other critical write is in progress,
+     * so a lone writer never pays it. Only used with group_commit.
+     *
+     * @since 4.1.0
+     */
+    uint32_t max_sync_delay_us = 0;
 };
 
 /**
@@ -91,6 +117,13 @@ struct critical_writer_config {
  * 3. Optional write-ahead logging for crash recovery
  * 4. File descriptor synchronization (fsync) for durability
  *
+ * When the wrapped writer is a file_writer (or rotating_file_writer), the
+ * sync is file_writer::sync(), an fdatasync of the log file. With
+ * critical_writer_config::group_commit, critical writes from several
+ * threads are grouped into sync epochs: the first writer to need a sync
+ * leads it, writes that arrive meanwhile wait and are covered by the next
+ * one, so a burst of N writes costs a few syncs instead of N.
+ *
  * For signal handling, use signal_manager or crash_safe_logger instead.
  *
  * Thread Safety: All methods are thread-safe. Critical writes are serialized
@@ -128,7 +161,8 @@ public:
      * - Writes to WAL (if enabled)
      * - Writes to wrapped writer
      * - Forces immediate flush
-     * - Syncs file descriptor (if configured)
+     * - Syncs file descriptor (if configured), joining the current sync
+     *   epoch with group_commit
      *
      * For non-critical messages, delegates to wrapped writer normally.
      *
@@ -180,6 +214,16 @@ public:
         std::atomic<uint64_t> total_flushes{0};
         std::atomic<uint64_t> wal_writes{0};
         std::atomic<uint64_t> sync_calls{0};
+
+        /// Critical writes made durable by sync_calls; their ratio is the
+        /// mean epoch size (since 4.1.0)
+        std::atomic<uint64_t> synced_writes{0};
+        /// Most writes covered by one sync (since 4.1.0)
+        std::atomic<uint64_t> max_epoch_writes{0};
+        /// Time critical writes spent waiting for their sync, summed and
+        /// worst case, in microseconds (since 4.1.0)
+        std::atomic<uint64_t> total_sync_wait_us{0};
+        std::atomic<uint64_t> max_sync_wait_us{0};
     };
 
     const critical_stats& get_stats() const { return stats_; }
@@ -201,7 +245,19 @@ private:
     /**
      * @brief Force sync of underlying file descriptor
      */
-    void sync_file_descriptor();
+    common::VoidResult sync_file_descriptor();
+
+    /**
+     * @brief Critical write whose sync is shared with concurrent writes
+     */
+    common::VoidResult write_group_committed(const log_entry& entry);
+
+    /**
+     * @brief Wait until a sync covering the given write has completed,
+     * leading one if none is running
+     * @param ticket Sequence number the write got once flushed
+     */
+    common::VoidResult wait_for_sync(uint64_t ticket);
 
 
     /// Configuration
@@ -216,6 +272,28 @@ private:
     /// Write-ahead log stream
     std::unique_ptr<std::ofstream> wal_stream_;
 
+    /// Descriptor of the WAL file used for syncing it (-1 if none)
+    int wal_fd_ = -1;
+
+    /// Group commit state, guarded by sync_mutex_. Tickets count flushed
+    /// critical writes; a sync covers every ticket issued before it began.
+    std::mutex sync_mutex_;
+    std::condition_variable sync_done_;
+    std::condition_variable write_joined_;
+    uint64_t written_ticket_ = 0;
+    uint64_t synced_ticket_ = 0;
+    uint32_t writes_in_progress_ = 0;
+    bool sync_running_ = false;
+
+    /// A sync that failed, kept until every write it covered has seen it
+    struct failed_sync {
+        uint64_t first_ticket;
+        uint64_t last_ticket;
+        uint64_t unreported;
+        common::VoidResult result;
+    };
+    std::vector<failed_sync> failed_syncs_;
+
     /// Statistics
     mutable critical_stats stats_;
 
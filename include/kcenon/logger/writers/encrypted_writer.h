@@ -229,6 +229,21 @@ public:
      */
     common::VoidResult write(const log_entry& entry) override;
 
+    /**
+     * @brief Encrypt a batch of entries and forward them in one call
+     * @param entries Entries to encrypt in order
+     * @return common::VoidResult Success or error code
+     *
+     * @details Checks key rotation once, encrypts every entry under a single
+     * acquisition of the cipher lock and passes the results to the wrapped
+     * writer's write_batch(). An entry that fails to encrypt is skipped and
+     * counted in get_entries_dropped(); the others are still written and the
+     * first encryption error is returned.
+     *
+     * @since 4.1.0
+     */
+    common::VoidResult write_batch(std::span<const log_entry> entries) override;
+
     /**
      * @brief Rotate encryption key
      * @param new_key New key to use (moved)
@@ -249,6 +264,12 @@ public:
      */
     uint64_t get_entries_encrypted() const;
 
+    /**
+     * @brief Get the number of entries dropped because encryption failed
+     * @since 4.1.0
+     */
+    uint64_t get_entries_dropped() const;
+
     /**
      * @brief Get time of last key rotation
      * @return Timestamp of last key rotation (or construction time)
@@ -299,6 +320,11 @@ private:
      */
     common::VoidResult auto_rotate_key_if_needed();
 
+    /**
+     * @brief Render an entry as the plaintext line that gets encrypted
+     */
+    static std::string format_plaintext(const log_entry& entry);
+
 #ifdef LOGGER_HAS_OPENSSL_CRYPTO
     /**
      * @brief Initialize OpenSSL cipher context
@@ -316,6 +342,7 @@ private:
     mutable std::mutex write_mutex_;
 
     std::atomic<uint64_t> entries_encrypted_{0};
+    std::atomic<uint64_t> entries_dropped_{0};
     std::chrono::system_clock::time_point last_key_rotation_;
     std::atomic<bool> is_initialized_{false};
 
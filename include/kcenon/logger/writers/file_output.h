@@ -0,0 +1,199 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file file_output.h
+ * @brief Output backends behind file_writer and rotating_file_writer
+ * @since 4.1.0
+ *
+ * @details A file_output owns the open file and everything between a
+ * formatted record and the kernel. The writer formats records straight
+ * into buffer() and calls commit(); the backend decides when the bytes
+ * reach the file:
+ * - stream: a std::ofstream with its default buffering; every commit()
+ *   is handed to the stream (the behaviour file_writer always had)
+ * - direct: a raw file descriptor behind a large user-space buffer
+ *   (1 MiB by default). Records accumulate in the buffer and reach the
+ *   file with one write(2) when the buffer fills, when flush_interval has
+ *   passed since the last write-out, or on flush() and close()
+ * - io_uring: like direct, but with two buffers. A full buffer is submitted
+ *   to an io_uring and the writer keeps formatting into the other one while
+ *   the write is in flight, so a thread stalled in writeback no longer
+ *   stalls the caller. sync() links an fdatasync to the final write so both
+ *   go to the kernel in one submission
+ * - mmap: blocks are reserved in mmap_extent steps (64 MiB) with fallocate()
+ *   and the current window is mapped shared; each commit() is a memcpy into
+ *   the page cache, with an ftruncate() only when the file size must grow
+ *   by another step (at most 1 MiB). A new window is mapped when the
+ *   current one is exhausted, sync() is msync() plus fdatasync(), and
+ *   close() truncates the file to the bytes actually written. Until then
+ *   the file may end in up to one step of zero padding; opening it again in
+ *   append mode trims padding a crash left behind. Truncating the file from
+ *   another process while it is mapped raises SIGBUS in the writer
+ *
+ * Any mode can also compress the file as it is written (compression set to
+ * anything but none). Committed records are deflated straight away and the
+ * file grows by one gzip member per frame: a frame ends after frame_size
+ * uncompressed bytes, once it is older than flush_interval, and on flush(),
+ * sync() and close(). Every member decompresses on its own, so the file
+ * stays readable with zcat and zgrep, a crash loses at most the frame
+ * being built, and compressed_log_reader can seek to any frame through
+ * the index written when the file is closed. Frames are gzip, which needs
+ * zlib; zstd, or gzip in a build without zlib, makes open() fail with
+ * file_compression_failed. File writers count the compressed bytes toward
+ * their size (and rotation thresholds), and rotating_file_writer does not
+ * compress such segments a second time.
+ *
+ * In the buffered modes the interval is checked as records are committed,
+ * so data committed before an idle period stays buffered until the next
+ * record, flush() or close(). Each mode degrades to the next simpler one
+ * where it is unavailable: io_uring falls back to direct when the kernel
+ * headers lack it or io_uring_setup() fails (old kernel, seccomp filter),
+ * and direct and mmap fall back to stream without POSIX file descriptors. mode()
+ * reports what was actually created.
+ *
+ * @code
+ * file_output_options output;
+ * output.mode = file_output_mode::direct;
+ * output.buffer_size = 4 * 1024 * 1024;
+ * auto writer = std::make_unique<file_writer>("app.log", true, nullptr, output);
+ * @endcode
+ */
+
+#include <kcenon/common/patterns/result.h>
+#include <kcenon/logger/core/error_codes.h>
+#include <kcenon/logger/logger_export.h>
+#include <kcenon/logger/writers/segment_compression.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <string>
+
+namespace kcenon::logger {
+
+/**
+ * @brief Which backend a file writer writes through
+ */
+enum class file_output_mode : std::uint8_t {
+    stream,    ///< std::ofstream with its default buffering
+    direct,    ///< Raw file descriptor behind a large user-space buffer
+    io_uring,  ///< Double-buffered asynchronous writes through io_uring (Linux)
+    mmap       ///< memcpy into a shared mapping of preallocated file extents
+};
+
+/**
+ * @brief Backend selection and tuning for file writers
+ */
+struct file_output_options {
+    file_output_mode mode = file_output_mode::stream;
+    /// User-space buffer size in bytes (direct and io_uring modes; per buffer)
+    std::size_t buffer_size = 1024 * 1024;
+    /// Longest committed data may stay buffered while records keep arriving; 0 disables
+    std::chrono::milliseconds flush_interval{1000};
+    /// Make a write that contains a critical record durable before it returns
+    bool sync_on_critical = false;
+    /// Block reservation step and minimum window size in bytes (mmap mode)
+    std::size_t mmap_extent = 64 * 1024 * 1024;
+    /// Compress the file as it is written; only gzip is supported
+    compression_codec compression = compression_codec::none;
+    /// gzip level for compressed files, 1 (fastest) to 9
+    int compression_level = 1;
+    /// Uncompressed bytes per compressed frame, clamped to [64 KiB, 1 GiB]
+    std::size_t frame_size = 4 * 1024 * 1024;
+};
+
+/**
+ * @class file_output
+ * @brief Open file plus the buffering policy in front of it
+ *
+ * @details Not thread-safe; the owning writer serializes all calls under
+ * its mutex.
+ */
+class LOGGER_SYSTEM_API file_output {
+public:
+    virtual ~file_output() = default;
+
+    /**
+     * @brief Open (or create) a file, truncating it unless append is set
+     * @note The parent directory must already exist
+     */
+    virtual common::VoidResult open(const std::string& path, bool append) = 0;
+
+    /**
+     * @brief Write out buffered data and close the file
+     */
+    virtual common::VoidResult close() = 0;
+
+    [[nodiscard]] virtual bool is_open() const noexcept = 0;
+
+    /**
+     * @brief False once a write to the file has failed
+     */
+    [[nodiscard]] virtual bool good() const noexcept = 0;
+
+    /**
+     * @brief Size of the file when it was opened
+     */
+    [[nodiscard]] virtual std::uint64_t opened_size() const noexcept = 0;
+
+    /**
+     * @brief Size of the file once everything committed so far is written
+     *
+     * Counts bytes on disk, so a compressing output reports compressed
+     * bytes, including those of the frame being built.
+     * @since 4.1.0
+     */
+    [[nodiscard]] virtual std::uint64_t stored_size() const noexcept = 0;
+
+    /**
+     * @brief Buffer the next records are appended to
+     *
+     * Append whole records only; the backend may write the buffer out at
+     * any commit().
+     */
+    [[nodiscard]] virtual std::pmr::string& buffer() noexcept = 0;
+
+    /**
+     * @brief Take ownership of everything appended to buffer()
+     */
+    virtual common::VoidResult commit() = 0;
+
+    /**
+     * @brief Write every committed byte to the file
+     */
+    virtual common::VoidResult flush() = 0;
+
+    /**
+     * @brief Commit buffer(), write every committed byte and wait until it is durable
+     *
+     * Uses fdatasync(), so file metadata other than the size may lag. Can
+     * stand in for commit() when the records just appended must be durable.
+     */
+    virtual common::VoidResult sync() = 0;
+
+    [[nodiscard]] virtual file_output_mode mode() const noexcept = 0;
+
+    /**
+     * @brief Descriptor of the open file, -1 when closed or unavailable
+     *
+     * Lets a caller that has flush()ed wait for the device on a dup() of
+     * it without holding the writer's lock. Valid until close().
+     * @since 4.1.0
+     */
+    [[nodiscard]] virtual int native_handle() const noexcept = 0;
+};
+
+/**
+ * @brief Create the backend described by options
+ * @return A closed file_output
+ */
+[[nodiscard]] LOGGER_SYSTEM_API std::unique_ptr<file_output> make_file_output(
+    const file_output_options& options = {});
+
+} // namespace kcenon::logger
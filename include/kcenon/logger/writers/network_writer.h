@@ -14,6 +14,7 @@
 #include "base_writer.h"
 #include "../interfaces/log_entry.h"
 #include "../interfaces/writer_category.h"
+#include "../core/memory_budget.h"
 
 #include <kcenon/logger/logger_export.h>
 
@@ -72,6 +73,14 @@ public:
      */
     common::VoidResult write(const log_entry& entry) override;
 
+    /**
+     * @brief Queue a batch of log entries under one lock
+     * @param entries Entries to send in order
+     * @return common::VoidResult indicating success or error
+     * @since 4.1.0
+     */
+    common::VoidResult write_batch(std::span<const log_entry> entries) override;
+
     /**
      * @brief Flush pending logs
      */
@@ -100,14 +109,22 @@ public:
     };
     
     connection_stats get_stats() const;
+
+    /**
+     * @brief Get this writer's memory budget accounting
+     * @since 4.1.0
+     */
+    budget_consumer_stats get_budget_stats() const { return budget_.get_stats(); }
     
 private:
     
     // Network operations
     bool connect();
     void disconnect();
-    bool send_data(const std::string& data);
+    bool send_data(const std::string& data, uint64_t message_count = 1);
     void process_buffer();
+    void enqueue_locked(log_entry&& entry);
+    static log_entry copy_for_network(const log_entry& entry);
     void attempt_reconnect();
     
     // Format log for network transmission
@@ -129,6 +146,7 @@ private:
     std::queue<log_entry> buffer_;
     mutable std::mutex buffer_mutex_;
     std::condition_variable buffer_cv_;
+    budget_consumer budget_{"network_writer"};
     
     // Worker threads (using std::jthread)
     std::unique_ptr<network_send_jthread_worker> send_worker_;
@@ -33,6 +33,7 @@
 #include "base_writer.h"
 #include "../interfaces/writer_category.h"
 #include "../otlp/otel_context.h"
+#include "../core/memory_budget.h"
 
 #include <kcenon/logger/logger_export.h>
 
@@ -219,6 +220,14 @@ public:
      */
     common::VoidResult write(const log_entry& entry) override;
 
+    /**
+     * @brief Queue a batch of log entries under one lock
+     * @param entries Entries to export in order
+     * @return common::VoidResult indicating success or error
+     * @since 4.1.0
+     */
+    common::VoidResult write_batch(std::span<const log_entry> entries) override;
+
     /**
      * @brief Flush pending logs
      */
@@ -239,6 +248,12 @@ public:
      */
     export_stats get_stats() const;
 
+    /**
+     * @brief Get this writer's memory budget accounting
+     * @since 4.1.0
+     */
+    budget_consumer_stats get_budget_stats() const { return budget_.get_stats(); }
+
     /**
      * @brief Force immediate export of current batch
      */
@@ -251,6 +266,17 @@ private:
     // Export batch to collector
     bool export_batch(const std::vector<log_entry>& batch);
 
+    // Copy the fields exported by OTLP, attaching the OTEL context
+    static log_entry copy_for_export(const log_entry& entry,
+                                     const std::optional<otlp::otel_context>& fallback_ctx);
+
+    // Push an admitted copy into queue_ (queue_mutex_ must be held)
+    void enqueue_locked(log_entry&& entry);
+
+    // Move up to max_count entries out of queue_ and release their budget
+    // (queue_mutex_ must be held)
+    void take_locked(std::vector<log_entry>& batch, std::size_t max_count);
+
     // Convert log level to OTLP severity
     static int to_otlp_severity(common::interfaces::log_level level);
 
@@ -273,6 +299,7 @@ private:
     std::queue<log_entry> queue_;
     mutable std::mutex queue_mutex_;
     std::condition_variable queue_cv_;
+    budget_consumer budget_{"otlp_writer"};
 
     // Background thread
     std::unique_ptr<std::thread> export_thread_;
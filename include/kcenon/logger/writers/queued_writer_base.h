@@ -13,6 +13,7 @@
  */
 
 #include "decorator_writer_base.h"
+#include "../core/memory_budget.h"
 #include "../interfaces/log_entry.h"
 #include "../interfaces/writer_category.h"
 #include <mutex>
@@ -55,6 +56,10 @@ inline log_entry copy_log_entry(const log_entry& entry) {
  * Template Parameter:
  * - Container: The container type to use for storing entries (e.g., std::queue, std::vector)
  *
+ * Queued copies are charged to the process-wide memory_budget under the
+ * decorator name; derived classes release them with release_entry() when
+ * they leave the queue.
+ *
  * Category: Asynchronous (non-blocking), Decorator (wraps another writer)
  */
 template <typename Container>
@@ -72,6 +77,7 @@ public:
                                 std::string_view decorator_name)
         : decorator_writer_base(std::move(wrapped_writer), decorator_name)
         , max_queue_size_(max_queue_size)
+        , budget_(std::string(decorator_name) + "_writer")
         , shutting_down_(false) {
     }
 
@@ -105,6 +111,14 @@ public:
         return max_queue_size_;
     }
 
+    /**
+     * @brief Memory budget accounting for this writer's queue
+     * @since 4.1.0
+     */
+    budget_consumer_stats get_budget_stats() const {
+        return budget_.get_stats();
+    }
+
 protected:
     /**
      * @brief Try to enqueue an entry with overflow protection
@@ -112,17 +126,65 @@ protected:
      * @return common::VoidResult indicating success or queue_full error
      */
     common::VoidResult try_enqueue(const log_entry& entry) {
+        log_entry copy = copy_log_entry(entry);
+        switch (admit_entry(copy)) {
+        case budget_decision::dropped:
+            return make_logger_void_result(logger_error_code::queue_overflow_dropped,
+                                           "Memory budget exceeded");
+        case budget_decision::spill:
+            return common::ok();
+        case budget_decision::admitted:
+        default:
+            break;
+        }
+
         std::lock_guard<std::mutex> lock(queue_mutex_);
 
         if (get_container_size(queue_) >= max_queue_size_) {
+            release_entry(copy);
             return handle_overflow(entry);
         }
 
-        enqueue_entry(queue_, entry);
+        enqueue_entry(queue_, std::move(copy));
         on_entry_enqueued();
         return common::ok();
     }
 
+    /**
+     * @brief Charge a queued copy to the memory budget
+     * @return admitted to queue it; spill if it was written to the spill
+     *         file instead; dropped otherwise
+     * @note Call without holding queue_mutex_ (the block policy waits)
+     * @since 4.1.0
+     */
+    budget_decision admit_entry(const log_entry& copy) {
+        const auto decision = budget_.admit(copy.level, budget_consumer::entry_bytes(copy));
+        if (decision == budget_decision::spill) {
+            budget_.spill(copy);
+        }
+        return decision;
+    }
+
+    /**
+     * @brief Charge a queued copy only if it fits right now
+     *
+     * Never waits, spills or counts a drop, so it is safe under
+     * queue_mutex_; a derived writer can flush its own queue to make room
+     * before falling back to admit_entry().
+     * @since 4.1.0
+     */
+    bool try_admit_entry(const log_entry& copy) noexcept {
+        return budget_.try_admit(copy.level, budget_consumer::entry_bytes(copy));
+    }
+
+    /**
+     * @brief Return the budget charged by admit_entry() or try_admit_entry()
+     * @since 4.1.0
+     */
+    void release_entry(const log_entry& copy) noexcept {
+        budget_.release(budget_consumer::entry_bytes(copy));
+    }
+
     /**
      * @brief Handle queue overflow condition
      * @param entry The entry that couldn't be enqueued
@@ -159,19 +221,20 @@ protected:
      * @brief Enqueue entry (specialization for std::queue)
      */
     template <typename T>
-    static void enqueue_entry(std::queue<T>& container, const log_entry& entry) {
-        container.push(copy_log_entry(entry));
+    static void enqueue_entry(std::queue<T>& container, log_entry&& entry) {
+        container.push(std::move(entry));
     }
 
     /**
      * @brief Enqueue entry (specialization for std::vector)
      */
     template <typename T>
-    static void enqueue_entry(std::vector<T>& container, const log_entry& entry) {
-        container.push_back(copy_log_entry(entry));
+    static void enqueue_entry(std::vector<T>& container, log_entry&& entry) {
+        container.push_back(std::move(entry));
     }
 
     std::size_t max_queue_size_;
+    budget_consumer budget_;
 
     mutable std::mutex queue_mutex_;
     Container queue_;
@@ -12,16 +12,26 @@
 #pragma once
 
 #include "file_writer.h"
+#include "segment_compression.h"
 #include "../interfaces/writer_category.h"
 
 #include <kcenon/logger/logger_export.h>
 
 #include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include <sstream>
 
 namespace kcenon::logger {
 
+namespace detail {
+class background_worker;
+class backup_index;
+class segment_compressor;
+} // namespace detail
+
 /**
  * @enum rotation_type
  * @brief Determines when log rotation should occur
@@ -33,6 +43,19 @@ enum class rotation_type {
     size_and_time   ///< Rotate based on both size and time
 };
 
+/**
+ * @struct retention_options
+ * @brief Limits on rotated backups besides max_files
+ * @since 4.1.0
+ */
+struct retention_options {
+    /// Combined size of all backups in bytes; 0 means no limit
+    std::uint64_t max_total_bytes = 0;
+
+    /// Backups last written longer ago than this are deleted; 0 means no limit
+    std::chrono::seconds max_age{0};
+};
+
 /**
  * @class rotating_file_writer
  * @brief File writer with automatic log rotation support
@@ -47,6 +70,41 @@ enum class rotation_type {
  * - Time-based: Rotates daily or hourly
  * - Combined: Rotates when either condition is met
  *
+ * Off-thread rotation (since 4.1.0):
+ * - Once the file is half way to max_size (or at any check, for time-based
+ *   rotation) a background thread opens the next segment as
+ *   `<name>.next`
+ * - At the rotation boundary the writer only swaps outputs under its mutex;
+ *   closing the old output, the renames and the cleanup of old backups run
+ *   on the background thread, in rotation order
+ * - If no segment is ready the writer waits for the background thread and
+ *   rotates in place, as before
+ * - rotate() and flush() return once pending rotations have finished, so the
+ *   directory then holds the expected backups
+ *
+ * Compression (since 4.1.0):
+ * - With a codec in segment_compression_options, every rotated segment is
+ *   compressed to `<segment>.gz` or `<segment>.zst` by low-priority threads
+ *   (see segment_compression.h), which replace it once done
+ * - Compressed and uncompressed backups count alike toward max_files;
+ *   a compressed file keeps its segment's modification time, which decides
+ *   what is deleted first
+ * - Uncompressed backups found at construction, e.g. left by a process that
+ *   exited mid-compression, are queued as well
+ *
+ * Retention (since 4.1.0):
+ * - The directory is scanned once at construction; from then on the writer
+ *   keeps its backups in memory, in rotation order, with their sizes, so
+ *   naming a backup and enforcing retention cost no directory listing and
+ *   at most one stat per rotation
+ * - The oldest backups are deleted until there are at most max_files, their
+ *   combined size is within retention_options::max_total_bytes and none is
+ *   older than retention_options::max_age. Limits are applied at
+ *   construction and after every rotation, so an idle writer deletes
+ *   expired backups only when it next rotates
+ * - Backups created or deleted behind the writer's back are not noticed
+ *   until the next writer for the file starts
+ *
  * Thread Safety:
  * - All public methods are thread-safe
  * - Uses mutex from thread_safe_writer base class
@@ -65,11 +123,17 @@ public:
      * @param max_size Maximum file size in bytes before rotation
      * @param max_files Maximum number of backup files to keep
      * @param check_interval Number of writes between rotation checks (default: 100)
+     * @param output Output backend for every generation of the file (since 4.1.0)
+     * @param compression How rotated segments are compressed (since 4.1.0)
+     * @param retention Size and age limits on backups (since 4.1.0)
      */
     rotating_file_writer(const std::string& filename,
                         size_t max_size,
                         size_t max_files,
-                        size_t check_interval = 100);
+                        size_t check_interval = 100,
+                        const file_output_options& output = {},
+                        const segment_compression_options& compression = {},
+                        const retention_options& retention = {});
 
     /**
      * @brief Construct with time-based rotation
@@ -77,11 +141,17 @@ public:
      * @param type Rotation type (daily or hourly)
      * @param max_files Maximum number of backup files to keep
      * @param check_interval Number of writes between rotation checks (default: 100)
+     * @param output Output backend for every generation of the file (since 4.1.0)
+     * @param compression How rotated segments are compressed (since 4.1.0)
+     * @param retention Size and age limits on backups (since 4.1.0)
      */
     rotating_file_writer(const std::string& filename,
                         rotation_type type,
                         size_t max_files,
-                        size_t check_interval = 100);
+                        size_t check_interval = 100,
+                        const file_output_options& output = {},
+                        const segment_compression_options& compression = {},
+                        const retention_options& retention = {});
 
     /**
      * @brief Construct with combined size and time rotation
@@ -90,13 +160,26 @@ public:
      * @param max_size Maximum file size in bytes before rotation
      * @param max_files Maximum number of backup files to keep
      * @param check_interval Number of writes between rotation checks (default: 100)
+     * @param output Output backend for every generation of the file (since 4.1.0)
+     * @param compression How rotated segments are compressed (since 4.1.0)
+     * @param retention Size and age limits on backups (since 4.1.0)
      * @throws std::invalid_argument if type is not size_and_time
      */
     rotating_file_writer(const std::string& filename,
                         rotation_type type,
                         size_t max_size,
                         size_t max_files,
-                        size_t check_interval = 100);
+                        size_t check_interval = 100,
+                        const file_output_options& output = {},
+                        const segment_compression_options& compression = {},
+                        const retention_options& retention = {});
+
+    /**
+     * @brief Finishes pending rotations and removes an unused next segment
+     * @details Compression in progress is abandoned; its segment stays
+     * uncompressed until the next writer for this file starts.
+     */
+    ~rotating_file_writer() override;
 
     /**
      * @brief Get writer name
@@ -105,9 +188,23 @@ public:
 
     /**
      * @brief Manually trigger log rotation (thread-safe)
+     * @note Returns after the renames and cleanup have completed
      */
     void rotate();
 
+    /**
+     * @brief Flush the output and wait for pending rotations
+     * @since 4.1.0
+     */
+    common::VoidResult flush() override;
+
+    /**
+     * @brief Block until every rotated segment queued so far is compressed
+     * @details Returns at once when compression is off.
+     * @since 4.1.0
+     */
+    void wait_for_compression();
+
 public:
     /**
      * @brief Write operation with automatic rotation check
@@ -118,6 +215,19 @@ public:
      */
     common::VoidResult write(const log_entry& entry) override;
 
+    /**
+     * @brief Batch write with rotation checks at entry granularity
+     * @param entries Entries to write in order
+     *
+     * @details Takes the mutex once. Entries are formatted into the output
+     * buffer and committed whenever a rotation check is due, so each output
+     * segment still honours check_interval and max_size. Rotation closes
+     * the backend first, so buffered records land in the file they belong to.
+     *
+     * @since 4.1.0
+     */
+    common::VoidResult write_batch(std::span<const log_entry> entries) override;
+
 private:
     /**
      * @brief Check if rotation should occur
@@ -126,23 +236,81 @@ private:
 
     /**
      * @brief Perform the actual rotation operation
+     * @details Swaps in the pre-opened next segment and hands the old output
+     * to the background thread, or rotates in place when none is ready.
      * @note Caller must hold the mutex
      */
     void perform_rotation();
 
+    /**
+     * @brief Close, rename and reopen on the calling thread
+     * @note Caller must hold the mutex and the background thread must be idle
+     */
+    void rotate_in_place(std::chrono::system_clock::time_point when);
+
+    /**
+     * @brief Ask the background thread to open the next segment, once
+     * @note Caller must hold the mutex
+     */
+    void request_next_segment();
+
+    /**
+     * @brief Open the next segment (background thread)
+     */
+    void prepare_next_segment();
+
+    /**
+     * @brief Close the retired output, rename both files and clean up
+     *        (background thread)
+     */
+    void finish_rotation(const std::shared_ptr<file_output>& retired,
+                         std::chrono::system_clock::time_point when);
+
+    /**
+     * @brief Replace a segment with its compressed copy (background thread)
+     * @details Skipped if retention removed the segment meanwhile.
+     */
+    void finish_compression(const std::string& segment,
+                            const std::string& temporary,
+                            const std::string& compressed);
+
+    /**
+     * @brief Recover leftovers of an earlier process and start compression
+     * @note Called at the end of every constructor
+     */
+    void start_housekeeping(const segment_compression_options& compression);
+
+    /**
+     * @brief Deal with a next segment left behind by an earlier process
+     * @details An empty one is removed; one holding records is kept as a backup.
+     */
+    void recover_next_segment();
+
     /**
      * @brief Generate filename for rotated log
+     * @param when Rotation time, used by the time-based name formats
      * @param index Optional index for size-based rotation (-1 for auto)
      */
-    std::string generate_rotated_filename(int index = -1) const;
+    std::string generate_rotated_filename(std::chrono::system_clock::time_point when,
+                                          int index = -1) const;
 
     /**
-     * @brief Remove old backup files beyond max_files limit
+     * @brief Delete the oldest backups until max_files and the retention limits hold
      */
     void cleanup_old_files();
 
     /**
-     * @brief Get list of existing backup files
+     * @brief Build the backup index from one scan of the directory
+     */
+    void load_backup_index();
+
+    /**
+     * @brief Add a freshly rotated file to the backup index as the newest
+     */
+    void record_backup(const std::string& path);
+
+    /**
+     * @brief List existing backup files, compressed or not, from the directory
      */
     std::vector<std::string> get_backup_files() const;
 
@@ -166,6 +334,19 @@ private:
     std::string file_extension_;
     std::chrono::system_clock::time_point last_rotation_time_;
     std::chrono::system_clock::time_point current_period_start_;
+
+    file_output_options output_options_;  ///< Used to open each next segment
+    std::string next_filename_;           ///< Where the next segment is pre-opened
+    bool next_requested_{false};          ///< A next segment is open or being opened
+
+    std::mutex next_mutex_;                      ///< Guards next_output_
+    std::unique_ptr<file_output> next_output_;   ///< Pre-opened next segment
+    retention_options retention_;
+    mutable std::mutex backups_mutex_;               ///< Guards backups_
+    std::unique_ptr<detail::backup_index> backups_;  ///< Backups on disk, oldest first
+
+    std::unique_ptr<detail::background_worker> worker_;
+    std::unique_ptr<detail::segment_compressor> compressor_;  ///< Null when compression is off
 };
 
 } // namespace kcenon::logger
@@ -0,0 +1,86 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file segment_compression.h
+ * @brief Compression of rotated log segments
+ * @since 4.1.0
+ *
+ * @details rotating_file_writer hands every file it rotates out to a pool of
+ * background threads, which compress it to `<segment>.gz` or
+ * `<segment>.zst` and remove the original. The threads run at the lowest
+ * scheduling priority and sleep between chunks so that, on average, each
+ * uses no more than cpu_budget of one core.
+ *
+ * gzip needs zlib and zstd needs libzstd at build time (see
+ * LOGGER_USE_COMPRESSION); is_compression_available() tells which were
+ * found. A writer asked for an unavailable codec falls back to the other
+ * one, or leaves its segments uncompressed when neither is built in.
+ */
+
+#pragma once
+
+#include <kcenon/common/patterns/result.h>
+#include <kcenon/logger/core/error_codes.h>
+#include <kcenon/logger/logger_export.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace kcenon::logger {
+
+/**
+ * @enum compression_codec
+ * @brief Format rotated segments are compressed to
+ */
+enum class compression_codec : std::uint8_t {
+    none,  ///< Leave rotated segments as they are
+    gzip,  ///< gzip stream via zlib, written as `<segment>.gz`
+    zstd   ///< Zstandard frame via libzstd, written as `<segment>.zst`
+};
+
+/**
+ * @struct segment_compression_options
+ * @brief How rotating_file_writer compresses the segments it rotates out
+ */
+struct segment_compression_options {
+    compression_codec codec = compression_codec::none;
+
+    /// Codec level; 0 picks the codec default (6 for gzip, 3 for zstd)
+    int level = 0;
+
+    /// Segments compressed at the same time, one thread each
+    std::size_t max_concurrent = 1;
+
+    /// Average share of one core each thread may use, in (0, 1];
+    /// 1 disables throttling
+    double cpu_budget = 0.5;
+};
+
+/**
+ * @brief Whether this build can write the given codec
+ * @return true for compression_codec::none
+ */
+[[nodiscard]] LOGGER_SYSTEM_API bool is_compression_available(compression_codec codec) noexcept;
+
+/**
+ * @brief File name suffix of a codec (".gz", ".zst", or "" for none)
+ */
+[[nodiscard]] LOGGER_SYSTEM_API const char* compression_extension(compression_codec codec) noexcept;
+
+/**
+ * @brief Compress a file on the calling thread, honouring level and cpu_budget
+ * @param source File to read
+ * @param destination File to create or truncate
+ * @param options Codec, level and CPU budget; max_concurrent is ignored
+ * @return file_compression_failed if the codec is unavailable or a codec
+ *         call fails, file_open_failed / file_write_failed for I/O errors.
+ *         The source is left untouched either way.
+ */
+LOGGER_SYSTEM_API common::VoidResult compress_file(const std::string& source,
+                                                   const std::string& destination,
+                                                   const segment_compression_options& options);
+
+} // namespace kcenon::logger
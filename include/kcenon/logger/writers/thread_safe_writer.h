@@ -116,6 +116,18 @@ public:
      */
     common::VoidResult write(const log_entry& entry) final;
 
+    /**
+     * @brief Thread-safe batch write operation
+     * @param entries Entries to write in order
+     * @return common::VoidResult with the first error encountered, if any
+     *
+     * @details Acquires the mutex once for the whole batch and delegates to
+     * write_batch_impl().
+     *
+     * @since 4.1.0
+     */
+    common::VoidResult write_batch(std::span<const log_entry> entries) final;
+
     /**
      * @brief Thread-safe flush operation
      * @return common::VoidResult Success or error code
@@ -144,6 +156,20 @@ protected:
      */
     virtual common::VoidResult write_entry_impl(const log_entry& entry) = 0;
 
+    /**
+     * @brief Implementation of batch write (override to batch the output)
+     * @param entries Entries to write in order
+     * @return common::VoidResult with the first error encountered, if any
+     *
+     * @details Called by write_batch() while holding the mutex. The default
+     * calls write_entry_impl() for each entry.
+     *
+     * @note The mutex is held when this method is called.
+     *
+     * @since 4.1.0
+     */
+    virtual common::VoidResult write_batch_impl(std::span<const log_entry> entries);
+
     /**
      * @brief Implementation of flush operation (override in derived classes)
      * @return common::VoidResult Success or error code
@@ -0,0 +1,88 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file batch_context.cpp
+ * @brief Per-batch monotonic arena implementation
+ * @since 4.1.0
+ */
+
+#include <kcenon/logger/core/batch_context.h>
+
+#include <bit>
+
+namespace kcenon::logger {
+
+namespace {
+
+thread_local batch_context* t_current_context = nullptr;
+
+} // namespace
+
+batch_context::batch_context(std::size_t initial_bytes)
+    : block_(std::make_unique<std::byte[]>(initial_bytes))
+    , capacity_(initial_bytes) {
+    arena_.emplace(block_.get(), capacity_, &spill_);
+}
+
+batch_context::~batch_context() = default;
+
+std::pmr::memory_resource* batch_context::resource() noexcept {
+    return &*arena_;
+}
+
+void batch_context::reset() {
+    // Returns every spilled chunk to the heap
+    arena_.reset();
+
+    if (spill_.spilled != 0) {
+        // Grow once to the high-water mark so the next such batch fits
+        capacity_ = std::bit_ceil(capacity_ + spill_.spilled);
+        block_ = std::make_unique<std::byte[]>(capacity_);
+        spill_.spilled = 0;
+        ++grow_count_;
+    }
+
+    arena_.emplace(block_.get(), capacity_, &spill_);
+}
+
+std::size_t batch_context::capacity() const noexcept {
+    return capacity_;
+}
+
+std::uint64_t batch_context::grow_count() const noexcept {
+    return grow_count_;
+}
+
+batch_context* batch_context::current() noexcept {
+    return t_current_context;
+}
+
+std::pmr::memory_resource* batch_context::current_resource() noexcept {
+    return t_current_context ? t_current_context->resource() : std::pmr::get_default_resource();
+}
+
+batch_context::scope::scope(batch_context& context) noexcept
+    : previous_(t_current_context) {
+    t_current_context = &context;
+}
+
+batch_context::scope::~scope() {
+    t_current_context = previous_;
+}
+
+void* batch_context::spill_resource::do_allocate(std::size_t bytes, std::size_t alignment) {
+    spilled += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+}
+
+void batch_context::spill_resource::do_deallocate(void* p, std::size_t bytes, std::size_t alignment) {
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+}
+
+bool batch_context::spill_resource::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+} // namespace kcenon::logger
@@ -0,0 +1,218 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file intern_table.cpp
+ * @brief Process-wide string intern table implementation
+ * @since 4.1.0
+ */
+
+#include <kcenon/logger/core/intern_table.h>
+
+#include <cstring>
+
+namespace kcenon::logger {
+
+namespace {
+
+constexpr std::size_t initial_index_capacity = 4096;
+
+} // namespace
+
+intern_table::hash_index::hash_index(std::size_t capacity)
+    : mask(capacity - 1)
+    , slots(std::make_unique<std::atomic<id_type>[]>(capacity)) {}
+
+intern_table& intern_table::instance() {
+    // Leaked on purpose: entries may be resolved during static destruction
+    static auto* table = new intern_table();
+    return *table;
+}
+
+intern_table::intern_table() {
+    indexes_.push_back(std::make_unique<hash_index>(initial_index_capacity));
+    index_.store(indexes_.back().get(), std::memory_order_release);
+
+    // Id 0 is the empty string
+    segment_storage_.push_back(std::make_unique<entry[]>(segment_size));
+    segment_storage_.back()[0] = entry{"", 0, 0};
+    segments_[0].store(segment_storage_.back().get(), std::memory_order_release);
+}
+
+std::uint64_t intern_table::hash(std::string_view text) noexcept {
+    // Word-at-a-time multiply/xor mix; file paths and signatures are long
+    constexpr std::uint64_t k = 0x9E3779B97F4A7C15ULL;
+    std::uint64_t h = text.size() * k;
+    const char* p = text.data();
+    std::size_t n = text.size();
+    while (n >= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, p, 8);
+        h = (h ^ word) * k;
+        h ^= h >> 29;
+        p += 8;
+        n -= 8;
+    }
+    if (n != 0) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, p, n);
+        h = (h ^ word) * k;
+        h ^= h >> 29;
+    }
+    return h ^ (h >> 32);
+}
+
+const intern_table::entry& intern_table::entry_at(id_type id) const noexcept {
+    const entry* segment = segments_[id >> segment_bits].load(std::memory_order_acquire);
+    return segment[id & (segment_size - 1)];
+}
+
+intern_table::id_type intern_table::find(const hash_index& index, std::string_view text,
+                                         std::uint64_t h) const noexcept {
+    const auto h32 = static_cast<std::uint32_t>(h);
+    for (std::size_t slot = h & index.mask;; slot = (slot + 1) & index.mask) {
+        const id_type id = index.slots[slot].load(std::memory_order_acquire);
+        if (id == empty_id) {
+            return empty_id;
+        }
+        const entry& e = entry_at(id);
+        if (e.hash == h32 && e.size == text.size() &&
+            std::memcmp(e.data, text.data(), text.size()) == 0) {
+            return id;
+        }
+    }
+}
+
+intern_table::id_type intern_table::intern(std::string_view text) {
+    return find_or_add(text, false);
+}
+
+intern_table::id_type intern_table::intern_category(std::string_view text) {
+    return find_or_add(text, true);
+}
+
+intern_table::id_type intern_table::find_or_add(std::string_view text, bool category) {
+    if (text.empty()) {
+        return empty_id;
+    }
+
+    const std::uint64_t h = hash(text);
+    if (const id_type id = find(*index_.load(std::memory_order_acquire), text, h)) {
+        return id;
+    }
+
+    std::lock_guard<std::mutex> lock(insert_mutex_);
+
+    // Another thread may have added it since the lock-free probe
+    hash_index* index = index_.load(std::memory_order_relaxed);
+    if (const id_type id = find(*index, text, h)) {
+        return id;
+    }
+
+    if (category && categories_ >= max_categories) {
+        category_overflow_.fetch_add(1, std::memory_order_relaxed);
+        return empty_id;
+    }
+
+    const std::size_t count = count_.load(std::memory_order_relaxed);
+    if (count >= max_entries) {
+        overflow_.fetch_add(1, std::memory_order_relaxed);
+        return empty_id;
+    }
+    if (category) {
+        ++categories_;
+    }
+
+    const auto id = static_cast<id_type>(count);
+    const std::size_t segment = id >> segment_bits;
+    if (segments_[segment].load(std::memory_order_relaxed) == nullptr) {
+        segment_storage_.push_back(std::make_unique<entry[]>(segment_size));
+        segments_[segment].store(segment_storage_.back().get(), std::memory_order_release);
+    }
+
+    entry* slots = segments_[segment].load(std::memory_order_relaxed);
+    slots[id & (segment_size - 1)] = entry{store(text), static_cast<std::uint32_t>(text.size()),
+                                           static_cast<std::uint32_t>(h)};
+    count_.store(count + 1, std::memory_order_release);
+
+    // Keep the load factor at or below one half so probes stay short
+    if ((count + 1) * 2 > index->mask + 1) {
+        grow_index();
+        index = index_.load(std::memory_order_relaxed);
+    }
+    insert(*index, id, h);
+    return id;
+}
+
+std::string_view intern_table::resolve(id_type id) const noexcept {
+    const entry& e = entry_at(id);
+    return std::string_view(e.data, e.size);
+}
+
+std::size_t intern_table::size() const noexcept {
+    return count_.load(std::memory_order_acquire);
+}
+
+std::size_t intern_table::memory_usage() const noexcept {
+    std::lock_guard<std::mutex> lock(insert_mutex_);
+    std::size_t bytes = chunks_.size() * chunk_size + storage_bytes_.load(std::memory_order_relaxed);
+    bytes += segment_storage_.size() * segment_size * sizeof(entry);
+    for (const auto& index : indexes_) {
+        bytes += (index->mask + 1) * sizeof(std::atomic<id_type>);
+    }
+    return bytes;
+}
+
+std::uint64_t intern_table::overflow_count() const noexcept {
+    return overflow_.load(std::memory_order_relaxed);
+}
+
+std::uint64_t intern_table::category_overflow_count() const noexcept {
+    return category_overflow_.load(std::memory_order_relaxed);
+}
+
+const char* intern_table::store(std::string_view text) {
+    const std::size_t needed = text.size() + 1;
+    char* out;
+    if (needed > chunk_size / 4) {
+        // Oversized strings get their own block rather than wasting a chunk
+        chunks_.insert(chunks_.begin(), std::make_unique<char[]>(needed));
+        storage_bytes_.fetch_add(needed, std::memory_order_relaxed);
+        out = chunks_.front().get();
+    } else {
+        if (chunk_used_ + needed > chunk_size) {
+            chunks_.push_back(std::make_unique<char[]>(chunk_size));
+            chunk_used_ = 0;
+        }
+        out = chunks_.back().get() + chunk_used_;
+        chunk_used_ += needed;
+    }
+    std::memcpy(out, text.data(), text.size());
+    out[text.size()] = '\0';
+    return out;
+}
+
+void intern_table::insert(hash_index& index, id_type id, std::uint64_t h) noexcept {
+    std::size_t slot = h & index.mask;
+    while (index.slots[slot].load(std::memory_order_relaxed) != empty_id) {
+        slot = (slot + 1) & index.mask;
+    }
+    index.slots[slot].store(id, std::memory_order_release);
+}
+
+void intern_table::grow_index() {
+    const hash_index& current = *index_.load(std::memory_order_relaxed);
+    auto next = std::make_unique<hash_index>((current.mask + 1) * 2);
+    for (std::size_t slot = 0; slot <= current.mask; ++slot) {
+        const id_type id = current.slots[slot].load(std::memory_order_relaxed);
+        if (id != empty_id) {
+            const entry& e = entry_at(id);
+            insert(*next, id, hash(std::string_view(e.data, e.size)));
+        }
+    }
+    indexes_.push_back(std::move(next));
+    index_.store(indexes_.back().get(), std::memory_order_release);
+}
+
+} // namespace kcenon::logger
@@ -14,19 +14,30 @@
  */
 
 #include <kcenon/logger/core/log_collector.h>
+#include <kcenon/logger/core/batch_context.h>
+#include <kcenon/logger/core/memory_budget.h>
 #include <kcenon/logger/writers/base_writer.h>
 #include <kcenon/logger/interfaces/log_entry.h>
 #include <kcenon/common/interfaces/logger_interface.h>
 
+#include "../impl/async/cpu_index.h"
+#include "../impl/async/dispatch_lane.h"
 #include "../impl/async/jthread_compat.h"
+#include "../impl/async/lockfree_queue.h"
+#include "../impl/async/queued_record.h"
+#include "../impl/async/rcu_snapshot.h"
+#include "../impl/async/record_ring.h"
 
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <cstdio>
 #include <functional>
 #include <memory>
+#include <memory_resource>
 #include <mutex>
-#include <queue>
+#include <optional>
 #include <thread>
 #include <vector>
 
@@ -35,29 +46,543 @@ namespace kcenon::logger {
 // Type alias for log_level
 using log_level = common::interfaces::log_level;
 
+namespace {
+
+/**
+ * @brief Queue implementation selected for a collector
+ */
+enum class collector_queue_kind {
+    mutex,       ///< record_ring guarded by queue_mutex (default)
+    lock_free,   ///< Shared bounded MPMC ring
+    per_thread,  ///< Per-thread SPSC staging rings with fan-in
+    per_cpu      ///< One MPMC ring per CPU, indexed by the producer's current CPU
+};
+
+/**
+ * @brief Queue element: 64-byte header plus payload, see queued_record.h
+ */
+using async::queued_record;
+
+/**
+ * @brief Capacity of each per-thread staging ring
+ *
+ * Fixed at compile time by lockfree_spsc_queue. Each slot holds a full
+ * queued_record, so this is kept modest (~112 KB per producing thread).
+ */
+constexpr std::size_t staging_ring_capacity = 256;
+
+/**
+ * @brief Smallest per-CPU ring, so small buffers on many-core hosts still batch
+ */
+constexpr std::size_t min_cpu_ring_capacity = 64;
+
+/**
+ * @brief Single-producer staging ring owned by one logging thread
+ *
+ * The collector's registry owns the ring; the producing thread only keeps a
+ * weak reference, so the ring is released together with the collector.
+ */
+struct staging_ring {
+    async::lockfree_spsc_queue<std::optional<queued_record>, staging_ring_capacity> queue;
+    std::atomic<bool> producer_exited{false};
+};
+
+/**
+ * @brief Thread-local map from collector id to this thread's staging ring
+ *
+ * Marks the rings as retired on thread exit so the collector can release
+ * them once they are drained.
+ */
+struct staging_ring_cache {
+    struct slot {
+        std::uint64_t collector_id;
+        std::weak_ptr<staging_ring> ring;
+    };
+    std::vector<slot> slots;
+
+    ~staging_ring_cache() {
+        for (auto& s : slots) {
+            if (auto ring = s.ring.lock()) {
+                ring->producer_exited.store(true, std::memory_order_release);
+            }
+        }
+    }
+};
+
+thread_local staging_ring_cache t_staging_rings;
+std::atomic<std::uint64_t> next_collector_id{1};
+
+} // namespace
+
 /**
  * @brief Shared state for log processing - survives impl destruction
  *
  * This structure holds all the data that the worker needs to access.
  * By using shared_ptr, the worker can safely access this data even after
  * the impl object starts destruction, preventing use-after-free bugs.
+ *
+ * Four queue implementations are supported. The mutex-protected record_ring
+ * is the default. In lock_free mode entries go through a bounded MPMC ring;
+ * in per_thread mode every producing thread owns an SPSC staging ring that
+ * the worker drains round-robin; in per_cpu mode there is one MPMC ring per
+ * CPU and a producer pushes to the ring of the CPU it is running on. In the
+ * lock-free modes queue_mutex and queue_cv are only used to park the idle
+ * worker and, under the block overflow policy, producers waiting for space
+ * on space_cv.
  */
 struct log_collector_shared_state {
-    std::queue<log_entry> queue;
+    async::record_ring<queued_record> queue;
+    std::unique_ptr<async::lockfree_mpmc_queue<queued_record>> lockfree_queue;
     mutable std::mutex queue_mutex;
 #if LOGGER_HAS_JTHREAD
     std::condition_variable_any queue_cv;  // Works with stop_token
 #else
     std::condition_variable queue_cv;       // Standard condition variable
 #endif
-    std::vector<std::weak_ptr<log_writer_interface>> writers;
-    std::mutex writers_mutex;
+    std::atomic<bool> worker_waiting{false};  // Lock-free modes: worker parked on queue_cv
+    std::atomic<bool> worker_busy{false};     // Worker holds a popped batch not yet dispatched
+    async::rcu_snapshot<std::vector<std::shared_ptr<log_writer_interface>>> writers;
     const std::size_t batch_size;
     const std::size_t buffer_size;
 
-    explicit log_collector_shared_state(std::size_t buffer_sz, std::size_t batch_sz)
+    // Per-thread staging mode; staging_mutex is only taken by the worker and
+    // by a thread logging through this collector for the first time
+    const collector_queue_kind kind;
+    const bool merge_by_timestamp;
+    const std::uint64_t collector_id;
+    mutable std::mutex staging_mutex;
+    std::vector<std::shared_ptr<staging_ring>> staging_rings;
+    std::size_t staging_cursor = 0;
+
+    // Per-CPU mode; the ring set is fixed at construction, so producers index
+    // it without synchronization. cpu_cursor is only used by the draining thread.
+    std::vector<std::unique_ptr<async::lockfree_mpmc_queue<queued_record>>> cpu_rings;
+    std::size_t cpu_cursor = 0;
+
+    // Overflow handling; counters are only touched once the queue is full
+    const logger_config::overflow_policy overflow;
+    const std::chrono::nanoseconds block_timeout;
+    std::size_t capacity;  // Mutex mode only, guarded by queue_mutex; grows under grow
+    std::condition_variable space_cv;
+    std::atomic<std::uint32_t> blocked_producers{0};
+    std::atomic<std::uint64_t> dropped_newest{0};
+    std::atomic<std::uint64_t> evicted_oldest{0};
+    std::atomic<std::uint64_t> blocked_enqueues{0};
+    std::atomic<std::uint64_t> block_timeouts{0};
+    std::atomic<std::uint64_t> blocked_ns{0};
+    std::atomic<std::uint64_t> growth_events{0};
+
+    // Share of the process-wide memory budget; bytes are reserved in push()
+    // and released once the batch holding the record has been written (by
+    // every lane, when lanes are used). Declared before lanes so it outlives
+    // the batches they still hold.
+    budget_consumer budget{"log_collector"};
+
+    // Writer dispatch lanes (writer_thread_count > 1); lane_writers[i] lists
+    // the writers served by lanes[i]. Empty when the worker writes directly.
+    std::vector<std::unique_ptr<async::dispatch_lane>> lanes;
+    async::rcu_snapshot<std::vector<async::dispatch_lane::writers_ptr>> lane_writers;
+
+    explicit log_collector_shared_state(std::size_t buffer_sz, std::size_t batch_sz,
+                                        collector_queue_kind queue_kind = collector_queue_kind::mutex,
+                                        bool merge_timestamps = false,
+                                        logger_config::overflow_policy policy =
+                                            logger_config::overflow_policy::drop_newest,
+                                        std::chrono::milliseconds max_block = std::chrono::milliseconds{100},
+                                        std::size_t lane_count = 1,
+                                        async::ring_memory_options ring_memory = {})
         : batch_size(batch_sz)
-        , buffer_size(buffer_sz) {}
+        , buffer_size(buffer_sz)
+        , kind(queue_kind)
+        , merge_by_timestamp(merge_timestamps)
+        , collector_id(next_collector_id.fetch_add(1, std::memory_order_relaxed))
+        , overflow(effective_policy(queue_kind, policy))
+        , block_timeout(std::max(max_block, std::chrono::milliseconds::zero()))
+        , capacity(buffer_sz) {
+        if (kind == collector_queue_kind::lock_free) {
+            lockfree_queue = std::make_unique<async::lockfree_mpmc_queue<queued_record>>(buffer_sz, ring_memory);
+        }
+        if (kind == collector_queue_kind::per_cpu) {
+            // Split the buffer across CPUs so memory scales with cores, not threads
+            const std::size_t cpus = async::cpu_slot_count();
+            const std::size_t ring_capacity =
+                std::max(min_cpu_ring_capacity, (buffer_sz + cpus - 1) / cpus);
+            cpu_rings.reserve(cpus);
+            for (std::size_t i = 0; i < cpus; ++i) {
+                cpu_rings.push_back(
+                    std::make_unique<async::lockfree_mpmc_queue<queued_record>>(ring_capacity, ring_memory));
+            }
+        }
+        if (lane_count > 1) {
+            std::vector<async::dispatch_lane::writers_ptr> empty_lists;
+            for (std::size_t i = 0; i < lane_count; ++i) {
+                lanes.push_back(std::make_unique<async::dispatch_lane>(buffer_sz));
+                empty_lists.push_back(std::make_shared<const async::dispatch_lane::writer_list>());
+            }
+            lane_writers.update([&empty_lists](auto& lists) {
+                lists = std::move(empty_lists);
+                return true;
+            });
+        }
+    }
+
+    /**
+     * @brief Populate (and mlock() if configured) the lock-free rings
+     *
+     * Called from start() so a burst right after startup does not pay for
+     * page faults; a no-op for heap-backed rings.
+     */
+    void prefault_rings() noexcept {
+        if (lockfree_queue) {
+            lockfree_queue->prefault();
+        }
+        for (auto& ring : cpu_rings) {
+            ring->prefault();
+        }
+    }
+
+    [[nodiscard]] bool uses_lanes() const noexcept {
+        return !lanes.empty();
+    }
+
+    /**
+     * @brief Wait until every lane has written what was posted to it
+     */
+    void wait_lanes_idle() {
+        for (auto& lane : lanes) {
+            lane->wait_idle();
+        }
+    }
+
+    /**
+     * @brief Map the configured policy onto what the queue kind supports
+     *
+     * Lock-free rings are fixed-size, so grow degrades to drop_newest; a
+     * per-thread SPSC ring cannot be popped by its producer, so drop_oldest
+     * does too.
+     */
+    static logger_config::overflow_policy effective_policy(collector_queue_kind queue_kind,
+                                                           logger_config::overflow_policy policy) {
+        using policy_t = logger_config::overflow_policy;
+        if (queue_kind != collector_queue_kind::mutex && policy == policy_t::grow) {
+            return policy_t::drop_newest;
+        }
+        if (queue_kind == collector_queue_kind::per_thread && policy == policy_t::drop_oldest) {
+            return policy_t::drop_newest;
+        }
+        return policy;
+    }
+
+    /**
+     * @brief Wait on space_cv until try_push succeeds or block_timeout expires
+     * @param lock Held lock on queue_mutex
+     * @param try_push Predicate that attempts the enqueue
+     * @return true if the entry was enqueued
+     *
+     * The increment of blocked_producers pairs with the fence in
+     * release_blocked_producers(): either the worker sees a waiting producer
+     * or the producer sees the space the worker just freed.
+     */
+    template<typename TryPush>
+    bool wait_for_space(std::unique_lock<std::mutex>& lock, TryPush&& try_push) {
+        blocked_enqueues.fetch_add(1, std::memory_order_relaxed);
+        blocked_producers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool pushed = space_cv.wait_until(lock, start + block_timeout, try_push);
+        const auto waited = std::chrono::steady_clock::now() - start;
+
+        blocked_producers.fetch_sub(1, std::memory_order_relaxed);
+        blocked_ns.fetch_add(static_cast<std::uint64_t>(
+                                 std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count()),
+                             std::memory_order_relaxed);
+        if (!pushed) {
+            block_timeouts.fetch_add(1, std::memory_order_relaxed);
+        }
+        return pushed;
+    }
+
+    /**
+     * @brief Wake producers blocked on a full queue after the worker drained it
+     * @note Must be called without holding queue_mutex
+     */
+    void release_blocked_producers() {
+        if (overflow != logger_config::overflow_policy::block) {
+            return;
+        }
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (blocked_producers.load(std::memory_order_relaxed) != 0) {
+            { std::lock_guard<std::mutex> lock(queue_mutex); }
+            space_cv.notify_all();
+        }
+    }
+
+    [[nodiscard]] bool is_lock_free() const noexcept {
+        return lockfree_queue != nullptr;
+    }
+
+    [[nodiscard]] bool is_per_thread() const noexcept {
+        return kind == collector_queue_kind::per_thread;
+    }
+
+    [[nodiscard]] bool is_per_cpu() const noexcept {
+        return kind == collector_queue_kind::per_cpu;
+    }
+
+    /**
+     * @brief MPMC ring a producer pushes to (lock_free and per_cpu modes)
+     */
+    [[nodiscard]] async::lockfree_mpmc_queue<queued_record>& producer_ring() const noexcept {
+        if (is_per_cpu()) {
+            return *cpu_rings[async::current_cpu() % cpu_rings.size()];
+        }
+        return *lockfree_queue;
+    }
+
+    /**
+     * @brief True when producers never take queue_mutex
+     */
+    [[nodiscard]] bool bypasses_queue_mutex() const noexcept {
+        return kind != collector_queue_kind::mutex;
+    }
+
+    /**
+     * @brief Check for queued entries
+     * @note In mutex mode the caller must hold queue_mutex
+     */
+    [[nodiscard]] bool has_pending() const {
+        if (is_per_thread()) {
+            std::lock_guard<std::mutex> lock(staging_mutex);
+            return std::any_of(staging_rings.begin(), staging_rings.end(),
+                               [](const auto& ring) { return !ring->queue.empty(); });
+        }
+        if (is_per_cpu()) {
+            return std::any_of(cpu_rings.begin(), cpu_rings.end(),
+                               [](const auto& ring) { return !ring->empty(); });
+        }
+        return is_lock_free() ? !lockfree_queue->empty() : !queue.empty();
+    }
+
+    /**
+     * @brief Move up to batch_size entries into batch
+     * @note In mutex mode the caller must hold queue_mutex
+     */
+    void pop_batch(std::vector<queued_record>& batch) {
+        if (is_per_thread()) {
+            pop_staged_batch(batch);
+            return;
+        }
+        if (is_per_cpu()) {
+            pop_cpu_batch(batch);
+            return;
+        }
+        if (is_lock_free()) {
+            lockfree_queue->dequeue_bulk(batch, batch_size);
+            return;
+        }
+        batch.reserve(std::min(batch_size, queue.size()));
+        while (!queue.empty() && batch.size() < batch_size) {
+            batch.push_back(std::move(queue.front()));
+            queue.pop();
+        }
+    }
+
+    /**
+     * @brief Budget held by the records of a batch
+     */
+    [[nodiscard]] static std::size_t batch_bytes(const std::vector<queued_record>& batch) noexcept {
+        std::size_t bytes = 0;
+        for (const auto& item : batch) {
+            bytes += item.footprint();
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Return the budget held by a batch that has been written
+     *
+     * With lanes the batch is only posted when write_batch_to_all() returns;
+     * its budget is returned when the last lane has finished with it.
+     */
+    void release_batch(const std::vector<queued_record>& batch) noexcept {
+        if (!uses_lanes()) {
+            budget.release(batch_bytes(batch));
+        }
+    }
+
+    /**
+     * @brief Get the calling thread's staging ring, registering it on first use
+     * @return Strong reference that keeps the ring alive during the enqueue
+     */
+    std::shared_ptr<staging_ring> local_staging_ring() {
+        auto& slots = t_staging_rings.slots;
+        for (auto& s : slots) {
+            if (s.collector_id == collector_id) {
+                if (auto ring = s.ring.lock()) {
+                    return ring;
+                }
+            }
+        }
+
+        // First entry from this thread: drop slots of destroyed collectors
+        slots.erase(std::remove_if(slots.begin(), slots.end(),
+                                   [](const auto& s) { return s.ring.expired(); }),
+                    slots.end());
+
+        auto ring = std::make_shared<staging_ring>();
+        {
+            std::lock_guard<std::mutex> lock(staging_mutex);
+            staging_rings.push_back(ring);
+        }
+        slots.push_back({collector_id, ring});
+        return ring;
+    }
+
+    /**
+     * @brief Snapshot of entries and capacity summed over the per-CPU rings
+     */
+    [[nodiscard]] std::pair<std::size_t, std::size_t> cpu_ring_metrics() const {
+        std::size_t size = 0;
+        std::size_t total = 0;
+        for (const auto& ring : cpu_rings) {
+            size += ring->size();
+            total += ring->capacity();
+        }
+        return {size, total};
+    }
+
+    /**
+     * @brief Snapshot of staged entries and ring capacity
+     */
+    [[nodiscard]] std::pair<std::size_t, std::size_t> staged_metrics() const {
+        std::lock_guard<std::mutex> lock(staging_mutex);
+        std::size_t size = 0;
+        for (const auto& ring : staging_rings) {
+            size += ring->queue.size();
+        }
+        return {size, staging_rings.size() * staging_ring_capacity};
+    }
+
+    /**
+     * @brief Wake the worker after a lock-free enqueue if it is parked
+     *
+     * Pairs with the fence in the worker's wait path (Dekker-style): either
+     * the producer observes worker_waiting or the worker observes the new
+     * entry before it sleeps, so a wake-up cannot be lost.
+     */
+    void wake_parked_worker() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (worker_waiting.load(std::memory_order_relaxed)) {
+            { std::lock_guard<std::mutex> lock(queue_mutex); }
+            queue_cv.notify_one();
+        }
+    }
+
+private:
+    /**
+     * @brief Fan-in drain of the per-thread staging rings
+     *
+     * Rings are visited round-robin, starting one further each call so no
+     * thread is starved, and each ring is drained in order until the batch
+     * is full. Entries from one thread therefore keep their enqueue order;
+     * with merge_by_timestamp the per-ring runs are additionally merged by
+     * timestamp within the batch.
+     */
+    void pop_staged_batch(std::vector<queued_record>& batch) {
+        std::vector<std::size_t> run_ends;
+        {
+            std::lock_guard<std::mutex> lock(staging_mutex);
+            const std::size_t ring_count = staging_rings.size();
+            if (ring_count == 0) {
+                return;
+            }
+
+            batch.reserve(batch_size);
+            std::optional<queued_record> slot;
+            const std::size_t start = staging_cursor++ % ring_count;
+            for (std::size_t i = 0; i < ring_count && batch.size() < batch_size; ++i) {
+                auto& ring = staging_rings[(start + i) % ring_count];
+                const std::size_t before = batch.size();
+                while (batch.size() < batch_size && ring->queue.dequeue(slot)) {
+                    batch.push_back(std::move(*slot));
+                }
+                if (batch.size() != before) {
+                    run_ends.push_back(batch.size());
+                }
+            }
+
+            // Release rings whose thread has exited and that are fully drained
+            staging_rings.erase(
+                std::remove_if(staging_rings.begin(), staging_rings.end(),
+                               [](const auto& ring) {
+                                   return ring->producer_exited.load(std::memory_order_acquire) &&
+                                          ring->queue.empty();
+                               }),
+                staging_rings.end());
+        }
+
+        if (merge_by_timestamp && run_ends.size() > 1) {
+            merge_runs_by_timestamp(batch, run_ends);
+        }
+    }
+
+    /**
+     * @brief Fan-in drain of the per-CPU rings
+     *
+     * Same round-robin as pop_staged_batch(). A ring interleaves every
+     * thread that ran on its CPU, and a thread that migrates may leave
+     * entries in two rings, so with merge_by_timestamp the batch is stably
+     * sorted by timestamp instead of run-merged.
+     */
+    void pop_cpu_batch(std::vector<queued_record>& batch) {
+        const std::size_t ring_count = cpu_rings.size();
+        batch.reserve(batch_size);
+        const std::size_t start = cpu_cursor++ % ring_count;
+        for (std::size_t i = 0; i < ring_count && batch.size() < batch_size; ++i) {
+            cpu_rings[(start + i) % ring_count]->dequeue_bulk(batch, batch_size - batch.size());
+        }
+
+        if (merge_by_timestamp) {
+            std::stable_sort(batch.begin(), batch.end(),
+                             [](const queued_record& a, const queued_record& b) {
+                                 return a.timestamp() < b.timestamp();
+                             });
+        }
+    }
+
+    /**
+     * @brief Stable k-way merge of consecutive per-thread runs by timestamp
+     *
+     * Each run is consumed strictly front to back, so per-thread order is
+     * preserved even if a thread's timestamps are not monotonic.
+     */
+    static void merge_runs_by_timestamp(std::vector<queued_record>& batch,
+                                        const std::vector<std::size_t>& run_ends) {
+        std::vector<std::size_t> heads;
+        heads.reserve(run_ends.size());
+        heads.push_back(0);
+        for (std::size_t r = 0; r + 1 < run_ends.size(); ++r) {
+            heads.push_back(run_ends[r]);
+        }
+
+        std::vector<queued_record> merged;
+        merged.reserve(batch.size());
+        while (merged.size() < batch.size()) {
+            std::size_t best = run_ends.size();
+            for (std::size_t r = 0; r < run_ends.size(); ++r) {
+                if (heads[r] == run_ends[r]) {
+                    continue;
+                }
+                if (best == run_ends.size() ||
+                    batch[heads[r]].timestamp() < batch[heads[best]].timestamp()) {
+                    best = r;
+                }
+            }
+            merged.push_back(std::move(batch[heads[best]++]));
+        }
+        batch.swap(merged);
+    }
 };
 
 /**
@@ -109,6 +634,7 @@ public:
 
         // Wake up the worker in case it's waiting
         if (state_) {
+            { std::lock_guard<std::mutex> lock(state_->queue_mutex); }
             state_->queue_cv.notify_all();
         }
 
@@ -134,15 +660,34 @@ private:
             return;
         }
 
-        while (!stop_token.stop_requested()) {
-            std::vector<log_entry> batch;
+        // Reused across iterations so steady-state batches do not allocate
+        std::vector<queued_record> batch;
+        batch_context context;
 
-            {
+        while (!stop_token.stop_requested()) {
+            batch.clear();
+
+            if (state->bypasses_queue_mutex()) {
+                // Producers never touch queue_mutex; drain without locking
+                state->worker_busy.store(true, std::memory_order_seq_cst);
+                state->pop_batch(batch);
+                if (batch.empty()) {
+                    state->worker_busy.store(false, std::memory_order_release);
+                    std::unique_lock<std::mutex> lock(state->queue_mutex);
+                    state->worker_waiting.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    state->queue_cv.wait(lock, stop_token, [&state]() {
+                        return state->has_pending();
+                    });
+                    state->worker_waiting.store(false, std::memory_order_relaxed);
+                    continue;
+                }
+            } else {
                 std::unique_lock<std::mutex> lock(state->queue_mutex);
 
                 // Wait for work or stop signal using condition_variable_any
                 bool has_work = state->queue_cv.wait(lock, stop_token, [&state]() {
-                    return !state->queue.empty();
+                    return state->has_pending();
                 });
 
                 // Check if stop was requested
@@ -151,22 +696,25 @@ private:
                 }
 
                 // Check if we actually have work
-                if (!has_work || state->queue.empty()) {
+                if (!has_work || !state->has_pending()) {
                     continue;
                 }
 
                 // Extract batch from queue
-                batch.reserve(std::min(state->batch_size, state->queue.size()));
-                while (!state->queue.empty() && batch.size() < state->batch_size) {
-                    batch.push_back(std::move(state->queue.front()));
-                    state->queue.pop();
-                }
+                state->pop_batch(batch);
+                state->worker_busy.store(true, std::memory_order_relaxed);
             }
 
             // Process batch outside the lock
-            for (const auto& entry : batch) {
-                write_to_all(state, entry);
+            state->release_blocked_producers();
+            {
+                batch_context::scope active(context);
+                write_batch_to_all(state, batch);
             }
+            context.reset();
+            state->release_batch(batch);
+            batch.clear();  // Release heap payloads before going idle
+            state->worker_busy.store(false, std::memory_order_release);
         }
     }
 #else
@@ -176,15 +724,34 @@ private:
             return;
         }
 
-        while (!stop.stop_requested()) {
-            std::vector<log_entry> batch;
+        // Reused across iterations so steady-state batches do not allocate
+        std::vector<queued_record> batch;
+        batch_context context;
 
-            {
+        while (!stop.stop_requested()) {
+            batch.clear();
+
+            if (state->bypasses_queue_mutex()) {
+                // Producers never touch queue_mutex; drain without locking
+                state->worker_busy.store(true, std::memory_order_seq_cst);
+                state->pop_batch(batch);
+                if (batch.empty()) {
+                    state->worker_busy.store(false, std::memory_order_release);
+                    std::unique_lock<std::mutex> lock(state->queue_mutex);
+                    state->worker_waiting.store(true, std::memory_order_relaxed);
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    state->queue_cv.wait(lock, [&state, &stop]() {
+                        return stop.stop_requested() || state->has_pending();
+                    });
+                    state->worker_waiting.store(false, std::memory_order_relaxed);
+                    continue;
+                }
+            } else {
                 std::unique_lock<std::mutex> lock(state->queue_mutex);
 
                 // Wait for work or stop signal
                 state->queue_cv.wait(lock, [&state, &stop]() {
-                    return stop.stop_requested() || !state->queue.empty();
+                    return stop.stop_requested() || state->has_pending();
                 });
 
                 // Check if stop was requested
@@ -193,48 +760,77 @@ private:
                 }
 
                 // Check if we actually have work
-                if (state->queue.empty()) {
+                if (!state->has_pending()) {
                     continue;
                 }
 
                 // Extract batch from queue
-                batch.reserve(std::min(state->batch_size, state->queue.size()));
-                while (!state->queue.empty() && batch.size() < state->batch_size) {
-                    batch.push_back(std::move(state->queue.front()));
-                    state->queue.pop();
-                }
+                state->pop_batch(batch);
+                state->worker_busy.store(true, std::memory_order_relaxed);
             }
 
             // Process batch outside the lock
-            for (const auto& entry : batch) {
-                write_to_all(state, entry);
+            state->release_blocked_producers();
+            {
+                batch_context::scope active(context);
+                write_batch_to_all(state, batch);
             }
+            context.reset();
+            state->release_batch(batch);
+            batch.clear();  // Release heap payloads before going idle
+            state->worker_busy.store(false, std::memory_order_release);
         }
     }
 #endif
 
-    static void write_to_all(const std::shared_ptr<log_collector_shared_state>& state,
-                            const log_entry& entry) {
-        if (!state) {
+public:
+    /**
+     * @brief Convert a drained batch and hand it to every writer
+     * @note Also used by impl::drain_queue() during stop()
+     */
+    static void write_batch_to_all(const std::shared_ptr<log_collector_shared_state>& state,
+                                   const std::vector<queued_record>& batch) {
+        if (!state || batch.empty()) {
             return;
         }
 
-        // Snapshot writers under lock
-        std::vector<std::shared_ptr<log_writer_interface>> writers_snapshot;
-        {
-            std::lock_guard<std::mutex> lock(state->writers_mutex);
-            writers_snapshot.reserve(state->writers.size());
-            for (auto& weak_writer : state->writers) {
-                if (auto writer = weak_writer.lock()) {
-                    writers_snapshot.push_back(writer);
+        // Writers still see full log_entry objects; build them only here
+        async::epoch_guard guard;
+        if (state->uses_lanes()) {
+            // Converted once, shared read-only by every lane; outlives the batch
+            // arena and keeps the records' budget until the last lane drops it
+            auto entries = std::make_unique<std::vector<log_entry>>();
+            entries->reserve(batch.size());
+            for (const auto& item : batch) {
+                entries->push_back(item.to_log_entry());
+            }
+            budget_consumer* budget = &state->budget;
+            const std::size_t bytes = log_collector_shared_state::batch_bytes(batch);
+            async::dispatch_lane::batch_ptr shared(
+                entries.release(), [budget, bytes](const std::vector<log_entry>* posted) {
+                    delete posted;
+                    budget->release(bytes);
+                });
+            const auto& lists = *state->lane_writers.load();
+            for (std::size_t i = 0; i < lists.size(); ++i) {
+                if (!lists[i]->empty()) {
+                    state->lanes[i]->post(shared, lists[i]);
                 }
             }
+            return;
+        }
+
+        // Released wholesale by the caller's batch_context
+        std::pmr::vector<log_entry> entries(batch_context::current_resource());
+        entries.reserve(batch.size());
+        for (const auto& item : batch) {
+            entries.push_back(item.to_log_entry());
         }
 
-        // Write to all writers without holding mutex
-        for (auto& writer : writers_snapshot) {
+        // One read-side critical section and one call per writer per batch
+        for (const auto& writer : *state->writers.load()) {
             try {
-                writer->write(entry);
+                writer->write_batch(entries);
             } catch (...) {
                 // Swallow exceptions to prevent thread termination
             }
@@ -249,8 +845,16 @@ private:
 
 class log_collector::impl {
 public:
-    explicit impl(std::size_t buffer_size, std::size_t batch_size)
-        : state_(std::make_shared<log_collector_shared_state>(buffer_size, batch_size))
+    explicit impl(std::size_t buffer_size, std::size_t batch_size,
+                  collector_queue_kind kind = collector_queue_kind::mutex,
+                  bool merge_by_timestamp = false,
+                  logger_config::overflow_policy policy = logger_config::overflow_policy::drop_newest,
+                  std::chrono::milliseconds max_block = std::chrono::milliseconds{100},
+                  std::size_t lane_count = 1,
+                  async::ring_memory_options ring_memory = {})
+        : state_(std::make_shared<log_collector_shared_state>(buffer_size, batch_size, kind,
+                                                              merge_by_timestamp, policy, max_block,
+                                                              lane_count, ring_memory))
         , worker_(std::make_unique<log_collector_jthread_worker>(state_)) {
     }
 
@@ -259,57 +863,87 @@ public:
     }
 
     bool enqueue(log_level level,
-                 const std::string& message,
-                 const std::string& file,
+                 std::string_view message,
+                 std::string_view file,
                  int line,
-                 const std::string& function,
+                 std::string_view function,
                  const std::chrono::system_clock::time_point& timestamp) {
-        {
-            std::lock_guard<std::mutex> lock(state_->queue_mutex);
-
-            // Check if queue is full
-            if (state_->queue.size() >= state_->buffer_size) {
-                // Track dropped message
-                std::uint64_t dropped = dropped_messages_.fetch_add(1, std::memory_order_relaxed) + 1;
-
-                // Log warning periodically (every 100 dropped messages) to avoid spam
-                if (dropped % 100 == 1) {
-                    std::fprintf(stderr, "[WARNING] Log queue full: %llu messages dropped total\n",
-                               static_cast<unsigned long long>(dropped));
-                }
-
-                return false;
-            }
-
-            // Create log_entry with optional source location
-            log_entry entry(level, message, timestamp);
-            if (!file.empty() || line != 0 || !function.empty()) {
-                entry.location = source_location{file, line, function};
-            }
-            state_->queue.push(std::move(entry));
-        }
+        return push(queued_record(level, timestamp, message, file, line, function));
+    }
 
-        // Notify worker thread
-        if (worker_) {
-            worker_->notify_work();
-        }
-        return true;
+    bool enqueue(log_level level,
+                 deferred_message&& message,
+                 const log_site* site,
+                 const std::chrono::system_clock::time_point& timestamp) {
+        // Message text and source location are filled in on the worker thread
+        return push(queued_record(level, timestamp, site, message));
     }
 
     void add_writer(std::shared_ptr<log_writer_interface> writer) {
         if (!writer) {
             return;
         }
-        std::lock_guard<std::mutex> lock(state_->writers_mutex);
-        state_->writers.push_back(writer);
+        if (state_->uses_lanes()) {
+            // Assign to the lane serving the fewest writers
+            state_->lane_writers.update([&writer](auto& lists) {
+                auto target = std::min_element(lists.begin(), lists.end(),
+                                               [](const auto& a, const auto& b) {
+                                                   return a->size() < b->size();
+                                               });
+                auto next = std::make_shared<async::dispatch_lane::writer_list>(**target);
+                next->push_back(writer);
+                *target = std::move(next);
+                return true;
+            });
+        }
+        state_->writers.update([&writer](auto& writers) {
+            writers.push_back(std::move(writer));
+            return true;
+        });
+    }
+
+    bool remove_writer(const std::shared_ptr<log_writer_interface>& writer) {
+        if (state_->uses_lanes()) {
+            state_->lane_writers.update([&writer](auto& lists) {
+                for (auto& list : lists) {
+                    auto it = std::find(list->begin(), list->end(), writer);
+                    if (it != list->end()) {
+                        auto next = std::make_shared<async::dispatch_lane::writer_list>(*list);
+                        next->erase(next->begin() + (it - list->begin()));
+                        list = std::move(next);
+                        return true;
+                    }
+                }
+                return false;
+            });
+        }
+        return state_->writers.update([&writer](auto& writers) {
+            auto it = std::find(writers.begin(), writers.end(), writer);
+            if (it == writers.end()) {
+                return false;
+            }
+            writers.erase(it);
+            return true;
+        });
     }
 
     void clear_writers() {
-        std::lock_guard<std::mutex> lock(state_->writers_mutex);
-        state_->writers.clear();
+        if (state_->uses_lanes()) {
+            state_->lane_writers.update([](auto& lists) {
+                for (auto& list : lists) {
+                    list = std::make_shared<const async::dispatch_lane::writer_list>();
+                }
+                return true;
+            });
+        }
+        state_->writers.update([](auto& writers) {
+            writers.clear();
+            return true;
+        });
     }
 
     void start() {
+        state_->prefault_rings();
         if (worker_) {
             worker_->start();
         }
@@ -323,17 +957,26 @@ public:
 
         // Drain remaining entries
         drain_queue();
+        state_->wait_lanes_idle();
 
         // Flush all writers
         flush_writers();
     }
 
     void flush() {
-        // Wait for queue to be empty
+        // Wait for the queue to be empty and the last popped batch dispatched
         while (true) {
-            {
+            if (state_->bypasses_queue_mutex()) {
+                if (!state_->has_pending()) {
+                    std::atomic_thread_fence(std::memory_order_seq_cst);
+                    if (!state_->worker_busy.load(std::memory_order_acquire)) {
+                        break;
+                    }
+                }
+            } else {
                 std::lock_guard<std::mutex> lock(state_->queue_mutex);
-                if (state_->queue.empty()) {
+                if (!state_->has_pending() &&
+                    !state_->worker_busy.load(std::memory_order_acquire)) {
                     break;
                 }
             }
@@ -341,71 +984,234 @@ public:
             std::this_thread::sleep_for(std::chrono::microseconds(100));
         }
 
+        // Lanes write on their own threads; wait for what was posted to them
+        state_->wait_lanes_idle();
+
         // Flush all writers
         flush_writers();
     }
 
     [[nodiscard]] std::pair<std::size_t, std::size_t> get_queue_metrics() const {
+        if (state_->is_per_thread()) {
+            return state_->staged_metrics();
+        }
+        if (state_->is_per_cpu()) {
+            return state_->cpu_ring_metrics();
+        }
+        if (state_->is_lock_free()) {
+            return {state_->lockfree_queue->size(), state_->lockfree_queue->capacity()};
+        }
         std::lock_guard<std::mutex> lock(state_->queue_mutex);
-        return {state_->queue.size(), state_->buffer_size};
+        return {state_->queue.size(), state_->capacity};
+    }
+
+    [[nodiscard]] std::vector<writer_lane_stats> get_lane_stats() const {
+        std::vector<writer_lane_stats> result;
+        async::epoch_guard guard;
+        const auto& lists = *state_->lane_writers.load();
+        for (std::size_t i = 0; i < state_->lanes.size(); ++i) {
+            const auto lane = state_->lanes[i]->get_stats();
+            writer_lane_stats stats;
+            for (const auto& writer : *lists[i]) {
+                stats.writers.push_back(writer->get_name());
+            }
+            stats.batches_written = lane.batches_written;
+            stats.entries_written = lane.entries_written;
+            stats.entries_dropped = lane.entries_dropped;
+            stats.total_latency = lane.total_latency;
+            stats.max_latency = lane.max_latency;
+            stats.queued_entries = lane.queued_entries;
+            stats.capacity = lane.capacity;
+            result.push_back(std::move(stats));
+        }
+        return result;
+    }
+
+    [[nodiscard]] queue_overflow_stats get_overflow_stats() const {
+        queue_overflow_stats stats;
+        stats.policy = state_->overflow;
+        stats.dropped_newest = state_->dropped_newest.load(std::memory_order_relaxed);
+        stats.evicted_oldest = state_->evicted_oldest.load(std::memory_order_relaxed);
+        stats.blocked_enqueues = state_->blocked_enqueues.load(std::memory_order_relaxed);
+        stats.block_timeouts = state_->block_timeouts.load(std::memory_order_relaxed);
+        stats.blocked_time = std::chrono::nanoseconds(
+            state_->blocked_ns.load(std::memory_order_relaxed));
+        stats.growth_events = state_->growth_events.load(std::memory_order_relaxed);
+        stats.capacity = get_queue_metrics().second;
+        return stats;
     }
 
 private:
-    void drain_queue() {
-        std::queue<log_entry> remaining;
-        {
-            std::lock_guard<std::mutex> lock(state_->queue_mutex);
-            std::swap(remaining, state_->queue);
+    bool push(queued_record&& item) {
+        // Reserve before touching any queue lock; admit() may wait
+        const std::size_t bytes = item.footprint();
+        switch (state_->budget.admit(item.header().level, bytes)) {
+        case budget_decision::dropped:
+            return false;
+        case budget_decision::spill:
+            state_->budget.spill(item.to_log_entry());
+            return true;
+        case budget_decision::admitted:
+        default:
+            break;
         }
 
-        // Process remaining entries
-        while (!remaining.empty()) {
-            auto entry = std::move(remaining.front());
-            remaining.pop();
-            write_to_all(entry);
+        if (!push_admitted(std::move(item))) {
+            state_->budget.release(bytes);
+            return false;
         }
+        return true;
     }
 
-    void flush_writers() {
-        std::vector<std::shared_ptr<log_writer_interface>> writers_snapshot;
-        {
-            std::lock_guard<std::mutex> lock(state_->writers_mutex);
-            writers_snapshot.reserve(state_->writers.size());
-            for (auto& weak_writer : state_->writers) {
-                if (auto writer = weak_writer.lock()) {
-                    writers_snapshot.push_back(writer);
+    bool push_admitted(queued_record&& item) {
+        using policy_t = logger_config::overflow_policy;
+        const policy_t policy = state_->overflow;
+
+        if (state_->is_per_thread()) {
+            // Only this thread writes to its ring; no shared counter is touched
+            auto ring = state_->local_staging_ring();
+            std::optional<queued_record> slot(std::move(item));
+            if (!ring->queue.enqueue(std::move(slot))) {
+                if (policy != policy_t::block || !block_until_pushed([&] {
+                        return ring->queue.enqueue(std::move(slot));
+                    })) {
+                    record_drop();
+                    return false;
                 }
             }
+            state_->wake_parked_worker();
+            return true;
         }
 
-        for (auto& writer : writers_snapshot) {
-            try {
-                writer->flush();
-            } catch (...) {
-                // Swallow exceptions during flush
+        if (state_->is_lock_free() || state_->is_per_cpu()) {
+            // The entry was built outside any critical section; the ring
+            // either accepts it with one CAS or reports full. Per-CPU rings
+            // are only contended by threads that share (or migrate off) a CPU.
+            auto& ring = state_->producer_ring();
+            if (!ring.enqueue(std::move(item))) {
+                const bool pushed =
+                    policy == policy_t::drop_oldest ? push_evicting(ring, item)
+                    : policy == policy_t::block
+                        ? block_until_pushed([&] { return ring.enqueue(std::move(item)); })
+                        : false;
+                if (!pushed) {
+                    record_drop();
+                    return false;
+                }
             }
+            state_->wake_parked_worker();
+            return true;
         }
-    }
 
-    void write_to_all(const log_entry& entry) {
-        // Snapshot writers under lock
-        std::vector<std::shared_ptr<log_writer_interface>> writers_snapshot;
         {
-            std::lock_guard<std::mutex> lock(state_->writers_mutex);
-            writers_snapshot.reserve(state_->writers.size());
-            for (auto& weak_writer : state_->writers) {
-                if (auto writer = weak_writer.lock()) {
-                    writers_snapshot.push_back(writer);
+            std::unique_lock<std::mutex> lock(state_->queue_mutex);
+
+            if (state_->queue.size() >= state_->capacity) {
+                switch (policy) {
+                case policy_t::drop_oldest:
+                    state_->budget.release(state_->queue.front().footprint());
+                    state_->queue.pop();
+                    state_->evicted_oldest.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                case policy_t::grow:
+                    state_->capacity *= 2;
+                    state_->growth_events.fetch_add(1, std::memory_order_relaxed);
+                    break;
+                case policy_t::block:
+                    // The worker drains without our help; make sure it is awake
+                    state_->queue_cv.notify_one();
+                    if (!state_->wait_for_space(lock, [this] {
+                            return state_->queue.size() < state_->capacity;
+                        })) {
+                        lock.unlock();
+                        record_drop();
+                        return false;
+                    }
+                    break;
+                case policy_t::drop_newest:
+                default:
+                    lock.unlock();
+                    record_drop();
+                    return false;
                 }
             }
+
+            state_->queue.push(std::move(item));
+        }
+
+        // Notify worker thread
+        if (worker_) {
+            worker_->notify_work();
+        }
+        return true;
+    }
+
+    /**
+     * @brief drop_oldest on an MPMC ring: evict from the consumer end and retry
+     *
+     * Other producers may take the freed slot first, so a few rounds are
+     * attempted before the new entry is dropped.
+     */
+    bool push_evicting(async::lockfree_mpmc_queue<queued_record>& ring, queued_record& item) {
+        constexpr int max_attempts = 8;
+        for (int attempt = 0; attempt < max_attempts; ++attempt) {
+            if (auto evicted = ring.try_dequeue()) {
+                state_->budget.release(evicted->footprint());
+                state_->evicted_oldest.fetch_add(1, std::memory_order_relaxed);
+            }
+            if (ring.enqueue(std::move(item))) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief block on a lock-free queue: park on space_cv until try_push succeeds
+     */
+    template<typename TryPush>
+    bool block_until_pushed(TryPush&& try_push) {
+        // A full ring means the worker has work; wake it in case it is parked
+        state_->wake_parked_worker();
+        std::unique_lock<std::mutex> lock(state_->queue_mutex);
+        return state_->wait_for_space(lock, std::forward<TryPush>(try_push));
+    }
+
+    void record_drop() {
+        // Track dropped message
+        std::uint64_t dropped = state_->dropped_newest.fetch_add(1, std::memory_order_relaxed) + 1;
+
+        // Log warning periodically (every 100 dropped messages) to avoid spam
+        if (dropped % 100 == 1) {
+            std::fprintf(stderr, "[WARNING] Log queue full: %llu messages dropped total\n",
+                       static_cast<unsigned long long>(dropped));
         }
+    }
+
+    void drain_queue() {
+        // Process remaining entries batch by batch
+        std::vector<queued_record> batch;
+        do {
+            batch.clear();
+            if (state_->bypasses_queue_mutex()) {
+                state_->pop_batch(batch);
+            } else {
+                std::lock_guard<std::mutex> lock(state_->queue_mutex);
+                state_->pop_batch(batch);
+            }
+            state_->release_blocked_producers();
+            log_collector_jthread_worker::write_batch_to_all(state_, batch);
+            state_->release_batch(batch);
+        } while (!batch.empty());
+    }
 
-        // Write to all writers without holding mutex
-        for (auto& writer : writers_snapshot) {
+    void flush_writers() {
+        async::epoch_guard guard;
+        for (const auto& writer : *state_->writers.load()) {
             try {
-                writer->write(entry);
+                writer->flush();
             } catch (...) {
-                // Swallow exceptions to prevent issues
+                // Swallow exceptions during flush
             }
         }
     }
@@ -413,7 +1219,6 @@ private:
 private:
     std::shared_ptr<log_collector_shared_state> state_;
     std::unique_ptr<log_collector_jthread_worker> worker_;
-    std::atomic<std::uint64_t> dropped_messages_{0};
 };
 
 // log_collector public interface implementation
@@ -422,21 +1227,44 @@ log_collector::log_collector(std::size_t buffer_size, std::size_t batch_size)
     : pimpl_(std::make_unique<impl>(buffer_size, batch_size)) {
 }
 
+log_collector::log_collector(const logger_config& config)
+    : pimpl_(std::make_unique<impl>(config.buffer_size, config.batch_size,
+                                    config.use_per_cpu_buffers        ? collector_queue_kind::per_cpu
+                                    : config.use_thread_local_buffers ? collector_queue_kind::per_thread
+                                    : config.use_lock_free            ? collector_queue_kind::lock_free
+                                                                      : collector_queue_kind::mutex,
+                                    config.merge_by_timestamp, config.queue_overflow_policy,
+                                    config.overflow_block_timeout, config.writer_thread_count,
+                                    async::ring_memory_options{config.queue_huge_pages,
+                                                               config.queue_lock_memory})) {
+}
+
 log_collector::~log_collector() = default;
 
 bool log_collector::enqueue(log_level level,
-                           const std::string& message,
-                           const std::string& file,
+                           std::string_view message,
+                           std::string_view file,
                            int line,
-                           const std::string& function,
+                           std::string_view function,
                            const std::chrono::system_clock::time_point& timestamp) {
     return pimpl_->enqueue(level, message, file, line, function, timestamp);
 }
 
+bool log_collector::enqueue(log_level level,
+                           deferred_message&& message,
+                           const log_site* site,
+                           const std::chrono::system_clock::time_point& timestamp) {
+    return pimpl_->enqueue(level, std::move(message), site, timestamp);
+}
+
 void log_collector::add_writer(std::shared_ptr<log_writer_interface> writer) {
     pimpl_->add_writer(writer);
 }
 
+bool log_collector::remove_writer(const std::shared_ptr<log_writer_interface>& writer) {
+    return pimpl_->remove_writer(writer);
+}
+
 void log_collector::clear_writers() {
     pimpl_->clear_writers();
 }
@@ -457,4 +1285,12 @@ std::pair<std::size_t, std::size_t> log_collector::get_queue_metrics() const {
     return pimpl_->get_queue_metrics();
 }
 
+queue_overflow_stats log_collector::get_overflow_stats() const {
+    return pimpl_->get_overflow_stats();
+}
+
+std::vector<writer_lane_stats> log_collector::get_lane_stats() const {
+    return pimpl_->get_lane_stats();
+}
+
 } // namespace kcenon::logger
@@ -21,6 +21,8 @@
 #include <kcenon/logger/interfaces/log_entry.h>
 #include <kcenon/common/patterns/result.h>
 
+#include "../impl/async/rcu_snapshot.h"
+
 #include <algorithm>
 #include <atomic>
 #include <chrono>
@@ -63,9 +65,19 @@ public:
     bool running_;
     bool metrics_enabled_;
     std::atomic<log_level> min_level_;
-    std::vector<std::shared_ptr<log_writer_interface>> writers_;
-    std::unordered_map<std::string, std::shared_ptr<log_writer_interface>> named_writers_;  // Named writer storage
-    std::shared_mutex writers_mutex_;  // Protects writers_ and named_writers_ from concurrent modification
+
+    /**
+     * @brief Immutable set of registered writers
+     *
+     * Published through writers_: log calls read it inside an epoch_guard
+     * without locking or touching reference counts, and every add/remove
+     * copies the table and publishes the new version.
+     */
+    struct writer_table {
+        std::vector<std::shared_ptr<log_writer_interface>> writers;
+        std::unordered_map<std::string, std::shared_ptr<log_writer_interface>> named;  // Named writer storage
+    };
+    async::rcu_snapshot<writer_table> writers_;
     std::unique_ptr<backends::integration_backend> backend_;  // Integration backend
     std::unique_ptr<log_collector> collector_;  // Async log collector for async mode
     std::unique_ptr<log_filter_interface> filter_;  // Global filter for log entries
@@ -93,12 +105,12 @@ public:
     std::atomic<int> emergency_fd_{-1};  // File descriptor for emergency writes
 
     impl(bool async, std::size_t buffer_size, std::unique_ptr<backends::integration_backend> backend)
-        : async_mode_(async), buffer_size_(buffer_size), running_(false), metrics_enabled_(false),
+        : impl(make_config(async, buffer_size), std::move(backend)) {}
+
+    impl(const logger_config& config, std::unique_ptr<backends::integration_backend> backend)
+        : async_mode_(config.async), buffer_size_(config.buffer_size), running_(false), metrics_enabled_(false),
           min_level_(log_level::info), backend_(std::move(backend)),
           router_(std::make_unique<log_router>()) {
-        // Reserve space to avoid reallocation during typical usage
-        writers_.reserve(10);
-
         // Auto-detect backend if not provided
         // Users can provide thread_system_backend or other backends via constructor
         if (!backend_) {
@@ -112,10 +124,20 @@ public:
 
         // Create log collector for async mode
         if (async_mode_) {
-            collector_ = std::make_unique<log_collector>(buffer_size_);
+            collector_ = std::make_unique<log_collector>(config);
         }
     }
 
+    static logger_config make_config(bool async, std::size_t buffer_size) {
+        // Mirrors the historical (async, buffer_size) behaviour: the collector
+        // keeps its default batch size and the mutex-backed queue
+        logger_config config;
+        config.async = async;
+        config.buffer_size = buffer_size;
+        config.batch_size = 100;
+        return config;
+    }
+
     ~impl() {
         if (backend_) {
             backend_->shutdown();
@@ -131,6 +153,26 @@ public:
      * @param function Source function
      * @param entry Log entry for routing check
      */
+    /**
+     * @brief Whether a call can go straight to the collector without a log_entry
+     *
+     * Filters and samplers inspect a log_entry, so they force one to be built;
+     * without them the async path copies the caller's text into the queue once.
+     */
+    bool can_enqueue_directly() const {
+        if (!async_mode_ || !collector_) {
+            return false;
+        }
+        {
+            std::shared_lock<std::shared_mutex> filter_lock(filter_mutex_);
+            if (filter_) {
+                return false;
+            }
+        }
+        std::shared_lock<std::shared_mutex> sampler_lock(sampler_mutex_);
+        return !(sampler_ && sampler_->is_enabled());
+    }
+
     void dispatch_to_writers(log_level level,
                             const std::string& message,
                             const std::string& file,
@@ -167,22 +209,20 @@ public:
 
         auto now = std::chrono::system_clock::now();
 
+        // Read the current writer table without locking or copying it
+        async::epoch_guard guard;
+        const writer_table& table = *writers_.load();
+
         if (is_exclusive) {
             // Exclusive mode: only send to matched routes
             // If no routes match, message is dropped (exclusive mode behavior)
             if (!routed_writer_names.empty()) {
-                std::unordered_map<std::string, std::shared_ptr<log_writer_interface>> local_named_writers;
-                {
-                    std::shared_lock<std::shared_mutex> lock(writers_mutex_);
-                    local_named_writers = named_writers_;
-                }
-
                 // Create log_entry for routing
                 log_entry entry(level, message, file, line, function, now);
 
                 for (const auto& writer_name : routed_writer_names) {
-                    auto it = local_named_writers.find(writer_name);
-                    if (it != local_named_writers.end() && it->second) {
+                    auto it = table.named.find(writer_name);
+                    if (it != table.named.end() && it->second) {
                         it->second->write(entry);
                     }
                 }
@@ -190,16 +230,10 @@ public:
             // No matched routes in exclusive mode = drop message
         } else {
             // Non-exclusive mode: send to all writers
-            std::vector<std::shared_ptr<log_writer_interface>> local_writers;
-            {
-                std::shared_lock<std::shared_mutex> lock(writers_mutex_);
-                local_writers = writers_;
-            }
-
             // Create log_entry once for all writers
             log_entry entry(level, message, file, line, function, now);
 
-            for (auto& writer : local_writers) {
+            for (const auto& writer : table.writers) {
                 if (writer) {
                     writer->write(entry);
                 }
@@ -213,6 +247,10 @@ logger::logger(bool async, std::size_t buffer_size, std::unique_ptr<backends::in
     // Initialize logger with configuration
 }
 
+logger::logger(const logger_config& config, std::unique_ptr<backends::integration_backend> backend)
+    : pimpl_(std::make_unique<impl>(config, std::move(backend))) {
+}
+
 logger::~logger() {
     if (pimpl_ && pimpl_->running_) {
         stop();
@@ -227,8 +265,8 @@ common::VoidResult logger::start() {
         if (pimpl_->async_mode_ && pimpl_->collector_) {
             // Register all existing writers with the collector
             {
-                std::shared_lock<std::shared_mutex> lock(pimpl_->writers_mutex_);
-                for (const auto& writer : pimpl_->writers_) {
+                async::epoch_guard guard;
+                for (const auto& writer : pimpl_->writers_.load()->writers) {
                     if (writer) {
                         pimpl_->collector_->add_writer(writer);
                     }
@@ -266,10 +304,10 @@ common::VoidResult logger::add_writer(log_writer_ptr writer) {
     if (pimpl_ && writer) {
         std::shared_ptr<log_writer_interface> shared_writer(std::move(writer));
 
-        {
-            std::lock_guard<std::shared_mutex> lock(pimpl_->writers_mutex_);
-            pimpl_->writers_.push_back(shared_writer);
-        }
+        pimpl_->writers_.update([&shared_writer](impl::writer_table& table) {
+            table.writers.push_back(shared_writer);
+            return true;
+        });
 
         // Register with collector if in async mode and running
         if (pimpl_->async_mode_ && pimpl_->collector_ && pimpl_->running_) {
@@ -295,13 +333,13 @@ common::VoidResult logger::add_writer(const std::string& name, log_writer_ptr wr
 
     std::shared_ptr<log_writer_interface> shared_writer(std::move(writer));
 
-    {
-        std::lock_guard<std::shared_mutex> lock(pimpl_->writers_mutex_);
-        pimpl_->writers_.push_back(shared_writer);
+    pimpl_->writers_.update([&name, &shared_writer](impl::writer_table& table) {
+        table.writers.push_back(shared_writer);
         if (!name.empty()) {
-            pimpl_->named_writers_[name] = shared_writer;
+            table.named[name] = shared_writer;
         }
-    }
+        return true;
+    });
 
     // Register with collector if in async mode and running
     if (pimpl_->async_mode_ && pimpl_->collector_ && pimpl_->running_) {
@@ -313,11 +351,11 @@ common::VoidResult logger::add_writer(const std::string& name, log_writer_ptr wr
 
 common::VoidResult logger::clear_writers() {
     if (pimpl_) {
-        {
-            std::lock_guard<std::shared_mutex> lock(pimpl_->writers_mutex_);
-            pimpl_->writers_.clear();
-            pimpl_->named_writers_.clear();
-        }
+        pimpl_->writers_.update([](impl::writer_table& table) {
+            table.writers.clear();
+            table.named.clear();
+            return true;
+        });
 
         // Clear collectors writers if in async mode
         if (pimpl_->async_mode_ && pimpl_->collector_) {
@@ -332,28 +370,31 @@ bool logger::remove_writer(const std::string& name) {
         return false;
     }
 
-    std::lock_guard<std::shared_mutex> lock(pimpl_->writers_mutex_);
+    std::shared_ptr<log_writer_interface> writer_to_remove;
+    const bool removed = pimpl_->writers_.update([&name, &writer_to_remove](impl::writer_table& table) {
+        auto it = table.named.find(name);
+        if (it == table.named.end()) {
+            return false;
+        }
 
-    auto it = pimpl_->named_writers_.find(name);
-    if (it == pimpl_->named_writers_.end()) {
-        return false;
-    }
+        writer_to_remove = it->second;
 
-    auto writer_to_remove = it->second;
+        // Remove from named map
+        table.named.erase(it);
 
-    // Remove from named_writers_ map
-    pimpl_->named_writers_.erase(it);
+        // Remove from writers vector
+        auto vec_it = std::find(table.writers.begin(), table.writers.end(), writer_to_remove);
+        if (vec_it != table.writers.end()) {
+            table.writers.erase(vec_it);
+        }
+        return true;
+    });
 
-    // Remove from writers_ vector
-    auto vec_it = std::find(pimpl_->writers_.begin(), pimpl_->writers_.end(), writer_to_remove);
-    if (vec_it != pimpl_->writers_.end()) {
-        pimpl_->writers_.erase(vec_it);
+    if (removed && pimpl_->async_mode_ && pimpl_->collector_) {
+        pimpl_->collector_->remove_writer(writer_to_remove);
     }
 
-    // Note: Cannot remove from collector's writers list as it doesn't support removal
-    // The writer will be skipped during iteration if it's no longer valid
-
-    return true;
+    return removed;
 }
 
 log_writer_interface* logger::get_writer(const std::string& name) {
@@ -361,10 +402,11 @@ log_writer_interface* logger::get_writer(const std::string& name) {
         return nullptr;
     }
 
-    std::shared_lock<std::shared_mutex> lock(pimpl_->writers_mutex_);
+    async::epoch_guard guard;
+    const auto& named = pimpl_->writers_.load()->named;
 
-    auto it = pimpl_->named_writers_.find(name);
-    if (it != pimpl_->named_writers_.end() && it->second) {
+    auto it = named.find(name);
+    if (it != named.end() && it->second) {
         return it->second.get();
     }
 
@@ -427,6 +469,23 @@ common::VoidResult logger::log(common::interfaces::log_level level,
         return common::ok();
     }
 
+    if (pimpl_->can_enqueue_directly()) {
+        // Record metrics if enabled
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        // The collector copies the views into its queued record; no strings are built
+        auto now = std::chrono::system_clock::now();
+        pimpl_->collector_->enqueue(level, message, loc.file_name(), loc.line(),
+                                    loc.function_name(), now);
+
+        if (pimpl_->metrics_enabled_) {
+            auto end_time = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+            metrics::record_message_logged(duration.count());
+        }
+        return common::ok();
+    }
+
     std::string msg_str(message);
     std::string file_str(loc.file_name());
     int line = loc.line();
@@ -486,6 +545,78 @@ common::VoidResult logger::log(common::interfaces::log_level level,
     return common::ok();
 }
 
+common::VoidResult logger::log_deferred(common::interfaces::log_level level,
+                                        deferred_message&& message,
+                                        const log_site* site) {
+    if (!pimpl_ || !meets_threshold(level, pimpl_->min_level_.load())) {
+        return common::ok();
+    }
+
+    // Filters and samplers inspect the message text, so they force eager formatting
+    const bool needs_text = !pimpl_->can_enqueue_directly();
+
+    // Record metrics if enabled
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    if (!needs_text) {
+        // Only the format pointer, argument bytes and site pointer cross the queue
+        auto now = std::chrono::system_clock::now();
+        pimpl_->collector_->enqueue(level, std::move(message), site, now);
+
+        if (pimpl_->metrics_enabled_) {
+            auto end_time = std::chrono::high_resolution_clock::now();
+            auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+            metrics::record_message_logged(duration.count());
+        }
+        return common::ok();
+    }
+
+    std::string msg_str = message.render();
+    std::string file_str(site ? site->file : "");
+    int line = site ? site->line : 0;
+    std::string func_str(site ? site->function : "");
+
+    // Create log entry for filtering and routing
+    log_entry entry(level, msg_str, file_str, line, func_str);
+
+    // Apply filter if set
+    {
+        std::shared_lock<std::shared_mutex> filter_lock(pimpl_->filter_mutex_);
+        if (pimpl_->filter_) {
+            if (!pimpl_->filter_->should_log(entry)) {
+                return common::ok();
+            }
+        }
+    }
+
+    // Apply sampling if set
+    {
+        std::shared_lock<std::shared_mutex> sampler_lock(pimpl_->sampler_mutex_);
+        if (pimpl_->sampler_ && pimpl_->sampler_->is_enabled()) {
+            if (!pimpl_->sampler_->should_sample(entry)) {
+                return common::ok();
+            }
+        }
+    }
+
+    if (pimpl_->async_mode_ && pimpl_->collector_) {
+        auto now = std::chrono::system_clock::now();
+        pimpl_->collector_->enqueue(level, msg_str, file_str, line, func_str, now);
+    } else {
+        // Synchronous path: dispatch with routing support
+        pimpl_->dispatch_to_writers(level, msg_str, file_str, line, func_str, entry);
+    }
+
+    // Update metrics after logging
+    if (pimpl_->metrics_enabled_) {
+        auto end_time = std::chrono::high_resolution_clock::now();
+        auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end_time - start_time);
+        metrics::record_message_logged(duration.count());
+    }
+
+    return common::ok();
+}
+
 common::VoidResult logger::log(const common::interfaces::log_entry& entry) {
     if (!pimpl_ || !meets_threshold(entry.level, pimpl_->min_level_.load())) {
         return common::ok();
@@ -584,13 +715,8 @@ common::VoidResult logger::flush() {
         pimpl_->collector_->flush();
     } else {
         // Synchronous mode: manually flush writers
-        std::vector<std::shared_ptr<log_writer_interface>> local_writers;
-        {
-            std::shared_lock<std::shared_mutex> lock(pimpl_->writers_mutex_);
-            local_writers = pimpl_->writers_;
-        }
-
-        for (auto& writer : local_writers) {
+        async::epoch_guard guard;
+        for (const auto& writer : pimpl_->writers_.load()->writers) {
             if (writer) {
                 writer->flush();
             }
@@ -635,6 +761,15 @@ result<logger_metrics> logger::get_current_metrics() const {
     return result<logger_metrics>::ok_value(metrics::g_logger_stats);
 }
 
+result<queue_overflow_stats> logger::get_queue_overflow_stats() const {
+    if (!pimpl_ || !pimpl_->async_mode_ || !pimpl_->collector_) {
+        return result<queue_overflow_stats>{
+            logger_error_code::invalid_argument,
+            "Overflow statistics are only available in async mode"};
+    }
+    return result<queue_overflow_stats>::ok_value(pimpl_->collector_->get_overflow_stats());
+}
+
 // Emergency flush support implementation (critical_logger_interface)
 
 int logger::get_emergency_fd() const {
@@ -0,0 +1,439 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file memory_budget.cpp
+ * @brief Process-wide byte budget implementation
+ * @since 4.1.0
+ */
+
+#include <kcenon/logger/core/memory_budget.h>
+#include <kcenon/logger/utils/string_utils.h>
+#include <kcenon/logger/utils/time_utils.h>
+#include "../impl/async/cpu_index.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <variant>
+
+namespace kcenon::logger {
+
+namespace {
+
+void raise_peak(std::atomic<std::size_t>& peak, std::size_t value) noexcept {
+    std::size_t current = peak.load(std::memory_order_relaxed);
+    while (value > current &&
+           !peak.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+struct budget_consumer::state {
+    /**
+     * @brief Counters updated by the threads running on one CPU
+     *
+     * A thread admits and releases through the shard of its current CPU, so
+     * producers on different cores never write the same cache line. Bytes
+     * are often released on another CPU than the one that admitted them, so
+     * a shard's held count may go negative; only the sum is meaningful.
+     */
+    struct alignas(64) shard {
+        std::atomic<std::int64_t> held{0};
+        std::atomic<std::uint64_t> admitted{0};
+    };
+
+    /// CPUs beyond this share shards
+    static constexpr std::size_t max_shards = 64;
+
+    explicit state(std::string consumer_name) noexcept
+        : name(std::move(consumer_name))
+        , shard_count(std::min(async::cpu_slot_count(), max_shards)) {}
+
+    shard& local_shard() noexcept {
+        return shards[async::current_cpu() % shard_count];
+    }
+
+    /**
+     * @brief Sum of the shards
+     *
+     * The shards are read one by one, so a release can be seen without the
+     * admission it pairs with; a negative sum is reported as zero.
+     */
+    [[nodiscard]] std::size_t held() const noexcept {
+        std::int64_t total = 0;
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            total += shards[i].held.load(std::memory_order_relaxed);
+        }
+        return total > 0 ? static_cast<std::size_t>(total) : 0;
+    }
+
+    [[nodiscard]] std::uint64_t admitted() const noexcept {
+        std::uint64_t total = 0;
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            total += shards[i].admitted.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    /**
+     * @brief Raise peak to the bytes held now and return them
+     *
+     * Held bytes only grow between releases, so sampling before each
+     * release (and when stats are read) catches every high-water mark
+     * without producers touching a shared counter.
+     */
+    std::size_t sample_peak() noexcept {
+        const std::size_t current = held();
+        raise_peak(peak, current);
+        return current;
+    }
+
+    void clear() noexcept {
+        for (std::size_t i = 0; i < shard_count; ++i) {
+            shards[i].held.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    const std::string name;
+    const std::size_t shard_count;
+    std::array<shard, max_shards> shards;
+    std::atomic<std::size_t> charged{0};  ///< Part of held reserved in the global counter
+    std::atomic<std::size_t> peak{0};
+    std::atomic<std::uint64_t> dropped{0};
+    std::atomic<std::uint64_t> blocked{0};
+    std::atomic<std::uint64_t> spilled{0};
+};
+
+class memory_budget::impl {
+public:
+    /**
+     * @brief Reserve bytes if used + bytes stays within cap
+     */
+    bool try_reserve(std::size_t bytes, std::size_t cap) noexcept {
+        std::size_t current = used.load(std::memory_order_relaxed);
+        do {
+            if (current + bytes > cap) {
+                return false;
+            }
+        } while (!used.compare_exchange_weak(current, current + bytes, std::memory_order_relaxed));
+        raise_peak(peak, current + bytes);
+        return true;
+    }
+
+    void release(std::size_t bytes) noexcept {
+        used.fetch_sub(bytes, std::memory_order_relaxed);
+        // Pairs with the fence in admit(): either this sees the waiter or
+        // the waiter's predicate sees the freed bytes
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters.load(std::memory_order_relaxed) != 0) {
+            std::lock_guard<std::mutex> lock(wait_mutex);
+            space_cv.notify_all();
+        }
+    }
+
+    std::atomic<std::size_t> used{0};
+    std::atomic<std::size_t> peak{0};
+    std::atomic<std::size_t> limit{0};
+    std::atomic<budget_policy> policy{budget_policy::drop_by_level};
+    std::atomic<std::int64_t> block_timeout_ms{100};
+
+    std::atomic<int> waiters{0};
+    std::mutex wait_mutex;
+    std::condition_variable space_cv;
+
+    std::mutex config_mutex;  ///< Guards spill_path and spill_file
+    std::string spill_path;
+    std::FILE* spill_file = nullptr;
+
+    mutable std::mutex consumers_mutex;
+    std::vector<std::weak_ptr<budget_consumer::state>> consumers;
+};
+
+memory_budget::memory_budget() : pimpl_(std::make_unique<impl>()) {}
+
+memory_budget::~memory_budget() = default;
+
+memory_budget& memory_budget::instance() {
+    // Leaked on purpose: consumers may be destroyed during static destruction
+    static auto* budget = new memory_budget();
+    return *budget;
+}
+
+void memory_budget::configure(const config& cfg) {
+    pimpl_->limit.store(cfg.limit_bytes, std::memory_order_relaxed);
+    pimpl_->policy.store(cfg.policy, std::memory_order_relaxed);
+    pimpl_->block_timeout_ms.store(cfg.block_timeout.count(), std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(pimpl_->config_mutex);
+    if (cfg.spill_path != pimpl_->spill_path) {
+        if (pimpl_->spill_file) {
+            std::fclose(pimpl_->spill_file);
+            pimpl_->spill_file = nullptr;
+        }
+        pimpl_->spill_path = cfg.spill_path;
+    }
+
+    // A raised limit may admit blocked producers
+    std::lock_guard<std::mutex> wait_lock(pimpl_->wait_mutex);
+    pimpl_->space_cv.notify_all();
+}
+
+memory_budget::config memory_budget::get_config() const {
+    config cfg;
+    cfg.limit_bytes = pimpl_->limit.load(std::memory_order_relaxed);
+    cfg.policy = pimpl_->policy.load(std::memory_order_relaxed);
+    cfg.block_timeout = std::chrono::milliseconds(
+        pimpl_->block_timeout_ms.load(std::memory_order_relaxed));
+    std::lock_guard<std::mutex> lock(pimpl_->config_mutex);
+    cfg.spill_path = pimpl_->spill_path;
+    return cfg;
+}
+
+std::size_t memory_budget::used_bytes() const noexcept {
+    if (pimpl_->limit.load(std::memory_order_relaxed) != 0) {
+        return pimpl_->used.load(std::memory_order_relaxed);
+    }
+
+    // Without a limit nothing is reserved globally; sum the consumers
+    std::size_t total = 0;
+    std::lock_guard<std::mutex> lock(pimpl_->consumers_mutex);
+    for (const auto& weak : pimpl_->consumers) {
+        if (auto consumer = weak.lock()) {
+            total += consumer->held();
+        }
+    }
+    return total;
+}
+
+std::size_t memory_budget::peak_bytes() const noexcept {
+    return pimpl_->peak.load(std::memory_order_relaxed);
+}
+
+std::vector<budget_consumer_stats> memory_budget::get_consumer_stats() const {
+    std::vector<std::shared_ptr<budget_consumer::state>> live;
+    {
+        std::lock_guard<std::mutex> lock(pimpl_->consumers_mutex);
+        for (const auto& weak : pimpl_->consumers) {
+            if (auto consumer = weak.lock()) {
+                live.push_back(std::move(consumer));
+            }
+        }
+    }
+
+    std::vector<budget_consumer_stats> result;
+    result.reserve(live.size());
+    for (const auto& s : live) {
+        budget_consumer_stats stats;
+        stats.name = s->name;
+        stats.held_bytes = s->sample_peak();
+        stats.peak_bytes = s->peak.load(std::memory_order_relaxed);
+        stats.admitted = s->admitted();
+        stats.dropped = s->dropped.load(std::memory_order_relaxed);
+        stats.blocked = s->blocked.load(std::memory_order_relaxed);
+        stats.spilled = s->spilled.load(std::memory_order_relaxed);
+        result.push_back(std::move(stats));
+    }
+    return result;
+}
+
+std::size_t memory_budget::level_share_percent(log_level level) noexcept {
+    switch (level) {
+        case log_level::trace:    return 50;
+        case log_level::debug:    return 60;
+        case log_level::info:     return 75;
+        case log_level::warning:  return 85;
+        case log_level::error:    return 95;
+        case log_level::critical:
+        case log_level::off:
+        default:                  return 100;
+    }
+}
+
+budget_consumer::budget_consumer(std::string name)
+    : state_(std::make_shared<state>(std::move(name))) {
+    auto& budget = *memory_budget::instance().pimpl_;
+    std::lock_guard<std::mutex> lock(budget.consumers_mutex);
+    // Prune consumers that have gone away since the last registration
+    budget.consumers.erase(std::remove_if(budget.consumers.begin(), budget.consumers.end(),
+                                          [](const auto& weak) { return weak.expired(); }),
+                           budget.consumers.end());
+    budget.consumers.push_back(state_);
+}
+
+budget_consumer::~budget_consumer() {
+    state_->clear();
+    const std::size_t charged = state_->charged.exchange(0, std::memory_order_relaxed);
+    if (charged != 0) {
+        memory_budget::instance().pimpl_->release(charged);
+    }
+}
+
+bool budget_consumer::try_admit(log_level level, std::size_t bytes) noexcept {
+    auto& budget = *memory_budget::instance().pimpl_;
+    const std::size_t limit = budget.limit.load(std::memory_order_relaxed);
+
+    // Without a limit only this consumer's per-CPU counters are touched;
+    // with one, every producer reserves in the shared global counter
+    if (limit != 0) {
+        const std::size_t cap =
+            budget.policy.load(std::memory_order_relaxed) == budget_policy::drop_by_level
+                ? limit / 100 * memory_budget::level_share_percent(level)
+                : limit;
+        if (!budget.try_reserve(bytes, cap)) {
+            return false;
+        }
+        state_->charged.fetch_add(bytes, std::memory_order_relaxed);
+    }
+
+    auto& own = state_->local_shard();
+    own.held.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+    own.admitted.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+budget_decision budget_consumer::admit(log_level level, std::size_t bytes) {
+    if (try_admit(level, bytes)) {
+        return budget_decision::admitted;
+    }
+
+    auto& budget = *memory_budget::instance().pimpl_;
+    const budget_policy policy = budget.policy.load(std::memory_order_relaxed);
+    bool reserved = false;
+    if (policy == budget_policy::block) {
+        state_->blocked.fetch_add(1, std::memory_order_relaxed);
+        const auto deadline = std::chrono::steady_clock::now() +
+            std::chrono::milliseconds(budget.block_timeout_ms.load(std::memory_order_relaxed));
+        budget.waiters.fetch_add(1, std::memory_order_relaxed);
+        // Pairs with the fence in impl::release()
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(budget.wait_mutex);
+            reserved = budget.space_cv.wait_until(lock, deadline, [&] {
+                const std::size_t limit = budget.limit.load(std::memory_order_relaxed);
+                if (limit == 0) {
+                    // The limit was lifted while waiting
+                    return true;
+                }
+                if (!budget.try_reserve(bytes, limit)) {
+                    return false;
+                }
+                state_->charged.fetch_add(bytes, std::memory_order_relaxed);
+                return true;
+            });
+        }
+        budget.waiters.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    if (reserved) {
+        auto& own = state_->local_shard();
+        own.held.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+        own.admitted.fetch_add(1, std::memory_order_relaxed);
+        return budget_decision::admitted;
+    }
+
+    if (policy == budget_policy::spill) {
+        std::lock_guard<std::mutex> lock(budget.config_mutex);
+        if (!budget.spill_path.empty()) {
+            return budget_decision::spill;
+        }
+    }
+    state_->dropped.fetch_add(1, std::memory_order_relaxed);
+    return budget_decision::dropped;
+}
+
+void budget_consumer::release(std::size_t bytes) noexcept {
+    if (bytes == 0) {
+        return;
+    }
+    state_->sample_peak();
+    state_->local_shard().held.fetch_sub(static_cast<std::int64_t>(bytes),
+                                         std::memory_order_relaxed);
+
+    // Return to the global counter only what was reserved there; bytes
+    // admitted while no limit was set never were
+    std::size_t charged = state_->charged.load(std::memory_order_relaxed);
+    std::size_t returned = 0;
+    while (charged != 0) {
+        returned = std::min(bytes, charged);
+        if (state_->charged.compare_exchange_weak(charged, charged - returned,
+                                                  std::memory_order_relaxed)) {
+            break;
+        }
+        returned = 0;
+    }
+    if (returned != 0) {
+        memory_budget::instance().pimpl_->release(returned);
+    }
+}
+
+void budget_consumer::spill(const log_entry& entry) {
+    spill(entry.level, entry.timestamp, std::string_view(entry.message));
+}
+
+void budget_consumer::spill(log_level level,
+                            std::chrono::system_clock::time_point timestamp,
+                            std::string_view message) {
+    auto& budget = *memory_budget::instance().pimpl_;
+    char stamp[utils::time_utils::timestamp_buffer_size];
+    const std::size_t stamp_length = utils::time_utils::write_timestamp(timestamp, stamp);
+    const std::string level_text = utils::string_utils::level_to_string(level);
+
+    std::lock_guard<std::mutex> lock(budget.config_mutex);
+    if (!budget.spill_file && !budget.spill_path.empty()) {
+        budget.spill_file = std::fopen(budget.spill_path.c_str(), "ab");
+    }
+    if (!budget.spill_file) {
+        state_->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    std::fprintf(budget.spill_file, "[%.*s] [%s] %.*s\n", static_cast<int>(stamp_length), stamp,
+                 level_text.c_str(), static_cast<int>(message.size()), message.data());
+    std::fflush(budget.spill_file);
+    state_->spilled.fetch_add(1, std::memory_order_relaxed);
+}
+
+std::size_t budget_consumer::held_bytes() const noexcept {
+    return state_->held();
+}
+
+budget_consumer_stats budget_consumer::get_stats() const {
+    budget_consumer_stats stats;
+    stats.name = state_->name;
+    stats.held_bytes = state_->sample_peak();
+    stats.peak_bytes = state_->peak.load(std::memory_order_relaxed);
+    stats.admitted = state_->admitted();
+    stats.dropped = state_->dropped.load(std::memory_order_relaxed);
+    stats.blocked = state_->blocked.load(std::memory_order_relaxed);
+    stats.spilled = state_->spilled.load(std::memory_order_relaxed);
+    return stats;
+}
+
+std::size_t budget_consumer::entry_bytes(const log_entry& entry) noexcept {
+    // Approximate per-node overhead of an unordered_map entry
+    constexpr std::size_t field_node_bytes = 64;
+
+    std::size_t bytes = sizeof(log_entry);
+    if (!entry.message.is_small()) {
+        bytes += entry.message.capacity() + 1;
+    }
+    if (entry.thread_id && !entry.thread_id->is_small()) {
+        bytes += entry.thread_id->capacity() + 1;
+    }
+    if (entry.fields) {
+        for (const auto& [key, value] : *entry.fields) {
+            bytes += field_node_bytes + key.size();
+            if (const auto* text = std::get_if<std::string>(&value)) {
+                bytes += text->size();
+            }
+        }
+    }
+    return bytes;
+}
+
+} // namespace kcenon::logger
@@ -0,0 +1,232 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file string_pool.cpp
+ * @brief Size-class string buffer pool implementation
+ * @since 4.1.0
+ */
+
+#include <kcenon/logger/core/string_pool.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace kcenon::logger {
+
+namespace {
+
+// Two classes per power of two (2^k and 1.5 * 2^k), from 64 B to 128 KiB, so
+// a block wastes at most a third of its size
+constexpr std::size_t min_class_size = 64;
+constexpr std::size_t class_count = 23;
+
+/// Per-thread cache budget per class
+constexpr std::size_t thread_cache_bytes = 64 * 1024;
+constexpr std::size_t max_thread_blocks = 64;
+
+/// Shared depot budget per class
+constexpr std::size_t depot_bytes_per_class = 1024 * 1024;
+
+constexpr std::size_t class_index(std::size_t bytes) noexcept {
+    if (bytes <= min_class_size) {
+        return 0;
+    }
+    const std::size_t power = std::bit_width(bytes - 1);  // 2^power >= bytes
+    const bool fits_midpoint = bytes <= (std::size_t{3} << (power - 2));
+    return 2 * (power - 6) - (fits_midpoint ? 1 : 0);
+}
+
+constexpr std::size_t class_size(std::size_t index) noexcept {
+    const std::size_t k = (index + 1) / 2;
+    return (index % 2 == 0) ? (min_class_size << k) : (std::size_t{3} << (k + 4));
+}
+
+static_assert(class_size(class_count - 1) == string_pool::max_pooled_size);
+static_assert(class_index(string_pool::max_pooled_size) == class_count - 1);
+static_assert(class_index(96) == 1 && class_index(97) == 2 && class_index(1536) == 9);
+
+constexpr std::size_t thread_limit(std::size_t index) noexcept {
+    return std::clamp<std::size_t>(thread_cache_bytes / class_size(index), 2, max_thread_blocks);
+}
+
+constexpr std::size_t depot_limit(std::size_t index) noexcept {
+    return std::max<std::size_t>(depot_bytes_per_class / class_size(index), 4);
+}
+
+/**
+ * @brief Shared per-class block lists and counters (never destroyed)
+ */
+struct depot {
+    struct bucket {
+        std::mutex mutex;
+        std::vector<void*> blocks;
+    };
+
+    std::array<bucket, class_count> buckets;
+    std::atomic<std::uint64_t> fresh{0};
+    std::atomic<std::uint64_t> released{0};
+    std::atomic<std::uint64_t> oversize{0};
+    std::atomic<std::size_t> parked_bytes{0};
+
+    static depot& instance() {
+        static auto* shared = new depot();
+        return *shared;
+    }
+
+    /// Move up to count blocks into out; returns the number moved
+    std::size_t take(std::size_t index, void** out, std::size_t count) {
+        auto& b = buckets[index];
+        std::lock_guard<std::mutex> lock(b.mutex);
+        const std::size_t moved = std::min(count, b.blocks.size());
+        std::copy(b.blocks.end() - static_cast<std::ptrdiff_t>(moved), b.blocks.end(), out);
+        b.blocks.resize(b.blocks.size() - moved);
+        parked_bytes.fetch_sub(moved * class_size(index), std::memory_order_relaxed);
+        return moved;
+    }
+
+    /// Park blocks, returning the ones that do not fit to the heap
+    void give(std::size_t index, void* const* blocks, std::size_t count) noexcept {
+        auto& b = buckets[index];
+        std::size_t kept = 0;
+        {
+            std::lock_guard<std::mutex> lock(b.mutex);
+            const std::size_t room = depot_limit(index) - std::min(depot_limit(index), b.blocks.size());
+            kept = std::min(room, count);
+            try {
+                b.blocks.insert(b.blocks.end(), blocks, blocks + kept);
+            } catch (...) {
+                kept = 0;
+            }
+        }
+        parked_bytes.fetch_add(kept * class_size(index), std::memory_order_relaxed);
+        for (std::size_t i = kept; i < count; ++i) {
+            ::operator delete(blocks[i]);
+        }
+        if (count > kept) {
+            released.fetch_add(count - kept, std::memory_order_relaxed);
+        }
+    }
+};
+
+/**
+ * @brief Blocks cached by one thread
+ */
+struct thread_cache {
+    struct bucket {
+        std::array<void*, max_thread_blocks> blocks;
+        std::size_t count = 0;
+    };
+
+    std::array<bucket, class_count> buckets{};
+
+    ~thread_cache() {
+        auto& shared = depot::instance();
+        for (std::size_t i = 0; i < class_count; ++i) {
+            shared.give(i, buckets[i].blocks.data(), buckets[i].count);
+        }
+    }
+};
+
+// Trivially destructible, so it stays readable while other thread_local
+// objects are destroyed at thread exit
+thread_local bool t_cache_retired = false;
+
+struct thread_cache_holder {
+    thread_cache* cache = nullptr;
+
+    ~thread_cache_holder() {
+        t_cache_retired = true;
+        delete cache;
+    }
+};
+
+thread_local thread_cache_holder t_holder;
+
+thread_cache* local_cache() noexcept {
+    if (t_cache_retired) {
+        return nullptr;
+    }
+    if (t_holder.cache == nullptr) {
+        t_holder.cache = new (std::nothrow) thread_cache();
+    }
+    return t_holder.cache;
+}
+
+} // namespace
+
+void* string_pool::allocate(std::size_t bytes) {
+    auto& shared = depot::instance();
+    if (bytes > max_pooled_size) {
+        shared.oversize.fetch_add(1, std::memory_order_relaxed);
+        return ::operator new(bytes);
+    }
+
+    const std::size_t index = class_index(bytes);
+    if (thread_cache* cache = local_cache()) {
+        auto& bucket = cache->buckets[index];
+        if (bucket.count == 0) {
+            bucket.count = shared.take(index, bucket.blocks.data(), thread_limit(index) / 2 + 1);
+        }
+        if (bucket.count != 0) {
+            return bucket.blocks[--bucket.count];
+        }
+    } else {
+        void* block = nullptr;
+        if (shared.take(index, &block, 1) == 1) {
+            return block;
+        }
+    }
+
+    shared.fresh.fetch_add(1, std::memory_order_relaxed);
+    return ::operator new(class_size(index));
+}
+
+void string_pool::deallocate(void* block, std::size_t bytes) noexcept {
+    if (block == nullptr) {
+        return;
+    }
+    if (bytes > max_pooled_size) {
+        ::operator delete(block);
+        return;
+    }
+
+    const std::size_t index = class_index(bytes);
+    auto& shared = depot::instance();
+    thread_cache* cache = local_cache();
+    if (cache == nullptr) {
+        shared.give(index, &block, 1);
+        return;
+    }
+
+    auto& bucket = cache->buckets[index];
+    if (bucket.count == thread_limit(index)) {
+        // Hand half to the depot so a consumer thread does not hoard blocks
+        const std::size_t spill = bucket.count / 2;
+        bucket.count -= spill;
+        shared.give(index, bucket.blocks.data() + bucket.count, spill);
+    }
+    bucket.blocks[bucket.count++] = block;
+}
+
+std::size_t string_pool::good_size(std::size_t bytes) noexcept {
+    return bytes > max_pooled_size ? bytes : class_size(class_index(bytes));
+}
+
+string_pool::statistics string_pool::get_statistics() noexcept {
+    const auto& shared = depot::instance();
+    statistics stats;
+    stats.fresh_allocations = shared.fresh.load(std::memory_order_relaxed);
+    stats.released_blocks = shared.released.load(std::memory_order_relaxed);
+    stats.oversize_allocations = shared.oversize.load(std::memory_order_relaxed);
+    stats.depot_bytes = shared.parked_bytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+} // namespace kcenon::logger
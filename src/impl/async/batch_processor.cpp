@@ -119,7 +119,7 @@ private:
 batch_processor::batch_processor(log_writer_ptr writer, const config& cfg)
     : config_(cfg)
     , writer_(std::move(writer))
-    , queue_(std::make_unique<lockfree_spsc_queue<batch_entry, queue_size>>())
+    , queue_(make_lockfree_queue<batch_entry, queue_size>(cfg.queue_memory))
     , current_batch_size_(cfg.initial_batch_size)
     , current_wait_time_(cfg.max_wait_time)
     , last_adjustment_time_(std::chrono::steady_clock::now()) {
@@ -149,6 +149,7 @@ bool batch_processor::start() {
     }
 
     should_stop_ = false;
+    queue_.get_deleter().memory.prefault();
     processing_worker_ = std::make_unique<batch_processing_jthread_worker>(
         [this] { process_loop_iteration(); }, notify_mutex_, notify_cv_);
     processing_worker_->start();
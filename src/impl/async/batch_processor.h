@@ -55,6 +55,8 @@ public:
         size_t back_pressure_threshold{5000}; ///< Queue size threshold for back-pressure
         std::chrono::microseconds back_pressure_delay{100}; ///< Delay when under back-pressure
 
+        ring_memory_options queue_memory{};   ///< Huge-page/mlock() storage for the entry ring (since 4.1.0)
+
         config() noexcept {}
     };
 
@@ -251,7 +253,7 @@ private:
 
     // Queue
     static constexpr size_t queue_size = 8192;  // Must be power of 2
-    std::unique_ptr<lockfree_spsc_queue<batch_entry, queue_size>> queue_;
+    mapped_spsc_queue_ptr<batch_entry, queue_size> queue_;
 
     // Processing worker (using std::jthread)
     std::unique_ptr<batch_processing_jthread_worker> processing_worker_;
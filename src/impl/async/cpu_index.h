@@ -0,0 +1,94 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file cpu_index.h
+ * @brief Cheap lookup of the CPU the calling thread is running on
+ * @since 4.1.0
+ *
+ * @details Used to pick a per-CPU staging ring. On Linux with glibc 2.35 or
+ * later the kernel keeps the current CPU number in the thread's registered
+ * restartable-sequence (rseq) area, so the lookup is a single load from
+ * thread-local memory. Otherwise sched_getcpu() (a vDSO call on Linux) or
+ * GetCurrentProcessorNumber() is used, and platforms with neither fall back
+ * to a per-thread hash.
+ *
+ * The result is only a hint: the thread may migrate right after reading
+ * it, so rings indexed by it must still accept concurrent producers.
+ *
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__linux__)
+#include <sched.h>
+#if defined(__has_include) && __has_include(<sys/rseq.h>) && defined(__has_builtin)
+#if __has_builtin(__builtin_thread_pointer)
+#include <sys/rseq.h>
+#define LOGGER_HAS_RSEQ_CPU_ID 1
+#endif
+#endif
+#endif
+
+#ifndef LOGGER_HAS_RSEQ_CPU_ID
+#define LOGGER_HAS_RSEQ_CPU_ID 0
+#endif
+
+namespace kcenon::logger::async {
+
+/**
+ * @brief Number of CPU slots to provision for per-CPU structures
+ */
+[[nodiscard]] inline std::size_t cpu_slot_count() noexcept {
+    const unsigned int count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+/**
+ * @brief Index of the CPU the calling thread is running on
+ * @return A CPU number; callers reduce it modulo their slot count
+ */
+[[nodiscard]] inline std::size_t current_cpu() noexcept {
+#if defined(_WIN32)
+    return GetCurrentProcessorNumber();
+#else
+#if LOGGER_HAS_RSEQ_CPU_ID
+    // glibc registers rseq for every thread; __rseq_size is 0 if it could not
+    if (__rseq_size != 0) {
+        const auto* area = reinterpret_cast<const volatile struct rseq*>(
+            static_cast<const char*>(__builtin_thread_pointer()) + __rseq_offset);
+        const std::uint32_t cpu = area->cpu_id;
+        // Negative states (uninitialized, registration failed) read as huge values
+        if (cpu < 0x80000000u) {
+            return cpu;
+        }
+    }
+#endif
+#if defined(__linux__)
+    const int cpu = sched_getcpu();
+    if (cpu >= 0) {
+        return static_cast<std::size_t>(cpu);
+    }
+#endif
+    // No CPU query available: spread threads by identity instead
+    thread_local const std::size_t thread_slot = std::hash<std::thread::id>{}(std::this_thread::get_id());
+    return thread_slot;
+#endif
+}
+
+} // namespace kcenon::logger::async
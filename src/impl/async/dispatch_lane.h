@@ -0,0 +1,183 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file dispatch_lane.h
+ * @brief Per-writer dispatch lane: a bounded batch queue with its own thread
+ * @since 4.1.0
+ *
+ * @details The collector converts each drained batch to log_entry objects
+ * once and posts the shared, immutable result to every lane. A lane writes
+ * the batch to the writers assigned to it on its own thread, so a slow sink
+ * only delays its own lane. When a lane's queue is full the batch is dropped
+ * for that lane alone rather than stalling the collector.
+ *
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <kcenon/logger/interfaces/log_entry.h>
+#include <kcenon/logger/interfaces/log_writer_interface.h>
+
+#include "jthread_compat.h"
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace kcenon::logger::async {
+
+/**
+ * @brief Bounded queue of shared batches drained by a dedicated thread
+ */
+class dispatch_lane {
+public:
+    using batch_ptr = std::shared_ptr<const std::vector<log_entry>>;
+    using writer_list = std::vector<std::shared_ptr<log_writer_interface>>;
+    using writers_ptr = std::shared_ptr<const writer_list>;
+
+    /**
+     * @brief Counter snapshot for one lane
+     */
+    struct stats {
+        std::uint64_t batches_written = 0;
+        std::uint64_t entries_written = 0;
+        std::uint64_t entries_dropped = 0;
+        std::chrono::nanoseconds total_latency{0};
+        std::chrono::nanoseconds max_latency{0};
+        std::size_t queued_entries = 0;
+        std::size_t capacity = 0;
+    };
+
+    /**
+     * @brief Start the lane thread
+     * @param capacity Maximum number of queued entries across all batches
+     */
+    explicit dispatch_lane(std::size_t capacity)
+        : capacity_(capacity) {
+        // The lane has its own stop flag; the compat stop token is unused
+        thread_ = compat_jthread([this](auto&&) { run(); });
+    }
+
+    ~dispatch_lane() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        work_cv_.notify_one();
+        thread_.join();
+    }
+
+    dispatch_lane(const dispatch_lane&) = delete;
+    dispatch_lane& operator=(const dispatch_lane&) = delete;
+
+    /**
+     * @brief Queue a batch for the given writers
+     * @return false if the lane was full and the batch was dropped for it
+     */
+    bool post(const batch_ptr& batch, const writers_ptr& writers) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (pending_entries_ + batch->size() > capacity_ && pending_entries_ != 0) {
+                entries_dropped_ += batch->size();
+                return false;
+            }
+            queue_.push_back({batch, writers, std::chrono::steady_clock::now()});
+            pending_entries_ += batch->size();
+        }
+        work_cv_.notify_one();
+        return true;
+    }
+
+    /**
+     * @brief Block until every posted batch has been written
+     */
+    void wait_idle() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_cv_.wait(lock, [this] { return queue_.empty() && !busy_; });
+    }
+
+    [[nodiscard]] stats get_stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats result;
+        result.batches_written = batches_written_;
+        result.entries_written = entries_written_;
+        result.entries_dropped = entries_dropped_;
+        result.total_latency = total_latency_;
+        result.max_latency = max_latency_;
+        result.queued_entries = pending_entries_;
+        result.capacity = capacity_;
+        return result;
+    }
+
+private:
+    struct work_item {
+        batch_ptr batch;
+        writers_ptr writers;
+        std::chrono::steady_clock::time_point posted;
+    };
+
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            work_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;  // Stopping and fully drained
+            }
+
+            work_item item = std::move(queue_.front());
+            queue_.pop_front();
+            busy_ = true;
+            lock.unlock();
+
+            for (const auto& writer : *item.writers) {
+                try {
+                    writer->write_batch(*item.batch);
+                } catch (...) {
+                    // Swallow exceptions to keep the lane alive
+                }
+            }
+            const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - item.posted);
+
+            lock.lock();
+            busy_ = false;
+            pending_entries_ -= item.batch->size();
+            ++batches_written_;
+            entries_written_ += item.batch->size();
+            total_latency_ += latency;
+            max_latency_ = std::max(max_latency_, latency);
+            if (queue_.empty()) {
+                idle_cv_.notify_all();
+            }
+        }
+    }
+
+    const std::size_t capacity_;
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<work_item> queue_;
+    std::size_t pending_entries_ = 0;
+    bool busy_ = false;
+    bool stopping_ = false;
+
+    // Guarded by mutex_
+    std::uint64_t batches_written_ = 0;
+    std::uint64_t entries_written_ = 0;
+    std::uint64_t entries_dropped_ = 0;
+    std::chrono::nanoseconds total_latency_{0};
+    std::chrono::nanoseconds max_latency_{0};
+
+    compat_jthread thread_;  // Started in the constructor body, after all other members
+};
+
+} // namespace kcenon::logger::async
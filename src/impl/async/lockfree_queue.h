@@ -8,21 +8,29 @@
  * @file lockfree_queue.h
  * @brief High-performance lock-free queue implementation
  *
- * This file provides a lock-free queue optimized for single-producer,
- * single-consumer scenarios commonly found in logging systems.
+ * This file provides lock-free queues for the logging pipeline: a
+ * single-producer, single-consumer ring for dedicated writer threads and a
+ * bounded multi-producer, multi-consumer ring for the shared log collector.
  *
  * Features:
  * - Lock-free implementation using atomic operations
- * - Single-producer, single-consumer optimized
+ * - SPSC and bounded MPMC variants
  * - Memory ordering optimization
  * - ABA problem prevention
  * - Cache-friendly design with padding
+ * - Optional huge-page, prefaulted and mlock()ed ring storage (ring_memory.h)
  */
 
+#include "ring_memory.h"
+
 #include <atomic>
+#include <cstddef>
 #include <memory>
+#include <new>
+#include <optional>
 #include <array>
 #include <type_traits>
+#include <utility>
 
 namespace kcenon::logger::async {
 
@@ -84,17 +92,17 @@ public:
      */
     bool dequeue(T& item) {
         const size_t pos = tail_.load(std::memory_order_relaxed);
-        auto& cell = cells_[pos & mask_];
+        auto& slot = cells_[pos & mask_];
 
-        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        const size_t seq = slot.sequence.load(std::memory_order_acquire);
         const size_t expected_seq = pos + 1;
 
         if (seq != expected_seq) {
             return false; // Queue is empty
         }
 
-        item = std::move(cell.data);
-        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+        item = std::move(slot.data);
+        slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
         tail_.store(pos + 1, std::memory_order_relaxed);
 
         return true;
@@ -165,17 +173,17 @@ private:
     template<typename U>
     bool enqueue_impl(U&& item) {
         const size_t pos = head_.load(std::memory_order_relaxed);
-        auto& cell = cells_[pos & mask_];
+        auto& slot = cells_[pos & mask_];
 
-        const size_t seq = cell.sequence.load(std::memory_order_acquire);
+        const size_t seq = slot.sequence.load(std::memory_order_acquire);
         const size_t expected_seq = pos;
 
         if (seq != expected_seq) {
             return false; // Queue is full
         }
 
-        cell.data = std::forward<U>(item);
-        cell.sequence.store(pos + 1, std::memory_order_release);
+        slot.data = std::forward<U>(item);
+        slot.sequence.store(pos + 1, std::memory_order_release);
         head_.store(pos + 1, std::memory_order_relaxed);
 
         return true;
@@ -199,15 +207,290 @@ std::unique_ptr<lockfree_spsc_queue<T, Size>> make_lockfree_queue() {
 }
 
 /**
- * @brief Multi-producer multi-consumer lock-free queue (for future use)
+ * @brief Deleter for an object constructed in its own ring_memory
+ * @tparam T Object type
  *
- * Note: This is a placeholder for MPMC implementation if needed.
- * Currently, SPSC is sufficient for most logging scenarios.
+ * Owns the storage, so the queue and its pages are released together.
+ */
+template<typename T>
+struct ring_memory_deleter {
+    ring_memory memory;
+
+    void operator()(T* object) noexcept {
+        object->~T();
+        memory = ring_memory();
+    }
+};
+
+/**
+ * @brief SPSC queue whose storage comes from ring_memory
  */
 template<typename T, size_t Size>
+using mapped_spsc_queue_ptr =
+    std::unique_ptr<lockfree_spsc_queue<T, Size>, ring_memory_deleter<lockfree_spsc_queue<T, Size>>>;
+
+/**
+ * @brief Factory function to create a lock-free queue in ring_memory
+ * @tparam T Element type
+ * @tparam Size Queue size (must be power of 2)
+ * @param options Huge-page and mlock() settings for the storage
+ * @return Owning pointer; call get_deleter().memory.prefault() before a burst
+ * @since 4.1.0
+ */
+template<typename T, size_t Size = 1024>
+mapped_spsc_queue_ptr<T, Size> make_lockfree_queue(const ring_memory_options& options) {
+    using queue_type = lockfree_spsc_queue<T, Size>;
+    ring_memory memory(sizeof(queue_type), alignof(queue_type), options);
+    auto* queue = new (memory.data()) queue_type();
+    return mapped_spsc_queue_ptr<T, Size>(queue, ring_memory_deleter<queue_type>{std::move(memory)});
+}
+
+/**
+ * @brief Bounded multi-producer multi-consumer lock-free queue
+ * @tparam T Type of elements to store (only needs to be move-constructible)
+ *
+ * Ring buffer with a per-cell sequence number (Vyukov's bounded MPMC design).
+ * Producers claim a slot with a single CAS on the enqueue position and then
+ * publish it by bumping the cell sequence; consumers do the same on the
+ * dequeue position. No thread ever blocks another, and producers only contend
+ * with each other on the enqueue counter, never on a mutex.
+ *
+ * Unlike lockfree_spsc_queue the capacity is a runtime value (rounded up to
+ * the next power of 2) because the collector sizes its queue from
+ * logger_config::buffer_size. Elements are constructed in place inside the
+ * cells, so T does not have to be default-constructible (log_entry is not).
+ */
+template<typename T>
 class lockfree_mpmc_queue {
-    // TODO: Implement if multi-producer scenarios are needed
-    static_assert(sizeof(T) == 0, "MPMC queue not yet implemented");
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Minimum number of elements the queue can hold
+     *                 (rounded up to the next power of 2, at least 2)
+     * @param memory Huge-page and mlock() settings for the cells (since 4.1.0)
+     */
+    explicit lockfree_mpmc_queue(size_t capacity, const ring_memory_options& memory = {})
+        : capacity_{round_up_pow2(capacity)}
+        , mask_{capacity_ - 1}
+        , memory_{capacity_ * sizeof(cell), alignof(cell), memory}
+        , cells_{static_cast<cell*>(memory_.data())}
+        , enqueue_pos_{0}
+        , dequeue_pos_{0} {
+        for (size_t i = 0; i < capacity_; ++i) {
+            new (&cells_[i]) cell();
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Destructor - destroys elements still in the queue
+     */
+    ~lockfree_mpmc_queue() {
+        while (try_dequeue()) {
+            // Clean up remaining items
+        }
+    }
+
+    lockfree_mpmc_queue(const lockfree_mpmc_queue&) = delete;
+    lockfree_mpmc_queue& operator=(const lockfree_mpmc_queue&) = delete;
+
+    /**
+     * @brief Enqueue an item (any producer thread)
+     * @param item Item to enqueue
+     * @return true if successful, false if queue is full
+     */
+    bool enqueue(const T& item) {
+        return emplace(item);
+    }
+
+    /**
+     * @brief Enqueue an item using move semantics (any producer thread)
+     * @param item Item to enqueue
+     * @return true if successful, false if queue is full
+     */
+    bool enqueue(T&& item) {
+        return emplace(std::move(item));
+    }
+
+    /**
+     * @brief Construct an item in place (any producer thread)
+     * @param args Constructor arguments for T
+     * @return true if successful, false if queue is full
+     */
+    template<typename... Args>
+    bool emplace(Args&&... args) {
+        cell* target = nullptr;
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            target = &cells_[pos & mask_];
+            const size_t seq = target->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Queue is full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        ::new (static_cast<void*>(target->storage)) T(std::forward<Args>(args)...);
+        target->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Dequeue an item (any consumer thread)
+     * @param item Reference to store the dequeued item (move-assigned)
+     * @return true if successful, false if queue is empty
+     */
+    bool dequeue(T& item) {
+        return consume_one([&item](T&& value) { item = std::move(value); });
+    }
+
+    /**
+     * @brief Dequeue an item without requiring a default-constructed target
+     * @return The dequeued item, or std::nullopt if the queue is empty
+     */
+    std::optional<T> try_dequeue() {
+        std::optional<T> result;
+        consume_one([&result](T&& value) { result.emplace(std::move(value)); });
+        return result;
+    }
+
+    /**
+     * @brief Dequeue up to max_items into a container (any consumer thread)
+     * @param out Container receiving the items via emplace_back
+     * @param max_items Maximum number of items to dequeue
+     * @return Number of items dequeued
+     */
+    template<typename Container>
+    size_t dequeue_bulk(Container& out, size_t max_items) {
+        size_t count = 0;
+        while (count < max_items &&
+               consume_one([&out](T&& value) { out.emplace_back(std::move(value)); })) {
+            ++count;
+        }
+        return count;
+    }
+
+    /**
+     * @brief Check if queue is empty
+     * @return true if no slot has been claimed beyond the consumer position
+     */
+    bool empty() const {
+        return size() == 0;
+    }
+
+    /**
+     * @brief Get approximate queue size
+     * @return Approximate number of elements in queue
+     */
+    size_t size() const {
+        const size_t tail_pos = dequeue_pos_.load(std::memory_order_acquire);
+        const size_t head_pos = enqueue_pos_.load(std::memory_order_acquire);
+        return head_pos > tail_pos ? head_pos - tail_pos : 0;
+    }
+
+    /**
+     * @brief Get queue capacity
+     * @return Maximum number of elements
+     */
+    size_t capacity() const {
+        return capacity_;
+    }
+
+    /**
+     * @brief Bytes occupied by the ring's cells
+     * @return capacity() times the padded per-cell size
+     */
+    size_t memory_footprint() const {
+        return capacity_ * sizeof(cell);
+    }
+
+    /**
+     * @brief Storage backing the cells
+     * @since 4.1.0
+     */
+    const ring_memory& memory() const noexcept {
+        return memory_;
+    }
+
+    /**
+     * @brief Populate (and mlock() if requested) the cells before a burst
+     * @since 4.1.0
+     */
+    void prefault() noexcept {
+        memory_.prefault();
+    }
+
+private:
+    /**
+     * @brief Cache line size for padding
+     */
+    static constexpr size_t cache_line_size = 64;
+
+    /**
+     * @brief Cell with sequence number and raw storage for one element
+     *
+     * The sequence encodes the cell state for the lap identified by a
+     * position: seq == pos means free for the producer claiming pos,
+     * seq == pos + 1 means published for the consumer claiming pos.
+     */
+    struct alignas(cache_line_size) cell {
+        std::atomic<size_t> sequence{0};
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+    static_assert(std::is_trivially_destructible_v<cell>, "cells are released with their storage");
+
+    static size_t round_up_pow2(size_t value) {
+        size_t result = 2;
+        while (result < value) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    template<typename Consumer>
+    bool consume_one(Consumer&& consumer) {
+        cell* target = nullptr;
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            target = &cells_[pos & mask_];
+            const size_t seq = target->sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false; // Queue is empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        T* value = std::launder(reinterpret_cast<T*>(target->storage));
+        consumer(std::move(*value));
+        value->~T();
+        target->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    ring_memory memory_;
+    cell* cells_;  // Constructed in memory_; trivially destructible
+
+    // Producer and consumer counters live on separate cache lines
+    alignas(cache_line_size) std::atomic<size_t> enqueue_pos_;
+    alignas(cache_line_size) std::atomic<size_t> dequeue_pos_;
 };
 
-} // namespace kcenon::logger::async
\ No newline at end of file
+} // namespace kcenon::logger::async
@@ -0,0 +1,322 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file queued_record.h
+ * @brief Compact representation of a log entry while it sits in a queue
+ * @since 4.1.0
+ *
+ * @details log_entry inlines small_string buffers for the message and thread
+ * id and is several hundred bytes, most of it padding that is copied on every
+ * move through a queue.
+ * queued_record keeps a 64-byte header (level, timestamp, call site, thread
+ * id, interned file and function ids, payload length) followed by the payload
+ * bytes actually used, and is converted to a log_entry only when it reaches
+ * the writers.
+ *
+ * Payload layout:
+ * - Plain message: message bytes
+ * - Deferred message: serialised format arguments (see deferred_format.h)
+ *
+ * Payloads up to inline_capacity bytes live inside the record; larger ones
+ * spill to a single heap block. Spill blocks up to spill_block::capacity are
+ * recycled through a lock-free object_pool: producers take one when they
+ * build the record and the worker returns it once every writer has consumed
+ * the batch, so steady-state logging of long messages does not allocate.
+ */
+
+#include <kcenon/common/interfaces/logger_interface.h>
+#include <kcenon/logger/core/deferred_format.h>
+#include <kcenon/logger/core/intern_table.h>
+#include <kcenon/logger/interfaces/log_entry.h>
+
+#include "../memory/object_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace kcenon::logger::async {
+
+/**
+ * @brief Fixed-size metadata of a queued record (one cache line)
+ */
+struct record_header {
+    std::chrono::system_clock::time_point timestamp{};
+    const log_site* site = nullptr;                 ///< Call-site id (static record)
+    std::thread::id thread;                         ///< Producing thread
+    deferred_message::render_fn render = nullptr;   ///< Set for deferred messages
+    const char* format = nullptr;                   ///< Deferred format string
+    std::uint32_t format_length = 0;
+    std::uint32_t payload_length = 0;
+    std::int32_t line = 0;
+    intern_table::id_type file_id = intern_table::empty_id;      ///< Plain messages only
+    intern_table::id_type function_id = intern_table::empty_id;  ///< Plain messages only
+    common::interfaces::log_level level = common::interfaces::log_level::info;
+};
+
+static_assert(sizeof(record_header) <= 64, "record_header must fit in one cache line");
+
+/**
+ * @brief Recyclable heap block for payloads that do not fit inline
+ */
+struct spill_block {
+    static constexpr std::size_t capacity = 4096;
+    std::byte data[capacity];
+};
+
+/**
+ * @brief Process-wide pool of spill blocks
+ *
+ * Blocks are acquired on producer threads and released on the worker, so a
+ * shared lock-free pool fits better than per-thread caches. The pool is
+ * never destroyed so records released during static destruction stay safe.
+ */
+inline memory::object_pool<spill_block>& spill_pool() {
+    static auto* pool = new memory::object_pool<spill_block>([] {
+        memory::object_pool<spill_block>::config cfg;
+        cfg.initial_size = 0;
+        cfg.max_size = 1024;
+        cfg.strategy = memory::pool_strategy::lock_free;
+        return cfg;
+    }());
+    return *pool;
+}
+
+/**
+ * @brief Move-only queue element holding a header and its payload
+ */
+class queued_record {
+public:
+    /// Total record size; chosen so an MPMC ring cell is exactly 384 bytes
+    static constexpr std::size_t record_size = 376;
+    /// Payload bytes stored without a heap allocation
+    static constexpr std::size_t inline_capacity = record_size - sizeof(record_header);
+
+    /**
+     * @brief Record for a fully formatted message
+     */
+    queued_record(common::interfaces::log_level level,
+                  std::chrono::system_clock::time_point timestamp,
+                  std::string_view message,
+                  std::string_view file,
+                  int line,
+                  std::string_view function) {
+        init_header(level, timestamp);
+        auto& table = intern_table::instance();
+        header_.line = line;
+        header_.file_id = table.intern(file);
+        header_.function_id = table.intern(function);
+
+        std::byte* out = allocate(message.size());
+        std::memcpy(out, message.data(), message.size());
+    }
+
+    /**
+     * @brief Record for a deferred message from a static call site
+     */
+    queued_record(common::interfaces::log_level level,
+                  std::chrono::system_clock::time_point timestamp,
+                  const log_site* site,
+                  const deferred_message& message) {
+        init_header(level, timestamp);
+        header_.site = site;
+        header_.render = message.renderer();
+        header_.format = message.format().data();
+        header_.format_length = static_cast<std::uint32_t>(message.format().size());
+
+        std::byte* out = allocate(message.payload_size());
+        if (message.payload_size() != 0) {
+            std::memcpy(out, message.payload(), message.payload_size());
+        }
+    }
+
+    queued_record(queued_record&& other) noexcept {
+        take(other);
+    }
+
+    queued_record& operator=(queued_record&& other) noexcept {
+        if (this != &other) {
+            release();
+            take(other);
+        }
+        return *this;
+    }
+
+    queued_record(const queued_record&) = delete;
+    queued_record& operator=(const queued_record&) = delete;
+
+    ~queued_record() {
+        release();
+    }
+
+    [[nodiscard]] const record_header& header() const noexcept {
+        return header_;
+    }
+
+    [[nodiscard]] std::chrono::system_clock::time_point timestamp() const noexcept {
+        return header_.timestamp;
+    }
+
+    /**
+     * @brief Bytes this record holds while queued (record plus heap payload)
+     */
+    [[nodiscard]] std::size_t footprint() const noexcept {
+        if (!on_heap()) {
+            return sizeof(queued_record);
+        }
+        return sizeof(queued_record) + (pooled() ? spill_block::capacity : header_.payload_length);
+    }
+
+    /**
+     * @brief Build the writer-facing log_entry (renders deferred messages)
+     */
+    [[nodiscard]] log_entry to_log_entry() const {
+        const std::byte* data = payload();
+        const auto* chars = reinterpret_cast<const char*>(data);
+
+        log_entry entry(header_.level, std::string(), header_.timestamp);
+        if (header_.render) {
+            entry.message = header_.render(std::string_view(header_.format, header_.format_length), data);
+        } else {
+            entry.message = std::string_view(chars, header_.payload_length);
+        }
+
+        if (header_.site) {
+            const log_site& site = *header_.site;
+            entry.location.emplace(site_string(site.file_id, site.file), site.line,
+                                   site_string(site.function_id, site.function));
+        } else if (header_.file_id != intern_table::empty_id || header_.line != 0 ||
+                   header_.function_id != intern_table::empty_id) {
+            entry.location.emplace(interned_string::from_id(header_.file_id), header_.line,
+                                   interned_string::from_id(header_.function_id));
+        }
+
+        entry.thread_id = thread_text(header_.thread);
+        return entry;
+    }
+
+private:
+    /**
+     * @brief Interned call-site string, looked up once per site
+     *
+     * Racing first records intern the same text and store the same id.
+     * Release/acquire makes the table entry visible with the id.
+     */
+    static interned_string site_string(std::atomic<std::uint32_t>& cached, const char* text) {
+        auto id = cached.load(std::memory_order_acquire);
+        if (id == intern_table::empty_id && text != nullptr && *text != '\0') {
+            id = intern_table::instance().intern(text);
+            cached.store(id, std::memory_order_release);
+        }
+        return interned_string::from_id(id);
+    }
+
+    void init_header(common::interfaces::log_level level,
+                     std::chrono::system_clock::time_point timestamp) {
+        header_.level = level;
+        header_.timestamp = timestamp;
+        header_.thread = std::this_thread::get_id();
+    }
+
+    [[nodiscard]] bool on_heap() const noexcept {
+        return header_.payload_length > inline_capacity;
+    }
+
+    [[nodiscard]] bool pooled() const noexcept {
+        return header_.payload_length <= spill_block::capacity;
+    }
+
+    std::byte* allocate(std::size_t length) {
+        header_.payload_length = static_cast<std::uint32_t>(length);
+        if (!on_heap()) {
+            return inline_;
+        }
+        if (pooled()) {
+            // data is the first member, so the block is recovered from heap_ on release
+            heap_ = spill_pool().acquire().release()->data;
+        } else {
+            heap_ = new std::byte[length];
+        }
+        return heap_;
+    }
+
+    [[nodiscard]] const std::byte* payload() const noexcept {
+        return on_heap() ? heap_ : inline_;
+    }
+
+    void take(queued_record& other) noexcept {
+        header_ = other.header_;
+        if (other.on_heap()) {
+            heap_ = other.heap_;
+            other.header_.payload_length = 0;
+        } else {
+            // Copy only the bytes in use rather than the whole inline area
+            std::memcpy(inline_, other.inline_, header_.payload_length);
+        }
+    }
+
+    void release() noexcept {
+        if (on_heap()) {
+            if (pooled()) {
+                spill_pool().release(std::unique_ptr<spill_block>(
+                    reinterpret_cast<spill_block*>(heap_)));
+            } else {
+                delete[] heap_;
+            }
+        }
+        header_.payload_length = 0;
+    }
+
+    /**
+     * @brief Text form of a thread id, cached per consuming thread
+     *
+     * A batch interleaves records from several producers, so a few recent
+     * ids are kept rather than only the last one.
+     */
+    static const std::string& thread_text(std::thread::id id) {
+        struct cached_thread {
+            std::thread::id id;
+            std::string text;
+        };
+        thread_local std::array<cached_thread, 8> cache;
+        thread_local std::size_t next_victim = 0;
+
+        for (const auto& entry : cache) {
+            if (entry.id == id && !entry.text.empty()) {
+                return entry.text;
+            }
+        }
+
+        auto& entry = cache[next_victim];
+        next_victim = (next_victim + 1) % cache.size();
+        std::ostringstream oss;
+        oss << id;
+        entry.text = oss.str();
+        entry.id = id;
+        return entry.text;
+    }
+
+    record_header header_;
+    union {
+        std::byte inline_[inline_capacity];
+        std::byte* heap_;
+    };
+};
+
+static_assert(sizeof(queued_record) == queued_record::record_size,
+              "queued_record must stay compact; adjust record_size");
+
+} // namespace kcenon::logger::async
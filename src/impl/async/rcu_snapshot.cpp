@@ -0,0 +1,114 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include "rcu_snapshot.h"
+
+#include <limits>
+
+namespace kcenon::logger::async {
+
+/**
+ * @brief Per-thread reader announcement
+ *
+ * Padded to a cache line so readers on different cores never share one.
+ * depth is only touched by the owning thread.
+ */
+struct alignas(64) epoch_domain::reader_slot {
+    std::atomic<std::uint64_t> epoch{0};
+    std::atomic<bool> in_use{false};
+    std::uint32_t depth = 0;
+    reader_slot* next = nullptr;
+};
+
+namespace {
+
+/**
+ * @brief Releases the calling thread's slot for reuse on thread exit
+ */
+struct slot_owner {
+    void* slot = nullptr;
+    std::atomic<bool>* in_use = nullptr;
+
+    ~slot_owner() {
+        if (in_use) {
+            in_use->store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local slot_owner t_slot_owner;
+
+} // namespace
+
+epoch_domain& epoch_domain::instance() {
+    // Intentionally leaked: thread-local slot owners may outlive static
+    // destruction on detached threads
+    static epoch_domain* domain = new epoch_domain();
+    return *domain;
+}
+
+epoch_domain::reader_slot* epoch_domain::local_slot() {
+    if (t_slot_owner.slot) {
+        return static_cast<reader_slot*>(t_slot_owner.slot);
+    }
+
+    // Reuse a slot released by an exited thread
+    reader_slot* slot = slots_.load(std::memory_order_acquire);
+    for (; slot != nullptr; slot = slot->next) {
+        bool expected = false;
+        if (!slot->in_use.load(std::memory_order_relaxed) &&
+            slot->in_use.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+
+    if (!slot) {
+        slot = new reader_slot();
+        slot->in_use.store(true, std::memory_order_relaxed);
+        reader_slot* head = slots_.load(std::memory_order_relaxed);
+        do {
+            slot->next = head;
+        } while (!slots_.compare_exchange_weak(head, slot, std::memory_order_release,
+                                               std::memory_order_relaxed));
+    }
+
+    t_slot_owner.slot = slot;
+    t_slot_owner.in_use = &slot->in_use;
+    return slot;
+}
+
+void epoch_domain::enter() noexcept {
+    reader_slot* slot = local_slot();
+    if (slot->depth++ == 0) {
+        slot->epoch.store(global_epoch_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        // Order the announcement before the snapshot load; pairs with the
+        // seq_cst exchange and epoch advance in rcu_snapshot::update
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+    }
+}
+
+void epoch_domain::exit() noexcept {
+    reader_slot* slot = local_slot();
+    if (--slot->depth == 0) {
+        slot->epoch.store(0, std::memory_order_release);
+    }
+}
+
+std::uint64_t epoch_domain::advance() noexcept {
+    return global_epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+}
+
+std::uint64_t epoch_domain::min_active_epoch() const noexcept {
+    std::uint64_t min_epoch = std::numeric_limits<std::uint64_t>::max();
+    for (reader_slot* slot = slots_.load(std::memory_order_acquire); slot != nullptr;
+         slot = slot->next) {
+        const std::uint64_t e = slot->epoch.load(std::memory_order_seq_cst);
+        if (e != 0 && e < min_epoch) {
+            min_epoch = e;
+        }
+    }
+    return min_epoch;
+}
+
+} // namespace kcenon::logger::async
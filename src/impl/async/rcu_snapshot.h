@@ -0,0 +1,201 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file rcu_snapshot.h
+ * @brief Read-copy-update snapshots with epoch-based reclamation
+ * @since 4.1.0
+ *
+ * @details Provides an immutable, versioned snapshot that readers access
+ * without locks or reference counting, and that updaters replace with a
+ * copy-and-publish. Retired snapshots are freed once every reader that could
+ * still observe them has left its read-side critical section.
+ *
+ * Usage:
+ * @code
+ * rcu_snapshot<std::vector<int>> table;
+ *
+ * // Reader (any thread, no locks)
+ * {
+ *     epoch_guard guard;
+ *     for (int v : *table.load()) { ... }
+ * }
+ *
+ * // Updater (serialised internally)
+ * table.update([](std::vector<int>& next) { next.push_back(1); return true; });
+ * @endcode
+ */
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace kcenon::logger::async {
+
+/**
+ * @brief Process-wide epoch domain shared by all rcu_snapshot instances
+ *
+ * Every reading thread owns a cache-line sized slot in which it announces
+ * the global epoch on entry to a read-side critical section (0 = quiescent).
+ * A snapshot retired at epoch E can be freed as soon as no slot announces an
+ * epoch lower than E. Slots are recycled when their thread exits; the domain
+ * itself is never destroyed so that thread exit is always safe.
+ */
+class epoch_domain {
+public:
+    /**
+     * @brief Get the process-wide domain
+     */
+    static epoch_domain& instance();
+
+    /**
+     * @brief Enter a read-side critical section (re-entrant)
+     */
+    void enter() noexcept;
+
+    /**
+     * @brief Leave a read-side critical section
+     */
+    void exit() noexcept;
+
+    /**
+     * @brief Advance the global epoch after publishing a new snapshot
+     * @return Retire epoch for the snapshot that was replaced
+     */
+    std::uint64_t advance() noexcept;
+
+    /**
+     * @brief Smallest epoch announced by an active reader
+     * @return UINT64_MAX when no reader is inside a critical section
+     */
+    [[nodiscard]] std::uint64_t min_active_epoch() const noexcept;
+
+    epoch_domain(const epoch_domain&) = delete;
+    epoch_domain& operator=(const epoch_domain&) = delete;
+
+private:
+    struct reader_slot;
+
+    epoch_domain() = default;
+    ~epoch_domain() = default;
+
+    reader_slot* local_slot();
+
+    std::atomic<std::uint64_t> global_epoch_{1};
+    std::atomic<reader_slot*> slots_{nullptr};
+};
+
+/**
+ * @brief RAII read-side critical section
+ *
+ * Pointers obtained from rcu_snapshot::load() stay valid until the guard that
+ * was active when they were loaded is destroyed.
+ */
+class epoch_guard {
+public:
+    epoch_guard() noexcept { epoch_domain::instance().enter(); }
+    ~epoch_guard() { epoch_domain::instance().exit(); }
+
+    epoch_guard(const epoch_guard&) = delete;
+    epoch_guard& operator=(const epoch_guard&) = delete;
+};
+
+/**
+ * @brief Immutable, atomically published snapshot of a value
+ * @tparam T Snapshot type (must be copy-constructible)
+ *
+ * Readers call load() inside an epoch_guard and never block. update() copies
+ * the current value, applies the mutation and publishes the copy; the
+ * previous value is reclaimed through the epoch domain.
+ */
+template<typename T>
+class rcu_snapshot {
+public:
+    rcu_snapshot()
+        : current_(new T()) {}
+
+    explicit rcu_snapshot(T initial)
+        : current_(new T(std::move(initial))) {}
+
+    /**
+     * @brief Destructor
+     * @note No reader may still hold a pointer from load()
+     */
+    ~rcu_snapshot() {
+        delete current_.load(std::memory_order_relaxed);
+        for (auto& r : retired_) {
+            delete r.value;
+        }
+    }
+
+    rcu_snapshot(const rcu_snapshot&) = delete;
+    rcu_snapshot& operator=(const rcu_snapshot&) = delete;
+
+    /**
+     * @brief Get the current snapshot
+     * @return Pointer valid until the enclosing epoch_guard ends
+     */
+    [[nodiscard]] const T* load() const noexcept {
+        return current_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Number of snapshots published since construction
+     */
+    [[nodiscard]] std::uint64_t version() const noexcept {
+        return version_.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Copy, mutate and publish a new snapshot
+     * @param mutate Callable taking T& and returning true if it changed the
+     *               copy; nothing is published when it returns false
+     * @return Value returned by mutate
+     */
+    template<typename Fn>
+    bool update(Fn&& mutate) {
+        std::lock_guard<std::mutex> lock(update_mutex_);
+        auto next = std::make_unique<T>(*current_.load(std::memory_order_relaxed));
+        if (!mutate(*next)) {
+            return false;
+        }
+
+        const T* previous = current_.exchange(next.release(), std::memory_order_seq_cst);
+        version_.fetch_add(1, std::memory_order_release);
+        retired_.push_back({previous, epoch_domain::instance().advance()});
+        reclaim_locked();
+        return true;
+    }
+
+private:
+    struct retired_snapshot {
+        const T* value;
+        std::uint64_t epoch;
+    };
+
+    void reclaim_locked() {
+        const std::uint64_t min_active = epoch_domain::instance().min_active_epoch();
+        auto it = retired_.begin();
+        while (it != retired_.end()) {
+            if (it->epoch <= min_active) {
+                delete it->value;
+                it = retired_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    std::atomic<const T*> current_;
+    std::atomic<std::uint64_t> version_{0};
+    std::mutex update_mutex_;
+    std::vector<retired_snapshot> retired_;  // Guarded by update_mutex_
+};
+
+} // namespace kcenon::logger::async
@@ -0,0 +1,93 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file record_ring.h
+ * @brief Growable FIFO ring that reuses its storage
+ * @since 4.1.0
+ *
+ * @details Replacement for std::queue in the mutex-protected collector
+ * queue. std::deque allocates a node per element once elements exceed a few
+ * hundred bytes, so every enqueue of a queued_record hit the heap. The ring
+ * grows geometrically while it fills and never shrinks, so once it has
+ * reached the queue's working depth pushes and pops do not allocate.
+ *
+ * @note Not thread-safe; the collector guards it with queue_mutex.
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace kcenon::logger::async {
+
+/**
+ * @brief Unbounded FIFO over a circular buffer of optional slots
+ * @tparam T Move-constructible element type
+ */
+template<typename T>
+class record_ring {
+public:
+    static constexpr std::size_t min_slots = 16;
+
+    [[nodiscard]] bool empty() const noexcept {
+        return count_ == 0;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return count_;
+    }
+
+    /**
+     * @brief Number of slots currently allocated
+     */
+    [[nodiscard]] std::size_t slots() const noexcept {
+        return slots_.size();
+    }
+
+    void push(T&& value) {
+        if (count_ == slots_.size()) {
+            grow();
+        }
+        slots_[(head_ + count_) % slots_.size()].emplace(std::move(value));
+        ++count_;
+    }
+
+    /**
+     * @pre !empty()
+     */
+    [[nodiscard]] T& front() noexcept {
+        return *slots_[head_];
+    }
+
+    /**
+     * @pre !empty()
+     */
+    void pop() noexcept {
+        slots_[head_].reset();
+        head_ = (head_ + 1) % slots_.size();
+        --count_;
+    }
+
+private:
+    void grow() {
+        std::vector<std::optional<T>> next(std::max(slots_.size() * 2, min_slots));
+        for (std::size_t i = 0; i < count_; ++i) {
+            next[i].emplace(std::move(*slots_[(head_ + i) % slots_.size()]));
+        }
+        slots_.swap(next);
+        head_ = 0;
+    }
+
+    std::vector<std::optional<T>> slots_;
+    std::size_t head_ = 0;
+    std::size_t count_ = 0;
+};
+
+} // namespace kcenon::logger::async
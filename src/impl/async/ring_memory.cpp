@@ -0,0 +1,168 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include "ring_memory.h"
+
+#include <new>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#define LOGGER_RING_MEMORY_MMAP 1
+#else
+#define LOGGER_RING_MEMORY_MMAP 0
+#endif
+
+namespace kcenon::logger::async {
+
+namespace {
+
+#if LOGGER_RING_MEMORY_MMAP
+/// Default huge page size on x86-64 and arm64
+constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+std::size_t round_up(std::size_t value, std::size_t multiple) noexcept {
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+std::size_t page_size() noexcept {
+    const long size = ::sysconf(_SC_PAGESIZE);
+    return size > 0 ? static_cast<std::size_t>(size) : 4096;
+}
+
+void* map_anonymous(std::size_t bytes, int extra_flags) noexcept {
+    void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                     MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return p == MAP_FAILED ? nullptr : p;
+}
+#endif
+
+} // namespace
+
+ring_memory::ring_memory(std::size_t bytes, std::size_t alignment, const ring_memory_options& options)
+    : size_(bytes)
+    , alignment_(alignment)
+    , lock_requested_(options.lock) {
+#if LOGGER_RING_MEMORY_MMAP
+    if (options.mapped() && bytes != 0) {
+#if defined(MAP_HUGETLB)
+        if (options.huge_pages) {
+            // Only succeeds if huge pages are reserved (vm.nr_hugepages)
+            const std::size_t length = round_up(bytes, huge_page_size);
+            if (void* p = map_anonymous(length, MAP_HUGETLB)) {
+                data_ = mapping_ = p;
+                mapping_size_ = length;
+                backing_ = backing::huge_pages;
+                return;
+            }
+        }
+#endif
+        if (options.huge_pages) {
+            // Over-map so a 2 MiB-aligned range can be handed to THP
+            const std::size_t length = round_up(bytes, huge_page_size) + huge_page_size;
+            if (void* p = map_anonymous(length, 0)) {
+                const auto base = reinterpret_cast<std::uintptr_t>(p);
+                const auto aligned = round_up(base, huge_page_size);
+                mapping_ = p;
+                mapping_size_ = length;
+                data_ = reinterpret_cast<void*>(aligned);
+                backing_ = backing::pages;
+#if defined(MADV_HUGEPAGE)
+                if (::madvise(data_, round_up(bytes, huge_page_size), MADV_HUGEPAGE) == 0) {
+                    backing_ = backing::transparent_huge_pages;
+                }
+#endif
+                return;
+            }
+        } else {
+            const std::size_t length = round_up(bytes, page_size());
+            if (void* p = map_anonymous(length, 0)) {
+                data_ = mapping_ = p;
+                mapping_size_ = length;
+                backing_ = backing::pages;
+                return;
+            }
+        }
+    }
+#endif
+    data_ = ::operator new(bytes, std::align_val_t(alignment));
+    backing_ = backing::heap;
+}
+
+ring_memory::~ring_memory() {
+    reset();
+}
+
+ring_memory::ring_memory(ring_memory&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0))
+    , mapping_(std::exchange(other.mapping_, nullptr))
+    , mapping_size_(std::exchange(other.mapping_size_, 0))
+    , alignment_(other.alignment_)
+    , backing_(std::exchange(other.backing_, backing::heap))
+    , lock_requested_(std::exchange(other.lock_requested_, false))
+    , locked_(std::exchange(other.locked_, false)) {
+}
+
+ring_memory& ring_memory::operator=(ring_memory&& other) noexcept {
+    if (this != &other) {
+        reset();
+        data_ = std::exchange(other.data_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        mapping_ = std::exchange(other.mapping_, nullptr);
+        mapping_size_ = std::exchange(other.mapping_size_, 0);
+        alignment_ = other.alignment_;
+        backing_ = std::exchange(other.backing_, backing::heap);
+        lock_requested_ = std::exchange(other.lock_requested_, false);
+        locked_ = std::exchange(other.locked_, false);
+    }
+    return *this;
+}
+
+void ring_memory::prefault() noexcept {
+#if LOGGER_RING_MEMORY_MMAP
+    if (mapping_ == nullptr) {
+        return;
+    }
+    bool populated = false;
+#if defined(MADV_POPULATE_WRITE)
+    populated = ::madvise(data_, size_, MADV_POPULATE_WRITE) == 0;
+#endif
+    if (!populated) {
+        // Reads fault in pages that were written or swapped without
+        // changing what producers may be writing concurrently
+        const std::size_t step = page_size();
+        const auto* bytes = static_cast<const volatile unsigned char*>(data_);
+        for (std::size_t offset = 0; offset < size_; offset += step) {
+            (void)bytes[offset];
+        }
+    }
+    if (lock_requested_ && !locked_) {
+        // Fails quietly when RLIMIT_MEMLOCK is too low
+        locked_ = ::mlock(data_, size_) == 0;
+    }
+#endif
+}
+
+void ring_memory::reset() noexcept {
+    if (data_ == nullptr) {
+        return;
+    }
+#if LOGGER_RING_MEMORY_MMAP
+    if (mapping_ != nullptr) {
+        if (locked_) {
+            ::munlock(data_, size_);
+        }
+        ::munmap(mapping_, mapping_size_);
+        data_ = nullptr;
+        mapping_ = nullptr;
+        return;
+    }
+#endif
+    ::operator delete(data_, std::align_val_t(alignment_));
+    data_ = nullptr;
+}
+
+} // namespace kcenon::logger::async
@@ -0,0 +1,117 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file ring_memory.h
+ * @brief Backing storage for large lock-free rings
+ * @since 4.1.0
+ *
+ * @details A 64K-entry collector ring spans tens of megabytes of 4 KiB
+ * pages, so the first burst through it walks thousands of TLB entries. With
+ * ring_memory_options::huge_pages the storage is mapped with MAP_HUGETLB
+ * (reserved 2 MiB pages); when none are reserved it falls back to a
+ * 2 MiB-aligned anonymous mapping advised with MADV_HUGEPAGE, so
+ * transparent huge pages can back it. prefault() populates every page up
+ * front and, with ring_memory_options::lock, pins it with mlock() so a
+ * burst never waits for the page to come back from reclaim or swap.
+ *
+ * Without options, and on platforms without mmap, the storage is an
+ * ordinary aligned heap block. Every step degrades silently: get_backing()
+ * and locked() report what was actually obtained.
+ *
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace kcenon::logger::async {
+
+/**
+ * @brief How a ring's storage should be allocated
+ */
+struct ring_memory_options {
+    bool huge_pages = false;  ///< Map with huge pages where available
+    bool lock = false;        ///< mlock() the storage when it is prefaulted
+
+    [[nodiscard]] bool mapped() const noexcept {
+        return huge_pages || lock;
+    }
+};
+
+/**
+ * @class ring_memory
+ * @brief Owning, move-only block of ring storage
+ */
+class ring_memory {
+public:
+    /**
+     * @brief What the storage ended up on
+     */
+    enum class backing : std::uint8_t {
+        heap,                    ///< Aligned operator new
+        pages,                   ///< Anonymous mapping with regular pages
+        transparent_huge_pages,  ///< Anonymous mapping advised with MADV_HUGEPAGE
+        huge_pages               ///< MAP_HUGETLB mapping
+    };
+
+    ring_memory() noexcept = default;
+
+    /**
+     * @brief Allocate storage
+     * @param bytes Usable size
+     * @param alignment Required alignment (at most the page size)
+     * @param options Allocation mode
+     * @throws std::bad_alloc if no backing could be obtained
+     */
+    ring_memory(std::size_t bytes, std::size_t alignment, const ring_memory_options& options);
+
+    ~ring_memory();
+
+    ring_memory(ring_memory&& other) noexcept;
+    ring_memory& operator=(ring_memory&& other) noexcept;
+
+    ring_memory(const ring_memory&) = delete;
+    ring_memory& operator=(const ring_memory&) = delete;
+
+    [[nodiscard]] void* data() const noexcept {
+        return data_;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        return size_;
+    }
+
+    [[nodiscard]] backing get_backing() const noexcept {
+        return backing_;
+    }
+
+    [[nodiscard]] bool locked() const noexcept {
+        return locked_;
+    }
+
+    /**
+     * @brief Populate every page and apply the requested mlock()
+     *
+     * Never modifies the contents, so it is safe while the ring is in use.
+     * A no-op for heap storage.
+     */
+    void prefault() noexcept;
+
+private:
+    void reset() noexcept;
+
+    void* data_ = nullptr;
+    std::size_t size_ = 0;
+    void* mapping_ = nullptr;        ///< Start of the mapping (may precede data_)
+    std::size_t mapping_size_ = 0;
+    std::size_t alignment_ = 0;
+    backing backing_ = backing::heap;
+    bool lock_requested_ = false;
+    bool locked_ = false;
+};
+
+} // namespace kcenon::logger::async
@@ -27,9 +27,10 @@ namespace kcenon::logger {
 // Core Writers
 //============================================================================
 
-writer_builder& writer_builder::file(const std::string& filename, bool append) {
+writer_builder& writer_builder::file(const std::string& filename, bool append,
+                                     const file_output_options& output) {
     ensure_no_core_writer();
-    writer_ = std::make_unique<file_writer>(filename, append);
+    writer_ = std::make_unique<file_writer>(filename, append, nullptr, output);
     return *this;
 }
 
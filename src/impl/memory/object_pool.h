@@ -13,6 +13,9 @@
 #pragma once
 
 #include <kcenon/logger/core/error_codes.h>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <vector>
 #include <mutex>
@@ -21,6 +24,84 @@
 
 namespace kcenon::logger::memory {
 
+/**
+ * @brief Synchronization strategy used by object_pool
+ * @since 4.1.0
+ */
+enum class pool_strategy {
+    mutex,      ///< Mutex-protected queue (original behavior)
+    lock_free   ///< ABA-tagged Treiber stacks over a fixed slot array
+};
+
+namespace detail {
+
+/**
+ * @brief Lock-free LIFO of slot indices with an ABA tag in the head word
+ *
+ * @details The head packs a 32-bit generation tag above a 32-bit slot index.
+ * Every successful push or pop bumps the tag, so a pop that read a stale
+ * head (the slot was popped, reused and pushed back in between) fails its
+ * CAS instead of installing a stale next link. Links live in a caller-owned
+ * array of atomics, so stale reads are never data races.
+ *
+ * @since 4.1.0
+ */
+class tagged_index_stack {
+public:
+    static constexpr std::uint32_t npos = std::numeric_limits<std::uint32_t>::max();
+
+    /**
+     * @param links Next-index array shared with the owning pool
+     */
+    explicit tagged_index_stack(std::atomic<std::uint32_t>* links) noexcept
+        : links_(links) {}
+
+    void push(std::uint32_t index) noexcept {
+        std::uint64_t head = head_.load(std::memory_order_relaxed);
+        std::uint64_t desired;
+        do {
+            links_[index].store(index_of(head), std::memory_order_relaxed);
+            desired = pack(tag_of(head) + 1, index);
+        } while (!head_.compare_exchange_weak(head, desired, std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    /**
+     * @return Popped index, or npos if the stack is empty
+     */
+    std::uint32_t pop() noexcept {
+        std::uint64_t head = head_.load(std::memory_order_acquire);
+        while (index_of(head) != npos) {
+            const std::uint32_t next = links_[index_of(head)].load(std::memory_order_relaxed);
+            if (head_.compare_exchange_weak(head, pack(tag_of(head) + 1, next),
+                                            std::memory_order_acquire,
+                                            std::memory_order_acquire)) {
+                return index_of(head);
+            }
+        }
+        return npos;
+    }
+
+private:
+    static constexpr std::uint64_t pack(std::uint32_t tag, std::uint32_t index) noexcept {
+        return (std::uint64_t{tag} << 32) | index;
+    }
+
+    static constexpr std::uint32_t tag_of(std::uint64_t word) noexcept {
+        return static_cast<std::uint32_t>(word >> 32);
+    }
+
+    static constexpr std::uint32_t index_of(std::uint64_t word) noexcept {
+        return static_cast<std::uint32_t>(word);
+    }
+
+    // Own cache line so the two stacks of a pool do not false-share
+    alignas(64) std::atomic<std::uint64_t> head_{pack(0, npos)};
+    std::atomic<std::uint32_t>* links_;
+};
+
+} // namespace detail
+
 /**
  * @brief Thread-safe object pool for high-performance memory management
  * @tparam T The type of objects to pool
@@ -35,6 +116,7 @@ public:
         size_t initial_size{100};        ///< Initial pool size
         size_t max_size{10000};          ///< Maximum pool size
         bool allow_growth{true};         ///< Allow pool to grow beyond initial size
+        pool_strategy strategy{pool_strategy::mutex}; ///< Synchronization strategy (since 4.1.0)
 
         config() = default;
     };
@@ -42,9 +124,15 @@ public:
     /**
      * @brief Construct object pool with configuration
      * @param cfg Pool configuration
+     *
+     * @details With pool_strategy::lock_free, max_size slots are allocated up
+     * front (capped at 2^32 - 2) and acquire/release never take a lock.
      */
     explicit object_pool(const config& cfg = config{})
         : config_(cfg), pool_size_(0) {
+        if (config_.strategy == pool_strategy::lock_free) {
+            initialize_slots();
+        }
         initialize_pool();
     }
 
@@ -58,6 +146,17 @@ public:
      * @return Unique pointer to object, or nullptr if pool is empty and growth is disabled
      */
     std::unique_ptr<T> acquire() {
+        if (lock_free_) {
+            const auto index = lock_free_->full.pop();
+            if (index != detail::tagged_index_stack::npos) {
+                auto obj = std::move(lock_free_->objects[index]);
+                lock_free_->available.fetch_sub(1, std::memory_order_relaxed);
+                lock_free_->empty.push(index);
+                return obj;
+            }
+            return create_object();
+        }
+
         std::lock_guard<std::mutex> lock(mutex_);
 
         if (!available_objects_.empty()) {
@@ -66,14 +165,7 @@ public:
             return obj;
         }
 
-        // If pool is empty and growth is allowed, create new object
-        if (config_.allow_growth && pool_size_.load() < config_.max_size) {
-            pool_size_.fetch_add(1);
-            return std::make_unique<T>();
-        }
-
-        // Create temporary object if pool limits reached
-        return std::make_unique<T>();
+        return create_object();
     }
 
     /**
@@ -85,6 +177,17 @@ public:
             return;
         }
 
+        if (lock_free_) {
+            // No free slot means max_size objects are already pooled
+            const auto index = lock_free_->empty.pop();
+            if (index != detail::tagged_index_stack::npos) {
+                lock_free_->objects[index] = std::move(obj);
+                lock_free_->available.fetch_add(1, std::memory_order_relaxed);
+                lock_free_->full.push(index);
+            }
+            return;
+        }
+
         std::lock_guard<std::mutex> lock(mutex_);
 
         // Only return to pool if not exceeding max size
@@ -108,6 +211,16 @@ public:
      * @return Current pool statistics
      */
     statistics get_statistics() const {
+        if (lock_free_) {
+            // Counters are read separately; the snapshot is approximate under load
+            statistics stats;
+            stats.total_size = pool_size_.load();
+            stats.available_count = lock_free_->available.load(std::memory_order_relaxed);
+            stats.in_use_count = stats.total_size > stats.available_count
+                ? stats.total_size - stats.available_count : 0;
+            return stats;
+        }
+
         std::lock_guard<std::mutex> lock(mutex_);
         statistics stats;
         stats.total_size = pool_size_.load();
@@ -116,10 +229,30 @@ public:
         return stats;
     }
 
+    /**
+     * @brief Get the configured synchronization strategy
+     * @since 4.1.0
+     */
+    pool_strategy strategy() const noexcept {
+        return config_.strategy;
+    }
+
     /**
      * @brief Clear all objects from pool
+     * @note With pool_strategy::lock_free, must not race with acquire/release
      */
     void clear() {
+        if (lock_free_) {
+            for (auto index = lock_free_->full.pop(); index != detail::tagged_index_stack::npos;
+                 index = lock_free_->full.pop()) {
+                lock_free_->objects[index].reset();
+                lock_free_->empty.push(index);
+            }
+            lock_free_->available.store(0, std::memory_order_relaxed);
+            pool_size_.store(0);
+            return;
+        }
+
         std::lock_guard<std::mutex> lock(mutex_);
         while (!available_objects_.empty()) {
             available_objects_.pop();
@@ -128,10 +261,67 @@ public:
     }
 
 private:
+    /**
+     * @brief Slot storage and stacks for pool_strategy::lock_free
+     *
+     * @details Each slot is on exactly one stack: full slots own a pooled
+     * object, empty slots are spare. A slot's object is only touched by the
+     * thread that popped the slot.
+     */
+    struct lock_free_slots {
+        explicit lock_free_slots(std::size_t count)
+            : objects(count)
+            , links(std::make_unique<std::atomic<std::uint32_t>[]>(count))
+            , full(links.get())
+            , empty(links.get()) {
+            for (std::size_t i = count; i-- > 0;) {
+                empty.push(static_cast<std::uint32_t>(i));
+            }
+        }
+
+        std::vector<std::unique_ptr<T>> objects;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> links;
+        detail::tagged_index_stack full;
+        detail::tagged_index_stack empty;
+        std::atomic<std::size_t> available{0};
+    };
+
+    /**
+     * @brief Create an object when no pooled one is available
+     */
+    std::unique_ptr<T> create_object() {
+        // If pool is empty and growth is allowed, count the new object
+        if (config_.allow_growth && pool_size_.load() < config_.max_size) {
+            pool_size_.fetch_add(1);
+            return std::make_unique<T>();
+        }
+
+        // Create temporary object if pool limits reached
+        return std::make_unique<T>();
+    }
+
+    /**
+     * @brief Allocate the slot array for pool_strategy::lock_free
+     */
+    void initialize_slots() {
+        // npos is reserved as the empty-stack marker
+        const std::size_t limit = detail::tagged_index_stack::npos - 1;
+        const std::size_t count = std::max<std::size_t>(std::min(config_.max_size, limit), 1);
+        lock_free_ = std::make_unique<lock_free_slots>(count);
+    }
+
     /**
      * @brief Initialize pool with initial objects
      */
     void initialize_pool() {
+        if (lock_free_) {
+            for (size_t i = 0; i < config_.initial_size; ++i) {
+                release(std::make_unique<T>());
+            }
+            pool_size_.store(lock_free_->available.load(std::memory_order_relaxed));
+            return;
+        }
+
         std::lock_guard<std::mutex> lock(mutex_);
 
         for (size_t i = 0; i < config_.initial_size; ++i) {
@@ -145,6 +335,7 @@ private:
     mutable std::mutex mutex_;                         ///< Thread safety mutex
     std::queue<std::unique_ptr<T>> available_objects_; ///< Available objects
     std::atomic<size_t> pool_size_;                    ///< Current pool size
+    std::unique_ptr<lock_free_slots> lock_free_;       ///< Set for pool_strategy::lock_free
 };
 
 /**
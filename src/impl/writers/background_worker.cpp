@@ -0,0 +1,62 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include "background_worker.h"
+
+#include <utility>
+
+namespace kcenon::logger::detail {
+
+background_worker::~background_worker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_cv_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void background_worker::post(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+        if (!thread_.joinable()) {
+            thread_ = std::thread([this]() { run(); });
+        }
+    }
+    work_cv_.notify_one();
+}
+
+void background_worker::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this]() { return tasks_.empty() && !busy_; });
+}
+
+void background_worker::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        work_cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+        if (tasks_.empty()) {
+            // Only reached when stopping with nothing left to run
+            return;
+        }
+
+        auto task = std::move(tasks_.front());
+        tasks_.pop_front();
+        busy_ = true;
+        lock.unlock();
+        task();
+        task = nullptr;
+        lock.lock();
+        busy_ = false;
+
+        if (tasks_.empty()) {
+            idle_cv_.notify_all();
+        }
+    }
+}
+
+} // namespace kcenon::logger::detail
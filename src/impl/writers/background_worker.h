@@ -0,0 +1,62 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file background_worker.h
+ * @brief Single-thread FIFO task runner for file housekeeping
+ * @since 4.1.0
+ *
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace kcenon::logger::detail {
+
+/**
+ * @class background_worker
+ * @brief Runs posted tasks one at a time, in the order they were posted
+ *
+ * @details Used to keep renames, directory scans and file opens off the
+ * logging path. The thread is started by the first post(), so a writer that
+ * never needs it costs nothing. Tasks must not throw; the destructor runs
+ * whatever is still queued before joining.
+ */
+class background_worker {
+public:
+    background_worker() = default;
+    ~background_worker();
+
+    background_worker(const background_worker&) = delete;
+    background_worker& operator=(const background_worker&) = delete;
+
+    /**
+     * @brief Queue a task behind everything posted before it
+     */
+    void post(std::function<void()> task);
+
+    /**
+     * @brief Block until every posted task has finished
+     */
+    void wait_idle();
+
+private:
+    void run();
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<std::function<void()>> tasks_;
+    bool busy_ = false;
+    bool stopping_ = false;
+    std::thread thread_;
+};
+
+} // namespace kcenon::logger::detail
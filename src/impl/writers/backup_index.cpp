@@ -0,0 +1,94 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include "backup_index.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace kcenon::logger::detail {
+
+void backup_index::assign(std::vector<backup_file> files) {
+    files_.clear();
+    by_path_.clear();
+    indices_.clear();
+    total_bytes_ = 0;
+
+    std::stable_sort(files.begin(), files.end(),
+                     [](const backup_file& a, const backup_file& b) {
+                         return a.modified < b.modified;
+                     });
+    for (auto& file : files) {
+        add(std::move(file));
+    }
+}
+
+void backup_index::add(backup_file file) {
+    if (auto found = by_path_.find(file.path); found != by_path_.end()) {
+        erase(found->second);
+    }
+
+    total_bytes_ += file.size;
+    if (file.index >= 0) {
+        indices_.insert(file.index);
+    }
+    files_.push_back(std::move(file));
+    by_path_.emplace(files_.back().path, std::prev(files_.end()));
+}
+
+bool backup_index::replace(const std::string& path, const std::string& new_path, std::uint64_t size) {
+    auto found = by_path_.find(path);
+    if (found == by_path_.end()) {
+        return false;
+    }
+
+    auto it = found->second;
+    by_path_.erase(found);
+    if (auto clash = by_path_.find(new_path); clash != by_path_.end()) {
+        erase(clash->second);
+    }
+    total_bytes_ = total_bytes_ - it->size + size;
+    it->path = new_path;
+    it->size = size;
+    by_path_.emplace(new_path, it);
+    return true;
+}
+
+int backup_index::lowest_free_index() const {
+    int next = 1;
+    for (auto it = indices_.lower_bound(next); it != indices_.end() && *it <= next; ++it) {
+        next = *it + 1;
+    }
+    return next;
+}
+
+std::vector<std::string> backup_index::evict(std::size_t max_files,
+                                             std::uint64_t max_total_bytes,
+                                             std::chrono::seconds max_age,
+                                             std::filesystem::file_time_type now) {
+    std::vector<std::string> removed;
+    while (!files_.empty()) {
+        const auto& oldest = files_.front();
+        const bool too_many = files_.size() > max_files;
+        const bool too_large = max_total_bytes > 0 && total_bytes_ > max_total_bytes;
+        const bool too_old = max_age.count() > 0 && now - oldest.modified > max_age;
+        if (!too_many && !too_large && !too_old) {
+            break;
+        }
+        removed.push_back(oldest.path);
+        erase(files_.begin());
+    }
+    return removed;
+}
+
+void backup_index::erase(std::list<backup_file>::iterator it) {
+    total_bytes_ -= it->size;
+    if (it->index >= 0) {
+        indices_.erase(indices_.find(it->index));
+    }
+    by_path_.erase(it->path);
+    files_.erase(it);
+}
+
+} // namespace kcenon::logger::detail
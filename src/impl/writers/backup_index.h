@@ -0,0 +1,100 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file backup_index.h
+ * @brief In-memory list of a rotating writer's backups, oldest first
+ * @since 4.1.0
+ *
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace kcenon::logger::detail {
+
+/**
+ * @brief One rotated segment on disk
+ */
+struct backup_file {
+    std::string path;
+    std::uint64_t size = 0;
+    std::filesystem::file_time_type modified;
+    int index = -1;  ///< Numeric suffix of size-based names, -1 for timestamps
+};
+
+/**
+ * @class backup_index
+ * @brief Backups in rotation order with their total size and used indices
+ *
+ * @details Filled from one directory scan and then kept current by the
+ * writer as it rotates, compresses and deletes, so none of those needs to
+ * list or stat the directory again. Not thread-safe.
+ */
+class backup_index {
+public:
+    /**
+     * @brief Replace the contents, ordering files by modification time
+     */
+    void assign(std::vector<backup_file> files);
+
+    /**
+     * @brief Record a new backup as the newest; replaces one with the same path
+     */
+    void add(backup_file file);
+
+    /**
+     * @brief Point an entry at its compressed copy, keeping its place
+     * @return false if path is not indexed (retention deleted it)
+     */
+    bool replace(const std::string& path, const std::string& new_path, std::uint64_t size);
+
+    [[nodiscard]] bool contains(const std::string& path) const {
+        return by_path_.count(path) != 0;
+    }
+
+    /**
+     * @brief Smallest suffix from 1 up that no backup uses
+     */
+    [[nodiscard]] int lowest_free_index() const;
+
+    /**
+     * @brief Drop the oldest backups until every limit holds
+     * @param max_files Backups to keep at most
+     * @param max_total_bytes Combined size to keep at most, 0 for no limit
+     * @param max_age Backups modified longer ago than this go, 0 for no limit
+     * @return Paths of the dropped backups, for the caller to delete
+     */
+    std::vector<std::string> evict(std::size_t max_files,
+                                   std::uint64_t max_total_bytes,
+                                   std::chrono::seconds max_age,
+                                   std::filesystem::file_time_type now);
+
+    [[nodiscard]] const std::list<backup_file>& files() const noexcept {
+        return files_;
+    }
+
+    [[nodiscard]] std::uint64_t total_bytes() const noexcept {
+        return total_bytes_;
+    }
+
+private:
+    void erase(std::list<backup_file>::iterator it);
+
+    std::list<backup_file> files_;  ///< Oldest first
+    std::unordered_map<std::string, std::list<backup_file>::iterator> by_path_;
+    std::multiset<int> indices_;    ///< A segment and its compressed copy may share one
+    std::uint64_t total_bytes_ = 0;
+};
+
+} // namespace kcenon::logger::detail
@@ -35,13 +35,26 @@ common::VoidResult batch_writer::write(const log_entry& entry) {
         return make_logger_void_result(logger_error_code::queue_stopped, "Batch writer is shutting down");
     }
 
+    log_entry copy = copy_log_entry(entry);
+    switch (reserve_entry(copy)) {
+    case budget_decision::dropped:
+        stats_.dropped_entries++;
+        return make_logger_void_result(logger_error_code::queue_overflow_dropped,
+                                       "Memory budget exceeded");
+    case budget_decision::spill:
+        return common::ok();
+    case budget_decision::admitted:
+    default:
+        break;
+    }
+
     bool should_flush = false;
 
     {
         std::lock_guard<std::mutex> lock(queue_mutex_);
 
         // Add entry to batch using shared helper
-        queue_.push_back(copy_log_entry(entry));
+        queue_.push_back(std::move(copy));
         stats_.total_entries++;
 
         // Check if we should flush
@@ -59,6 +72,45 @@ common::VoidResult batch_writer::write(const log_entry& entry) {
     return common::ok();
 }
 
+common::VoidResult batch_writer::write_batch(std::span<const log_entry> entries) {
+
+    if (shutting_down_) {
+        return make_logger_void_result(logger_error_code::queue_stopped, "Batch writer is shutting down");
+    }
+
+    std::unique_lock<std::mutex> lock(queue_mutex_);
+
+    common::VoidResult last_result = common::ok();
+    for (const auto& entry : entries) {
+        log_entry copy = copy_log_entry(entry);
+        if (!try_admit_entry(copy)) {
+            // Making room may flush this queue or wait for other writers,
+            // both of which need the lock released
+            lock.unlock();
+            const auto decision = reserve_entry(copy);
+            lock.lock();
+            if (decision != budget_decision::admitted) {
+                if (decision == budget_decision::dropped) {
+                    stats_.dropped_entries++;
+                }
+                continue;
+            }
+        }
+        queue_.push_back(std::move(copy));
+        stats_.total_entries++;
+
+        if (should_flush_by_size()) {
+            stats_.flush_on_size++;
+            auto result = flush_batch_unsafe();
+            if (result.is_err()) {
+                last_result = result;
+            }
+        }
+    }
+
+    return last_result;
+}
+
 common::VoidResult batch_writer::flush() {
     if (shutting_down_ && queue_.empty()) {
         return common::ok();
@@ -78,16 +130,11 @@ common::VoidResult batch_writer::flush_batch_unsafe() {
         return common::ok();
     }
 
-    // Write all entries in the batch
-    common::VoidResult last_result = common::ok();
-
-    for (const auto& entry : queue_) {
-        auto result = wrapped().write(entry);
-
-        if (result.is_err()) {
-            last_result = result;
-            stats_.dropped_entries++;
-        }
+    // Hand the whole batch to the underlying writer in one call; a failed
+    // batch counts all of its entries as dropped
+    common::VoidResult last_result = wrapped().write_batch(queue_);
+    if (last_result.is_err()) {
+        stats_.dropped_entries += queue_.size();
     }
 
     // Flush the underlying writer
@@ -100,6 +147,9 @@ common::VoidResult batch_writer::flush_batch_unsafe() {
     stats_.total_batches++;
 
     // Clear the batch
+    for (const auto& entry : queue_) {
+        release_entry(entry);
+    }
     queue_.clear();
     last_flush_time_ = std::chrono::steady_clock::now();
 
@@ -107,6 +157,20 @@ common::VoidResult batch_writer::flush_batch_unsafe() {
     return last_result;
 }
 
+budget_decision batch_writer::reserve_entry(const log_entry& copy) {
+    if (try_admit_entry(copy)) {
+        return budget_decision::admitted;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (!queue_.empty()) {
+            flush_batch_unsafe();
+        }
+    }
+    return admit_entry(copy);
+}
+
 std::string batch_writer::get_name() const {
     return "batch_writer[" + wrapped().get_name() + "]";
 }
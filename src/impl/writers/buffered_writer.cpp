@@ -12,6 +12,7 @@
 #include <kcenon/logger/writers/buffered_writer.h>
 
 #include <stdexcept>
+#include <utility>
 
 namespace kcenon::logger {
 
@@ -37,10 +38,23 @@ buffered_writer::~buffered_writer() {
 }
 
 common::VoidResult buffered_writer::write(const log_entry& entry) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    log_entry copy = copy_entry(entry);
+    const size_t bytes = budget_consumer::entry_bytes(copy);
+    switch (reserve_entry(copy, bytes)) {
+    case budget_decision::dropped:
+        return make_logger_void_result(logger_error_code::queue_overflow_dropped,
+                                       "Memory budget exceeded");
+    case budget_decision::spill:
+        return common::ok();
+    case budget_decision::admitted:
+    default:
+        break;
+    }
 
     // Add entry to buffer
-    buffer_.push_back(copy_entry(entry));
+    std::lock_guard<std::mutex> lock(mutex_);
+    buffer_.push_back(std::move(copy));
+    buffered_bytes_ += bytes;
     stats_.total_entries_written.fetch_add(1, std::memory_order_relaxed);
 
     // Check if we need to flush
@@ -63,6 +77,46 @@ common::VoidResult buffered_writer::write(const log_entry& entry) {
     return common::ok();
 }
 
+common::VoidResult buffered_writer::write_batch(std::span<const log_entry> entries) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    common::VoidResult first_error = common::ok();
+    for (const auto& entry : entries) {
+        log_entry copy = copy_entry(entry);
+        const size_t bytes = budget_consumer::entry_bytes(copy);
+        if (!budget_.try_admit(copy.level, bytes)) {
+            // Making room may flush this buffer or wait for other writers,
+            // both of which need the lock released
+            lock.unlock();
+            const auto decision = reserve_entry(copy, bytes);
+            lock.lock();
+            if (decision != budget_decision::admitted) {
+                continue;
+            }
+        }
+        buffer_.push_back(std::move(copy));
+        buffered_bytes_ += bytes;
+        if (buffer_.size() >= max_entries_) {
+            stats_.flush_on_full.fetch_add(1, std::memory_order_relaxed);
+            auto result = flush_buffer_unsafe();
+            if (result.is_err() && first_error.is_ok()) {
+                first_error = result;
+            }
+        }
+    }
+    stats_.total_entries_written.fetch_add(entries.size(), std::memory_order_relaxed);
+
+    if (!buffer_.empty() && should_flush_by_time()) {
+        stats_.flush_on_interval.fetch_add(1, std::memory_order_relaxed);
+        auto result = flush_buffer_unsafe();
+        if (result.is_err() && first_error.is_ok()) {
+            first_error = result;
+        }
+    }
+
+    return first_error;
+}
+
 common::VoidResult buffered_writer::flush() {
     std::lock_guard<std::mutex> lock(mutex_);
 
@@ -74,15 +128,14 @@ common::VoidResult buffered_writer::flush() {
 }
 
 common::VoidResult buffered_writer::flush_buffer_unsafe() {
-    // Write all buffered entries to wrapped writer
-    for (const auto& entry : buffer_) {
-        auto result = wrapped().write(entry);
-        if (result.is_err()) {
-            // Clear buffer even on error to avoid infinite retry
-            buffer_.clear();
-            last_flush_time_ = std::chrono::steady_clock::now();
-            return result;
-        }
+    // Write all buffered entries to wrapped writer in one call
+    auto result = wrapped().write_batch(buffer_);
+    budget_.release(std::exchange(buffered_bytes_, 0));
+    if (result.is_err()) {
+        // Clear buffer even on error to avoid infinite retry
+        buffer_.clear();
+        last_flush_time_ = std::chrono::steady_clock::now();
+        return result;
     }
 
     buffer_.clear();
@@ -106,6 +159,26 @@ bool buffered_writer::should_flush_by_time() const {
     return elapsed >= flush_interval_;
 }
 
+budget_decision buffered_writer::reserve_entry(const log_entry& copy, size_t bytes) {
+    if (budget_.try_admit(copy.level, bytes)) {
+        return budget_decision::admitted;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!buffer_.empty()) {
+            stats_.flush_on_budget.fetch_add(1, std::memory_order_relaxed);
+            flush_buffer_unsafe();
+        }
+    }
+
+    const auto decision = budget_.admit(copy.level, bytes);
+    if (decision == budget_decision::spill) {
+        budget_.spill(copy);
+    }
+    return decision;
+}
+
 log_entry buffered_writer::copy_entry(const log_entry& entry) {
     if (entry.location) {
         return log_entry(entry.level,
@@ -141,6 +214,11 @@ void buffered_writer::reset_stats() {
     stats_.flush_on_full.store(0, std::memory_order_relaxed);
     stats_.flush_on_interval.store(0, std::memory_order_relaxed);
     stats_.manual_flushes.store(0, std::memory_order_relaxed);
+    stats_.flush_on_budget.store(0, std::memory_order_relaxed);
+}
+
+budget_consumer_stats buffered_writer::get_budget_stats() const {
+    return budget_.get_stats();
 }
 
 std::unique_ptr<buffered_writer> make_buffered_writer(
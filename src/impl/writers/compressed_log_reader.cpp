@@ -0,0 +1,298 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include <kcenon/logger/writers/compressed_log_reader.h>
+#include "compressed_output.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#if defined(LOGGER_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+namespace kcenon::logger {
+
+namespace {
+
+using detail::frame_header_size;
+using detail::gzip_fixed_header;
+using detail::gzip_trailer_size;
+
+/// Bytes read per step while looking for the next member after damage
+constexpr std::size_t scan_chunk = 64 * 1024;
+/// Enough to identify a member: fixed header, XLEN and a subfield header
+constexpr std::size_t probe_size = gzip_fixed_header + 2 + 4;
+
+std::uint64_t get_le(const char* data, int bytes) {
+    std::uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Subfield id of a member written by compressed_output, or 0
+ * @param data probe_size bytes
+ */
+char member_kind(const char* data) {
+    if (std::memcmp(data, detail::frame_magic, sizeof(detail::frame_magic)) != 0 ||
+        data[12] != 'L' || (data[13] != 'F' && data[13] != 'X') ||
+        get_le(data + 10, 2) != get_le(data + 14, 2) + 4) {
+        return 0;
+    }
+    return data[13];
+}
+
+/**
+ * @brief Whether a member of this size can hold a frame of size bytes
+ *
+ * Sizes come from the file, so one that deflate could not have produced
+ * marks a damaged header rather than an allocation to make.
+ */
+bool plausible_frame(std::uint64_t member, std::uint64_t size) {
+    return member >= frame_header_size + gzip_trailer_size &&
+           size <= (member - frame_header_size - gzip_trailer_size) * detail::max_deflate_ratio;
+}
+
+} // namespace
+
+common::VoidResult compressed_log_reader::open(const std::string& path) {
+    file_.close();
+    file_.clear();
+    frames_.clear();
+    skipped_bytes_ = 0;
+
+    std::error_code ec;
+    file_size_ = std::filesystem::file_size(path, ec);
+    file_.open(path, std::ios::binary);
+    if (ec || !file_.is_open()) {
+        return make_logger_void_result(logger_error_code::file_open_failed,
+                                       "Failed to open compressed log: " + path);
+    }
+
+    // The footer indexes the last session; anything before it is walked
+    if (!read_footer()) {
+        walk(0, file_size_);
+    }
+    if (file_.bad()) {
+        return make_logger_void_result(logger_error_code::file_read_failed,
+                                       "Failed to read compressed log: " + path);
+    }
+    return common::ok();
+}
+
+std::uint64_t compressed_log_reader::size() const noexcept {
+    return frames_.empty() ? 0 : frames_.back().position + frames_.back().size;
+}
+
+std::size_t compressed_log_reader::frame_at(std::uint64_t position) const noexcept {
+    auto it = std::upper_bound(frames_.begin(), frames_.end(), position,
+        [](std::uint64_t value, const compressed_frame& frame) { return value < frame.position; });
+    if (it == frames_.begin()) {
+        return frames_.size();
+    }
+    --it;
+    return position < it->position + it->size ? static_cast<std::size_t>(it - frames_.begin())
+                                               : frames_.size();
+}
+
+result<std::string> compressed_log_reader::read_frame(std::size_t index) {
+    if (index >= frames_.size()) {
+        return result<std::string>(logger_error_code::invalid_argument, "Frame index out of range");
+    }
+#if defined(LOGGER_HAS_ZLIB)
+    const auto& frame = frames_[index];
+    if (frame.offset + frame.member_size > file_size_ ||
+        !plausible_frame(frame.member_size, frame.size)) {
+        return result<std::string>(logger_error_code::file_read_failed,
+                                   "Corrupt frame at offset " + std::to_string(frame.offset));
+    }
+    std::string member(frame.member_size, '\0');
+    if (!read_at(frame.offset, member.data(), member.size())) {
+        return result<std::string>(logger_error_code::file_read_failed,
+                                   "Failed to read frame at offset " + std::to_string(frame.offset));
+    }
+
+    // 16 added to the window bits: expect the gzip wrapper and check its CRC
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 16) != Z_OK) {
+        return result<std::string>(logger_error_code::file_read_failed, "inflateInit2 failed");
+    }
+    std::string text(frame.size, '\0');
+    stream.next_in = reinterpret_cast<Bytef*>(member.data());
+    stream.avail_in = static_cast<uInt>(member.size());
+    stream.next_out = reinterpret_cast<Bytef*>(text.data());
+    stream.avail_out = static_cast<uInt>(text.size());
+    const int rc = inflate(&stream, Z_FINISH);
+    const bool complete = rc == Z_STREAM_END && stream.avail_out == 0 && stream.avail_in == 0;
+    inflateEnd(&stream);
+    if (!complete) {
+        return result<std::string>(logger_error_code::file_read_failed,
+                                   "Corrupt frame at offset " + std::to_string(frame.offset));
+    }
+    return result<std::string>(std::move(text));
+#else
+    return result<std::string>(logger_error_code::file_read_failed,
+                               "Built without zlib, cannot decompress frames");
+#endif
+}
+
+result<std::string> compressed_log_reader::read(std::uint64_t position, std::size_t length) {
+    std::string text;
+    const std::uint64_t end = std::min<std::uint64_t>(position + length, size());
+    for (std::size_t index = frame_at(position); index < frames_.size() && position < end; ++index) {
+        auto frame = read_frame(index);
+        if (!frame) {
+            return frame;
+        }
+        const auto& frame_text = frame.value();
+        const std::uint64_t skip = position - frames_[index].position;
+        const std::uint64_t take = std::min<std::uint64_t>(end - position, frame_text.size() - skip);
+        text.append(frame_text, static_cast<std::size_t>(skip), static_cast<std::size_t>(take));
+        position += take;
+    }
+    return result<std::string>(std::move(text));
+}
+
+bool compressed_log_reader::read_at(std::uint64_t offset, char* data, std::size_t size) {
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(offset));
+    file_.read(data, static_cast<std::streamsize>(size));
+    return static_cast<std::size_t>(file_.gcount()) == size;
+}
+
+/**
+ * @brief List the frames through an index member that ends the file
+ * @return false if the file does not end with a consistent index
+ */
+bool compressed_log_reader::read_footer() {
+    const std::size_t largest = detail::footer_overhead + 8 * detail::max_footer_entries;
+    const auto tail_size = static_cast<std::size_t>(std::min<std::uint64_t>(file_size_, largest));
+    if (tail_size < detail::footer_overhead) {
+        return false;
+    }
+    std::string tail(tail_size, '\0');
+    if (!read_at(file_size_ - tail_size, tail.data(), tail.size())) {
+        return false;
+    }
+
+    // The footer's own length fixes where it starts, so try each entry count
+    for (std::size_t count = 1; count <= detail::max_footer_entries; ++count) {
+        const std::size_t length = detail::footer_overhead + 8 * count;
+        if (length > tail_size) {
+            break;
+        }
+        const char* footer = tail.data() + tail_size - length;
+        if (member_kind(footer) != 'X' || get_le(footer + 14, 2) != 8 + 8 * count) {
+            continue;
+        }
+
+        const std::uint64_t footer_offset = file_size_ - length;
+        const std::uint64_t first_offset = get_le(footer + probe_size, 8);
+        std::uint64_t offset = first_offset;
+        const char* entry = footer + probe_size + 8;
+        for (std::size_t i = 0; i < count; ++i, entry += 8) {
+            offset += get_le(entry, 4);
+        }
+        if (first_offset > footer_offset || offset != footer_offset) {
+            return false;
+        }
+
+        std::vector<compressed_frame> indexed;
+        offset = first_offset;
+        entry = footer + probe_size + 8;
+        for (std::size_t i = 0; i < count; ++i, entry += 8) {
+            const auto member = static_cast<std::uint32_t>(get_le(entry, 4));
+            if (!plausible_frame(member, get_le(entry + 4, 4))) {
+                return false;
+            }
+            indexed.push_back({offset, member, 0, static_cast<std::uint32_t>(get_le(entry + 4, 4))});
+            offset += member;
+        }
+
+        // Frames before the index are walked first; positions follow them
+        walk(0, first_offset);
+        for (const auto& frame : indexed) {
+            add_frame(frame.offset, frame.member_size, frame.size);
+        }
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief List the complete frames between two offsets by their headers
+ *
+ * Index members are stepped over; bytes that are not a whole member
+ * (a frame torn by a crash) are skipped up to the next recognisable one.
+ */
+void compressed_log_reader::walk(std::uint64_t from, std::uint64_t to) {
+    std::uint64_t offset = from;
+    char probe[frame_header_size];
+    while (offset < to) {
+        std::uint64_t member = 0;
+        if (to - offset >= probe_size && read_at(offset, probe, probe_size)) {
+            const char kind = member_kind(probe);
+            if (kind == 'F' && get_le(probe + 14, 2) == 8 &&
+                read_at(offset + probe_size, probe + probe_size, 8)) {
+                member = get_le(probe + probe_size, 4);
+                if (plausible_frame(member, get_le(probe + probe_size + 4, 4)) &&
+                    member <= to - offset) {
+                    add_frame(offset, static_cast<std::uint32_t>(member),
+                              static_cast<std::uint32_t>(get_le(probe + probe_size + 4, 4)));
+                } else {
+                    member = 0;
+                }
+            } else if (kind == 'X') {
+                member = gzip_fixed_header + 2 + get_le(probe + 10, 2) +
+                         sizeof(detail::empty_deflate) + gzip_trailer_size;
+                member = member <= to - offset ? member : 0;
+            }
+        }
+
+        if (member == 0) {
+            const std::uint64_t next = find_member(offset + 1, to);
+            skipped_bytes_ += next - offset;
+            offset = next;
+        } else {
+            offset += member;
+        }
+    }
+}
+
+/**
+ * @brief Offset of the first member header in [from, to), or to
+ */
+std::uint64_t compressed_log_reader::find_member(std::uint64_t from, std::uint64_t to) {
+    std::string window;
+    for (std::uint64_t start = from; start < to;) {
+        const auto length = static_cast<std::size_t>(
+            std::min<std::uint64_t>(scan_chunk + probe_size, to - start));
+        window.resize(length);
+        if (!read_at(start, window.data(), length)) {
+            return to;
+        }
+        for (std::size_t i = 0; i + probe_size <= length; ++i) {
+            if (window[i] == '\x1f' && member_kind(window.data() + i) != 0) {
+                return start + i;
+            }
+        }
+        if (length < scan_chunk + probe_size) {
+            break;
+        }
+        start += scan_chunk;
+    }
+    return to;
+}
+
+void compressed_log_reader::add_frame(std::uint64_t offset,
+                                      std::uint32_t member_size,
+                                      std::uint32_t size) {
+    frames_.push_back({offset, member_size, this->size(), size});
+}
+
+} // namespace kcenon::logger
@@ -0,0 +1,436 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include "compressed_output.h"
+#include "fd_io.h"
+
+#include <algorithm>
+#include <climits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(LOGGER_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+namespace kcenon::logger::detail {
+
+#if defined(LOGGER_HAS_ZLIB)
+
+namespace {
+
+constexpr std::size_t min_frame_size = 64 * 1024;
+/// Keeps every member size within the u32 of its header
+constexpr std::size_t max_frame_size = 1024 * 1024 * 1024;
+
+void put_le(std::pmr::string& out, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out += static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+}
+
+void put_le_at(std::pmr::string& out, std::size_t at, std::uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out[at + static_cast<std::size_t>(i)] = static_cast<char>((value >> (8 * i)) & 0xff);
+    }
+}
+
+void put_gzip_header(std::pmr::string& out, std::size_t xlen) {
+    out.append(reinterpret_cast<const char*>(frame_magic), sizeof(frame_magic));
+    out.append(4, '\0');    // MTIME: none, so identical input gives identical frames
+    out += '\0';            // XFL
+    out += '\xff';          // OS: unknown
+    put_le(out, xlen, 2);
+}
+
+/**
+ * @brief Compresses committed records into gzip members on the inner output
+ *
+ * @details Each commit() deflates the new bytes straight away, so the cost
+ * is spread over the records instead of landing on the one that ends a
+ * frame. Compressed bytes go into the inner output's buffer behind a
+ * placeholder header that is filled in when the frame ends; only then is
+ * the inner output committed and flushed, so the file only ever grows by
+ * whole members and a crash loses at most the frame being built.
+ */
+class compressed_output final : public file_output {
+public:
+    compressed_output(std::unique_ptr<file_output> inner, const file_output_options& options)
+        : inner_(std::move(inner))
+        , level_(std::clamp(options.compression_level, 1, 9))
+        , frame_size_(std::clamp(options.frame_size, min_frame_size, max_frame_size))
+        , flush_interval_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+              options.flush_interval).count()) {}
+
+    ~compressed_output() override {
+        close();
+        if (stream_ready_) {
+            deflateEnd(&stream_);
+        }
+    }
+
+    common::VoidResult open(const std::string& path, bool append) override {
+        auto result = inner_->open(path, append);
+        if (result.is_err()) {
+            return result;
+        }
+
+        if (!stream_ready_) {
+            // Negative window bits: raw deflate, the member wrapper is ours
+            if (deflateInit2(&stream_, level_, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+                inner_->close();
+                return make_logger_void_result(logger_error_code::file_compression_failed,
+                                               "deflateInit2 failed");
+            }
+            stream_ready_ = true;
+        } else {
+            deflateReset(&stream_);
+        }
+
+        input_.clear();
+        index_.clear();
+        offset_ = inner_->opened_size();
+        frame_open_ = false;
+        failed_ = false;
+        return common::ok();
+    }
+
+    common::VoidResult close() override {
+        if (!inner_->is_open()) {
+            return common::ok();
+        }
+        auto result = end_frame();
+        auto footer = write_footer();
+        auto closed = inner_->close();
+        if (result.is_err()) {
+            return result;
+        }
+        return footer.is_err() ? footer : closed;
+    }
+
+    bool is_open() const noexcept override {
+        return inner_->is_open();
+    }
+
+    bool good() const noexcept override {
+        return !failed_ && inner_->good();
+    }
+
+    std::uint64_t opened_size() const noexcept override {
+        return inner_->opened_size();
+    }
+
+    std::uint64_t stored_size() const noexcept override {
+        // The open frame sits in the inner buffer until it ends
+        return offset_ + (frame_open_ ? inner_->buffer().size() - header_at_ : 0);
+    }
+
+    std::pmr::string& buffer() noexcept override {
+        return input_;
+    }
+
+    common::VoidResult commit() override {
+        auto result = compress_input();
+        if (result.is_err() || !frame_open_) {
+            return result;
+        }
+        if (frame_bytes_ >= frame_size_ ||
+            (flush_interval_ns_ > 0 && monotonic_ns() - frame_started_ns_ >= flush_interval_ns_)) {
+            return end_frame();
+        }
+        return common::ok();
+    }
+
+    common::VoidResult flush() override {
+        auto result = compress_input();
+        if (result.is_ok()) {
+            result = end_frame();
+        }
+        return result;
+    }
+
+    common::VoidResult sync() override {
+        auto result = flush();
+        if (result.is_err()) {
+            return result;
+        }
+        return inner_->sync();
+    }
+
+    file_output_mode mode() const noexcept override {
+        return inner_->mode();
+    }
+
+    int native_handle() const noexcept override {
+        return inner_->native_handle();
+    }
+
+private:
+    common::VoidResult fail(const char* what) {
+        failed_ = true;
+        // Drop the broken member rather than leave half of it in the file
+        if (frame_open_) {
+            inner_->buffer().resize(header_at_);
+            deflateReset(&stream_);
+            frame_open_ = false;
+        }
+        input_.clear();
+        return make_logger_void_result(logger_error_code::file_compression_failed,
+                                       std::string("Frame compression failed: ") + what);
+    }
+
+    /**
+     * @brief Run deflate until it has consumed its input (or finished the stream)
+     */
+    bool deflate_into(std::pmr::string& out, int flush) {
+        int rc = Z_OK;
+        do {
+            stream_.next_out = reinterpret_cast<Bytef*>(chunk_);
+            stream_.avail_out = sizeof(chunk_);
+            rc = deflate(&stream_, flush);
+            if (rc == Z_STREAM_ERROR || (flush == Z_FINISH && rc == Z_BUF_ERROR)) {
+                return false;
+            }
+            out.append(chunk_, sizeof(chunk_) - stream_.avail_out);
+        } while (stream_.avail_out == 0 || (flush == Z_FINISH && rc != Z_STREAM_END));
+        return true;
+    }
+
+    common::VoidResult compress_input() {
+        if (input_.empty()) {
+            return common::ok();
+        }
+        if (!inner_->is_open()) {
+            input_.clear();
+            return make_logger_void_result(logger_error_code::file_write_failed, "File is not open");
+        }
+
+        auto& out = inner_->buffer();
+        if (!frame_open_) {
+            // Sizes are filled in by end_frame()
+            header_at_ = out.size();
+            put_gzip_header(out, 4 + 8);
+            out += 'L';
+            out += 'F';
+            put_le(out, 8, 2);
+            out.append(8, '\0');
+            crc_ = crc32(0, nullptr, 0);
+            frame_bytes_ = 0;
+            frame_started_ns_ = monotonic_ns();
+            frame_open_ = true;
+        }
+
+        const char* data = input_.data();
+        std::size_t left = input_.size();
+        while (left > 0) {
+            const auto piece = static_cast<uInt>(std::min<std::size_t>(left, UINT_MAX));
+            crc_ = crc32(crc_, reinterpret_cast<const Bytef*>(data), piece);
+            stream_.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            stream_.avail_in = piece;
+            if (!deflate_into(out, Z_NO_FLUSH)) {
+                return fail("deflate");
+            }
+            data += piece;
+            left -= piece;
+        }
+        frame_bytes_ += input_.size();
+        input_.clear();
+        return common::ok();
+    }
+
+    /**
+     * @brief Finish the current member, fill in its header and write it out
+     */
+    common::VoidResult end_frame() {
+        if (!frame_open_) {
+            return common::ok();
+        }
+
+        auto& out = inner_->buffer();
+        stream_.next_in = nullptr;
+        stream_.avail_in = 0;
+        if (!deflate_into(out, Z_FINISH)) {
+            return fail("deflate finish");
+        }
+        put_le(out, crc_, 4);
+        put_le(out, frame_bytes_ & 0xffffffffu, 4);  // ISIZE is the size modulo 2^32
+
+        const std::size_t member = out.size() - header_at_;
+        if (member > UINT32_MAX || frame_bytes_ > UINT32_MAX) {
+            return fail("frame too large");
+        }
+        put_le_at(out, header_at_ + frame_header_size - 8, member, 4);
+        put_le_at(out, header_at_ + frame_header_size - 4, frame_bytes_, 4);
+
+        deflateReset(&stream_);
+        frame_open_ = false;
+        index_.push_back({static_cast<std::uint32_t>(member),
+                          static_cast<std::uint32_t>(frame_bytes_)});
+        offset_ += member;
+
+        auto result = inner_->commit();
+        if (result.is_ok()) {
+            result = inner_->flush();
+        }
+        return result;
+    }
+
+    /**
+     * @brief Append the index of this session's frames as an empty member
+     *
+     * Sessions with more frames than one subfield can hold index only the
+     * most recent ones; a reader walks the member headers before those.
+     */
+    common::VoidResult write_footer() {
+        if (index_.empty() || !good()) {
+            return common::ok();
+        }
+
+        const std::size_t count = std::min(index_.size(), max_footer_entries);
+        const auto first = index_.end() - static_cast<std::ptrdiff_t>(count);
+        std::uint64_t first_offset = offset_;
+        for (auto it = first; it != index_.end(); ++it) {
+            first_offset -= it->member;
+        }
+
+        const std::size_t data = 8 + 8 * count;
+        auto& out = inner_->buffer();
+        put_gzip_header(out, 4 + data);
+        out += 'L';
+        out += 'X';
+        put_le(out, data, 2);
+        put_le(out, first_offset, 8);
+        for (auto it = first; it != index_.end(); ++it) {
+            put_le(out, it->member, 4);
+            put_le(out, it->size, 4);
+        }
+        out.append(reinterpret_cast<const char*>(empty_deflate), sizeof(empty_deflate));
+        out.append(gzip_trailer_size, '\0');  // CRC32 and ISIZE of no data
+
+        auto result = inner_->commit();
+        if (result.is_ok()) {
+            result = inner_->flush();
+        }
+        return result;
+    }
+
+    struct frame_entry {
+        std::uint32_t member;
+        std::uint32_t size;
+    };
+
+    std::unique_ptr<file_output> inner_;
+    int level_;
+    std::size_t frame_size_;
+    std::int64_t flush_interval_ns_;
+
+    std::pmr::string input_;
+    z_stream stream_{};
+    bool stream_ready_ = false;
+    bool failed_ = false;
+    char chunk_[16 * 1024];
+
+    bool frame_open_ = false;
+    std::size_t header_at_ = 0;       ///< Offset of the open frame in the inner buffer
+    std::uint64_t frame_bytes_ = 0;   ///< Uncompressed bytes in the open frame
+    std::int64_t frame_started_ns_ = 0;
+    uLong crc_ = 0;
+
+    std::uint64_t offset_ = 0;        ///< File offset where the next member starts
+    std::vector<frame_entry> index_;  ///< Frames written since open()
+};
+
+} // namespace
+
+#endif // LOGGER_HAS_ZLIB
+
+namespace {
+
+/**
+ * @brief Stands in for a compressed output this build cannot write
+ *
+ * open() always fails, so a writer asked for it reports the error instead
+ * of silently writing the file uncompressed or in another format.
+ */
+class unsupported_output final : public file_output {
+public:
+    unsupported_output(std::unique_ptr<file_output> inner, std::string reason)
+        : inner_(std::move(inner)), reason_(std::move(reason)) {}
+
+    common::VoidResult open(const std::string& path, bool) override {
+        return make_logger_void_result(logger_error_code::file_compression_failed,
+                                       reason_ + ": " + path);
+    }
+
+    common::VoidResult close() override {
+        return common::ok();
+    }
+
+    bool is_open() const noexcept override {
+        return false;
+    }
+
+    bool good() const noexcept override {
+        return false;
+    }
+
+    std::uint64_t opened_size() const noexcept override {
+        return 0;
+    }
+
+    std::uint64_t stored_size() const noexcept override {
+        return 0;
+    }
+
+    std::pmr::string& buffer() noexcept override {
+        return inner_->buffer();
+    }
+
+    common::VoidResult commit() override {
+        inner_->buffer().clear();
+        return make_logger_void_result(logger_error_code::file_write_failed, "File is not open");
+    }
+
+    common::VoidResult flush() override {
+        return common::ok();
+    }
+
+    common::VoidResult sync() override {
+        return commit();
+    }
+
+    file_output_mode mode() const noexcept override {
+        return inner_->mode();
+    }
+
+    int native_handle() const noexcept override {
+        return -1;
+    }
+
+private:
+    std::unique_ptr<file_output> inner_;
+    std::string reason_;
+};
+
+} // namespace
+
+std::unique_ptr<file_output> make_compressed_output(std::unique_ptr<file_output> inner,
+                                                    const file_output_options& options) {
+    if (options.compression == compression_codec::none) {
+        return inner;
+    }
+    if (options.compression != compression_codec::gzip) {
+        return std::make_unique<unsupported_output>(
+            std::move(inner), "Compressed output only supports gzip");
+    }
+#if defined(LOGGER_HAS_ZLIB)
+    return std::make_unique<compressed_output>(std::move(inner), options);
+#else
+    return std::make_unique<unsupported_output>(
+        std::move(inner), "Compressed output needs zlib, which this build lacks");
+#endif
+}
+
+} // namespace kcenon::logger::detail
@@ -0,0 +1,58 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file compressed_output.h
+ * @brief file_output decorator writing the file as independent gzip members
+ * @since 4.1.0
+ *
+ * @details Layout shared by the writer and compressed_log_reader. Every
+ * frame is a complete gzip member whose header carries an FEXTRA subfield
+ * 'L','F' of 8 bytes: the member's total size and the frame's uncompressed
+ * size, both little-endian u32. A session that closes cleanly ends with an
+ * empty member whose FEXTRA subfield 'L','X' holds the offset of the first
+ * frame it indexes (u64) followed by one (member size, uncompressed size)
+ * pair per frame, up to the end of the footer. gzip tools skip both
+ * subfields, so the file still decompresses with zcat and greps with zgrep.
+ *
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <kcenon/logger/writers/file_output.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace kcenon::logger::detail {
+
+/// Fixed gzip header: magic, CM=deflate, FLG=FEXTRA, MTIME, XFL, OS=unknown
+inline constexpr unsigned char frame_magic[] = {0x1f, 0x8b, 0x08, 0x04};
+inline constexpr std::size_t gzip_fixed_header = 10;
+/// Fixed header, XLEN and one 'L','F' subfield
+inline constexpr std::size_t frame_header_size = gzip_fixed_header + 2 + 4 + 8;
+/// CRC32 and ISIZE
+inline constexpr std::size_t gzip_trailer_size = 8;
+/// Deflate encoding of an empty final stored block
+inline constexpr unsigned char empty_deflate[] = {0x03, 0x00};
+/// Bytes of a footer besides its index entries
+inline constexpr std::size_t footer_overhead =
+    gzip_fixed_header + 2 + 4 + 8 + sizeof(empty_deflate) + gzip_trailer_size;
+/// Upper bound of deflate's compression ratio, used to reject implausible frame sizes
+inline constexpr std::uint64_t max_deflate_ratio = 1032;
+/// A subfield is at most 65535 bytes including its own 4-byte header
+inline constexpr std::size_t max_footer_entries = (65535 - 4 - 8) / 8;
+
+/**
+ * @brief Wrap inner so everything committed is written as compressed frames
+ * @return inner itself when options.compression is none; an output whose
+ *         open() fails with file_compression_failed for zstd, or for gzip
+ *         in a build without zlib
+ */
+std::unique_ptr<file_output> make_compressed_output(std::unique_ptr<file_output> inner,
+                                                    const file_output_options& options);
+
+} // namespace kcenon::logger::detail
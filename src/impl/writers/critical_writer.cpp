@@ -3,6 +3,7 @@
 // See the LICENSE file in the project root for full license information.
 
 #include <kcenon/logger/writers/critical_writer.h>
+#include <kcenon/logger/writers/file_writer.h>
 #include <kcenon/logger/core/error_codes.h>
 #include <kcenon/logger/utils/error_handling_utils.h>
 #include <kcenon/logger/utils/string_utils.h>
@@ -10,6 +11,9 @@
 #include <sstream>
 #include <iomanip>
 #include <ctime>
+#include <cstring>
+
+#include "fd_io.h"
 
 #ifdef _WIN32
 #include <io.h>       // For _flushall()
@@ -21,6 +25,17 @@
 
 namespace kcenon::logger {
 
+namespace {
+
+void store_max(std::atomic<uint64_t>& target, uint64_t value) {
+    auto current = target.load(std::memory_order_relaxed);
+    while (current < value &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
 critical_writer::critical_writer(
     log_writer_ptr wrapped_writer,
     critical_writer_config config
@@ -59,6 +74,14 @@ critical_writer::critical_writer(
                       << wal_result.error().message << std::endl;
             wal_stream_.reset();
         }
+
+#if LOGGER_HAS_POSIX_FD
+        // std::ofstream hides its descriptor; syncing any descriptor of
+        // the file writes back the same dirty pages
+        if (wal_stream_) {
+            wal_fd_ = ::open(config_.wal_path.c_str(), O_WRONLY | O_CLOEXEC);
+        }
+#endif
     }
 
 }
@@ -78,6 +101,12 @@ critical_writer::~critical_writer() {
             wal_stream_->close();
         });
     }
+
+#if LOGGER_HAS_POSIX_FD
+    if (wal_fd_ >= 0) {
+        ::close(wal_fd_);
+    }
+#endif
 }
 
 common::VoidResult critical_writer::write(const log_entry& entry) {
@@ -101,6 +130,10 @@ common::VoidResult critical_writer::write(const log_entry& entry) {
     // Check if this is a critical level
     const bool is_critical = is_critical_level(level);
 
+    if (is_critical && config_.sync_on_critical && config_.group_commit) {
+        return write_group_committed(entry);
+    }
+
     if (is_critical) {
         // Acquire exclusive lock for critical writes
         std::lock_guard<std::mutex> lock(critical_mutex_);
@@ -123,8 +156,13 @@ common::VoidResult critical_writer::write(const log_entry& entry) {
 
         // Sync file descriptor if configured
         if (config_.sync_on_critical) {
-            sync_file_descriptor();
+            auto sync_result = sync_file_descriptor();
             stats_.sync_calls.fetch_add(1, std::memory_order_relaxed);
+            stats_.synced_writes.fetch_add(1, std::memory_order_relaxed);
+            store_max(stats_.max_epoch_writes, 1);
+            if (flush_result.is_ok() && sync_result.is_err()) {
+                flush_result = sync_result;
+            }
         }
 
         stats_.total_critical_writes.fetch_add(1, std::memory_order_relaxed);
@@ -135,6 +173,112 @@ common::VoidResult critical_writer::write(const log_entry& entry) {
     return wrapped_writer_->write(entry);
 }
 
+common::VoidResult critical_writer::write_group_committed(const log_entry& entry) {
+    // Announce the write so a sync leader waiting for joiners holds its
+    // sync until it is flushed
+    {
+        std::lock_guard<std::mutex> lock(sync_mutex_);
+        ++writes_in_progress_;
+    }
+
+    common::VoidResult result = common::ok();
+    uint64_t ticket = 0;
+    {
+        std::lock_guard<std::mutex> lock(critical_mutex_);
+
+        if (wal_stream_ && wal_stream_->is_open()) {
+            write_to_wal(entry);
+            stats_.wal_writes.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        result = wrapped_writer_->write(entry);
+        if (result.is_ok()) {
+            result = wrapped_writer_->flush();
+            stats_.total_flushes.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Issued while still holding critical_mutex_, so tickets follow
+        // the order the writes reached the wrapped writer
+        std::lock_guard<std::mutex> sync_lock(sync_mutex_);
+        --writes_in_progress_;
+        if (result.is_ok()) {
+            ticket = ++written_ticket_;
+        }
+        if (writes_in_progress_ == 0) {
+            write_joined_.notify_all();
+        }
+    }
+
+    if (result.is_err()) {
+        return result;
+    }
+
+    // The sync runs outside critical_mutex_, so writes keep reaching the
+    // wrapped writer and queue up for the next epoch meanwhile
+    result = wait_for_sync(ticket);
+    stats_.total_critical_writes.fetch_add(1, std::memory_order_relaxed);
+    return result;
+}
+
+common::VoidResult critical_writer::wait_for_sync(uint64_t ticket) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::unique_lock<std::mutex> lock(sync_mutex_);
+    while (synced_ticket_ < ticket) {
+        if (sync_running_) {
+            // The running sync may have started before this write was
+            // flushed; wait for it and check again
+            sync_done_.wait(lock);
+            continue;
+        }
+
+        sync_running_ = true;
+        if (config_.max_sync_delay_us > 0) {
+            write_joined_.wait_for(lock, std::chrono::microseconds(config_.max_sync_delay_us),
+                                   [this] { return writes_in_progress_ == 0; });
+        }
+
+        // Every ticket issued so far belongs to a flushed write
+        const uint64_t first = synced_ticket_ + 1;
+        const uint64_t target = written_ticket_;
+        const uint64_t epoch_writes = target - synced_ticket_;
+        lock.unlock();
+
+        auto result = sync_file_descriptor();
+        stats_.sync_calls.fetch_add(1, std::memory_order_relaxed);
+        stats_.synced_writes.fetch_add(epoch_writes, std::memory_order_relaxed);
+        store_max(stats_.max_epoch_writes, epoch_writes);
+
+        lock.lock();
+        if (result.is_err()) {
+            // A waiter may wake after later epochs; keep this one's error
+            // for each write it covered
+            failed_syncs_.push_back({first, target, epoch_writes, std::move(result)});
+        }
+        synced_ticket_ = target;
+        sync_running_ = false;
+        sync_done_.notify_all();
+    }
+
+    common::VoidResult result = common::ok();
+    for (auto it = failed_syncs_.begin(); it != failed_syncs_.end(); ++it) {
+        if (ticket >= it->first_ticket && ticket <= it->last_ticket) {
+            result = it->result;
+            if (--it->unreported == 0) {
+                failed_syncs_.erase(it);
+            }
+            break;
+        }
+    }
+    lock.unlock();
+
+    const auto waited = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+    stats_.total_sync_wait_us.fetch_add(waited, std::memory_order_relaxed);
+    store_max(stats_.max_sync_wait_us, waited);
+    return result;
+}
+
 common::VoidResult critical_writer::flush() {
     std::lock_guard<std::mutex> lock(critical_mutex_);
 
@@ -223,32 +367,34 @@ void critical_writer::write_to_wal(const log_entry& entry) {
     }
 }
 
-void critical_writer::sync_file_descriptor() {
+common::VoidResult critical_writer::sync_file_descriptor() {
+    // A file writer makes its own output durable (fdatasync); the WAL
+    // stream is flushed by every write_to_wal(), so only its descriptor
+    // needs syncing here. Neither touches state guarded by critical_mutex_.
+    common::VoidResult result = common::ok();
+    if (auto* file = dynamic_cast<file_writer*>(wrapped_writer_.get())) {
+        result = file->sync();
+    } else {
 #ifdef _WIN32
-    // Windows: Use _commit() to flush file buffers to disk
-    // Note: std::ofstream doesn't expose HANDLE, so we flush the stream
-    // For a complete implementation, would need native Windows file handling
-    if (wal_stream_) {
-        wal_stream_->flush();
-    }
-    // Could use _flushall() to flush all open streams, but it's global
-    ::_flushall();
+        // std::ofstream doesn't expose HANDLE; _flushall() flushes all
+        // open CRT streams
+        ::_flushall();
 #elif defined(__unix__) || defined(__APPLE__)
-    // POSIX: Use fsync() to synchronize file to disk
-    // Get file descriptor from wrapped writer if it's a file writer
-    // This is a simplified implementation - actual implementation would need
-    // to query the wrapped writer for its file descriptor
-
-    // For now, sync stdout/stderr as fallback
-    ::fsync(STDOUT_FILENO);
-    ::fsync(STDERR_FILENO);
+        // Other writers don't expose a descriptor; sync stdout/stderr
+        ::fsync(STDOUT_FILENO);
+        ::fsync(STDERR_FILENO);
+#endif
+    }
 
-    // Sync WAL
-    if (wal_stream_) {
-        wal_stream_->flush();
-        // Note: std::ofstream doesn't expose fd, would need native file handling
+#if LOGGER_HAS_POSIX_FD
+    if (wal_fd_ >= 0) {
+        if (const int error = detail::sync_fd(wal_fd_); error != 0 && result.is_ok()) {
+            result = make_logger_void_result(logger_error_code::file_write_failed,
+                                             std::string("WAL sync failed: ") + std::strerror(error));
+        }
     }
 #endif
+    return result;
 }
 
 // ============================================================================
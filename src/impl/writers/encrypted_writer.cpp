@@ -85,31 +85,8 @@ common::VoidResult encrypted_writer::write(const log_entry& entry) {
     }
 
     // Format the log entry first
-    std::ostringstream oss;
-    auto time_t_val = std::chrono::system_clock::to_time_t(entry.timestamp);
-    std::tm tm_val;
-#ifdef _WIN32
-    localtime_s(&tm_val, &time_t_val);
-#else
-    localtime_r(&time_t_val, &tm_val);
-#endif
-
-    // Convert log_level from logger_system to common::interfaces
     auto level = static_cast<common::interfaces::log_level>(static_cast<int>(entry.level));
-
-    oss << std::put_time(&tm_val, "%Y-%m-%dT%H:%M:%S")
-        << " [" << static_cast<int>(level) << "] "
-        << entry.message.to_string();
-
-    if (entry.location) {
-        std::string file = entry.location->file.to_string();
-        std::string function = entry.location->function.to_string();
-        if (!file.empty()) {
-            oss << " (" << file << ":" << entry.location->line << " " << function << ")";
-        }
-    }
-
-    std::string plaintext = oss.str();
+    std::string plaintext = format_plaintext(entry);
 
     // Encrypt the formatted log entry
     std::vector<uint8_t> encrypted_data;
@@ -117,6 +94,7 @@ common::VoidResult encrypted_writer::write(const log_entry& entry) {
         std::lock_guard lock(write_mutex_);
         auto encrypt_result = encrypt_data(plaintext, encrypted_data);
         if (encrypt_result.is_err()) {
+            entries_dropped_.fetch_add(1);
             return encrypt_result;
         }
     }
@@ -137,6 +115,93 @@ common::VoidResult encrypted_writer::write(const log_entry& entry) {
 }
 
 
+common::VoidResult encrypted_writer::write_batch(std::span<const log_entry> entries) {
+    if (!is_initialized_.load()) {
+        return make_logger_void_result(
+            logger_error_code::encryption_failed,
+            "encrypted_writer not initialized"
+        );
+    }
+    if (entries.empty()) {
+        return common::ok();
+    }
+
+    // Check for automatic key rotation once per batch
+    auto rotate_result = auto_rotate_key_if_needed();
+    if (rotate_result.is_err()) {
+        security::audit_logger::log_audit_event(
+            security::audit_logger::audit_event::suspicious_activity,
+            "Key rotation failed",
+            {{"error", get_logger_error_message(rotate_result)}}
+        );
+    }
+
+    std::vector<log_entry> encrypted_entries;
+    encrypted_entries.reserve(entries.size());
+    common::VoidResult encrypt_error = common::ok();
+    {
+        std::lock_guard lock(write_mutex_);
+        std::vector<uint8_t> encrypted_data;
+        for (const auto& entry : entries) {
+            encrypted_data.clear();
+            auto encrypt_result = encrypt_data(format_plaintext(entry), encrypted_data);
+            if (encrypt_result.is_err()) {
+                // Skip only this entry; the rest of the batch is still written
+                entries_dropped_.fetch_add(1);
+                if (encrypt_error.is_ok()) {
+                    encrypt_error = encrypt_result;
+                }
+                continue;
+            }
+            encrypted_entries.emplace_back(
+                entry.level,
+                std::string(reinterpret_cast<const char*>(encrypted_data.data()),
+                            encrypted_data.size()),
+                entry.timestamp);
+        }
+    }
+
+    if (encrypted_entries.empty()) {
+        return encrypt_error;
+    }
+
+    // Delegate the whole batch to the wrapped writer
+    auto write_result = wrapped().write_batch(encrypted_entries);
+    if (write_result.is_ok()) {
+        entries_encrypted_.fetch_add(encrypted_entries.size());
+        return encrypt_error;
+    }
+    return write_result;
+}
+
+std::string encrypted_writer::format_plaintext(const log_entry& entry) {
+    std::ostringstream oss;
+    auto time_t_val = std::chrono::system_clock::to_time_t(entry.timestamp);
+    std::tm tm_val;
+#ifdef _WIN32
+    localtime_s(&tm_val, &time_t_val);
+#else
+    localtime_r(&time_t_val, &tm_val);
+#endif
+
+    // Convert log_level from logger_system to common::interfaces
+    auto level = static_cast<common::interfaces::log_level>(static_cast<int>(entry.level));
+
+    oss << std::put_time(&tm_val, "%Y-%m-%dT%H:%M:%S")
+        << " [" << static_cast<int>(level) << "] "
+        << entry.message.to_string();
+
+    if (entry.location) {
+        std::string file = entry.location->file.to_string();
+        std::string function = entry.location->function.to_string();
+        if (!file.empty()) {
+            oss << " (" << file << ":" << entry.location->line << " " << function << ")";
+        }
+    }
+
+    return oss.str();
+}
+
 common::VoidResult encrypted_writer::rotate_key(security::secure_key new_key) {
     // Validate new key
     if (new_key.size() != 32) {
@@ -181,6 +246,10 @@ uint64_t encrypted_writer::get_entries_encrypted() const {
     return entries_encrypted_.load();
 }
 
+uint64_t encrypted_writer::get_entries_dropped() const {
+    return entries_dropped_.load();
+}
+
 std::chrono::system_clock::time_point encrypted_writer::get_last_key_rotation() const {
     return last_key_rotation_;
 }
@@ -0,0 +1,96 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file fd_io.h
+ * @brief POSIX file descriptor helpers shared by the file_output backends
+ * @since 4.1.0
+ *
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if !defined(_WIN32)
+#include <cerrno>
+#include <time.h>
+#include <unistd.h>
+#define LOGGER_HAS_POSIX_FD 1
+#else
+#define LOGGER_HAS_POSIX_FD 0
+#endif
+
+namespace kcenon::logger::detail {
+
+/// Smallest user-space buffer the buffered backends accept
+constexpr std::size_t min_output_buffer = 4096;
+
+/// Headroom reserved past the buffer size so the record that crosses it
+/// does not reallocate
+constexpr std::size_t output_buffer_slack = 64 * 1024;
+
+/**
+ * @brief Monotonic time in nanoseconds, read once per committed record
+ *
+ * A flush interval does not need more than the coarse clock's few
+ * milliseconds of resolution, and it costs a fraction of steady_clock.
+ */
+inline std::int64_t monotonic_ns() noexcept {
+#if defined(CLOCK_MONOTONIC_COARSE)
+    timespec now{};
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    return std::int64_t{now.tv_sec} * 1'000'000'000 + now.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+#if LOGGER_HAS_POSIX_FD
+
+/**
+ * @brief fdatasync() where available, fsync() otherwise
+ * @return 0 on success, an errno value on failure
+ */
+inline int sync_fd(int fd) noexcept {
+#if defined(__APPLE__)
+    const int rc = ::fsync(fd);
+#else
+    const int rc = ::fdatasync(fd);
+#endif
+    return rc == 0 ? 0 : errno;
+}
+
+/**
+ * @brief Write all of data, retrying short writes and EINTR
+ * @param offset File offset for pwrite(), or negative to use write()
+ * @return 0 on success, an errno value on failure
+ */
+inline int write_all(int fd, const char* data, std::size_t size, std::int64_t offset = -1) noexcept {
+    while (size > 0) {
+        const ssize_t written = offset < 0
+            ? ::write(fd, data, size)
+            : ::pwrite(fd, data, size, offset);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return errno;
+        }
+        data += written;
+        size -= static_cast<std::size_t>(written);
+        if (offset >= 0) {
+            offset += written;
+        }
+    }
+    return 0;
+}
+
+#endif // LOGGER_HAS_POSIX_FD
+
+} // namespace kcenon::logger::detail
@@ -0,0 +1,309 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include <kcenon/logger/writers/file_output.h>
+#include <kcenon/logger/utils/error_handling_utils.h>
+#include "compressed_output.h"
+#include "fd_io.h"
+#include "io_uring_output.h"
+#include "mmap_output.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+
+#if LOGGER_HAS_POSIX_FD
+#include <fcntl.h>
+#include <sys/stat.h>
+#endif
+
+namespace kcenon::logger {
+
+namespace {
+
+/**
+ * @brief std::ofstream backend; every commit goes straight to the stream
+ */
+class stream_output final : public file_output {
+public:
+    ~stream_output() override {
+        close();
+    }
+
+    common::VoidResult open(const std::string& path, bool append) override {
+        auto mode = append ? std::ios::app : std::ios::trunc;
+        stream_.open(path, std::ios::out | mode);
+        path_ = path;
+        if (!stream_.is_open()) {
+            return make_logger_void_result(logger_error_code::file_open_failed,
+                                           "Failed to open file: " + path);
+        }
+
+        opened_size_ = 0;
+        if (append) {
+            stream_.seekp(0, std::ios::end);
+            opened_size_ = static_cast<std::uint64_t>(stream_.tellp());
+        }
+        stored_size_ = opened_size_;
+#if LOGGER_HAS_POSIX_FD
+        // The stream hides its descriptor; one opened alongside it names the
+        // same file even after a rename, and syncing it writes back the
+        // stream's dirty pages
+        sync_fd_ = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);
+#endif
+        return common::ok();
+    }
+
+    common::VoidResult close() override {
+        if (!stream_.is_open()) {
+            return common::ok();
+        }
+        stream_.flush();
+        auto result = utils::check_stream_state(stream_, "flush");
+        stream_.close();
+        stream_.clear();
+#if LOGGER_HAS_POSIX_FD
+        if (sync_fd_ >= 0) {
+            ::close(sync_fd_);
+            sync_fd_ = -1;
+        }
+#endif
+        return result;
+    }
+
+    bool is_open() const noexcept override {
+        return stream_.is_open();
+    }
+
+    bool good() const noexcept override {
+        return stream_.good();
+    }
+
+    std::uint64_t opened_size() const noexcept override {
+        return opened_size_;
+    }
+
+    std::uint64_t stored_size() const noexcept override {
+        return stored_size_;
+    }
+
+    std::pmr::string& buffer() noexcept override {
+        return scratch_;
+    }
+
+    common::VoidResult commit() override {
+        if (scratch_.empty()) {
+            return common::ok();
+        }
+        stream_.write(scratch_.data(), static_cast<std::streamsize>(scratch_.size()));
+        stored_size_ += scratch_.size();
+        scratch_.clear();
+        return utils::check_stream_state(stream_, "write");
+    }
+
+    common::VoidResult flush() override {
+        stream_.flush();
+        return utils::check_stream_state(stream_, "flush");
+    }
+
+    common::VoidResult sync() override {
+        auto result = commit();
+        if (result.is_ok()) {
+            result = flush();
+        }
+        if (result.is_err()) {
+            return result;
+        }
+#if LOGGER_HAS_POSIX_FD
+        if (sync_fd_ < 0) {
+            return make_logger_void_result(logger_error_code::file_write_failed,
+                                           "sync failed: no descriptor for " + path_);
+        }
+        if (const int error = detail::sync_fd(sync_fd_); error != 0) {
+            return make_logger_void_result(logger_error_code::file_write_failed,
+                                           std::string("sync failed: ") + std::strerror(error));
+        }
+#endif
+        return common::ok();
+    }
+
+    file_output_mode mode() const noexcept override {
+        return file_output_mode::stream;
+    }
+
+    int native_handle() const noexcept override {
+        return sync_fd_;
+    }
+
+private:
+    std::ofstream stream_;
+    int sync_fd_ = -1;  ///< Opened with the stream, for sync() (POSIX only)
+    std::string path_;
+    std::pmr::string scratch_;  ///< Keeps its capacity between commits
+    std::uint64_t opened_size_ = 0;
+    std::uint64_t stored_size_ = 0;
+};
+
+#if LOGGER_HAS_POSIX_FD
+
+/**
+ * @brief Raw file descriptor behind a large user-space buffer
+ */
+class direct_output final : public file_output {
+public:
+    explicit direct_output(const file_output_options& options)
+        : capacity_(std::max(options.buffer_size, detail::min_output_buffer))
+        , flush_interval_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+              options.flush_interval).count()) {
+        buffer_.reserve(capacity_ + detail::output_buffer_slack);
+    }
+
+    ~direct_output() override {
+        close();
+    }
+
+    common::VoidResult open(const std::string& path, bool append) override {
+        const int flags = O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC | (append ? 0 : O_TRUNC);
+        fd_ = ::open(path.c_str(), flags, 0644);
+        if (fd_ < 0) {
+            return make_logger_void_result(logger_error_code::file_open_failed,
+                                           "Failed to open file: " + path + ": " +
+                                               std::strerror(errno));
+        }
+
+        struct stat info {};
+        opened_size_ = ::fstat(fd_, &info) == 0 ? static_cast<std::uint64_t>(info.st_size) : 0;
+        written_size_ = opened_size_;
+        failed_ = false;
+        last_write_out_ns_ = detail::monotonic_ns();
+        return common::ok();
+    }
+
+    common::VoidResult close() override {
+        if (fd_ < 0) {
+            return common::ok();
+        }
+        auto result = write_out();
+        ::close(fd_);
+        fd_ = -1;
+        return result;
+    }
+
+    bool is_open() const noexcept override {
+        return fd_ >= 0;
+    }
+
+    bool good() const noexcept override {
+        return !failed_;
+    }
+
+    std::uint64_t opened_size() const noexcept override {
+        return opened_size_;
+    }
+
+    std::uint64_t stored_size() const noexcept override {
+        return written_size_ + buffer_.size();
+    }
+
+    std::pmr::string& buffer() noexcept override {
+        return buffer_;
+    }
+
+    common::VoidResult commit() override {
+        if (buffer_.size() >= capacity_) {
+            return write_out();
+        }
+        if (flush_interval_ns_ > 0 && !buffer_.empty() &&
+            detail::monotonic_ns() - last_write_out_ns_ >= flush_interval_ns_) {
+            return write_out();
+        }
+        return common::ok();
+    }
+
+    common::VoidResult flush() override {
+        return write_out();
+    }
+
+    common::VoidResult sync() override {
+        auto result = write_out();
+        if (result.is_err() || fd_ < 0) {
+            return result;
+        }
+        if (const int error = detail::sync_fd(fd_); error != 0) {
+            failed_ = true;
+            return make_logger_void_result(logger_error_code::file_write_failed,
+                                           std::string("sync failed: ") + std::strerror(error));
+        }
+        return common::ok();
+    }
+
+    file_output_mode mode() const noexcept override {
+        return file_output_mode::direct;
+    }
+
+    int native_handle() const noexcept override {
+        return fd_;
+    }
+
+private:
+    /**
+     * @brief Hand the whole buffer to the kernel, retrying short writes
+     *
+     * The buffer is emptied even on failure so a broken file cannot make it
+     * grow without bound; the error is reported and good() turns false.
+     */
+    common::VoidResult write_out() {
+        last_write_out_ns_ = detail::monotonic_ns();
+        if (buffer_.empty() || fd_ < 0) {
+            return common::ok();
+        }
+
+        const int error = detail::write_all(fd_, buffer_.data(), buffer_.size());
+        written_size_ += buffer_.size();
+        buffer_.clear();
+        if (error != 0) {
+            failed_ = true;
+            return make_logger_void_result(logger_error_code::file_write_failed,
+                                           std::string("write failed: ") + std::strerror(error));
+        }
+        return common::ok();
+    }
+
+    std::size_t capacity_;
+    std::int64_t flush_interval_ns_;
+    std::pmr::string buffer_;
+    int fd_ = -1;
+    bool failed_ = false;
+    std::uint64_t opened_size_ = 0;
+    std::uint64_t written_size_ = 0;  ///< Bytes handed to the kernel, plus opened_size_
+    std::int64_t last_write_out_ns_ = 0;
+};
+
+#endif // LOGGER_HAS_POSIX_FD
+
+std::unique_ptr<file_output> make_backend([[maybe_unused]] const file_output_options& options) {
+#if LOGGER_HAS_POSIX_FD
+    if (options.mode == file_output_mode::io_uring) {
+        if (auto output = detail::make_io_uring_output(options)) {
+            return output;
+        }
+    }
+    if (options.mode == file_output_mode::mmap) {
+        return detail::make_mmap_output(options);
+    }
+    if (options.mode != file_output_mode::stream) {
+        return std::make_unique<direct_output>(options);
+    }
+#endif
+    return std::make_unique<stream_output>();
+}
+
+} // namespace
+
+std::unique_ptr<file_output> make_file_output(const file_output_options& options) {
+    return detail::make_compressed_output(make_backend(options), options);
+}
+
+} // namespace kcenon::logger
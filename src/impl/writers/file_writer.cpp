@@ -6,16 +6,27 @@
 #include <kcenon/logger/interfaces/log_entry.h>
 #include <kcenon/logger/formatters/timestamp_formatter.h>
 #include <kcenon/logger/utils/error_handling_utils.h>
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
 
+#include "fd_io.h"
+
+#if LOGGER_HAS_POSIX_FD
+#include <fcntl.h>
+#endif
+
 namespace kcenon::logger {
 
 file_writer::file_writer(const std::string& filename,
                         bool append,
-                        std::unique_ptr<log_formatter_interface> formatter)
+                        std::unique_ptr<log_formatter_interface> formatter,
+                        const file_output_options& output)
     : filename_(filename)
     , append_mode_(append)
+    , output_(make_file_output(output))
+    , sync_on_critical_(output.sync_on_critical)
     , formatter_(formatter ? std::move(formatter) : std::make_unique<timestamp_formatter>()) {
     std::lock_guard<std::mutex> lock(mutex_);
     open_internal();
@@ -28,6 +39,20 @@ file_writer::~file_writer() {
 
 common::VoidResult file_writer::write(const log_entry& entry) {
     std::lock_guard<std::mutex> lock(mutex_);
+    return write_entries(std::span<const log_entry>(&entry, 1));
+}
+
+common::VoidResult file_writer::write_batch(std::span<const log_entry> entries) {
+    if (entries.empty()) {
+        return common::ok();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    return write_entries(entries);
+}
+
+common::VoidResult file_writer::write_entries(std::span<const log_entry> entries) {
+    // IMPORTANT: Caller must hold the mutex before calling this method
 
     return utils::try_write_operation([&]() -> common::VoidResult {
         // Check precondition
@@ -35,26 +60,88 @@ common::VoidResult file_writer::write(const log_entry& entry) {
             return make_logger_void_result(logger_error_code::file_write_failed, "File is not open");
         }
 
-        // Format and write
-        std::string formatted = format_entry(entry);
-        file_stream_ << formatted << '\n';
-        bytes_written_.fetch_add(formatted.size() + 1);  // +1 for newline
+        // Format straight into the backend's buffer, then hand it over once
+        auto& buffer = output_->buffer();
+        for (const auto& entry : entries) {
+            append_entry(entry, buffer);
+        }
 
-        // Verify stream state
-        return utils::check_stream_state(file_stream_, "write");
+        const bool durable = sync_on_critical_ &&
+            std::any_of(entries.begin(), entries.end(), [](const log_entry& entry) {
+                return entry.level >= log_level::critical;
+            });
+        auto result = durable ? output_->sync() : output_->commit();
+        // On-disk bytes, which differ from the formatted ones when compressing
+        bytes_written_.store(output_->stored_size());
+        return result;
     });
 }
 
 common::VoidResult file_writer::flush() {
     std::lock_guard<std::mutex> lock(mutex_);
 
+    return utils::try_write_operation([&]() -> common::VoidResult {
+        if (!is_open_) {
+            return common::ok();
+        }
+        auto result = output_->flush();
+        // Ending a compressed frame adds its trailer
+        bytes_written_.store(output_->stored_size());
+        return result;
+    }, logger_error_code::flush_timeout);
+}
+
+common::VoidResult file_writer::sync() {
+#if LOGGER_HAS_POSIX_FD
+    // Hand everything to the kernel under the lock, then wait for the
+    // device on a duplicate of the output's descriptor so writes can go on
+    // meanwhile. Taken under the lock, it is the file the records went to
+    // even if a rotation swaps or renames it before the sync.
+    int fd = -1;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!is_open_) {
+            return common::ok();
+        }
+        // Mapped pages are written back by msync(), which needs the window
+        if (output_->mode() == file_output_mode::mmap || output_->native_handle() < 0) {
+            return utils::try_write_operation([&]() {
+                return output_->sync();
+            }, logger_error_code::flush_timeout);
+        }
+
+        auto result = utils::try_write_operation([&]() {
+            auto committed = output_->commit();
+            return committed.is_ok() ? output_->flush() : committed;
+        }, logger_error_code::flush_timeout);
+        if (result.is_err()) {
+            return result;
+        }
+
+        fd = ::fcntl(output_->native_handle(), F_DUPFD_CLOEXEC, 0);
+        if (fd < 0) {
+            return make_logger_void_result(logger_error_code::file_write_failed,
+                                           std::string("sync failed: ") + std::strerror(errno));
+        }
+    }
+
+    const int error = detail::sync_fd(fd);
+    ::close(fd);
+    if (error != 0) {
+        return make_logger_void_result(logger_error_code::file_write_failed,
+                                       std::string("sync failed: ") + std::strerror(error));
+    }
+    return common::ok();
+#else
+    std::lock_guard<std::mutex> lock(mutex_);
+
     return utils::try_write_operation([&]() -> common::VoidResult {
         if (is_open_) {
-            file_stream_.flush();
-            return utils::check_stream_state(file_stream_, "flush");
+            return output_->sync();
         }
         return common::ok();
     }, logger_error_code::flush_timeout);
+#endif
 }
 
 common::VoidResult file_writer::close() {
@@ -64,7 +151,7 @@ common::VoidResult file_writer::close() {
 }
 
 bool file_writer::is_healthy() const {
-    return is_open_ && file_stream_.good();
+    return is_open_ && output_->good();
 }
 
 std::string file_writer::format_entry(const log_entry& entry) const {
@@ -75,6 +162,15 @@ std::string file_writer::format_entry(const log_entry& entry) const {
     return formatter_->format(entry);
 }
 
+void file_writer::append_entry(const log_entry& entry, std::pmr::string& out) const {
+    if (formatter_) {
+        formatter_->format_to(entry, out);
+    } else {
+        out += std::string_view(entry.message);
+    }
+    out += '\n';
+}
+
 common::VoidResult file_writer::open_internal() {
     // IMPORTANT: Caller must hold the mutex before calling this method
 
@@ -87,24 +183,11 @@ common::VoidResult file_writer::open_internal() {
         if (dir_result.is_err()) return dir_result;
 
         // Open file
-        auto mode = append_mode_ ? std::ios::app : std::ios::trunc;
-        file_stream_.open(filename_, std::ios::out | mode);
-
-        // Check if file opened successfully
-        auto check = utils::check_condition(
-            file_stream_.is_open(),
-            logger_error_code::file_open_failed,
-            "Failed to open file: " + filename_
-        );
-        if (check.is_err()) return check;
-
-        // Get current file size if appending
-        if (append_mode_) {
-            file_stream_.seekp(0, std::ios::end);
-            bytes_written_ = file_stream_.tellp();
-        } else {
-            bytes_written_ = 0;
-        }
+        auto open_result = output_->open(filename_, append_mode_);
+        if (open_result.is_err()) return open_result;
+
+        // Existing content counts toward the size when appending
+        bytes_written_ = output_->opened_size();
 
         is_open_ = true;
         return common::ok();
@@ -115,10 +198,7 @@ void file_writer::close_internal() {
     // IMPORTANT: Caller must hold the mutex before calling this method
 
     if (is_open_) {
-        if (file_stream_.is_open()) {
-            file_stream_.flush();
-            file_stream_.close();
-        }
+        output_->close();
         is_open_ = false;
     }
 }
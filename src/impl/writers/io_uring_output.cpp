@@ -0,0 +1,506 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include "io_uring_output.h"
+#include "fd_io.h"
+
+#if LOGGER_HAS_IO_URING
+#include <linux/io_uring.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <thread>
+#endif
+
+namespace kcenon::logger::detail {
+
+#if LOGGER_HAS_IO_URING && defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && \
+    defined(IOSQE_IO_LINK)
+
+namespace {
+
+/// Two writes and two linked fdatasyncs are the most ever outstanding
+constexpr unsigned ring_entries = 8;
+
+/// user_data of fdatasync submissions; writes carry their slot index
+constexpr std::uint64_t sync_tag = 2;
+
+template<typename T>
+T load_acquire(const T* p) noexcept {
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+template<typename T>
+void store_release(T* p, T value) noexcept {
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+/**
+ * @brief Minimal single-issuer io_uring over the raw system calls
+ */
+class uring {
+public:
+    uring() = default;
+    uring(const uring&) = delete;
+    uring& operator=(const uring&) = delete;
+
+    ~uring() {
+        if (sqes_ != nullptr) {
+            ::munmap(sqes_, sqes_size_);
+        }
+        if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+            ::munmap(cq_ptr_, cq_size_);
+        }
+        if (sq_ptr_ != nullptr) {
+            ::munmap(sq_ptr_, sq_size_);
+        }
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    /**
+     * @return false if the kernel refuses io_uring (ENOSYS, or EPERM from seccomp)
+     */
+    bool init(unsigned entries) noexcept {
+        io_uring_params params{};
+        fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0) {
+            return false;
+        }
+
+        sq_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+        single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single_mmap) {
+            sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+        }
+#endif
+
+        sq_ptr_ = map(sq_size_, IORING_OFF_SQ_RING);
+        cq_ptr_ = single_mmap ? sq_ptr_ : map(cq_size_, IORING_OFF_CQ_RING);
+        sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+        sqes_ = static_cast<io_uring_sqe*>(map(sqes_size_, IORING_OFF_SQES));
+        if (sq_ptr_ == nullptr || cq_ptr_ == nullptr || sqes_ == nullptr) {
+            return false;
+        }
+
+        auto* sq = static_cast<char*>(sq_ptr_);
+        sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+        sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        sq_mask_ = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        sq_entries_ = params.sq_entries;
+        local_tail_ = *sq_tail_;
+
+        auto* cq = static_cast<char*>(cq_ptr_);
+        cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        cq_mask_ = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        return true;
+    }
+
+    /**
+     * @brief Free submission slots
+     */
+    [[nodiscard]] unsigned space() const noexcept {
+        return sq_entries_ - (local_tail_ - load_acquire(sq_head_));
+    }
+
+    /**
+     * @brief Claim the next zeroed submission entry (check space() first)
+     */
+    io_uring_sqe* next_sqe() noexcept {
+        const unsigned index = local_tail_ & sq_mask_;
+        sq_array_[index] = index;
+        ++local_tail_;
+        auto* sqe = &sqes_[index];
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    /**
+     * @brief Submit every claimed entry and optionally wait for a completion
+     * @return 0, or the errno of a failed io_uring_enter()
+     */
+    int submit(bool wait) noexcept {
+        store_release(sq_tail_, local_tail_);
+        for (;;) {
+            const unsigned to_submit = local_tail_ - load_acquire(sq_head_);
+            if (to_submit == 0 && !wait) {
+                return 0;
+            }
+            const unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+            const long rc = ::syscall(__NR_io_uring_enter, fd_, to_submit, wait ? 1u : 0u,
+                                      flags, nullptr, 0);
+            if (rc >= 0) {
+                wait = false;
+                continue;
+            }
+            if (errno != EINTR) {
+                return errno;
+            }
+        }
+    }
+
+    /**
+     * @brief Consume every posted completion
+     */
+    template<typename Handler>
+    void drain(Handler&& handler) {
+        unsigned head = *cq_head_;
+        const unsigned tail = load_acquire(cq_tail_);
+        while (head != tail) {
+            const io_uring_cqe& cqe = cqes_[head & cq_mask_];
+            handler(cqe.user_data, cqe.res);
+            ++head;
+        }
+        store_release(cq_head_, head);
+    }
+
+private:
+    void* map(std::size_t size, off_t offset) const noexcept {
+        void* ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           fd_, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    }
+
+    int fd_ = -1;
+    void* sq_ptr_ = nullptr;
+    std::size_t sq_size_ = 0;
+    void* cq_ptr_ = nullptr;
+    std::size_t cq_size_ = 0;
+    io_uring_sqe* sqes_ = nullptr;
+    std::size_t sqes_size_ = 0;
+
+    unsigned* sq_head_ = nullptr;
+    unsigned* sq_tail_ = nullptr;
+    unsigned* sq_array_ = nullptr;
+    unsigned sq_mask_ = 0;
+    unsigned sq_entries_ = 0;
+    unsigned local_tail_ = 0;  ///< Claimed entries, published to sq_tail_ on submit
+
+    unsigned* cq_head_ = nullptr;
+    unsigned* cq_tail_ = nullptr;
+    unsigned cq_mask_ = 0;
+    io_uring_cqe* cqes_ = nullptr;
+};
+
+/**
+ * @brief Two user-space buffers written through io_uring
+ *
+ * One buffer is always the active one records are formatted into; the
+ * other may be in flight. A full active buffer is submitted with an
+ * explicit file offset and the buffers swap, waiting only if the other
+ * write has not completed yet. When the ring stops working the backend
+ * continues with pwrite() at the same offsets.
+ */
+class io_uring_output final : public file_output {
+    struct slot {
+        std::pmr::string data;
+        std::uint64_t offset = 0;
+        iovec iov{};
+        bool in_flight = false;
+    };
+
+public:
+    explicit io_uring_output(const file_output_options& options)
+        : capacity_(std::max(options.buffer_size, min_output_buffer))
+        , flush_interval_ns_(std::chrono::duration_cast<std::chrono::nanoseconds>(
+              options.flush_interval).count()) {
+        for (auto& io_slot : slots_) {
+            io_slot.data.reserve(capacity_ + output_buffer_slack);
+        }
+    }
+
+    ~io_uring_output() override {
+        close();
+    }
+
+    bool init() noexcept {
+        return ring_.init(ring_entries);
+    }
+
+    common::VoidResult open(const std::string& path, bool append) override {
+        // Writes carry explicit offsets, so no O_APPEND
+        const int flags = O_WRONLY | O_CREAT | O_CLOEXEC | (append ? 0 : O_TRUNC);
+        fd_ = ::open(path.c_str(), flags, 0644);
+        if (fd_ < 0) {
+            return make_logger_void_result(logger_error_code::file_open_failed,
+                                           "Failed to open file: " + path + ": " +
+                                               std::strerror(errno));
+        }
+
+        struct stat info {};
+        opened_size_ = ::fstat(fd_, &info) == 0 ? static_cast<std::uint64_t>(info.st_size) : 0;
+        offset_ = opened_size_;
+        failed_ = false;
+        last_write_out_ns_ = monotonic_ns();
+        return common::ok();
+    }
+
+    common::VoidResult close() override {
+        if (fd_ < 0) {
+            return common::ok();
+        }
+        auto result = flush();
+        ::close(fd_);
+        fd_ = -1;
+        return result;
+    }
+
+    bool is_open() const noexcept override {
+        return fd_ >= 0;
+    }
+
+    bool good() const noexcept override {
+        return !failed_;
+    }
+
+    std::uint64_t opened_size() const noexcept override {
+        return opened_size_;
+    }
+
+    std::uint64_t stored_size() const noexcept override {
+        return offset_ + slots_[active_].data.size();
+    }
+
+    std::pmr::string& buffer() noexcept override {
+        return slots_[active_].data;
+    }
+
+    common::VoidResult commit() override {
+        const auto& data = slots_[active_].data;
+        if (data.size() >= capacity_ ||
+            (flush_interval_ns_ > 0 && !data.empty() &&
+             monotonic_ns() - last_write_out_ns_ >= flush_interval_ns_)) {
+            submit_active(false);
+        }
+        return take_error();
+    }
+
+    common::VoidResult flush() override {
+        submit_active(false);
+        wait_idle();
+        return take_error();
+    }
+
+    common::VoidResult sync() override {
+        // The linked fdatasync only orders after its own write, so let the
+        // other buffer land first
+        wait_idle();
+        submit_active(true);
+        wait_idle();
+        return take_error();
+    }
+
+    file_output_mode mode() const noexcept override {
+        return file_output_mode::io_uring;
+    }
+
+    int native_handle() const noexcept override {
+        return fd_;
+    }
+
+private:
+    /**
+     * @brief Hand the active buffer to the kernel and switch to the other one
+     * @param durable Link an fdatasync to the write
+     *
+     * Failures are recorded and reported by the next take_error().
+     */
+    void submit_active(bool durable) {
+        last_write_out_ns_ = monotonic_ns();
+        if (fd_ < 0) {
+            return;
+        }
+
+        const std::size_t index = active_;
+        slot& current = slots_[index];
+        if (current.data.empty()) {
+            if (durable) {
+                wait_idle();
+                record_error(sync_fd(fd_));
+            }
+            return;
+        }
+
+        current.offset = offset_;
+        offset_ += current.data.size();
+        current.iov.iov_base = current.data.data();
+        current.iov.iov_len = current.data.size();
+
+        if (!queue_write(index, durable)) {
+            // pwrite path: the ring is unavailable or refused the submission
+            record_error(write_all(fd_, current.data.data(), current.data.size(),
+                                   static_cast<std::int64_t>(current.offset)));
+            if (durable) {
+                record_error(sync_fd(fd_));
+            }
+            current.data.clear();
+        }
+
+        // Keep formatting into the other buffer once its write has landed
+        active_ ^= 1;
+        wait_for([this] { return !slots_[active_].in_flight; });
+    }
+
+    bool queue_write(std::size_t index, bool durable) {
+        if (ring_broken_ || ring_.space() < (durable ? 2u : 1u)) {
+            return false;
+        }
+
+        slot& current = slots_[index];
+        io_uring_sqe* write = ring_.next_sqe();
+        write->opcode = IORING_OP_WRITEV;
+        write->fd = fd_;
+        write->addr = reinterpret_cast<std::uint64_t>(&current.iov);
+        write->len = 1;
+        write->off = current.offset;
+        write->user_data = index;
+
+        if (durable) {
+            write->flags = IOSQE_IO_LINK;
+            io_uring_sqe* sync = ring_.next_sqe();
+            sync->opcode = IORING_OP_FSYNC;
+            sync->fd = fd_;
+            sync->fsync_flags = IORING_FSYNC_DATASYNC;
+            sync->user_data = sync_tag;
+            ++syncs_in_flight_;
+        }
+
+        current.in_flight = true;
+        if (ring_.submit(false) != 0) {
+            // Entries the kernel did not take are never submitted again
+            ring_broken_ = true;
+            current.in_flight = false;
+            if (durable) {
+                --syncs_in_flight_;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reap completions until ready() holds
+     */
+    template<typename Ready>
+    void wait_for(Ready&& ready) {
+        reap();
+        while (!ready()) {
+            // Submitted work completes even if io_uring_enter() stops
+            // working, so fall back to polling the completion queue
+            if (ring_broken_ || ring_.submit(true) != 0) {
+                ring_broken_ = true;
+                std::this_thread::yield();
+            }
+            reap();
+        }
+    }
+
+    void wait_idle() {
+        wait_for([this] {
+            return !slots_[0].in_flight && !slots_[1].in_flight && syncs_in_flight_ == 0;
+        });
+        if (deferred_sync_) {
+            deferred_sync_ = false;
+            record_error(sync_fd(fd_));
+        }
+    }
+
+    void reap() {
+        ring_.drain([this](std::uint64_t tag, std::int32_t res) {
+            if (tag == sync_tag) {
+                --syncs_in_flight_;
+                if (res == -ECANCELED) {
+                    // A short write broke the link; sync once it is completed
+                    deferred_sync_ = true;
+                } else if (res < 0) {
+                    record_error(-res);
+                }
+                return;
+            }
+
+            slot& done = slots_[tag];
+            done.in_flight = false;
+            if (res < 0) {
+                record_error(-res);
+            } else if (static_cast<std::size_t>(res) < done.data.size()) {
+                const auto written = static_cast<std::size_t>(res);
+                record_error(write_all(fd_, done.data.data() + written, done.data.size() - written,
+                                       static_cast<std::int64_t>(done.offset + written)));
+            }
+            done.data.clear();
+        });
+    }
+
+    void record_error(int error) noexcept {
+        if (error != 0) {
+            failed_ = true;
+            if (!error_) {
+                error_ = error;
+            }
+        }
+    }
+
+    common::VoidResult take_error() {
+        if (!error_) {
+            return common::ok();
+        }
+        const int error = *error_;
+        error_.reset();
+        return make_logger_void_result(logger_error_code::file_write_failed,
+                                       std::string("write failed: ") + std::strerror(error));
+    }
+
+    uring ring_;
+    bool ring_broken_ = false;
+
+    std::size_t capacity_;
+    std::int64_t flush_interval_ns_;
+    std::array<slot, 2> slots_;
+    std::size_t active_ = 0;
+    unsigned syncs_in_flight_ = 0;
+    bool deferred_sync_ = false;
+
+    int fd_ = -1;
+    std::uint64_t offset_ = 0;  ///< Where the next submitted buffer goes
+    std::uint64_t opened_size_ = 0;
+    bool failed_ = false;
+    std::optional<int> error_;   ///< First error since the last report
+    std::int64_t last_write_out_ns_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<file_output> make_io_uring_output(const file_output_options& options) {
+    auto output = std::make_unique<io_uring_output>(options);
+    if (!output->init()) {
+        return nullptr;
+    }
+    return output;
+}
+
+#else
+
+std::unique_ptr<file_output> make_io_uring_output(const file_output_options&) {
+    return nullptr;
+}
+
+#endif
+
+} // namespace kcenon::logger::detail
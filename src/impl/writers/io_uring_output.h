@@ -0,0 +1,45 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file io_uring_output.h
+ * @brief Double-buffered io_uring file_output backend
+ * @since 4.1.0
+ *
+ * @details Talks to the kernel through the io_uring system calls and the
+ * <linux/io_uring.h> ABI directly, so no library is needed at build or run
+ * time. Compiled in when that header is found; define LOGGER_HAS_IO_URING
+ * to 0 to leave it out.
+ *
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <kcenon/logger/writers/file_output.h>
+
+#include <memory>
+
+#ifndef LOGGER_HAS_IO_URING
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define LOGGER_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+#ifndef LOGGER_HAS_IO_URING
+#define LOGGER_HAS_IO_URING 0
+#endif
+
+namespace kcenon::logger::detail {
+
+/**
+ * @brief Create an io_uring backend
+ * @return nullptr when io_uring is not compiled in or the kernel refuses
+ *         io_uring_setup() (too old, or blocked by a seccomp filter)
+ */
+std::unique_ptr<file_output> make_io_uring_output(const file_output_options& options);
+
+} // namespace kcenon::logger::detail
@@ -0,0 +1,308 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include "mmap_output.h"
+#include "fd_io.h"
+
+#if LOGGER_HAS_POSIX_FD
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+#endif
+
+namespace kcenon::logger::detail {
+
+#if LOGGER_HAS_POSIX_FD
+
+namespace {
+
+std::uint64_t round_up(std::uint64_t value, std::uint64_t step) noexcept {
+    return (value + step - 1) / step * step;
+}
+
+std::uint64_t page_size() noexcept {
+    static const auto size = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+    return size;
+}
+
+/// Most the visible file size runs ahead of the content
+constexpr std::uint64_t max_size_step = 1024 * 1024;
+
+/**
+ * @brief Offset just past the last non-NUL byte of the first size bytes
+ *
+ * A writer that did not reach close() leaves zero padding after its last
+ * record; log text never ends in NUL bytes.
+ */
+std::uint64_t content_end(int fd, std::uint64_t size) noexcept {
+    char chunk[4096];
+    while (size > 0) {
+        const std::uint64_t length = std::min<std::uint64_t>(size, sizeof(chunk));
+        const ssize_t got = ::pread(fd, chunk, length,
+                                    static_cast<off_t>(size - length));
+        if (got != static_cast<ssize_t>(length)) {
+            return size;
+        }
+        for (std::uint64_t i = length; i > 0; --i) {
+            if (chunk[i - 1] != '\0') {
+                return size - length + i;
+            }
+        }
+        size -= length;
+    }
+    return 0;
+}
+
+/**
+ * @brief Appends by copying into a shared mapping of preallocated extents
+ *
+ * Blocks are reserved ahead of the data in extent-sized steps without
+ * changing the file size (FALLOC_FL_KEEP_SIZE), and the size itself is
+ * raised at most max_size_step at a time as records need it, so a crash
+ * leaves little zero padding; append-mode open() trims what there is.
+ * close() truncates to the content. The mapped window always starts at
+ * the page holding size_ and ends on an extent boundary at least one
+ * extent further on; only the part below the file size is touched.
+ *
+ * Truncating the file from outside while it is mapped makes the next
+ * append fault with SIGBUS, as with any shared mapping.
+ */
+class mmap_output final : public file_output {
+public:
+    explicit mmap_output(const file_output_options& options)
+        : extent_(round_up(std::max<std::uint64_t>(options.mmap_extent, page_size()), page_size()))
+        , size_step_(std::min(extent_, max_size_step))
+        // Compressed frames may end in zero bytes; the reader skips padding
+        , trim_padding_(options.compression == compression_codec::none) {
+    }
+
+    ~mmap_output() override {
+        close();
+    }
+
+    common::VoidResult open(const std::string& path, bool append) override {
+        // Shared writable mappings need a read-write descriptor
+        const int flags = O_RDWR | O_CREAT | O_CLOEXEC | (append ? 0 : O_TRUNC);
+        fd_ = ::open(path.c_str(), flags, 0644);
+        if (fd_ < 0) {
+            return make_logger_void_result(logger_error_code::file_open_failed,
+                                           "Failed to open file: " + path + ": " +
+                                               std::strerror(errno));
+        }
+
+        struct stat info {};
+        size_ = ::fstat(fd_, &info) == 0 ? static_cast<std::uint64_t>(info.st_size) : 0;
+        if (append && trim_padding_ && size_ > 0) {
+            // Drop the padding of a run that ended without close()
+            const std::uint64_t end = content_end(fd_, size_);
+            if (end != size_ && ::ftruncate(fd_, static_cast<off_t>(end)) == 0) {
+                size_ = end;
+            }
+        }
+        allocated_ = size_;
+        file_size_ = size_;
+        opened_size_ = size_;
+        failed_ = false;
+        return common::ok();
+    }
+
+    common::VoidResult close() override {
+        if (fd_ < 0) {
+            return common::ok();
+        }
+        auto result = commit();
+        unmap();
+
+        // Drop the size step and reserved blocks past the last record
+        if ((file_size_ != size_ || allocated_ != size_) &&
+            ::ftruncate(fd_, static_cast<off_t>(size_)) != 0 && result.is_ok()) {
+            result = error_result("truncate failed", errno);
+        }
+        ::close(fd_);
+        fd_ = -1;
+        return result;
+    }
+
+    bool is_open() const noexcept override {
+        return fd_ >= 0;
+    }
+
+    bool good() const noexcept override {
+        return !failed_;
+    }
+
+    std::uint64_t opened_size() const noexcept override {
+        return opened_size_;
+    }
+
+    std::uint64_t stored_size() const noexcept override {
+        return size_ + scratch_.size();
+    }
+
+    std::pmr::string& buffer() noexcept override {
+        return scratch_;
+    }
+
+    common::VoidResult commit() override {
+        if (scratch_.empty() || fd_ < 0) {
+            return common::ok();
+        }
+
+        const std::size_t length = scratch_.size();
+        int error = ensure_window(length);
+        if (error == 0 && size_ + length > file_size_) {
+            error = grow(size_ + length);
+        }
+        if (error != 0) {
+            scratch_.clear();
+            failed_ = true;
+            return error_result("mmap append failed", error);
+        }
+
+        std::memcpy(window_ + (size_ - window_offset_), scratch_.data(), length);
+        size_ += length;
+        scratch_.clear();
+        return common::ok();
+    }
+
+    common::VoidResult flush() override {
+        // Mapped pages are already in the page cache, where readers see them
+        return commit();
+    }
+
+    common::VoidResult sync() override {
+        auto result = commit();
+        if (result.is_err() || fd_ < 0) {
+            return result;
+        }
+
+        // Write back the current window, then whatever earlier windows left dirty
+        if (window_ != nullptr && size_ > window_offset_ &&
+            ::msync(window_, size_ - window_offset_, MS_SYNC) != 0) {
+            failed_ = true;
+            return error_result("msync failed", errno);
+        }
+        if (const int error = sync_fd(fd_); error != 0) {
+            failed_ = true;
+            return error_result("sync failed", error);
+        }
+        return common::ok();
+    }
+
+    file_output_mode mode() const noexcept override {
+        return file_output_mode::mmap;
+    }
+
+    int native_handle() const noexcept override {
+        return fd_;
+    }
+
+private:
+    /**
+     * @brief Make the mapping cover [size_, size_ + length)
+     * @return 0, or an errno value
+     */
+    int ensure_window(std::size_t length) {
+        if (window_ != nullptr && size_ + length <= window_offset_ + window_size_) {
+            return 0;
+        }
+        unmap();
+
+        const std::uint64_t start = size_ / page_size() * page_size();
+        const std::uint64_t end = round_up(std::max(size_ + length, start + extent_), extent_);
+        if (end > allocated_) {
+            if (const int error = extend(end); error != 0) {
+                return error;
+            }
+        }
+
+        void* window = ::mmap(nullptr, end - start,
+                              PROT_READ | PROT_WRITE, MAP_SHARED, fd_, static_cast<off_t>(start));
+        if (window == MAP_FAILED) {
+            return errno;
+        }
+        window_ = static_cast<char*>(window);
+        window_offset_ = start;
+        window_size_ = end - start;
+        return 0;
+    }
+
+    /**
+     * @brief Reserve blocks up to new_size where supported, keeping the size
+     */
+    int extend(std::uint64_t new_size) {
+#if defined(__linux__)
+        if (::fallocate(fd_, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(allocated_),
+                        static_cast<off_t>(new_size - allocated_)) != 0 &&
+            errno != EOPNOTSUPP && errno != ENOSYS) {
+            return errno;
+        }
+#endif
+        // Without reserved blocks the file is simply filled sparsely
+        allocated_ = new_size;
+        return 0;
+    }
+
+    /**
+     * @brief Raise the file size to cover needed, one size step at a time
+     */
+    int grow(std::uint64_t needed) {
+        const std::uint64_t new_size = round_up(needed, size_step_);
+        if (::ftruncate(fd_, static_cast<off_t>(new_size)) != 0) {
+            return errno;
+        }
+        file_size_ = new_size;
+        return 0;
+    }
+
+    void unmap() noexcept {
+        if (window_ != nullptr) {
+            ::munmap(window_, window_size_);
+            window_ = nullptr;
+            window_size_ = 0;
+        }
+    }
+
+    static common::VoidResult error_result(const char* what, int error) {
+        return make_logger_void_result(logger_error_code::file_write_failed,
+                                       std::string(what) + ": " + std::strerror(error));
+    }
+
+    std::uint64_t extent_;
+    std::uint64_t size_step_;
+    bool trim_padding_;
+    std::pmr::string scratch_;  ///< Records are formatted here, then copied in
+
+    int fd_ = -1;
+    std::uint64_t size_ = 0;       ///< Bytes of real content
+    std::uint64_t file_size_ = 0;  ///< Visible file size, at most size_step_ past size_
+    std::uint64_t allocated_ = 0;  ///< End of the blocks reserved for the file
+    std::uint64_t opened_size_ = 0;
+    bool failed_ = false;
+
+    char* window_ = nullptr;
+    std::uint64_t window_offset_ = 0;
+    std::uint64_t window_size_ = 0;
+};
+
+} // namespace
+
+std::unique_ptr<file_output> make_mmap_output(const file_output_options& options) {
+    return std::make_unique<mmap_output>(options);
+}
+
+#else
+
+std::unique_ptr<file_output> make_mmap_output(const file_output_options&) {
+    return nullptr;
+}
+
+#endif
+
+} // namespace kcenon::logger::detail
@@ -0,0 +1,27 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file mmap_output.h
+ * @brief Memory-mapped append file_output backend
+ * @since 4.1.0
+ *
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <kcenon/logger/writers/file_output.h>
+
+#include <memory>
+
+namespace kcenon::logger::detail {
+
+/**
+ * @brief Create an mmap backend
+ * @return nullptr on platforms without POSIX mmap
+ */
+std::unique_ptr<file_output> make_mmap_output(const file_output_options& options);
+
+} // namespace kcenon::logger::detail
@@ -38,6 +38,7 @@
 #include <iomanip>
 #include <sstream>
 #include <thread>
+#include <vector>
 
 namespace kcenon::logger {
 
@@ -266,33 +267,59 @@ network_writer::~network_writer() {
 }
 
 common::VoidResult network_writer::write(const log_entry& entry) {
+    auto copy = copy_for_network(entry);
+    const auto bytes = budget_consumer::entry_bytes(copy);
+    switch (budget_.admit(copy.level, bytes)) {
+    case budget_decision::dropped:
+        return make_logger_void_result(logger_error_code::queue_overflow_dropped,
+                                       "Memory budget exceeded");
+    case budget_decision::spill:
+        budget_.spill(copy);
+        return common::ok();
+    case budget_decision::admitted:
+    default:
+        break;
+    }
 
-    std::lock_guard<std::mutex> lock(buffer_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        enqueue_locked(std::move(copy));
+    }
 
-    // Check buffer size
-    if (buffer_.size() >= buffer_size_) {
-        // Drop oldest message
-        buffer_.pop();
-        std::lock_guard<std::mutex> stats_lock(stats_mutex_);
-        stats_.send_failures++;
-        // Note: We still accept the new message after dropping the oldest
+    // Notify send worker
+    if (send_worker_) {
+        send_worker_->notify_work();
     }
 
-    // Create a copy of the entry since log_entry is move-only
-    if (entry.location) {
-        buffer_.emplace(entry.level,
-                       entry.message.to_string(),
-                       entry.location->file.to_string(),
-                       entry.location->line,
-                       entry.location->function.to_string(),
-                       entry.timestamp);
-    } else {
-        buffer_.emplace(entry.level,
-                       entry.message.to_string(),
-                       entry.timestamp);
+    return common::ok();
+}
+
+common::VoidResult network_writer::write_batch(std::span<const log_entry> entries) {
+    if (entries.empty()) {
+        return common::ok();
     }
 
-    // Notify send worker
+    // Copy and reserve outside the buffer lock; admit() may wait
+    std::vector<log_entry> copies;
+    copies.reserve(entries.size());
+    for (const auto& entry : entries) {
+        auto copy = copy_for_network(entry);
+        const auto decision = budget_.admit(copy.level, budget_consumer::entry_bytes(copy));
+        if (decision == budget_decision::admitted) {
+            copies.push_back(std::move(copy));
+        } else if (decision == budget_decision::spill) {
+            budget_.spill(copy);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(buffer_mutex_);
+        for (auto& copy : copies) {
+            enqueue_locked(std::move(copy));
+        }
+    }
+
+    // One wake-up for the whole batch
     if (send_worker_) {
         send_worker_->notify_work();
     }
@@ -300,6 +327,33 @@ common::VoidResult network_writer::write(const log_entry& entry) {
     return common::ok();
 }
 
+log_entry network_writer::copy_for_network(const log_entry& entry) {
+    // Only the fields format_for_network() uses are copied
+    if (entry.location) {
+        return log_entry(entry.level,
+                         entry.message.to_string(),
+                         entry.location->file.to_string(),
+                         entry.location->line,
+                         entry.location->function.to_string(),
+                         entry.timestamp);
+    }
+    return log_entry(entry.level, entry.message.to_string(), entry.timestamp);
+}
+
+void network_writer::enqueue_locked(log_entry&& entry) {
+    // Check buffer size
+    if (buffer_.size() >= buffer_size_) {
+        // Drop oldest message
+        budget_.release(budget_consumer::entry_bytes(buffer_.front()));
+        buffer_.pop();
+        std::lock_guard<std::mutex> stats_lock(stats_mutex_);
+        stats_.send_failures++;
+        // Note: We still accept the new message after dropping the oldest
+    }
+
+    buffer_.push(std::move(entry));
+}
+
 common::VoidResult network_writer::flush() {
     std::unique_lock<std::mutex> lock(buffer_mutex_);
     auto start = std::chrono::steady_clock::now();
@@ -386,7 +440,7 @@ void network_writer::disconnect() {
     connected_ = false;
 }
 
-bool network_writer::send_data(const std::string& data) {
+bool network_writer::send_data(const std::string& data, uint64_t message_count) {
     if (!connected_ || socket_fd_ < 0) {
         return false;
     }
@@ -409,7 +463,7 @@ bool network_writer::send_data(const std::string& data) {
     }
 
     std::lock_guard<std::mutex> lock(stats_mutex_);
-    stats_.messages_sent++;
+    stats_.messages_sent += message_count;
     stats_.bytes_sent += sent;
 
     return true;
@@ -418,11 +472,41 @@ bool network_writer::send_data(const std::string& data) {
 void network_writer::process_buffer() {
     std::unique_lock<std::mutex> lock(buffer_mutex_);
 
-    // Process buffered logs
+    if (protocol_ == protocol_type::tcp) {
+        if (!running_) {
+            return;
+        }
+
+        // TCP is a byte stream: drain everything and send it with one call
+        std::queue<log_entry> pending;
+        std::swap(pending, buffer_);
+        lock.unlock();
+        buffer_cv_.notify_all();
+
+        std::string payload;
+        uint64_t count = 0;
+        std::size_t released_bytes = 0;
+        for (; !pending.empty(); pending.pop()) {
+            released_bytes += budget_consumer::entry_bytes(pending.front());
+            // Once stopped, like the UDP path, send nothing more
+            if (running_) {
+                payload += format_for_network(pending.front());
+                ++count;
+            }
+        }
+        budget_.release(released_bytes);
+        if (count > 0 && running_) {
+            send_data(payload, count);
+        }
+        return;
+    }
+
+    // UDP: keep one datagram per log entry
     while (!buffer_.empty() && running_) {
         auto entry = std::move(buffer_.front());
         buffer_.pop();
         lock.unlock();
+        budget_.release(budget_consumer::entry_bytes(entry));
 
         // Format and send
         std::string formatted = format_for_network(entry);
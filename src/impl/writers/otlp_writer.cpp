@@ -143,10 +143,7 @@ otlp_writer::~otlp_writer() {
     std::vector<log_entry> remaining;
     {
         std::lock_guard<std::mutex> lock(queue_mutex_);
-        while (!queue_.empty()) {
-            remaining.push_back(std::move(queue_.front()));
-            queue_.pop();
-        }
+        take_locked(remaining, queue_.size());
     }
 
     if (!remaining.empty()) {
@@ -155,42 +152,105 @@ otlp_writer::~otlp_writer() {
 }
 
 common::VoidResult otlp_writer::write(const log_entry& entry) {
-    {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-
-        // Check queue size limit
-        if (queue_.size() >= config_.max_queue_size) {
+    const auto fallback_ctx = entry.otel_ctx.has_value()
+        ? std::optional<otlp::otel_context>() : otlp::otel_context_storage::get();
+
+    auto copy = copy_for_export(entry, fallback_ctx);
+    const auto decision = budget_.admit(copy.level, budget_consumer::entry_bytes(copy));
+    if (decision != budget_decision::admitted) {
+        if (decision == budget_decision::spill) {
+            budget_.spill(copy);
+        } else {
             stats_.logs_dropped.fetch_add(1, std::memory_order_relaxed);
-            return common::ok();  // Drop silently to avoid backpressure
         }
+        return common::ok();  // Never backpressure the caller, as for a full queue
+    }
 
-        // Create a copy of the entry since log_entry is move-only
-        if (entry.location) {
-            queue_.emplace(entry.level,
-                          entry.message.to_string(),
-                          entry.location->file.to_string(),
-                          entry.location->line,
-                          entry.location->function.to_string(),
-                          entry.timestamp);
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    enqueue_locked(std::move(copy));
+
+    // Wake up export thread if batch size reached
+    if (queue_.size() >= config_.max_batch_size) {
+        queue_cv_.notify_one();
+    }
+
+    return common::ok();
+}
+
+common::VoidResult otlp_writer::write_batch(std::span<const log_entry> entries) {
+    if (entries.empty()) {
+        return common::ok();
+    }
+
+    // The calling thread's context is the same for every entry in the batch
+    const auto fallback_ctx = otlp::otel_context_storage::get();
+
+    // Copy and reserve outside the queue lock; admit() may wait
+    std::vector<log_entry> copies;
+    copies.reserve(entries.size());
+    for (const auto& entry : entries) {
+        auto copy = copy_for_export(entry, fallback_ctx);
+        const auto decision = budget_.admit(copy.level, budget_consumer::entry_bytes(copy));
+        if (decision == budget_decision::admitted) {
+            copies.push_back(std::move(copy));
+        } else if (decision == budget_decision::spill) {
+            budget_.spill(copy);
         } else {
-            queue_.emplace(entry.level,
-                          entry.message.to_string(),
-                          entry.timestamp);
+            stats_.logs_dropped.fetch_add(1, std::memory_order_relaxed);
         }
+    }
 
-        // Copy OTEL context to the queued entry
-        auto& queued_entry = queue_.back();
-        queued_entry.otel_ctx = entry.otel_ctx.has_value() ? entry.otel_ctx : otlp::otel_context_storage::get();
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    for (auto& copy : copies) {
+        enqueue_locked(std::move(copy));
+    }
 
-        // Wake up export thread if batch size reached
-        if (queue_.size() >= config_.max_batch_size) {
-            queue_cv_.notify_one();
-        }
+    // Wake up export thread once if batch size reached
+    if (queue_.size() >= config_.max_batch_size) {
+        queue_cv_.notify_one();
     }
 
     return common::ok();
 }
 
+log_entry otlp_writer::copy_for_export(const log_entry& entry,
+                                       const std::optional<otlp::otel_context>& fallback_ctx) {
+    // Create a copy of the entry since log_entry is move-only
+    auto copy = entry.location
+        ? log_entry(entry.level,
+                    entry.message.to_string(),
+                    entry.location->file.to_string(),
+                    entry.location->line,
+                    entry.location->function.to_string(),
+                    entry.timestamp)
+        : log_entry(entry.level, entry.message.to_string(), entry.timestamp);
+
+    // Copy OTEL context to the queued entry
+    copy.otel_ctx = entry.otel_ctx.has_value() ? entry.otel_ctx : fallback_ctx;
+    return copy;
+}
+
+void otlp_writer::enqueue_locked(log_entry&& entry) {
+    // Check queue size limit
+    if (queue_.size() >= config_.max_queue_size) {
+        budget_.release(budget_consumer::entry_bytes(entry));
+        stats_.logs_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;  // Drop silently to avoid backpressure
+    }
+
+    queue_.push(std::move(entry));
+}
+
+void otlp_writer::take_locked(std::vector<log_entry>& batch, std::size_t max_count) {
+    std::size_t released_bytes = 0;
+    while (!queue_.empty() && batch.size() < max_count) {
+        released_bytes += budget_consumer::entry_bytes(queue_.front());
+        batch.push_back(std::move(queue_.front()));
+        queue_.pop();
+    }
+    budget_.release(released_bytes);
+}
+
 common::VoidResult otlp_writer::flush() {
     force_export();
     return common::ok();
@@ -217,10 +277,7 @@ void otlp_writer::force_export() {
 
     {
         std::lock_guard<std::mutex> lock(queue_mutex_);
-        while (!queue_.empty()) {
-            batch.push_back(std::move(queue_.front()));
-            queue_.pop();
-        }
+        take_locked(batch, queue_.size());
     }
 
     if (!batch.empty()) {
@@ -246,10 +303,7 @@ void otlp_writer::export_thread_func() {
             }
 
             // Collect batch
-            while (!queue_.empty() && batch.size() < config_.max_batch_size) {
-                batch.push_back(std::move(queue_.front()));
-                queue_.pop();
-            }
+            take_locked(batch, config_.max_batch_size);
         }
 
         // Export batch
@@ -4,25 +4,63 @@
 
 #include <kcenon/logger/writers/rotating_file_writer.h>
 #include <kcenon/logger/utils/error_handling_utils.h>
+
+#include "background_worker.h"
+#include "backup_index.h"
+#include "segment_compressor.h"
+
 #include <filesystem>
 #include <algorithm>
+#include <charconv>
 #include <regex>
 #include <ctime>
 #include <iostream>
+#include <utility>
 
 namespace kcenon::logger {
 
+namespace {
+
+/**
+ * @brief Numeric suffix of a size-rotated backup name, or -1
+ * @param name File name without directory
+ * @param prefix Base name, extension and the separating dot
+ */
+int backup_suffix(const std::string& name, const std::string& prefix) {
+    if (!name.starts_with(prefix)) {
+        return -1;
+    }
+    const char* first = name.data() + prefix.size();
+    const char* last = name.data() + name.size();
+    int index = -1;
+    auto [end, error] = std::from_chars(first, last, index);
+    if (error != std::errc() || end == first || (end != last && *end != '.')) {
+        return -1;
+    }
+    return index;
+}
+
+} // namespace
+
 rotating_file_writer::rotating_file_writer(const std::string& filename,
                                          size_t max_size,
                                          size_t max_files,
-                                         size_t check_interval)
-    : file_writer(filename, true)
+                                         size_t check_interval,
+                                         const file_output_options& output,
+                                         const segment_compression_options& compression,
+                                         const retention_options& retention)
+    : file_writer(filename, true, nullptr, output)
     , rotation_type_(rotation_type::size)
     , max_size_(max_size)
     , max_files_(max_files)
     , check_interval_(check_interval)
     , last_rotation_time_(std::chrono::system_clock::now())
-    , current_period_start_(std::chrono::system_clock::now()) {
+    , current_period_start_(std::chrono::system_clock::now())
+    , output_options_(output)
+    , next_filename_(filename + ".next")
+    , retention_(retention)
+    , backups_(std::make_unique<detail::backup_index>())
+    , worker_(std::make_unique<detail::background_worker>()) {
 
     // Extract base filename and extension
     std::filesystem::path path(filename);
@@ -31,19 +69,29 @@ rotating_file_writer::rotating_file_writer(const std::string& filename,
     if (file_extension_.empty()) {
         file_extension_ = ".log";
     }
+
+    start_housekeeping(compression);
 }
 
 rotating_file_writer::rotating_file_writer(const std::string& filename,
                                          rotation_type type,
                                          size_t max_files,
-                                         size_t check_interval)
-    : file_writer(filename, true)
+                                         size_t check_interval,
+                                         const file_output_options& output,
+                                         const segment_compression_options& compression,
+                                         const retention_options& retention)
+    : file_writer(filename, true, nullptr, output)
     , rotation_type_(type)
     , max_size_(0)
     , max_files_(max_files)
     , check_interval_(check_interval)
     , last_rotation_time_(std::chrono::system_clock::now())
-    , current_period_start_(std::chrono::system_clock::now()) {
+    , current_period_start_(std::chrono::system_clock::now())
+    , output_options_(output)
+    , next_filename_(filename + ".next")
+    , retention_(retention)
+    , backups_(std::make_unique<detail::backup_index>())
+    , worker_(std::make_unique<detail::background_worker>()) {
 
     // Extract base filename and extension
     std::filesystem::path path(filename);
@@ -52,20 +100,30 @@ rotating_file_writer::rotating_file_writer(const std::string& filename,
     if (file_extension_.empty()) {
         file_extension_ = ".log";
     }
+
+    start_housekeeping(compression);
 }
 
 rotating_file_writer::rotating_file_writer(const std::string& filename,
                                          rotation_type type,
                                          size_t max_size,
                                          size_t max_files,
-                                         size_t check_interval)
-    : file_writer(filename, true)
+                                         size_t check_interval,
+                                         const file_output_options& output,
+                                         const segment_compression_options& compression,
+                                         const retention_options& retention)
+    : file_writer(filename, true, nullptr, output)
     , rotation_type_(type)
     , max_size_(max_size)
     , max_files_(max_files)
     , check_interval_(check_interval)
     , last_rotation_time_(std::chrono::system_clock::now())
-    , current_period_start_(std::chrono::system_clock::now()) {
+    , current_period_start_(std::chrono::system_clock::now())
+    , output_options_(output)
+    , next_filename_(filename + ".next")
+    , retention_(retention)
+    , backups_(std::make_unique<detail::backup_index>())
+    , worker_(std::make_unique<detail::background_worker>()) {
 
     if (type != rotation_type::size_and_time) {
         throw std::invalid_argument("This constructor is only for size_and_time rotation");
@@ -78,36 +136,59 @@ rotating_file_writer::rotating_file_writer(const std::string& filename,
     if (file_extension_.empty()) {
         file_extension_ = ".log";
     }
-}
 
-common::VoidResult rotating_file_writer::write(const log_entry& entry) {
-    std::lock_guard<std::mutex> lock(get_mutex());
+    start_housekeeping(compression);
+}
 
-    // Check precondition
-    if (!file_stream_.is_open()) {
-        return make_logger_void_result(logger_error_code::file_write_failed, "File stream is not open");
+rotating_file_writer::~rotating_file_writer() {
+    // Compression threads post to the worker, so they stop first
+    compressor_.reset();
+    worker_->wait_idle();
+
+    // A segment opened ahead of time but never used holds no records
+    std::lock_guard<std::mutex> lock(next_mutex_);
+    if (next_output_) {
+        next_output_->close();
+        next_output_.reset();
+        std::error_code ec;
+        std::filesystem::remove(next_filename_, ec);
     }
+}
 
-    // Format and write - preserves all structured fields
-    std::string formatted = format_entry(entry);
-    file_stream_ << formatted << '\n';
-    bytes_written_.fetch_add(formatted.size() + 1);
+common::VoidResult rotating_file_writer::write(const log_entry& entry) {
+    return write_batch(std::span<const log_entry>(&entry, 1));
+}
 
-    // Verify stream state
-    if (file_stream_.fail()) {
-        return make_logger_void_result(logger_error_code::file_write_failed, "Write failed");
+common::VoidResult rotating_file_writer::write_batch(std::span<const log_entry> entries) {
+    if (entries.empty()) {
+        return common::ok();
     }
 
-    // Periodic rotation check optimization (Phase 2)
-    ++writes_since_check_;
+    std::lock_guard<std::mutex> lock(get_mutex());
 
-    if (writes_since_check_ >= check_interval_) {
-        if (should_rotate()) {
-            perform_rotation();
+    // Periodic rotation check: commit what belongs to the current file first
+    std::size_t segment_start = 0;
+    for (std::size_t i = 0; i < entries.size(); ++i) {
+        if (++writes_since_check_ >= check_interval_) {
+            auto result = write_entries(entries.subspan(segment_start, i + 1 - segment_start));
+            if (result.is_err()) {
+                return result;
+            }
+            segment_start = i + 1;
+
+            if (should_rotate()) {
+                perform_rotation();
+            } else if (rotation_type_ != rotation_type::size ||
+                       get_file_size() >= max_size_ / 2) {
+                request_next_segment();
+            }
+            writes_since_check_ = 0;
         }
-        writes_since_check_ = 0;
     }
 
+    if (segment_start < entries.size()) {
+        return write_entries(entries.subspan(segment_start));
+    }
     return common::ok();
 }
 
@@ -115,6 +196,23 @@ void rotating_file_writer::rotate() {
     // Public API for manual rotation
     std::lock_guard<std::mutex> lock(get_mutex());
     perform_rotation();
+    worker_->wait_idle();
+}
+
+common::VoidResult rotating_file_writer::flush() {
+    auto result = file_writer::flush();
+    worker_->wait_idle();
+    return result;
+}
+
+void rotating_file_writer::wait_for_compression() {
+    if (!compressor_) {
+        return;
+    }
+    // Segments still being rotated are submitted by the worker
+    worker_->wait_idle();
+    compressor_->wait_idle();
+    worker_->wait_idle();
 }
 
 bool rotating_file_writer::should_rotate() const {
@@ -137,20 +235,54 @@ bool rotating_file_writer::should_rotate() const {
 void rotating_file_writer::perform_rotation() {
     // IMPORTANT: Caller must hold the mutex before calling this method
     // This ensures thread safety for all file operations and mutable state modifications
+    const auto now = std::chrono::system_clock::now();
 
-    // Close current file
-    if (file_stream_.is_open()) {
-        file_stream_.flush();
-        file_stream_.close();
+    std::unique_ptr<file_output> next;
+    {
+        std::lock_guard<std::mutex> next_lock(next_mutex_);
+        next = std::move(next_output_);
+    }
+    if (!next) {
+        // The next segment may still be opening, and earlier rotations may
+        // still be renaming; in-place rotation must not overlap either
+        worker_->wait_idle();
+        std::lock_guard<std::mutex> next_lock(next_mutex_);
+        next = std::move(next_output_);
     }
+    next_requested_ = false;
+
+    if (next) {
+        // The boundary: records from here on go to the new segment, while
+        // the old output is closed and renamed off this thread
+        std::shared_ptr<file_output> retired = std::exchange(output_, std::move(next));
+        bytes_written_ = output_->opened_size();
+        is_open_ = true;
+        worker_->post([this, retired, now]() { finish_rotation(retired, now); });
+    } else {
+        rotate_in_place(now);
+    }
+
+    // Update rotation time - protected by mutex
+    last_rotation_time_ = now;
+    current_period_start_ = last_rotation_time_;
+
+    // Reset write counter after rotation
+    writes_since_check_ = 0;
+}
+
+void rotating_file_writer::rotate_in_place(std::chrono::system_clock::time_point when) {
+    // Close current file; buffered output is written to it first
+    close_internal();
 
     // Generate new filename for the current log
-    std::string rotated_name = generate_rotated_filename();
+    std::string rotated_name = generate_rotated_filename(when);
 
     // Rename current file (with error handling)
+    bool renamed = false;
     auto rename_result = utils::try_write_operation([&]() -> common::VoidResult {
         if (std::filesystem::exists(filename_)) {
             std::filesystem::rename(filename_, rotated_name);
+            renamed = true;
         }
         return common::ok();
     }, logger_error_code::file_rotation_failed);
@@ -158,10 +290,17 @@ void rotating_file_writer::perform_rotation() {
     if (rename_result.is_err()) {
         std::cerr << "Failed to rotate log file: " << rename_result.error().message << std::endl;
     }
+    if (renamed) {
+        record_backup(rotated_name);
+    }
 
     // Clean up old files
     cleanup_old_files();
 
+    if (renamed && compressor_) {
+        compressor_->submit(rotated_name);
+    }
+
     // Open new file (with error handling)
     auto open_result = utils::try_open_operation([&]() -> common::VoidResult {
         std::filesystem::path file_path(filename_);
@@ -170,29 +309,177 @@ void rotating_file_writer::perform_rotation() {
         auto dir_result = utils::ensure_directory_exists(dir);
         if (dir_result.is_err()) return dir_result;
 
-        auto mode = append_mode_ ? std::ios::app : std::ios::trunc;
-        file_stream_.open(filename_, std::ios::out | mode);
-
-        if (file_stream_.is_open()) {
-            bytes_written_ = 0;
-        }
+        auto result = output_->open(filename_, append_mode_);
+        if (result.is_err()) return result;
 
+        bytes_written_ = output_->opened_size();
+        is_open_ = true;
         return common::ok();
     });
 
     if (open_result.is_err()) {
         std::cerr << "Failed to open new log file: " << open_result.error().message << std::endl;
     }
+}
 
-    // Update rotation time - protected by mutex
-    last_rotation_time_ = std::chrono::system_clock::now();
-    current_period_start_ = last_rotation_time_;
+void rotating_file_writer::request_next_segment() {
+    if (next_requested_) {
+        return;
+    }
+    next_requested_ = true;
+    worker_->post([this]() { prepare_next_segment(); });
+}
 
-    // Reset write counter after rotation
-    writes_since_check_ = 0;
+void rotating_file_writer::prepare_next_segment() {
+    auto next = make_file_output(output_options_);
+    auto result = utils::try_open_operation([&]() -> common::VoidResult {
+        auto dir_result = utils::ensure_directory_exists(
+            std::filesystem::path(next_filename_).parent_path());
+        if (dir_result.is_err()) return dir_result;
+        return next->open(next_filename_, true);
+    });
+
+    if (result.is_err()) {
+        // perform_rotation() finds no segment and rotates in place
+        std::cerr << "Failed to open next log file: " << result.error().message << std::endl;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(next_mutex_);
+    next_output_ = std::move(next);
+}
+
+void rotating_file_writer::finish_rotation(const std::shared_ptr<file_output>& retired,
+                                           std::chrono::system_clock::time_point when) {
+    auto close_result = retired->close();
+    if (close_result.is_err()) {
+        std::cerr << "Failed to close rotated log file: " << close_result.error().message << std::endl;
+    }
+
+    // The writer already appends to the next segment; renaming an open file
+    // does not disturb it
+    std::string rotated_name = generate_rotated_filename(when);
+    bool renamed = false;
+    auto rename_result = utils::try_write_operation([&]() -> common::VoidResult {
+        if (std::filesystem::exists(filename_)) {
+            std::filesystem::rename(filename_, rotated_name);
+            renamed = true;
+        }
+        std::filesystem::rename(next_filename_, filename_);
+        return common::ok();
+    }, logger_error_code::file_rotation_failed);
+
+    if (rename_result.is_err()) {
+        std::cerr << "Failed to rotate log file: " << rename_result.error().message << std::endl;
+    }
+    if (renamed) {
+        record_backup(rotated_name);
+    }
+
+    cleanup_old_files();
+
+    if (renamed && compressor_) {
+        compressor_->submit(rotated_name);
+    }
+}
+
+void rotating_file_writer::finish_compression(const std::string& segment,
+                                              const std::string& temporary,
+                                              const std::string& compressed) {
+    // Runs on the worker, so the segment cannot be renamed over meanwhile
+    worker_->post([this, segment, temporary, compressed]() {
+        std::error_code ec;
+        std::lock_guard<std::mutex> lock(backups_mutex_);
+        // Retention may have deleted the segment while it was compressed
+        if (!backups_->contains(segment) || !std::filesystem::exists(segment, ec)) {
+            std::filesystem::remove(temporary, ec);
+            return;
+        }
+
+        // Ordering at the next startup goes by modification time
+        const auto modified = std::filesystem::last_write_time(segment, ec);
+        if (!ec) {
+            std::filesystem::last_write_time(temporary, modified, ec);
+        }
+
+        std::filesystem::rename(temporary, compressed, ec);
+        if (ec) {
+            std::cerr << "Failed to install compressed log file: " << ec.message() << std::endl;
+            std::filesystem::remove(temporary, ec);
+            return;
+        }
+        const auto size = std::filesystem::file_size(compressed, ec);
+        backups_->replace(segment, compressed, ec ? 0 : size);
+        std::filesystem::remove(segment, ec);
+    });
+}
+
+void rotating_file_writer::start_housekeeping(const segment_compression_options& compression) {
+    load_backup_index();
+    recover_next_segment();
+    cleanup_old_files();
+
+    // Segments the output already compresses are not compressed again
+    if (compression.codec == compression_codec::none ||
+        (output_options_.compression != compression_codec::none &&
+         is_compression_available(compression_codec::gzip))) {
+        return;
+    }
+    auto options = compression;
+    options.codec = detail::resolve_codec(compression.codec);
+    if (options.codec == compression_codec::none) {
+        std::cerr << "Log compression requested but no codec is built in; "
+                  << "rotated files stay uncompressed" << std::endl;
+        return;
+    }
+
+    compressor_ = std::make_unique<detail::segment_compressor>(
+        options, [this](const std::string& segment, const std::string& temporary,
+                        const std::string& compressed) {
+            finish_compression(segment, temporary, compressed);
+        });
+
+    // Pick up what an earlier process rotated but did not get to compress
+    std::vector<std::string> pending;
+    {
+        std::lock_guard<std::mutex> lock(backups_mutex_);
+        for (const auto& backup : backups_->files()) {
+            pending.push_back(backup.path);
+        }
+    }
+    for (const auto& backup : pending) {
+        std::error_code ec;
+        std::filesystem::remove(backup + ".gz.tmp", ec);
+        std::filesystem::remove(backup + ".zst.tmp", ec);
+        if (!backup.ends_with(".gz") && !backup.ends_with(".zst")) {
+            compressor_->submit(backup);
+        }
+    }
 }
 
-std::string rotating_file_writer::generate_rotated_filename(int index) const {
+void rotating_file_writer::recover_next_segment() {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(next_filename_, ec);
+    if (ec) {
+        return;
+    }
+    if (size == 0) {
+        std::filesystem::remove(next_filename_, ec);
+        return;
+    }
+
+    // A crash between the swap and the rename leaves records here
+    const auto rotated_name = generate_rotated_filename(std::chrono::system_clock::now());
+    std::filesystem::rename(next_filename_, rotated_name, ec);
+    if (ec) {
+        std::cerr << "Failed to recover next log file: " << ec.message() << std::endl;
+        return;
+    }
+    record_backup(rotated_name);
+}
+
+std::string rotating_file_writer::generate_rotated_filename(
+    std::chrono::system_clock::time_point when, int index) const {
     std::ostringstream oss;
     std::filesystem::path dir = std::filesystem::path(filename_).parent_path();
 
@@ -205,8 +492,7 @@ std::string rotating_file_writer::generate_rotated_filename(int index) const {
     oss << base_filename_ << file_extension_;
 
     // Add timestamp or index
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
+    auto time_t = std::chrono::system_clock::to_time_t(when);
 
     // Use thread-safe time conversion
     std::tm tm_buf{};
@@ -221,13 +507,9 @@ std::string rotating_file_writer::generate_rotated_filename(int index) const {
             if (index >= 0) {
                 oss << "." << index;
             } else {
-                // Find next available index
-                std::string base_with_ext = oss.str();
-                int next_index = 1;
-                while (std::filesystem::exists(base_with_ext + "." + std::to_string(next_index))) {
-                    next_index++;
-                }
-                oss << "." << next_index;
+                // Next available index; a compressed backup keeps its index
+                std::lock_guard<std::mutex> lock(backups_mutex_);
+                oss << "." << backups_->lowest_free_index();
             }
             break;
 
@@ -248,43 +530,77 @@ std::string rotating_file_writer::generate_rotated_filename(int index) const {
 }
 
 void rotating_file_writer::cleanup_old_files() {
-    auto backup_files = get_backup_files();
-
-    if (backup_files.size() > max_files_) {
-        // Sort by modification time (oldest first)
-        std::sort(backup_files.begin(), backup_files.end(),
-                 [](const std::string& a, const std::string& b) {
-                     return std::filesystem::last_write_time(a) <
-                            std::filesystem::last_write_time(b);
-                 });
-
-        // Remove oldest files
-        size_t files_to_remove = backup_files.size() - max_files_;
-        for (size_t i = 0; i < files_to_remove; ++i) {
-            auto remove_result = utils::try_write_operation([&]() -> common::VoidResult {
-                std::filesystem::remove(backup_files[i]);
-                return common::ok();
-            }, logger_error_code::file_rotation_failed);
-
-            if (remove_result.is_err()) {
-                std::cerr << "Failed to remove old log file: " << remove_result.error().message << std::endl;
-            }
+    std::vector<std::string> expired;
+    {
+        std::lock_guard<std::mutex> lock(backups_mutex_);
+        expired = backups_->evict(max_files_, retention_.max_total_bytes, retention_.max_age,
+                                  std::filesystem::file_time_type::clock::now());
+    }
+
+    // Oldest first; deleting outside the lock keeps compression unblocked
+    for (const auto& path : expired) {
+        auto remove_result = utils::try_write_operation([&]() -> common::VoidResult {
+            std::filesystem::remove(path);
+            return common::ok();
+        }, logger_error_code::file_rotation_failed);
+
+        if (remove_result.is_err()) {
+            std::cerr << "Failed to remove old log file: " << remove_result.error().message << std::endl;
+        }
+    }
+}
+
+void rotating_file_writer::load_backup_index() {
+    const std::string prefix = base_filename_ + file_extension_ + ".";
+    std::vector<detail::backup_file> files;
+    for (auto& path : get_backup_files()) {
+        std::error_code ec;
+        detail::backup_file file;
+        file.size = std::filesystem::file_size(path, ec);
+        if (!ec) {
+            file.modified = std::filesystem::last_write_time(path, ec);
         }
+        if (ec) {
+            continue;  // Gone since the listing
+        }
+        file.index = backup_suffix(std::filesystem::path(path).filename().string(), prefix);
+        file.path = std::move(path);
+        files.push_back(std::move(file));
     }
+
+    std::lock_guard<std::mutex> lock(backups_mutex_);
+    backups_->assign(std::move(files));
+}
+
+void rotating_file_writer::record_backup(const std::string& path) {
+    std::error_code ec;
+    detail::backup_file file;
+    const auto size = std::filesystem::file_size(path, ec);
+    file.size = ec ? 0 : size;
+    file.modified = std::filesystem::file_time_type::clock::now();
+    file.index = backup_suffix(std::filesystem::path(path).filename().string(),
+                               base_filename_ + file_extension_ + ".");
+    file.path = path;
+
+    std::lock_guard<std::mutex> lock(backups_mutex_);
+    backups_->add(std::move(file));
 }
 
 std::vector<std::string> rotating_file_writer::get_backup_files() const {
     std::vector<std::string> files;
     std::filesystem::path dir = std::filesystem::path(filename_).parent_path();
-    if (dir.empty()) {
+    // Paths are spelled the way generate_rotated_filename() spells them
+    const bool bare = dir.empty();
+    if (bare) {
         dir = ".";
     }
 
     // Create regex pattern for backup files
     // Pattern: base_filename + file_extension + "." + (number or timestamp)
-    // Example: "test_rotating.log.1" or "test.log.20250108"
-    std::string escaped_ext = std::regex_replace(file_extension_, std::regex(R"(\.)"), R"(\\.)");
-    std::string pattern = base_filename_ + escaped_ext + R"(\.(\d+|\d{8}|\d{8}_\d{2}|\d{8}_\d{6}))";
+    // Example: "test_rotating.log.1", "test.log.20250108" or "test.log.2.gz"
+    std::string escaped_ext = std::regex_replace(file_extension_, std::regex(R"(\.)"), R"(\.)");
+    std::string pattern = base_filename_ + escaped_ext +
+                          R"(\.(\d+|\d{8}|\d{8}_\d{2}|\d{8}_\d{6})(\.gz|\.zst)?)";
     std::regex backup_regex(pattern);
 
     // Use error handling utility for directory iteration
@@ -293,7 +609,7 @@ std::vector<std::string> rotating_file_writer::get_backup_files() const {
             if (entry.is_regular_file()) {
                 std::string filename = entry.path().filename().string();
                 if (std::regex_match(filename, backup_regex)) {
-                    files.push_back(entry.path().string());
+                    files.push_back(bare ? filename : entry.path().string());
                 }
             }
         }
@@ -357,7 +673,7 @@ std::size_t rotating_file_writer::get_file_size() const {
     // thread-safe. Only call filesystem functions during actual rotation when
     // the caller already holds the mutex.
 
-    if (!file_stream_.is_open()) {
+    if (!is_open_) {
         return 0;
     }
 
@@ -0,0 +1,296 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include <kcenon/logger/writers/segment_compression.h>
+#include "segment_compressor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <time.h>
+#endif
+
+#if defined(LOGGER_HAS_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(LOGGER_HAS_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace kcenon::logger {
+
+namespace {
+
+/// Input read, compressed and throttled per step
+constexpr std::size_t chunk_size = 256 * 1024;
+
+/**
+ * @brief CPU time of the calling thread, or wall time where unavailable
+ */
+std::int64_t thread_cpu_ns() noexcept {
+#if defined(CLOCK_THREAD_CPUTIME_ID)
+    timespec now{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return std::int64_t{now.tv_sec} * 1'000'000'000 + now.tv_nsec;
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * @brief Sleeps after each chunk so CPU time stays within budget of wall time
+ *
+ * A chunk that used c nanoseconds of CPU is followed by a sleep of
+ * c * (1 / budget - 1), which makes the long-run ratio budget.
+ */
+class cpu_throttle {
+public:
+    explicit cpu_throttle(double budget)
+        : idle_per_busy_(budget > 0.0 && budget < 1.0 ? 1.0 / budget - 1.0 : 0.0)
+        , mark_(thread_cpu_ns()) {}
+
+    void pace() {
+        if (idle_per_busy_ == 0.0) {
+            return;
+        }
+        const auto busy = thread_cpu_ns() - mark_;
+        std::this_thread::sleep_for(std::chrono::nanoseconds(
+            static_cast<std::int64_t>(static_cast<double>(busy) * idle_per_busy_)));
+        mark_ = thread_cpu_ns();
+    }
+
+private:
+    double idle_per_busy_;
+    std::int64_t mark_;
+};
+
+common::VoidResult compression_failed(const std::string& message) {
+    return make_logger_void_result(logger_error_code::file_compression_failed, message);
+}
+
+/**
+ * @brief Feed the source through encode() chunk by chunk
+ * @param encode bool(const char* data, std::size_t size, bool last,
+ *               std::string& out) appending compressed bytes to out
+ */
+template <typename Encode>
+common::VoidResult pump(const std::string& source,
+                        const std::string& destination,
+                        double cpu_budget,
+                        const std::atomic<bool>* stop,
+                        Encode&& encode) {
+    std::ifstream in(source, std::ios::binary);
+    if (!in) {
+        return make_logger_void_result(logger_error_code::file_open_failed,
+                                       "Failed to open segment: " + source);
+    }
+    std::ofstream out(destination, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        return make_logger_void_result(logger_error_code::file_open_failed,
+                                       "Failed to create compressed segment: " + destination);
+    }
+
+    cpu_throttle throttle(cpu_budget);
+    std::vector<char> input(chunk_size);
+    std::string output;
+    bool last = false;
+    while (!last) {
+        if (stop != nullptr && stop->load(std::memory_order_relaxed)) {
+            return compression_failed("Compression stopped: " + source);
+        }
+
+        in.read(input.data(), static_cast<std::streamsize>(input.size()));
+        const auto got = static_cast<std::size_t>(in.gcount());
+        if (in.bad()) {
+            return make_logger_void_result(logger_error_code::file_read_failed,
+                                           "Failed to read segment: " + source);
+        }
+        last = in.eof();
+
+        output.clear();
+        if (!encode(input.data(), got, last, output)) {
+            return compression_failed("Compressor error on " + source);
+        }
+        out.write(output.data(), static_cast<std::streamsize>(output.size()));
+        if (!out) {
+            return make_logger_void_result(logger_error_code::file_write_failed,
+                                           "Failed to write compressed segment: " + destination);
+        }
+        throttle.pace();
+    }
+
+    out.close();
+    if (!out) {
+        return make_logger_void_result(logger_error_code::file_write_failed,
+                                       "Failed to close compressed segment: " + destination);
+    }
+    return common::ok();
+}
+
+#if defined(LOGGER_HAS_ZLIB)
+
+common::VoidResult compress_gzip(const std::string& source,
+                                 const std::string& destination,
+                                 const segment_compression_options& options,
+                                 const std::atomic<bool>* stop) {
+    z_stream stream{};
+    // 16 added to the window bits selects the gzip wrapper
+    const int level = options.level == 0 ? 6 : std::clamp(options.level, 1, 9);
+    if (deflateInit2(&stream, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return compression_failed("deflateInit2 failed");
+    }
+
+    char buffer[64 * 1024];
+    auto result = pump(source, destination, options.cpu_budget, stop,
+        [&](const char* data, std::size_t size, bool last, std::string& out) {
+            stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data));
+            stream.avail_in = static_cast<uInt>(size);
+            int rc = Z_OK;
+            do {
+                stream.next_out = reinterpret_cast<Bytef*>(buffer);
+                stream.avail_out = sizeof(buffer);
+                rc = deflate(&stream, last ? Z_FINISH : Z_NO_FLUSH);
+                if (rc == Z_STREAM_ERROR) {
+                    return false;
+                }
+                out.append(buffer, sizeof(buffer) - stream.avail_out);
+            } while (stream.avail_out == 0);
+            return !last || rc == Z_STREAM_END;
+        });
+
+    deflateEnd(&stream);
+    return result;
+}
+
+#endif // LOGGER_HAS_ZLIB
+
+#if defined(LOGGER_HAS_ZSTD)
+
+common::VoidResult compress_zstd(const std::string& source,
+                                 const std::string& destination,
+                                 const segment_compression_options& options,
+                                 const std::atomic<bool>* stop) {
+    ZSTD_CCtx* context = ZSTD_createCCtx();
+    if (context == nullptr) {
+        return compression_failed("ZSTD_createCCtx failed");
+    }
+    const int level = options.level == 0 ? 3 : std::clamp(options.level, 1, ZSTD_maxCLevel());
+    ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, level);
+    ZSTD_CCtx_setParameter(context, ZSTD_c_checksumFlag, 1);
+
+    std::vector<char> buffer(ZSTD_CStreamOutSize());
+    auto result = pump(source, destination, options.cpu_budget, stop,
+        [&](const char* data, std::size_t size, bool last, std::string& out) {
+            ZSTD_inBuffer input{data, size, 0};
+            const auto mode = last ? ZSTD_e_end : ZSTD_e_continue;
+            bool done = false;
+            while (!done) {
+                ZSTD_outBuffer output{buffer.data(), buffer.size(), 0};
+                const std::size_t remaining = ZSTD_compressStream2(context, &output, &input, mode);
+                if (ZSTD_isError(remaining)) {
+                    return false;
+                }
+                out.append(buffer.data(), output.pos);
+                done = last ? remaining == 0 : input.pos == input.size;
+            }
+            return true;
+        });
+
+    ZSTD_freeCCtx(context);
+    return result;
+}
+
+#endif // LOGGER_HAS_ZSTD
+
+} // namespace
+
+bool is_compression_available(compression_codec codec) noexcept {
+    switch (codec) {
+        case compression_codec::none:
+            return true;
+        case compression_codec::gzip:
+#if defined(LOGGER_HAS_ZLIB)
+            return true;
+#else
+            return false;
+#endif
+        case compression_codec::zstd:
+#if defined(LOGGER_HAS_ZSTD)
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+const char* compression_extension(compression_codec codec) noexcept {
+    switch (codec) {
+        case compression_codec::gzip:
+            return ".gz";
+        case compression_codec::zstd:
+            return ".zst";
+        case compression_codec::none:
+        default:
+            return "";
+    }
+}
+
+common::VoidResult compress_file(const std::string& source,
+                                 const std::string& destination,
+                                 const segment_compression_options& options) {
+    return detail::compress_segment(source, destination, options, nullptr);
+}
+
+namespace detail {
+
+compression_codec resolve_codec(compression_codec requested) noexcept {
+    if (is_compression_available(requested)) {
+        return requested;
+    }
+    const auto other = requested == compression_codec::gzip ? compression_codec::zstd
+                                                            : compression_codec::gzip;
+    return is_compression_available(other) ? other : compression_codec::none;
+}
+
+common::VoidResult compress_segment([[maybe_unused]] const std::string& source,
+                                    const std::string& destination,
+                                    const segment_compression_options& options,
+                                    [[maybe_unused]] const std::atomic<bool>* stop) {
+    if (options.codec == compression_codec::none || !is_compression_available(options.codec)) {
+        return compression_failed(std::string("Codec not available: ") +
+                                  compression_extension(options.codec));
+    }
+
+    common::VoidResult result = common::ok();
+#if defined(LOGGER_HAS_ZLIB)
+    if (options.codec == compression_codec::gzip) {
+        result = compress_gzip(source, destination, options, stop);
+    }
+#endif
+#if defined(LOGGER_HAS_ZSTD)
+    if (options.codec == compression_codec::zstd) {
+        result = compress_zstd(source, destination, options, stop);
+    }
+#endif
+
+    if (result.is_err()) {
+        // Never leave a truncated stream that looks like a finished one
+        std::error_code ec;
+        std::filesystem::remove(destination, ec);
+    }
+    return result;
+}
+
+} // namespace detail
+
+} // namespace kcenon::logger
@@ -0,0 +1,108 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#include "segment_compressor.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace kcenon::logger::detail {
+
+namespace {
+
+/**
+ * @brief Give the calling thread the lowest non-idle priority
+ *
+ * Linux applies nice values per thread; elsewhere the CPU budget alone
+ * limits how much a compression thread takes from the loggers.
+ */
+void lower_thread_priority() noexcept {
+#if defined(__linux__)
+    ::setpriority(PRIO_PROCESS, static_cast<id_t>(::syscall(SYS_gettid)), 19);
+#endif
+}
+
+} // namespace
+
+segment_compressor::segment_compressor(const segment_compression_options& options,
+                                       finish_handler on_finish)
+    : options_(options)
+    , on_finish_(std::move(on_finish)) {
+    options_.max_concurrent = std::max<std::size_t>(options_.max_concurrent, 1);
+}
+
+segment_compressor::~segment_compressor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_.store(true, std::memory_order_relaxed);
+    }
+    work_cv_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void segment_compressor::submit(std::string segment) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push_back(std::move(segment));
+        if (threads_.size() < options_.max_concurrent && queue_.size() > threads_.size() - active_) {
+            threads_.emplace_back([this]() { run(); });
+        }
+    }
+    work_cv_.notify_one();
+}
+
+void segment_compressor::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_cv_.wait(lock, [this]() { return queue_.empty() && active_ == 0; });
+}
+
+void segment_compressor::run() {
+    lower_thread_priority();
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        work_cv_.wait(lock, [this]() {
+            return stop_.load(std::memory_order_relaxed) || !queue_.empty();
+        });
+        if (stop_.load(std::memory_order_relaxed)) {
+            return;
+        }
+
+        const std::string segment = std::move(queue_.front());
+        queue_.pop_front();
+        ++active_;
+        lock.unlock();
+
+        const std::string compressed = segment + compression_extension(options_.codec);
+        const std::string temporary = compressed + ".tmp";
+        // Retention may have removed the segment while it waited
+        std::error_code ec;
+        if (std::filesystem::exists(segment, ec)) {
+            auto result = compress_segment(segment, temporary, options_, &stop_);
+            if (result.is_ok()) {
+                on_finish_(segment, temporary, compressed);
+            } else if (!stop_.load(std::memory_order_relaxed)) {
+                std::cerr << "Failed to compress log file: " << result.error().message << std::endl;
+            }
+        }
+
+        lock.lock();
+        --active_;
+        if (queue_.empty() && active_ == 0) {
+            idle_cv_.notify_all();
+        }
+    }
+}
+
+} // namespace kcenon::logger::detail
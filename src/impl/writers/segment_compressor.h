@@ -0,0 +1,99 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+#pragma once
+
+/**
+ * @file segment_compressor.h
+ * @brief Low-priority thread pool compressing rotated log segments
+ * @since 4.1.0
+ *
+ * @note This is an internal header, not part of the public API
+ */
+
+#include <kcenon/logger/writers/segment_compression.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace kcenon::logger::detail {
+
+/**
+ * @brief The codec to use for a request: itself if built in, else the
+ *        other one, else none
+ */
+compression_codec resolve_codec(compression_codec requested) noexcept;
+
+/**
+ * @brief compress_file() that gives up between chunks once stop is set
+ */
+common::VoidResult compress_segment(const std::string& source,
+                                    const std::string& destination,
+                                    const segment_compression_options& options,
+                                    const std::atomic<bool>* stop);
+
+/**
+ * @class segment_compressor
+ * @brief Compresses queued segments on up to max_concurrent threads
+ *
+ * @details Each segment is compressed to `<segment><ext>.tmp`, then handed
+ * to the finish handler, which decides whether the result replaces the
+ * segment. Threads start with the first submit() and lower their own
+ * scheduling priority. Destruction abandons work in progress, deleting its
+ * temporary file; queued segments stay uncompressed.
+ */
+class segment_compressor {
+public:
+    /**
+     * @brief Called on a compression thread after a segment compressed
+     * @param segment The segment that was submitted
+     * @param temporary Compressed data, at `<compressed>.tmp`
+     * @param compressed Final name of the compressed segment
+     */
+    using finish_handler = std::function<void(const std::string& segment,
+                                              const std::string& temporary,
+                                              const std::string& compressed)>;
+
+    segment_compressor(const segment_compression_options& options, finish_handler on_finish);
+    ~segment_compressor();
+
+    segment_compressor(const segment_compressor&) = delete;
+    segment_compressor& operator=(const segment_compressor&) = delete;
+
+    /**
+     * @brief Queue a segment for compression
+     */
+    void submit(std::string segment);
+
+    /**
+     * @brief Block until every submitted segment has been handled
+     */
+    void wait_idle();
+
+    compression_codec codec() const noexcept {
+        return options_.codec;
+    }
+
+private:
+    void run();
+
+    segment_compression_options options_;
+    finish_handler on_finish_;
+
+    std::mutex mutex_;
+    std::condition_variable work_cv_;
+    std::condition_variable idle_cv_;
+    std::deque<std::string> queue_;
+    std::size_t active_ = 0;
+    std::atomic<bool> stop_{false};
+    std::vector<std::thread> threads_;
+};
+
+} // namespace kcenon::logger::detail
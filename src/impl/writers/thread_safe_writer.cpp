@@ -16,6 +16,22 @@ common::VoidResult thread_safe_writer::write(const log_entry& entry) {
     return write_entry_impl(entry);
 }
 
+common::VoidResult thread_safe_writer::write_batch(std::span<const log_entry> entries) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    return write_batch_impl(entries);
+}
+
+common::VoidResult thread_safe_writer::write_batch_impl(std::span<const log_entry> entries) {
+    common::VoidResult first_error = common::ok();
+    for (const auto& entry : entries) {
+        auto result = write_entry_impl(entry);
+        if (result.is_err() && first_error.is_ok()) {
+            first_error = result;
+        }
+    }
+    return first_error;
+}
+
 common::VoidResult thread_safe_writer::flush() {
     std::lock_guard<std::mutex> lock(write_mutex_);
     return flush_impl();
@@ -0,0 +1,236 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file batch_arena_test.cpp
+ * @brief Unit tests for the per-batch arena used by the collector worker
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <kcenon/logger/core/batch_context.h>
+#include <kcenon/logger/core/log_collector.h>
+#include <kcenon/logger/core/logger_config.h>
+#include <kcenon/logger/formatters/json_formatter.h>
+#include <kcenon/logger/formatters/timestamp_formatter.h>
+#include <kcenon/logger/interfaces/log_entry.h>
+#include <kcenon/logger/interfaces/log_writer_interface.h>
+#include <kcenon/logger/writers/file_writer.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <new>
+#include <span>
+#include <string>
+#include <thread>
+
+// Count heap allocations per thread so the worker's own allocations can be
+// isolated from the producer's
+namespace {
+thread_local std::uint64_t t_allocations = 0;
+}
+
+void* operator new(std::size_t size) {
+    ++t_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t align) {
+    ++t_allocations;
+    const auto alignment = static_cast<std::size_t>(align);
+    if (void* p = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+    std::free(p);
+}
+
+using namespace kcenon::logger;
+using log_level = kcenon::common::interfaces::log_level;
+
+namespace {
+
+/**
+ * @brief Writer that samples the calling thread's allocation count per batch
+ * @note Must not allocate itself
+ */
+class allocation_probe : public log_writer_interface {
+public:
+    static constexpr std::size_t max_samples = 64;
+
+    kcenon::common::VoidResult write(const log_entry&) override {
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult write_batch(std::span<const log_entry>) override {
+        const auto index = count_.load(std::memory_order_relaxed);
+        if (index < max_samples) {
+            samples_[index] = t_allocations;
+            count_.store(index + 1, std::memory_order_release);
+        }
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult flush() override {
+        return kcenon::common::ok();
+    }
+
+    std::string get_name() const override {
+        return "probe";
+    }
+
+    bool is_healthy() const override {
+        return true;
+    }
+
+    bool wait_for_samples(std::size_t count) const {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (count_.load(std::memory_order_acquire) < count) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+    std::size_t sample_count() const {
+        return count_.load(std::memory_order_acquire);
+    }
+
+    std::uint64_t sample(std::size_t index) const {
+        return samples_[index];
+    }
+
+private:
+    std::array<std::uint64_t, max_samples> samples_{};
+    std::atomic<std::size_t> count_{0};
+};
+
+log_entry sample_entry() {
+    log_entry entry(log_level::warning, "disk usage above threshold",
+                    "/src/storage/volume.cpp", 42, "check_usage",
+                    std::chrono::system_clock::now());
+    entry.thread_id = small_string_64("1234");
+    return entry;
+}
+
+} // namespace
+
+TEST(BatchArenaTest, CurrentResourceFollowsScope) {
+    EXPECT_EQ(batch_context::current(), nullptr);
+    EXPECT_EQ(batch_context::current_resource(), std::pmr::get_default_resource());
+
+    batch_context context(1024);
+    {
+        batch_context::scope active(context);
+        EXPECT_EQ(batch_context::current(), &context);
+        EXPECT_EQ(batch_context::current_resource(), context.resource());
+    }
+    EXPECT_EQ(batch_context::current(), nullptr);
+}
+
+TEST(BatchArenaTest, ResetGrowsToHighWaterMark) {
+    batch_context context(1024);
+    EXPECT_EQ(context.capacity(), 1024u);
+
+    {
+        std::pmr::string text(context.resource());
+        text.assign(4000, 'x');
+    }
+    context.reset();
+    EXPECT_EQ(context.grow_count(), 1u);
+    EXPECT_GE(context.capacity(), 5024u);
+
+    // The same batch now fits in the block and needs no further growth
+    const auto before = t_allocations;
+    {
+        std::pmr::string text(context.resource());
+        text.assign(4000, 'x');
+    }
+    context.reset();
+    EXPECT_EQ(t_allocations, before);
+    EXPECT_EQ(context.grow_count(), 1u);
+}
+
+TEST(BatchArenaTest, FormatToMatchesFormat) {
+    const auto entry = sample_entry();
+    const timestamp_formatter plain;
+    const json_formatter json;
+
+    for (const log_formatter_interface* formatter :
+         {static_cast<const log_formatter_interface*>(&plain),
+          static_cast<const log_formatter_interface*>(&json)}) {
+        std::pmr::string out;
+        formatter->format_to(entry, out);
+        EXPECT_EQ(std::string(out), formatter->format(entry)) << formatter->get_name();
+    }
+}
+
+TEST(BatchArenaTest, SteadyStateBatchesDoNotAllocateOnWorker) {
+    const auto path = std::filesystem::temp_directory_path() / "logger_batch_arena_test.log";
+    std::filesystem::remove(path);
+
+    constexpr std::size_t batch = 16;
+    constexpr std::size_t rounds = 12;
+    constexpr std::size_t warmup = 4;
+
+    logger_config config;
+    config.buffer_size = 256;
+    config.batch_size = batch;
+    config.use_lock_free = true;
+
+    {
+        log_collector collector(config);
+        auto probe = std::make_shared<allocation_probe>();
+        collector.add_writer(std::make_shared<file_writer>(path.string()));
+        collector.add_writer(probe);
+        collector.start();
+
+        for (std::size_t round = 0; round < rounds; ++round) {
+            for (std::size_t i = 0; i < batch; ++i) {
+                ASSERT_TRUE(collector.enqueue(log_level::info, "request served in 12 ms",
+                                              "/src/http/server.cpp", 128, "handle",
+                                              std::chrono::system_clock::now()));
+            }
+            ASSERT_TRUE(probe->wait_for_samples(round + 1));
+        }
+        // stop() drains on this thread; only worker-thread samples count
+        const auto samples = probe->sample_count();
+        collector.stop();
+
+        // A round may be drained as several batches; compare every pair
+        ASSERT_GT(samples, warmup + 1);
+        for (std::size_t i = warmup + 1; i < samples; ++i) {
+            EXPECT_EQ(probe->sample(i) - probe->sample(i - 1), 0u)
+                << "worker allocated during batch " << i;
+        }
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,205 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file dispatch_lane_test.cpp
+ * @brief Unit tests for per-writer dispatch lanes in log_collector
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <kcenon/logger/core/log_collector.h>
+#include <kcenon/logger/core/logger_config.h>
+#include <kcenon/logger/core/memory_budget.h>
+#include <kcenon/logger/interfaces/log_entry.h>
+#include <kcenon/logger/interfaces/log_writer_interface.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kcenon::logger;
+using log_level = kcenon::common::interfaces::log_level;
+
+namespace {
+
+/**
+ * @brief Writer that records entries; write_batch can be held closed
+ */
+class gated_writer : public log_writer_interface {
+public:
+    gated_writer(std::string name, bool open)
+        : name_(std::move(name)), open_(open) {}
+
+    kcenon::common::VoidResult write(const log_entry& entry) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        messages_.push_back(entry.message.to_string());
+        cv_.notify_all();
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult write_batch(std::span<const log_entry> entries) override {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return open_; });
+        }
+        return log_writer_interface::write_batch(entries);
+    }
+
+    kcenon::common::VoidResult flush() override {
+        return kcenon::common::ok();
+    }
+
+    std::string get_name() const override {
+        return name_;
+    }
+
+    bool is_healthy() const override {
+        return true;
+    }
+
+    void open() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        open_ = true;
+        cv_.notify_all();
+    }
+
+    bool wait_for_count(std::size_t count, std::chrono::milliseconds timeout) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cv_.wait_for(lock, timeout, [&] { return messages_.size() >= count; });
+    }
+
+    std::size_t count() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_.size();
+    }
+
+private:
+    std::string name_;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool open_;
+    std::vector<std::string> messages_;
+};
+
+logger_config lane_config(std::size_t lanes) {
+    logger_config config;
+    config.buffer_size = 16;
+    config.batch_size = 4;
+    config.writer_thread_count = lanes;
+    return config;
+}
+
+std::size_t collector_held_bytes() {
+    std::size_t held = 0;
+    for (const auto& stats : memory_budget::instance().get_consumer_stats()) {
+        if (stats.name == "log_collector") {
+            held += stats.held_bytes;
+        }
+    }
+    return held;
+}
+
+void enqueue_n(log_collector& collector, int count) {
+    for (int i = 0; i < count; ++i) {
+        ASSERT_TRUE(collector.enqueue(log_level::info, "m" + std::to_string(i), "", 0, "",
+                                      std::chrono::system_clock::now()));
+    }
+}
+
+} // namespace
+
+TEST(DispatchLaneTest, SingleWriterThreadHasNoLanes) {
+    log_collector collector(lane_config(1));
+    collector.add_writer(std::make_shared<gated_writer>("file", true));
+    EXPECT_TRUE(collector.get_lane_stats().empty());
+}
+
+TEST(DispatchLaneTest, WritersAreSpreadAcrossLanes) {
+    log_collector collector(lane_config(2));
+    collector.add_writer(std::make_shared<gated_writer>("a", true));
+    collector.add_writer(std::make_shared<gated_writer>("b", true));
+    collector.add_writer(std::make_shared<gated_writer>("c", true));
+
+    const auto stats = collector.get_lane_stats();
+    ASSERT_EQ(stats.size(), 2u);
+    EXPECT_EQ(stats[0].writers, (std::vector<std::string>{"a", "c"}));
+    EXPECT_EQ(stats[1].writers, (std::vector<std::string>{"b"}));
+    EXPECT_EQ(stats[0].capacity, 16u);
+}
+
+TEST(DispatchLaneTest, StalledWriterDoesNotBlockOtherLane) {
+    log_collector collector(lane_config(2));
+    auto slow = std::make_shared<gated_writer>("slow", false);
+    auto fast = std::make_shared<gated_writer>("fast", true);
+    collector.add_writer(slow);
+    collector.add_writer(fast);
+    collector.start();
+
+    enqueue_n(collector, 12);
+    EXPECT_TRUE(fast->wait_for_count(12, std::chrono::seconds(5)));
+    EXPECT_EQ(slow->count(), 0u);
+
+    slow->open();
+    collector.flush();
+    EXPECT_EQ(slow->count(), 12u);
+    collector.stop();
+
+    const auto stats = collector.get_lane_stats();
+    EXPECT_EQ(stats[0].entries_written, 12u);
+    EXPECT_EQ(stats[1].entries_written, 12u);
+    EXPECT_GE(stats[0].max_latency, stats[1].max_latency);
+}
+
+TEST(DispatchLaneTest, FullLaneDropsOnlyItsOwnBatches) {
+    log_collector collector(lane_config(2));
+    auto slow = std::make_shared<gated_writer>("slow", false);
+    auto fast = std::make_shared<gated_writer>("fast", true);
+    collector.add_writer(slow);
+    collector.add_writer(fast);
+    collector.start();
+
+    // Fills the stalled lane to its 16-entry capacity
+    enqueue_n(collector, 16);
+    ASSERT_TRUE(fast->wait_for_count(16, std::chrono::seconds(5)));
+
+    enqueue_n(collector, 8);
+    ASSERT_TRUE(fast->wait_for_count(24, std::chrono::seconds(5)));
+
+    auto stats = collector.get_lane_stats();
+    EXPECT_EQ(stats[0].entries_dropped, 8u);
+    EXPECT_EQ(stats[0].queued_entries, 16u);
+    EXPECT_EQ(stats[1].entries_dropped, 0u);
+
+    slow->open();
+    collector.stop();
+    EXPECT_EQ(slow->count(), 16u);
+    EXPECT_EQ(fast->count(), 24u);
+}
+
+TEST(DispatchLaneTest, LaneBacklogStaysChargedToTheBudget) {
+    log_collector collector(lane_config(2));
+    auto slow = std::make_shared<gated_writer>("slow", false);
+    auto fast = std::make_shared<gated_writer>("fast", true);
+    collector.add_writer(slow);
+    collector.add_writer(fast);
+    collector.start();
+
+    enqueue_n(collector, 8);
+    ASSERT_TRUE(fast->wait_for_count(8, std::chrono::seconds(5)));
+    // Written by one lane but still queued on the stalled one
+    EXPECT_GT(collector_held_bytes(), 0u);
+
+    slow->open();
+    collector.flush();
+    EXPECT_EQ(slow->count(), 8u);
+    collector.stop();
+    EXPECT_EQ(collector_held_bytes(), 0u);
+}
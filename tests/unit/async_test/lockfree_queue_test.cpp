@@ -0,0 +1,465 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file lockfree_queue_test.cpp
+ * @brief Unit tests for the lock-free MPMC queue and the lock-free collector
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "../../../src/impl/async/lockfree_queue.h"
+
+#include <kcenon/logger/core/log_collector.h>
+#include <kcenon/logger/core/logger_config.h>
+#include <kcenon/logger/interfaces/log_entry.h>
+#include <kcenon/logger/interfaces/log_writer_interface.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kcenon::logger;
+using log_level = kcenon::common::interfaces::log_level;
+
+namespace {
+
+class counting_writer : public log_writer_interface {
+public:
+    kcenon::common::VoidResult write(const log_entry& entry) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        messages_.push_back(entry.message.to_string());
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult flush() override {
+        return kcenon::common::ok();
+    }
+
+    std::string get_name() const override {
+        return "counting";
+    }
+
+    bool is_healthy() const override {
+        return true;
+    }
+
+    std::vector<std::string> messages() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::vector<std::string> messages_;
+};
+
+} // namespace
+
+// =============================================================================
+// lockfree_mpmc_queue
+// =============================================================================
+
+TEST(LockfreeMpmcQueueTest, CapacityRoundsUpToPowerOfTwo) {
+    async::lockfree_mpmc_queue<int> queue(100);
+    EXPECT_EQ(queue.capacity(), 128u);
+
+    async::lockfree_mpmc_queue<int> tiny(0);
+    EXPECT_EQ(tiny.capacity(), 2u);
+}
+
+TEST(LockfreeMpmcQueueTest, FifoOrderSingleThread) {
+    async::lockfree_mpmc_queue<int> queue(8);
+    for (int i = 0; i < 8; ++i) {
+        EXPECT_TRUE(queue.enqueue(i));
+    }
+    EXPECT_FALSE(queue.enqueue(99)) << "Queue should report full";
+    EXPECT_EQ(queue.size(), 8u);
+
+    for (int i = 0; i < 8; ++i) {
+        int value = -1;
+        ASSERT_TRUE(queue.dequeue(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_TRUE(queue.empty());
+    EXPECT_FALSE(queue.try_dequeue().has_value());
+}
+
+TEST(LockfreeMpmcQueueTest, HoldsMoveOnlyNonDefaultConstructible) {
+    async::lockfree_mpmc_queue<log_entry> queue(4);
+    EXPECT_TRUE(queue.enqueue(log_entry(log_level::info, "first")));
+    EXPECT_TRUE(queue.emplace(log_level::error, "second"));
+
+    std::vector<log_entry> out;
+    EXPECT_EQ(queue.dequeue_bulk(out, 10), 2u);
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_EQ(out[0].message.to_string(), "first");
+    EXPECT_EQ(out[1].level, log_level::error);
+}
+
+TEST(LockfreeMpmcQueueTest, DestructorReleasesRemainingItems) {
+    auto tracker = std::make_shared<int>(0);
+    {
+        async::lockfree_mpmc_queue<std::shared_ptr<int>> queue(4);
+        queue.enqueue(tracker);
+        queue.enqueue(tracker);
+        EXPECT_EQ(tracker.use_count(), 3);
+    }
+    EXPECT_EQ(tracker.use_count(), 1);
+}
+
+TEST(LockfreeMpmcQueueTest, ConcurrentProducersAndConsumers) {
+    constexpr int producers = 4;
+    constexpr int consumers = 4;
+    constexpr int per_producer = 20000;
+
+    async::lockfree_mpmc_queue<int> queue(1024);
+    std::atomic<long long> sum{0};
+    std::atomic<int> consumed{0};
+    std::vector<std::thread> threads;
+
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&queue, p] {
+            for (int i = 1; i <= per_producer; ++i) {
+                const int value = p * per_producer + i;
+                while (!queue.enqueue(value)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&] {
+            while (consumed.load() < producers * per_producer) {
+                int value = 0;
+                if (queue.dequeue(value)) {
+                    sum.fetch_add(value);
+                    consumed.fetch_add(1);
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    const long long n = static_cast<long long>(producers) * per_producer;
+    EXPECT_EQ(consumed.load(), n);
+    EXPECT_EQ(sum.load(), n * (n + 1) / 2);
+    EXPECT_TRUE(queue.empty());
+}
+
+// =============================================================================
+// ring_memory-backed queues
+// =============================================================================
+
+TEST(RingMemoryTest, MappedMpmcQueueKeepsFifoOrderAcrossPrefault) {
+    async::ring_memory_options options;
+    options.huge_pages = true;
+    options.lock = true;
+    async::lockfree_mpmc_queue<int> queue(1 << 14, options);
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(queue.enqueue(i));
+    }
+    // Populating and locking must not disturb queued elements
+    queue.prefault();
+    for (int i = 100; i < 200; ++i) {
+        ASSERT_TRUE(queue.enqueue(i));
+    }
+
+    int value = -1;
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(queue.dequeue(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_GE(queue.memory().size(), queue.memory_footprint());
+#if defined(__linux__)
+    EXPECT_NE(queue.memory().get_backing(), async::ring_memory::backing::heap);
+#endif
+}
+
+TEST(RingMemoryTest, DefaultOptionsUseHeap) {
+    async::lockfree_mpmc_queue<int> queue(64);
+    EXPECT_EQ(queue.memory().get_backing(), async::ring_memory::backing::heap);
+    queue.prefault();  // No-op
+    EXPECT_FALSE(queue.memory().locked());
+}
+
+TEST(RingMemoryTest, MappedSpscQueue) {
+    async::ring_memory_options options;
+    options.huge_pages = true;
+    auto queue = async::make_lockfree_queue<int, 4096>(options);
+    queue.get_deleter().memory.prefault();
+
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(queue.get()) % 64, 0u);
+    ASSERT_TRUE(queue->enqueue(7));
+    int value = 0;
+    ASSERT_TRUE(queue->dequeue(value));
+    EXPECT_EQ(value, 7);
+}
+
+TEST(RingMemoryTest, CollectorWithHugePagesDeliversEntries) {
+    logger_config config;
+    config.buffer_size = 1 << 12;
+    config.use_lock_free = true;
+    config.queue_huge_pages = true;
+
+    log_collector collector(config);
+    auto writer = std::make_shared<counting_writer>();
+    collector.add_writer(writer);
+    collector.start();
+    for (int i = 0; i < 1000; ++i) {
+        collector.enqueue(log_level::info, "m", "", 0, "", std::chrono::system_clock::now());
+    }
+    collector.flush();
+    collector.stop();
+
+    EXPECT_EQ(writer->messages().size(), 1000u);
+}
+
+// =============================================================================
+// log_collector with logger_config::use_lock_free
+// =============================================================================
+
+TEST(LockfreeCollectorTest, DeliversAllEntriesFromManyProducers) {
+    logger_config config;
+    config.buffer_size = 1 << 16;
+    config.batch_size = 64;
+    config.use_lock_free = true;
+
+    log_collector collector(config);
+    auto writer = std::make_shared<counting_writer>();
+    collector.add_writer(writer);
+    collector.start();
+
+    constexpr int producers = 8;
+    constexpr int per_producer = 1000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&collector] {
+            for (int i = 0; i < per_producer; ++i) {
+                collector.enqueue(log_level::info, "message", "", 0, "",
+                                  std::chrono::system_clock::now());
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    collector.flush();
+    collector.stop();
+
+    EXPECT_EQ(writer->messages().size(),
+              static_cast<size_t>(producers * per_producer));
+}
+
+TEST(LockfreeCollectorTest, ReportsRingCapacityAndDropsWhenFull) {
+    logger_config config;
+    config.buffer_size = 16;
+    config.use_lock_free = true;
+
+    log_collector collector(config);  // Not started: nothing drains the ring
+
+    auto metrics = collector.get_queue_metrics();
+    EXPECT_EQ(metrics.second, 16u);
+
+    size_t accepted = 0;
+    for (int i = 0; i < 32; ++i) {
+        if (collector.enqueue(log_level::info, "m", "", 0, "",
+                              std::chrono::system_clock::now())) {
+            ++accepted;
+        }
+    }
+    EXPECT_EQ(accepted, 16u);
+    EXPECT_EQ(collector.get_queue_metrics().first, 16u);
+}
+
+// =============================================================================
+// log_collector with logger_config::use_thread_local_buffers
+// =============================================================================
+
+TEST(PerThreadCollectorTest, PreservesPerThreadOrder) {
+    logger_config config;
+    config.batch_size = 32;
+    config.use_thread_local_buffers = true;
+
+    log_collector collector(config);
+    auto writer = std::make_shared<counting_writer>();
+    collector.add_writer(writer);
+    collector.start();
+
+    constexpr int producers = 6;
+    constexpr int per_producer = 2000;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&collector, p] {
+            for (int i = 0; i < per_producer; ++i) {
+                // Retry on a full ring so every entry is delivered
+                while (!collector.enqueue(log_level::info,
+                                          std::to_string(p) + ":" + std::to_string(i),
+                                          "", 0, "", std::chrono::system_clock::now())) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    collector.flush();
+    collector.stop();
+
+    auto messages = writer->messages();
+    ASSERT_EQ(messages.size(), static_cast<size_t>(producers * per_producer));
+
+    std::vector<int> next(producers, 0);
+    for (const auto& m : messages) {
+        const auto colon = m.find(':');
+        const int p = std::stoi(m.substr(0, colon));
+        const int i = std::stoi(m.substr(colon + 1));
+        EXPECT_EQ(i, next[p]) << "Out-of-order entry from thread " << p;
+        next[p] = i + 1;
+    }
+}
+
+TEST(PerThreadCollectorTest, MergeByTimestampInterleavesThreads) {
+    logger_config config;
+    config.batch_size = 16;
+    config.use_thread_local_buffers = true;
+    config.merge_by_timestamp = true;
+
+    log_collector collector(config);
+    auto writer = std::make_shared<counting_writer>();
+    collector.add_writer(writer);
+
+    // Stage entries before starting so the worker drains them in one batch
+    const auto base = std::chrono::system_clock::now();
+    auto stage = [&collector, base](std::vector<int> offsets) {
+        std::thread([&collector, base, offsets] {
+            for (int offset : offsets) {
+                collector.enqueue(log_level::info, std::to_string(offset), "", 0, "",
+                                  base + std::chrono::milliseconds(offset));
+            }
+        }).join();
+    };
+    stage({1, 3, 5});
+    stage({2, 4, 6});
+
+    EXPECT_EQ(collector.get_queue_metrics().first, 6u);
+
+    collector.start();
+    collector.flush();
+    collector.stop();
+
+    const std::vector<std::string> expected{"1", "2", "3", "4", "5", "6"};
+    EXPECT_EQ(writer->messages(), expected);
+}
+
+// =============================================================================
+// log_collector with logger_config::use_per_cpu_buffers
+// =============================================================================
+
+TEST(PerCpuCollectorTest, DeliversAllEntriesFromManyProducers) {
+    logger_config config;
+    config.batch_size = 64;
+    config.use_per_cpu_buffers = true;
+
+    log_collector collector(config);
+    auto writer = std::make_shared<counting_writer>();
+    collector.add_writer(writer);
+    collector.start();
+
+    // Short-lived threads share the per-CPU rings instead of adding their own
+    constexpr int producers = 32;
+    constexpr int per_producer = 500;
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&collector] {
+            for (int i = 0; i < per_producer; ++i) {
+                while (!collector.enqueue(log_level::info, "message", "", 0, "",
+                                          std::chrono::system_clock::now())) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    collector.flush();
+    collector.stop();
+
+    EXPECT_EQ(writer->messages().size(),
+              static_cast<size_t>(producers * per_producer));
+}
+
+TEST(PerCpuCollectorTest, CapacityScalesWithCpusNotThreads) {
+    logger_config config;
+    config.buffer_size = 4096;
+    config.use_per_cpu_buffers = true;
+
+    log_collector collector(config);  // Not started: nothing drains the rings
+    const auto capacity = collector.get_queue_metrics().second;
+    EXPECT_GE(capacity, 4096u);
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < 16; ++p) {
+        threads.emplace_back([&collector] {
+            collector.enqueue(log_level::info, "m", "", 0, "", std::chrono::system_clock::now());
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+
+    const auto metrics = collector.get_queue_metrics();
+    EXPECT_EQ(metrics.first, 16u);
+    EXPECT_EQ(metrics.second, capacity);
+}
+
+TEST(PerCpuCollectorTest, MergeByTimestampRestoresOrder) {
+    logger_config config;
+    config.batch_size = 256;
+    config.use_per_cpu_buffers = true;
+    config.merge_by_timestamp = true;
+
+    log_collector collector(config);
+    auto writer = std::make_shared<counting_writer>();
+    collector.add_writer(writer);
+
+    // Stage from several threads, which may land on different CPUs
+    const auto base = std::chrono::system_clock::now();
+    for (int t = 0; t < 4; ++t) {
+        std::thread([&collector, base, t] {
+            for (int i = t; i < 40; i += 4) {
+                collector.enqueue(log_level::info, std::to_string(i), "", 0, "",
+                                  base + std::chrono::milliseconds(i));
+            }
+        }).join();
+    }
+
+    collector.start();
+    collector.flush();
+    collector.stop();
+
+    const auto messages = writer->messages();
+    ASSERT_EQ(messages.size(), 40u);
+    for (int i = 0; i < 40; ++i) {
+        EXPECT_EQ(messages[static_cast<size_t>(i)], std::to_string(i));
+    }
+}
@@ -0,0 +1,222 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file overflow_policy_test.cpp
+ * @brief Unit tests for queue overflow policies in log_collector
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <kcenon/logger/core/log_collector.h>
+#include <kcenon/logger/core/logger.h>
+#include <kcenon/logger/core/logger_config.h>
+#include <kcenon/logger/interfaces/log_entry.h>
+#include <kcenon/logger/interfaces/log_writer_interface.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kcenon::logger;
+using log_level = kcenon::common::interfaces::log_level;
+using policy = logger_config::overflow_policy;
+
+namespace {
+
+/**
+ * @brief Writer that records messages, optionally stalling on each batch
+ */
+class slow_writer : public log_writer_interface {
+public:
+    explicit slow_writer(std::chrono::microseconds batch_delay = std::chrono::microseconds{0})
+        : batch_delay_(batch_delay) {}
+
+    kcenon::common::VoidResult write(const log_entry& entry) override {
+        std::lock_guard<std::mutex> lock(mutex_);
+        messages_.push_back(entry.message.to_string());
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult write_batch(std::span<const log_entry> entries) override {
+        std::this_thread::sleep_for(batch_delay_);
+        return log_writer_interface::write_batch(entries);
+    }
+
+    kcenon::common::VoidResult flush() override {
+        return kcenon::common::ok();
+    }
+
+    std::string get_name() const override {
+        return "slow";
+    }
+
+    bool is_healthy() const override {
+        return true;
+    }
+
+    std::vector<std::string> messages() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return messages_;
+    }
+
+private:
+    std::chrono::microseconds batch_delay_;
+    mutable std::mutex mutex_;
+    std::vector<std::string> messages_;
+};
+
+logger_config make_config(policy overflow, std::size_t buffer_size) {
+    logger_config config;
+    config.buffer_size = buffer_size;
+    config.batch_size = std::min<std::size_t>(buffer_size, 8);
+    config.queue_overflow_policy = overflow;
+    return config;
+}
+
+bool enqueue_text(log_collector& collector, const std::string& text) {
+    return collector.enqueue(log_level::info, text, "", 0, "", std::chrono::system_clock::now());
+}
+
+} // namespace
+
+TEST(OverflowPolicyTest, DropNewestRejectsAndCounts) {
+    log_collector collector(make_config(policy::drop_newest, 8));  // Not started
+
+    int accepted = 0;
+    for (int i = 0; i < 12; ++i) {
+        accepted += enqueue_text(collector, std::to_string(i)) ? 1 : 0;
+    }
+
+    const auto stats = collector.get_overflow_stats();
+    EXPECT_EQ(accepted, 8);
+    EXPECT_EQ(stats.policy, policy::drop_newest);
+    EXPECT_EQ(stats.dropped_newest, 4u);
+    EXPECT_EQ(stats.evicted_oldest, 0u);
+    EXPECT_EQ(stats.capacity, 8u);
+}
+
+TEST(OverflowPolicyTest, DropOldestKeepsNewestEntries) {
+    for (const bool lock_free : {false, true}) {
+        auto config = make_config(policy::drop_oldest, 4);
+        config.use_lock_free = lock_free;
+        log_collector collector(config);
+
+        for (int i = 0; i < 10; ++i) {
+            EXPECT_TRUE(enqueue_text(collector, std::to_string(i)));
+        }
+
+        auto writer = std::make_shared<slow_writer>();
+        collector.add_writer(writer);
+        collector.start();
+        collector.flush();
+        collector.stop();
+
+        EXPECT_EQ(writer->messages(), (std::vector<std::string>{"6", "7", "8", "9"}))
+            << "lock_free=" << lock_free;
+        const auto stats = collector.get_overflow_stats();
+        EXPECT_EQ(stats.evicted_oldest, 6u);
+        EXPECT_EQ(stats.dropped_newest, 0u);
+    }
+}
+
+TEST(OverflowPolicyTest, GrowDoublesCapacity) {
+    log_collector collector(make_config(policy::grow, 4));
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(enqueue_text(collector, std::to_string(i)));
+    }
+
+    const auto stats = collector.get_overflow_stats();
+    EXPECT_EQ(stats.growth_events, 2u);  // 4 -> 8 -> 16
+    EXPECT_EQ(stats.capacity, 16u);
+    EXPECT_EQ(collector.get_queue_metrics().first, 10u);
+}
+
+TEST(OverflowPolicyTest, GrowFallsBackOnFixedRings) {
+    auto config = make_config(policy::grow, 8);
+    config.use_lock_free = true;
+    log_collector collector(config);
+
+    EXPECT_EQ(collector.get_overflow_stats().policy, policy::drop_newest);
+}
+
+TEST(OverflowPolicyTest, BlockGivesUpAfterTimeout) {
+    auto config = make_config(policy::block, 2);
+    config.overflow_block_timeout = std::chrono::milliseconds(20);
+    log_collector collector(config);  // Not started: nothing frees space
+
+    EXPECT_TRUE(enqueue_text(collector, "a"));
+    EXPECT_TRUE(enqueue_text(collector, "b"));
+
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(enqueue_text(collector, "c"));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+
+    const auto stats = collector.get_overflow_stats();
+    EXPECT_EQ(stats.blocked_enqueues, 1u);
+    EXPECT_EQ(stats.block_timeouts, 1u);
+    EXPECT_EQ(stats.dropped_newest, 1u);
+    EXPECT_GE(stats.blocked_time, std::chrono::milliseconds(20));
+}
+
+TEST(OverflowPolicyTest, BlockAppliesBackPressureWithoutLoss) {
+    struct variant {
+        bool lock_free;
+        bool per_thread;
+    };
+    for (const auto v : {variant{false, false}, variant{true, false}, variant{false, true}}) {
+        auto config = make_config(policy::block, 16);
+        config.use_lock_free = v.lock_free;
+        config.use_thread_local_buffers = v.per_thread;
+        config.overflow_block_timeout = std::chrono::milliseconds(10000);
+
+        log_collector collector(config);
+        auto writer = std::make_shared<slow_writer>(std::chrono::microseconds(1000));
+        collector.add_writer(writer);
+        collector.start();
+
+        constexpr int producers = 2;
+        constexpr int per_producer = 600;
+        std::atomic<int> rejected{0};
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p) {
+            threads.emplace_back([&collector, &rejected] {
+                for (int i = 0; i < per_producer; ++i) {
+                    if (!enqueue_text(collector, "m")) {
+                        rejected.fetch_add(1);
+                    }
+                }
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        collector.flush();
+        collector.stop();
+
+        const auto stats = collector.get_overflow_stats();
+        EXPECT_EQ(rejected.load(), 0) << "lock_free=" << v.lock_free << " per_thread=" << v.per_thread;
+        EXPECT_EQ(writer->messages().size(), static_cast<std::size_t>(producers * per_producer));
+        EXPECT_GT(stats.blocked_enqueues, 0u);
+        EXPECT_EQ(stats.block_timeouts, 0u);
+        EXPECT_GT(stats.blocked_time.count(), 0);
+    }
+}
+
+TEST(OverflowPolicyTest, LoggerExposesStatsInAsyncModeOnly) {
+    logger sync_logger(false);
+    EXPECT_FALSE(sync_logger.get_queue_overflow_stats().has_value());
+
+    logger async_logger(true, 64);
+    auto stats = async_logger.get_queue_overflow_stats();
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats.value().dropped_newest, 0u);
+}
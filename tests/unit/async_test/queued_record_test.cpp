@@ -0,0 +1,145 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file queued_record_test.cpp
+ * @brief Unit tests for the compact queued log record
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "../../../src/impl/async/lockfree_queue.h"
+#include "../../../src/impl/async/queued_record.h"
+
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace kcenon::logger;
+using kcenon::common::interfaces::log_level;
+
+namespace {
+
+std::string current_thread_text() {
+    std::ostringstream oss;
+    oss << std::this_thread::get_id();
+    return oss.str();
+}
+
+} // namespace
+
+TEST(QueuedRecordTest, HeaderFitsOneCacheLine) {
+    EXPECT_LE(sizeof(async::record_header), 64u);
+    EXPECT_EQ(sizeof(async::queued_record), async::queued_record::record_size);
+    EXPECT_LT(sizeof(async::queued_record), sizeof(log_entry));
+}
+
+TEST(QueuedRecordTest, PlainMessageRoundTrip) {
+    const auto now = std::chrono::system_clock::now();
+    async::queued_record record(log_level::warning, now, "disk almost full", "io.cpp", 42, "flush");
+
+    // File and function are interned; only the message is stored
+    EXPECT_EQ(record.header().payload_length, 16u);
+
+    const log_entry entry = record.to_log_entry();
+    EXPECT_EQ(entry.level, log_level::warning);
+    EXPECT_EQ(entry.timestamp, now);
+    EXPECT_EQ(entry.message.to_string(), "disk almost full");
+    ASSERT_TRUE(entry.location.has_value());
+    EXPECT_EQ(entry.location->file.to_string(), "io.cpp");
+    EXPECT_EQ(entry.location->line, 42);
+    EXPECT_EQ(entry.location->function.to_string(), "flush");
+    ASSERT_TRUE(entry.thread_id.has_value());
+    EXPECT_EQ(entry.thread_id->to_string(), current_thread_text());
+}
+
+TEST(QueuedRecordTest, NoLocationWhenEmpty) {
+    async::queued_record record(log_level::info, std::chrono::system_clock::now(), "hello", "", 0, "");
+    const log_entry entry = record.to_log_entry();
+    EXPECT_EQ(entry.message.to_string(), "hello");
+    EXPECT_FALSE(entry.location.has_value());
+}
+
+TEST(QueuedRecordTest, DeferredMessageRendersAtConversion) {
+    static constexpr log_site site{"net.cpp", 7, "connect", log_level::error, "peer {} refused ({})"};
+    async::queued_record record(log_level::error, std::chrono::system_clock::now(), &site,
+                                make_deferred_message("peer {} refused ({})", std::string("db1"), 111));
+
+    EXPECT_EQ(record.header().site, &site);
+    const log_entry entry = record.to_log_entry();
+    EXPECT_EQ(entry.message.to_string(), "peer db1 refused (111)");
+    ASSERT_TRUE(entry.location.has_value());
+    EXPECT_EQ(entry.location->file.to_string(), "net.cpp");
+    EXPECT_EQ(entry.location->line, 7);
+
+    // The first conversion stores the call site's ids for later records
+    EXPECT_EQ(site.file_id.load(), entry.location->file.id());
+    EXPECT_EQ(site.function_id.load(), entry.location->function.id());
+}
+
+TEST(QueuedRecordTest, LargePayloadSpillsAndMoves) {
+    const std::string big(async::queued_record::inline_capacity * 3, 'z');
+    async::queued_record record(log_level::info, std::chrono::system_clock::now(), big, "", 0, "");
+
+    async::queued_record moved(std::move(record));
+    EXPECT_EQ(moved.to_log_entry().message.to_string(), big);
+
+    async::queued_record small(log_level::info, std::chrono::system_clock::now(), "small", "", 0, "");
+    small = std::move(moved);
+    EXPECT_EQ(small.to_log_entry().message.to_string(), big);
+
+    std::vector<async::queued_record> records;
+    for (int i = 0; i < 64; ++i) {
+        records.emplace_back(log_level::debug, std::chrono::system_clock::now(),
+                             i % 2 ? big : std::to_string(i), "", 0, "");
+    }
+    for (int i = 0; i < 64; ++i) {
+        EXPECT_EQ(records[i].to_log_entry().message.to_string(), i % 2 ? big : std::to_string(i));
+    }
+}
+
+TEST(QueuedRecordTest, SpillBlocksAreRecycled) {
+    auto& pool = async::spill_pool();
+    const std::string spilled(async::queued_record::inline_capacity * 2, 's');
+    const std::string oversized(async::spill_block::capacity * 2, 'o');
+
+    {
+        async::queued_record warm(log_level::info, std::chrono::system_clock::now(), spilled, "", 0, "");
+    }
+    const auto available = pool.get_statistics().available_count;
+    ASSERT_GE(available, 1u);
+
+    {
+        async::queued_record record(log_level::info, std::chrono::system_clock::now(), spilled, "", 0, "");
+        EXPECT_EQ(pool.get_statistics().available_count, available - 1);
+        EXPECT_EQ(record.to_log_entry().message.to_string(), spilled);
+    }
+    EXPECT_EQ(pool.get_statistics().available_count, available);
+
+    // Payloads beyond a spill block bypass the pool
+    {
+        async::queued_record record(log_level::info, std::chrono::system_clock::now(), oversized, "", 0, "");
+        EXPECT_EQ(pool.get_statistics().available_count, available);
+        EXPECT_EQ(record.to_log_entry().message.to_string(), oversized);
+    }
+    EXPECT_EQ(pool.get_statistics().available_count, available);
+}
+
+TEST(QueuedRecordTest, QueueFootprintAt8192) {
+    async::lockfree_mpmc_queue<log_entry> entry_ring(8192);
+    async::lockfree_mpmc_queue<async::queued_record> record_ring(8192);
+
+    std::printf("[ INFO     ] log_entry:     %zu bytes/entry, %zu bytes at 8192\n",
+                sizeof(log_entry), entry_ring.memory_footprint());
+    std::printf("[ INFO     ] queued_record: %zu bytes/entry, %zu bytes at 8192\n",
+                sizeof(async::queued_record), record_ring.memory_footprint());
+
+    EXPECT_EQ(record_ring.memory_footprint(), 8192u * 384u);
+    EXPECT_LT(record_ring.memory_footprint(), entry_ring.memory_footprint());
+}
@@ -0,0 +1,202 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file rcu_snapshot_test.cpp
+ * @brief Unit tests for RCU writer snapshots and epoch-based reclamation
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "../../../src/impl/async/rcu_snapshot.h"
+
+#include <kcenon/logger/core/log_collector.h>
+#include <kcenon/logger/interfaces/log_entry.h>
+#include <kcenon/logger/interfaces/log_writer_interface.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kcenon::logger;
+
+namespace {
+
+std::atomic<int> g_live_tables{0};
+
+/**
+ * @brief Snapshot payload that detects use after reclamation
+ */
+struct tracked_table {
+    static constexpr std::uint32_t alive_tag = 0xA11CE;
+
+    std::vector<int> values;
+    std::uint32_t tag = alive_tag;
+
+    tracked_table() { g_live_tables.fetch_add(1); }
+    tracked_table(const tracked_table& other) : values(other.values) { g_live_tables.fetch_add(1); }
+    ~tracked_table() {
+        tag = 0;
+        g_live_tables.fetch_sub(1);
+    }
+};
+
+class counting_writer : public log_writer_interface {
+public:
+    kcenon::common::VoidResult write(const log_entry&) override {
+        count.fetch_add(1);
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult flush() override {
+        return kcenon::common::ok();
+    }
+
+    std::string get_name() const override {
+        return "counting";
+    }
+
+    bool is_healthy() const override {
+        return true;
+    }
+
+    std::atomic<int> count{0};
+};
+
+} // namespace
+
+TEST(RcuSnapshotTest, UpdatePublishesNewVersion) {
+    async::rcu_snapshot<std::vector<int>> snapshot;
+    EXPECT_EQ(snapshot.version(), 0u);
+
+    EXPECT_TRUE(snapshot.update([](std::vector<int>& v) {
+        v.push_back(7);
+        return true;
+    }));
+    EXPECT_EQ(snapshot.version(), 1u);
+
+    async::epoch_guard guard;
+    ASSERT_EQ(snapshot.load()->size(), 1u);
+    EXPECT_EQ(snapshot.load()->front(), 7);
+}
+
+TEST(RcuSnapshotTest, RejectedUpdateDoesNotPublish) {
+    async::rcu_snapshot<std::vector<int>> snapshot;
+    EXPECT_FALSE(snapshot.update([](std::vector<int>&) { return false; }));
+    EXPECT_EQ(snapshot.version(), 0u);
+}
+
+TEST(RcuSnapshotTest, ReaderKeepsRetiredSnapshotAlive) {
+    const int baseline = g_live_tables.load();
+    {
+        async::rcu_snapshot<tracked_table> snapshot;
+
+        std::atomic<bool> loaded{false};
+        std::atomic<bool> release{false};
+        std::atomic<bool> intact{false};
+
+        std::thread reader([&] {
+            async::epoch_guard guard;
+            const tracked_table* table = snapshot.load();
+            loaded.store(true);
+            while (!release.load()) {
+                std::this_thread::yield();
+            }
+            intact.store(table->tag == tracked_table::alive_tag);
+        });
+
+        while (!loaded.load()) {
+            std::this_thread::yield();
+        }
+
+        // Replace the table the reader is holding several times
+        for (int i = 0; i < 4; ++i) {
+            snapshot.update([i](tracked_table& t) {
+                t.values.push_back(i);
+                return true;
+            });
+        }
+        // Retired tables stay alive while the reader is inside its guard
+        EXPECT_GE(g_live_tables.load() - baseline, 2);
+
+        release.store(true);
+        reader.join();
+        EXPECT_TRUE(intact.load());
+
+        // Next publish reclaims everything retired before the reader left
+        snapshot.update([](tracked_table&) { return true; });
+        EXPECT_EQ(g_live_tables.load() - baseline, 1);
+    }
+    EXPECT_EQ(g_live_tables.load(), baseline);
+}
+
+TEST(RcuSnapshotTest, ConcurrentReadersAndUpdater) {
+    async::rcu_snapshot<tracked_table> snapshot;
+    std::atomic<bool> stop{false};
+    std::atomic<int> corrupt{0};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; ++r) {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed)) {
+                async::epoch_guard guard;
+                const tracked_table* table = snapshot.load();
+                if (table->tag != tracked_table::alive_tag) {
+                    corrupt.fetch_add(1);
+                }
+                for (std::size_t i = 0; i < table->values.size(); ++i) {
+                    if (table->values[i] != static_cast<int>(i)) {
+                        corrupt.fetch_add(1);
+                    }
+                }
+            }
+        });
+    }
+
+    for (int i = 0; i < 2000; ++i) {
+        snapshot.update([](tracked_table& t) {
+            if (t.values.size() > 16) {
+                t.values.clear();
+            }
+            t.values.push_back(static_cast<int>(t.values.size()));
+            return true;
+        });
+    }
+
+    stop.store(true);
+    for (auto& t : readers) {
+        t.join();
+    }
+
+    EXPECT_EQ(corrupt.load(), 0);
+}
+
+TEST(RcuSnapshotTest, CollectorRemoveWriterStopsDelivery) {
+    log_collector collector(64, 8);
+    auto kept = std::make_shared<counting_writer>();
+    auto removed = std::make_shared<counting_writer>();
+    collector.add_writer(kept);
+    collector.add_writer(removed);
+    collector.start();
+
+    const auto now = std::chrono::system_clock::now();
+    collector.enqueue(kcenon::common::interfaces::log_level::info, "first", "", 0, "", now);
+    while (removed->count.load() == 0) {
+        std::this_thread::yield();
+    }
+
+    EXPECT_TRUE(collector.remove_writer(removed));
+    EXPECT_FALSE(collector.remove_writer(removed));
+
+    collector.enqueue(kcenon::common::interfaces::log_level::info, "second", "", 0, "", now);
+    collector.flush();
+    collector.stop();
+
+    EXPECT_EQ(kept->count.load(), 2);
+    EXPECT_EQ(removed->count.load(), 1);
+}
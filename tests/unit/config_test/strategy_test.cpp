@@ -15,6 +15,7 @@
 #include <kcenon/common/interfaces/logger_interface.h>
 #include <chrono>
 #include <cstdlib>
+#include <filesystem>
 
 using namespace kcenon::logger;
 namespace ci = kcenon::common::interfaces;
@@ -299,6 +300,34 @@ TEST_F(ConfigStrategyTest, WriterFactory_CreateRotatingFile) {
     EXPECT_EQ(writer->get_name(), "rotating_file");
 }
 
+TEST_F(ConfigStrategyTest, WriterFactory_RotatingFileFromConfigCompresses) {
+    if (!is_compression_available(compression_codec::gzip)) {
+        GTEST_SKIP() << "gzip support not built in";
+    }
+    const auto dir = std::filesystem::temp_directory_path() / "logger_factory_compression_test";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    auto config = logger_config::production();
+    config.log_directory = dir.string();
+    config.log_file_prefix = "svc";
+    {
+        auto writer = writer_factory::create_rotating_file(config);
+        auto* rotating = dynamic_cast<rotating_file_writer*>(writer.get());
+        ASSERT_NE(rotating, nullptr);
+        ASSERT_TRUE(rotating->write(log_entry(log_level::info, "before rotation")).is_ok());
+        rotating->rotate();
+        rotating->wait_for_compression();
+    }
+
+    bool compressed = false;
+    for (const auto& file : std::filesystem::directory_iterator(dir)) {
+        compressed = compressed || file.path().extension() == ".gz";
+    }
+    std::filesystem::remove_all(dir);
+    EXPECT_TRUE(compressed);
+}
+
 TEST_F(ConfigStrategyTest, WriterFactory_CreateDevelopment) {
     auto writer = writer_factory::create_development();
     ASSERT_NE(writer, nullptr);
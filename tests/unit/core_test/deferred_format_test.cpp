@@ -0,0 +1,168 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file deferred_format_test.cpp
+ * @brief Unit tests for deferred formatting and logger::logf
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <kcenon/logger/core/deferred_format.h>
+#include <kcenon/logger/core/log_collector.h>
+#include <kcenon/logger/core/logger.h>
+#include <kcenon/logger/interfaces/log_entry.h>
+#include <kcenon/logger/interfaces/log_writer_interface.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kcenon::logger;
+using kcenon::common::interfaces::log_level;
+
+namespace {
+
+struct captured_entry {
+    std::string message;
+    std::string file;
+    int line = 0;
+    std::thread::id writer_thread;
+};
+
+/**
+ * @brief Writer that records messages and the thread that wrote them
+ */
+class capture_writer : public log_writer_interface {
+public:
+    explicit capture_writer(std::shared_ptr<std::vector<captured_entry>> sink,
+                            std::shared_ptr<std::mutex> mutex)
+        : sink_(std::move(sink)), mutex_(std::move(mutex)) {}
+
+    kcenon::common::VoidResult write(const log_entry& entry) override {
+        captured_entry captured;
+        captured.message = entry.message.to_string();
+        if (entry.location) {
+            captured.file = entry.location->file.to_string();
+            captured.line = entry.location->line;
+        }
+        captured.writer_thread = std::this_thread::get_id();
+        std::lock_guard<std::mutex> lock(*mutex_);
+        sink_->push_back(std::move(captured));
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult flush() override {
+        return kcenon::common::ok();
+    }
+
+    std::string get_name() const override {
+        return "capture";
+    }
+
+    bool is_healthy() const override {
+        return true;
+    }
+
+private:
+    std::shared_ptr<std::vector<captured_entry>> sink_;
+    std::shared_ptr<std::mutex> mutex_;
+};
+
+} // namespace
+
+TEST(DeferredFormatTest, RendersIntegersAndFloatingPoint) {
+    auto msg = make_deferred_message("{} + {} = {}", 2, std::int64_t{40}, 42.5);
+    EXPECT_EQ(msg.render(), "2 + 40 = 42.5");
+    EXPECT_EQ(msg.format(), "{} + {} = {}");
+    EXPECT_EQ(msg.payload_size(), sizeof(int) + sizeof(std::int64_t) + sizeof(double));
+}
+
+TEST(DeferredFormatTest, CopiesStringArgumentsWithLengthPrefix) {
+    std::string owned = "alice";
+    const char* literal = "10.0.0.1";
+    auto msg = make_deferred_message("user {} from {} ({})", owned, literal, std::string_view("web"));
+
+    // The captured copy must not depend on the caller's storage
+    owned.assign("mallory");
+    EXPECT_EQ(msg.render(), "user alice from 10.0.0.1 (web)");
+    EXPECT_EQ(msg.payload_size(), 3 * sizeof(std::uint32_t) + 5 + 8 + 3);
+}
+
+TEST(DeferredFormatTest, EscapedBracesAndNoArguments) {
+    EXPECT_EQ(make_deferred_message("plain text").render(), "plain text");
+    EXPECT_EQ(make_deferred_message("{{literal}} {}", 7).render(), "{literal} 7");
+}
+
+TEST(DeferredFormatTest, LargeArgumentsSpillToHeap) {
+    const std::string big(format_arg_buffer::inline_capacity * 2, 'x');
+    auto msg = make_deferred_message("[{}] {}", big, 1);
+    EXPECT_EQ(msg.render(), "[" + big + "] 1");
+}
+
+TEST(DeferredFormatTest, CollectorRendersOnWorkerThread) {
+    auto sink = std::make_shared<std::vector<captured_entry>>();
+    auto mutex = std::make_shared<std::mutex>();
+
+    log_collector collector(64, 8);
+    collector.add_writer(std::make_shared<capture_writer>(sink, mutex));
+    collector.start();
+
+    static constexpr log_site site{"main.cpp", 12, "run", log_level::info, "value={}"};
+    EXPECT_TRUE(collector.enqueue(log_level::info, make_deferred_message("value={}", 99),
+                                  &site, std::chrono::system_clock::now()));
+    collector.flush();
+    collector.stop();
+
+    std::lock_guard<std::mutex> lock(*mutex);
+    ASSERT_EQ(sink->size(), 1u);
+    EXPECT_EQ(sink->front().message, "value=99");
+    EXPECT_EQ(sink->front().file, "main.cpp");
+    EXPECT_EQ(sink->front().line, 12);
+    EXPECT_NE(sink->front().writer_thread, std::this_thread::get_id());
+}
+
+TEST(DeferredFormatTest, AsyncLoggerLogf) {
+    auto sink = std::make_shared<std::vector<captured_entry>>();
+    auto mutex = std::make_shared<std::mutex>();
+
+    logger log(true, 256);
+    log.add_writer(std::make_unique<capture_writer>(sink, mutex));
+    log.start();
+
+    for (int i = 0; i < 10; ++i) {
+        log.logf(log_level::info, "message {} of {}", i, std::string("ten"));
+    }
+    // Below threshold: nothing is captured or queued
+    log.set_level(log_level::warning);
+    log.logf(log_level::info, "suppressed {}", 1);
+
+    log.flush();
+    log.stop();
+
+    std::lock_guard<std::mutex> lock(*mutex);
+    ASSERT_EQ(sink->size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_EQ((*sink)[i].message, "message " + std::to_string(i) + " of ten");
+    }
+}
+
+TEST(DeferredFormatTest, SyncLoggerFormatsEagerly) {
+    auto sink = std::make_shared<std::vector<captured_entry>>();
+    auto mutex = std::make_shared<std::mutex>();
+
+    logger log(false);
+    log.add_writer(std::make_unique<capture_writer>(sink, mutex));
+    log.logf(log_level::error, "code={} reason={}", 503, "unavailable");
+
+    std::lock_guard<std::mutex> lock(*mutex);
+    ASSERT_EQ(sink->size(), 1u);
+    EXPECT_EQ(sink->front().message, "code=503 reason=unavailable");
+    EXPECT_EQ(sink->front().writer_thread, std::this_thread::get_id());
+}
@@ -0,0 +1,135 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file intern_table_test.cpp
+ * @brief Unit tests for the process-wide intern table and interned_string
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <kcenon/logger/core/intern_table.h>
+#include <kcenon/logger/formatters/json_formatter.h>
+#include <kcenon/logger/interfaces/log_entry.h>
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kcenon::logger;
+using kcenon::common::interfaces::log_level;
+
+TEST(InternTableTest, EmptyStringIsReservedId) {
+    auto& table = intern_table::instance();
+    EXPECT_EQ(table.intern(""), intern_table::empty_id);
+    EXPECT_EQ(table.resolve(intern_table::empty_id), "");
+    EXPECT_TRUE(interned_string().empty());
+    EXPECT_TRUE(interned_string(static_cast<const char*>(nullptr)).empty());
+}
+
+TEST(InternTableTest, SameTextSameId) {
+    auto& table = intern_table::instance();
+    const std::string path = "/src/intern_table_test/same_text.cpp";
+    const auto id = table.intern(path);
+
+    EXPECT_NE(id, intern_table::empty_id);
+    EXPECT_EQ(table.intern(std::string(path)), id);
+    EXPECT_EQ(table.resolve(id), path);
+    EXPECT_NE(table.intern("/src/intern_table_test/other.cpp"), id);
+
+    // Resolved views are null-terminated
+    EXPECT_EQ(table.resolve(id).data()[path.size()], '\0');
+}
+
+TEST(InternTableTest, GrowsPastInitialIndex) {
+    auto& table = intern_table::instance();
+    std::vector<intern_table::id_type> ids;
+    for (int i = 0; i < 20000; ++i) {
+        ids.push_back(table.intern("grow_" + std::to_string(i)));
+    }
+    for (int i = 0; i < 20000; ++i) {
+        EXPECT_EQ(table.resolve(ids[static_cast<std::size_t>(i)]), "grow_" + std::to_string(i));
+        EXPECT_EQ(table.intern("grow_" + std::to_string(i)), ids[static_cast<std::size_t>(i)]);
+    }
+    EXPECT_GE(table.size(), 20000u);
+    EXPECT_EQ(table.overflow_count(), 0u);
+}
+
+TEST(InternTableTest, NewCategoriesAreRefusedPastTheCap) {
+    auto& table = intern_table::instance();
+    const auto known = table.intern("category_cap_known");
+    const auto refused_before = table.category_overflow_count();
+
+    std::size_t added = 0;
+    while (added <= intern_table::max_categories &&
+           table.intern_category("category_cap_" + std::to_string(added)) != intern_table::empty_id) {
+        ++added;
+    }
+    ASSERT_LE(added, intern_table::max_categories);
+    EXPECT_EQ(table.category_overflow_count(), refused_before + 1);
+
+    // Known strings still resolve; plain intern() is not bounded by the cap
+    EXPECT_EQ(table.intern_category("category_cap_known"), known);
+    EXPECT_EQ(table.intern_category("category_cap_0"), table.intern("category_cap_0"));
+    EXPECT_TRUE(interned_string::category("category_cap_refused").empty());
+    EXPECT_NE(table.intern("category_cap_refused"), intern_table::empty_id);
+    EXPECT_EQ(table.category_overflow_count(), refused_before + 2);
+}
+
+TEST(InternTableTest, LongStringsAreStored) {
+    const std::string long_text(100000, 'q');
+    interned_string text(long_text);
+    EXPECT_EQ(text.view(), long_text);
+    EXPECT_EQ(interned_string(long_text), text);
+}
+
+TEST(InternTableTest, ConcurrentInternAgreesOnIds) {
+    constexpr int threads = 8;
+    constexpr int strings = 2000;
+    std::vector<std::vector<intern_table::id_type>> results(threads);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([t, &results] {
+            auto& table = intern_table::instance();
+            for (int i = 0; i < strings; ++i) {
+                // Threads walk the strings in different orders
+                const int n = (i * (t + 1)) % strings;
+                results[static_cast<std::size_t>(t)].push_back(
+                    table.intern("concurrent_" + std::to_string(n)));
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    auto& table = intern_table::instance();
+    for (int t = 0; t < threads; ++t) {
+        for (int i = 0; i < strings; ++i) {
+            const int n = (i * (t + 1)) % strings;
+            const auto id = results[static_cast<std::size_t>(t)][static_cast<std::size_t>(i)];
+            EXPECT_EQ(table.resolve(id), "concurrent_" + std::to_string(n));
+        }
+    }
+}
+
+TEST(InternTableTest, LogEntryCarriesIds) {
+    log_entry entry(log_level::info, "hello", "/src/intern_table_test/entry.cpp", 7, "run",
+                    std::chrono::system_clock::now());
+    entry.category = "network";
+
+    ASSERT_TRUE(entry.location.has_value());
+    EXPECT_EQ(sizeof(entry.location->file), sizeof(intern_table::id_type));
+    EXPECT_EQ(entry.location->file, "/src/intern_table_test/entry.cpp");
+    EXPECT_EQ(entry.location->function.to_string(), "run");
+    EXPECT_EQ(*entry.category, interned_string("network"));
+
+    const auto formatted = json_formatter().format(entry);
+    EXPECT_NE(formatted.find("entry.cpp"), std::string::npos);
+    EXPECT_NE(formatted.find("network"), std::string::npos);
+}
@@ -0,0 +1,141 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file log_macros_test.cpp
+ * @brief Unit tests for the LOGGER_* call-site macros
+ * @since 4.1.0
+ */
+
+// Compile out trace and debug for this translation unit
+#define LOGGER_ACTIVE_LEVEL LOGGER_LEVEL_INFO
+
+#include <gtest/gtest.h>
+
+#include <kcenon/logger/core/log_macros.h>
+#include <kcenon/logger/interfaces/log_entry.h>
+#include <kcenon/logger/interfaces/log_writer_interface.h>
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using namespace kcenon::logger;
+using kcenon::common::interfaces::log_level;
+
+namespace {
+
+struct captured_entry {
+    std::string message;
+    std::string file;
+    int line = 0;
+    std::string function;
+};
+
+class capture_writer : public log_writer_interface {
+public:
+    explicit capture_writer(std::shared_ptr<std::vector<captured_entry>> sink)
+        : sink_(std::move(sink)) {}
+
+    kcenon::common::VoidResult write(const log_entry& entry) override {
+        captured_entry captured;
+        captured.message = entry.message.to_string();
+        if (entry.location) {
+            captured.file = entry.location->file.to_string();
+            captured.line = entry.location->line;
+            captured.function = entry.location->function.to_string();
+        }
+        std::lock_guard<std::mutex> lock(mutex_);
+        sink_->push_back(std::move(captured));
+        return kcenon::common::ok();
+    }
+
+    kcenon::common::VoidResult flush() override {
+        return kcenon::common::ok();
+    }
+
+    std::string get_name() const override {
+        return "capture";
+    }
+
+    bool is_healthy() const override {
+        return true;
+    }
+
+private:
+    std::shared_ptr<std::vector<captured_entry>> sink_;
+    std::mutex mutex_;
+};
+
+int g_evaluations = 0;
+
+int counted(int value) {
+    ++g_evaluations;
+    return value;
+}
+
+} // namespace
+
+TEST(LogMacrosTest, CompiledOutLevelsSkipArgumentEvaluation) {
+    auto sink = std::make_shared<std::vector<captured_entry>>();
+    logger log(false);
+    log.add_writer(std::make_unique<capture_writer>(sink));
+    log.set_level(log_level::trace);
+
+    g_evaluations = 0;
+    LOGGER_TRACE(log, "trace {}", counted(1));
+    LOGGER_DEBUG(log, "debug {}", counted(2));
+    EXPECT_EQ(g_evaluations, 0);
+    EXPECT_TRUE(sink->empty());
+}
+
+TEST(LogMacrosTest, RuntimeDisabledLevelSkipsArgumentEvaluation) {
+    auto sink = std::make_shared<std::vector<captured_entry>>();
+    logger log(false);
+    log.add_writer(std::make_unique<capture_writer>(sink));
+    log.set_level(log_level::error);
+
+    g_evaluations = 0;
+    LOGGER_INFO(log, "info {}", counted(3));
+    LOGGER_WARNING(log, "warning {}", counted(4));
+    EXPECT_EQ(g_evaluations, 0);
+
+    LOGGER_ERROR(log, "error {}", counted(5));
+    EXPECT_EQ(g_evaluations, 1);
+    ASSERT_EQ(sink->size(), 1u);
+    EXPECT_EQ(sink->front().message, "error 5");
+}
+
+TEST(LogMacrosTest, SiteMetadataReachesWriterSync) {
+    auto sink = std::make_shared<std::vector<captured_entry>>();
+    logger log(false);
+    log.add_writer(std::make_unique<capture_writer>(sink));
+
+    const int expected_line = __LINE__ + 1;
+    LOGGER_CRITICAL(log, "disk {} full", "/var");
+
+    ASSERT_EQ(sink->size(), 1u);
+    EXPECT_EQ(sink->front().message, "disk /var full");
+    EXPECT_NE(sink->front().file.find("log_macros_test.cpp"), std::string::npos);
+    EXPECT_EQ(sink->front().line, expected_line);
+    EXPECT_NE(sink->front().function.find("TestBody"), std::string::npos);
+}
+
+TEST(LogMacrosTest, SiteMetadataReachesWriterAsync) {
+    auto sink = std::make_shared<std::vector<captured_entry>>();
+    logger log(true, 64);
+    log.add_writer(std::make_unique<capture_writer>(sink));
+    log.start();
+
+    const int expected_line = __LINE__ + 1;
+    LOGGER_INFO(log, "no arguments");
+    log.flush();
+    log.stop();
+
+    ASSERT_EQ(sink->size(), 1u);
+    EXPECT_EQ(sink->front().message, "no arguments");
+    EXPECT_EQ(sink->front().line, expected_line);
+    EXPECT_NE(sink->front().file.find("log_macros_test.cpp"), std::string::npos);
+}
@@ -0,0 +1,252 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file memory_budget_test.cpp
+ * @brief Unit tests for the process-wide memory budget
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <kcenon/logger/core/memory_budget.h>
+#include <kcenon/logger/writers/async_writer.h>
+#include <kcenon/logger/writers/batch_writer.h>
+#include <kcenon/logger/writers/buffered_writer.h>
+#include <kcenon/logger/writers/base_writer.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kcenon::logger;
+
+namespace {
+
+/**
+ * @brief Writer that accepts every entry without output
+ */
+class null_writer : public base_writer {
+public:
+    kcenon::common::VoidResult write(const log_entry&) override {
+        return kcenon::common::ok();
+    }
+    kcenon::common::VoidResult flush() override {
+        return kcenon::common::ok();
+    }
+    std::string get_name() const override {
+        return "null";
+    }
+};
+
+class MemoryBudgetTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        baseline_ = memory_budget::instance().used_bytes();
+    }
+
+    void TearDown() override {
+        memory_budget::instance().configure(memory_budget::config{});
+    }
+
+    static void set_limit(std::size_t limit, budget_policy policy,
+                          std::string spill_path = {}) {
+        memory_budget::config cfg;
+        cfg.limit_bytes = limit;
+        cfg.policy = policy;
+        cfg.block_timeout = std::chrono::milliseconds(50);
+        cfg.spill_path = std::move(spill_path);
+        memory_budget::instance().configure(cfg);
+    }
+
+    std::size_t baseline_ = 0;
+};
+
+} // namespace
+
+TEST_F(MemoryBudgetTest, AccountsWithoutLimit) {
+    budget_consumer consumer("test");
+    EXPECT_EQ(consumer.admit(log_level::trace, 1 << 20), budget_decision::admitted);
+    EXPECT_EQ(consumer.held_bytes(), 1u << 20);
+    EXPECT_EQ(memory_budget::instance().used_bytes(), baseline_ + (1u << 20));
+
+    consumer.release(1 << 20);
+    EXPECT_EQ(consumer.held_bytes(), 0u);
+    EXPECT_EQ(memory_budget::instance().used_bytes(), baseline_);
+
+    const auto stats = consumer.get_stats();
+    EXPECT_EQ(stats.name, "test");
+    EXPECT_EQ(stats.admitted, 1u);
+    EXPECT_EQ(stats.peak_bytes, 1u << 20);
+}
+
+TEST_F(MemoryBudgetTest, AccountsAcrossProducerThreads) {
+    budget_consumer consumer("threads");
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 8; ++t) {
+        producers.emplace_back([&consumer] {
+            for (int i = 0; i < 1000; ++i) {
+                consumer.admit(log_level::info, 100);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    EXPECT_EQ(consumer.held_bytes(), 800000u);
+
+    // Released on another thread than the ones that admitted
+    consumer.release(800000);
+    const auto stats = consumer.get_stats();
+    EXPECT_EQ(stats.held_bytes, 0u);
+    EXPECT_EQ(stats.admitted, 8000u);
+    EXPECT_EQ(stats.peak_bytes, 800000u);
+}
+
+TEST_F(MemoryBudgetTest, DropByLevelKeepsHeadroomForErrors) {
+    set_limit(baseline_ + 1000, budget_policy::drop_by_level);
+    budget_consumer consumer("levels");
+
+    // Fill up to the info share, then lower levels are shed first
+    const std::size_t info_share = (baseline_ + 1000) / 100 * 75 - baseline_;
+    ASSERT_EQ(consumer.admit(log_level::info, info_share), budget_decision::admitted);
+    EXPECT_EQ(consumer.admit(log_level::debug, 1), budget_decision::dropped);
+    EXPECT_EQ(consumer.admit(log_level::info, 1), budget_decision::dropped);
+    EXPECT_EQ(consumer.admit(log_level::error, 100), budget_decision::admitted);
+    EXPECT_EQ(consumer.get_stats().dropped, 2u);
+}
+
+TEST_F(MemoryBudgetTest, BlockWaitsForRelease) {
+    set_limit(baseline_ + 100, budget_policy::block);
+    budget_consumer holder("holder");
+    budget_consumer waiter("waiter");
+    ASSERT_EQ(holder.admit(log_level::info, 100), budget_decision::admitted);
+
+    // Times out while nothing is released
+    EXPECT_EQ(waiter.admit(log_level::info, 50), budget_decision::dropped);
+
+    std::thread releaser([&holder] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        holder.release(100);
+    });
+    EXPECT_EQ(waiter.admit(log_level::info, 50), budget_decision::admitted);
+    releaser.join();
+
+    EXPECT_EQ(waiter.get_stats().blocked, 2u);
+    waiter.release(50);
+}
+
+TEST_F(MemoryBudgetTest, SpillAppendsToFile) {
+    const auto path = (std::filesystem::temp_directory_path() / "logger_budget_spill.log").string();
+    std::filesystem::remove(path);
+    set_limit(baseline_ + 10, budget_policy::spill, path);
+
+    budget_consumer consumer("spill");
+    log_entry entry(log_level::warning, "spilled message");
+    ASSERT_EQ(consumer.admit(entry.level, budget_consumer::entry_bytes(entry)),
+              budget_decision::spill);
+    consumer.spill(entry);
+    EXPECT_EQ(consumer.get_stats().spilled, 1u);
+
+    memory_budget::instance().configure(memory_budget::config{});  // Closes the file
+    std::ifstream in(path);
+    std::string line;
+    ASSERT_TRUE(std::getline(in, line));
+    EXPECT_NE(line.find("spilled message"), std::string::npos);
+    std::filesystem::remove(path);
+}
+
+TEST_F(MemoryBudgetTest, ConsumersAreListedWhileAlive) {
+    auto count_named = [](const std::string& name) {
+        int count = 0;
+        for (const auto& stats : memory_budget::instance().get_consumer_stats()) {
+            count += stats.name == name ? 1 : 0;
+        }
+        return count;
+    };
+    {
+        budget_consumer consumer("listed");
+        EXPECT_EQ(count_named("listed"), 1);
+        consumer.admit(log_level::info, 64);
+        // Held bytes are returned on destruction
+    }
+    EXPECT_EQ(count_named("listed"), 0);
+    EXPECT_EQ(memory_budget::instance().used_bytes(), baseline_);
+}
+
+TEST_F(MemoryBudgetTest, WritersReleaseWhatTheyQueue) {
+    {
+        buffered_writer writer(std::make_unique<null_writer>(), 10);
+        for (int i = 0; i < 5; ++i) {
+            writer.write(log_entry(log_level::info, std::string(1000, 'b')));
+        }
+        EXPECT_GT(writer.get_budget_stats().held_bytes, 5000u);
+        writer.flush();
+        EXPECT_EQ(writer.get_budget_stats().held_bytes, 0u);
+    }
+    {
+        async_writer writer(std::make_unique<null_writer>(), 100);
+        writer.start();
+        for (int i = 0; i < 50; ++i) {
+            writer.write(log_entry(log_level::info, "queued"));
+        }
+        writer.flush();
+        writer.stop();
+        EXPECT_EQ(writer.get_budget_stats().held_bytes, 0u);
+        EXPECT_EQ(writer.get_budget_stats().admitted, 50u);
+    }
+    EXPECT_EQ(memory_budget::instance().used_bytes(), baseline_);
+}
+
+TEST_F(MemoryBudgetTest, BufferedWriterFlushesToMakeRoom) {
+    buffered_writer writer(std::make_unique<null_writer>(), 1000);
+    const log_entry sample(log_level::info, std::string(1000, 'x'));
+    set_limit(baseline_ + budget_consumer::entry_bytes(sample) * 3, budget_policy::drop_by_level);
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(writer.write(log_entry(log_level::info, std::string(1000, 'x'))).is_ok());
+    }
+    EXPECT_GT(writer.get_stats().flush_on_budget, 0u);
+    EXPECT_EQ(writer.get_budget_stats().dropped, 0u);
+}
+
+TEST_F(MemoryBudgetTest, BatchUnderBlockPolicyFreesItsOwnQueue) {
+    batch_writer::config cfg;
+    cfg.max_batch_size = 100;
+    batch_writer writer(std::make_unique<null_writer>(), cfg);
+    std::vector<log_entry> batch;
+    for (int i = 0; i < 10; ++i) {
+        batch.emplace_back(log_level::info, std::string(1000, 'q'));
+    }
+    set_limit(baseline_ + budget_consumer::entry_bytes(batch.front()) * 3, budget_policy::block);
+
+    // Only a flush frees this writer's bytes; reserving under its lock
+    // would wait out block_timeout for every entry past the third
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_TRUE(writer.write_batch(batch).is_ok());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+    EXPECT_EQ(writer.get_stats().dropped_entries, 0u);
+    EXPECT_EQ(writer.get_stats().total_entries, 10u);
+}
+
+TEST_F(MemoryBudgetTest, BytesAdmittedWithoutLimitAreNotCharged) {
+    budget_consumer consumer("uncharged");
+    ASSERT_EQ(consumer.admit(log_level::info, 4096), budget_decision::admitted);
+    EXPECT_EQ(memory_budget::instance().used_bytes(), baseline_ + 4096);
+
+    // Only bytes reserved under a limit count against it
+    set_limit(1 << 20, budget_policy::drop_by_level);
+    const auto charged = memory_budget::instance().used_bytes();
+    ASSERT_EQ(consumer.admit(log_level::info, 100), budget_decision::admitted);
+    EXPECT_EQ(memory_budget::instance().used_bytes(), charged + 100);
+
+    consumer.release(4096 + 100);
+    EXPECT_EQ(memory_budget::instance().used_bytes(), charged);
+    EXPECT_EQ(consumer.held_bytes(), 0u);
+}
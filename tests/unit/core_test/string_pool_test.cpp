@@ -0,0 +1,155 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file string_pool_test.cpp
+ * @brief Unit tests for string_pool and allocator-aware small_string
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include <kcenon/logger/core/small_string.h>
+#include <kcenon/logger/core/string_pool.h>
+
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace kcenon::logger;
+
+namespace {
+
+/**
+ * @brief Memory resource that counts allocations passed to the heap
+ */
+class counting_resource : public std::pmr::memory_resource {
+public:
+    std::size_t allocations = 0;
+    std::size_t deallocations = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        ++allocations;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        ++deallocations;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+};
+
+} // namespace
+
+TEST(StringPoolTest, GoodSizeFollowsSizeClasses) {
+    EXPECT_EQ(string_pool::good_size(1), 64u);
+    EXPECT_EQ(string_pool::good_size(65), 96u);
+    EXPECT_EQ(string_pool::good_size(97), 128u);
+    EXPECT_EQ(string_pool::good_size(1000), 1024u);
+    EXPECT_EQ(string_pool::good_size(1025), 1536u);
+    EXPECT_EQ(string_pool::good_size(65537), 98304u);
+    EXPECT_EQ(string_pool::good_size(string_pool::max_pooled_size), string_pool::max_pooled_size);
+    EXPECT_EQ(string_pool::good_size(string_pool::max_pooled_size + 1),
+              string_pool::max_pooled_size + 1);
+
+    for (std::size_t bytes = 1; bytes < 10000; bytes += 37) {
+        EXPECT_GE(string_pool::good_size(bytes), bytes);
+        EXPECT_LE(string_pool::good_size(bytes), bytes * 2 + 64);
+    }
+}
+
+TEST(StringPoolTest, FreedBlockIsReused) {
+    void* first = string_pool::allocate(3000);
+    string_pool::deallocate(first, 3000);
+
+    // Same class, same thread: served from the thread cache
+    void* second = string_pool::allocate(string_pool::good_size(3000));
+    EXPECT_EQ(second, first);
+    string_pool::deallocate(second, string_pool::good_size(3000));
+}
+
+TEST(StringPoolTest, SmallStringHeapFallbackUsesPool) {
+    const std::string long_message(4000, 'm');
+    { small_string_256 warm(long_message); }
+
+    const auto before = string_pool::get_statistics().fresh_allocations;
+    for (int i = 0; i < 100; ++i) {
+        small_string_256 text(long_message);
+        EXPECT_FALSE(text.is_small());
+        EXPECT_EQ(text.to_string(), long_message);
+        EXPECT_GE(text.capacity(), long_message.size());
+    }
+    EXPECT_EQ(string_pool::get_statistics().fresh_allocations, before);
+}
+
+TEST(StringPoolTest, BlocksFreedOnAnotherThreadReturnToPool) {
+    constexpr int count = 200;
+    std::vector<small_string_256> texts;
+    for (int i = 0; i < count; ++i) {
+        texts.emplace_back(std::string(2000, 'c'));
+    }
+
+    // Freed on a thread that exits, which parks its cache in the depot
+    std::thread consumer([moved = std::move(texts)]() mutable { moved.clear(); });
+    consumer.join();
+
+    EXPECT_GT(string_pool::get_statistics().depot_bytes, 0u);
+    const auto before = string_pool::get_statistics().fresh_allocations;
+    {
+        small_string_256 text(std::string(2000, 'c'));
+        EXPECT_EQ(text.size(), 2000u);
+    }
+    EXPECT_EQ(string_pool::get_statistics().fresh_allocations, before);
+}
+
+TEST(StringPoolTest, AppendGrowsThroughClasses) {
+    small_string_64 text;
+    std::string expected;
+    for (int i = 0; i < 500; ++i) {
+        text.append("0123456789", 10);
+        expected.append("0123456789");
+    }
+    EXPECT_EQ(text.to_string(), expected);
+}
+
+TEST(StringPoolTest, PmrSmallStringUsesResource) {
+    counting_resource resource;
+    {
+        pmr_small_string<64> text(std::string(500, 'p'), &resource);
+        EXPECT_EQ(text.get_allocator().resource(), &resource);
+        EXPECT_EQ(resource.allocations, 1u);
+
+        pmr_small_string<64> inline_text("short", &resource);
+        EXPECT_EQ(resource.allocations, 1u);
+
+        // Moves keep the block and its resource
+        pmr_small_string<64> moved(std::move(text));
+        EXPECT_EQ(moved.size(), 500u);
+        EXPECT_EQ(resource.allocations, 1u);
+    }
+    EXPECT_EQ(resource.deallocations, 1u);
+}
+
+TEST(StringPoolTest, PmrMoveAssignAcrossResourcesCopies) {
+    counting_resource left;
+    counting_resource right;
+    {
+        pmr_small_string<64> target(&left);
+        pmr_small_string<64> source(std::string(300, 'r'), &right);
+
+        target = std::move(source);
+        EXPECT_EQ(target.get_allocator().resource(), &left);
+        EXPECT_EQ(target.to_string(), std::string(300, 'r'));
+        EXPECT_EQ(left.allocations, 1u);
+    }
+    EXPECT_EQ(left.deallocations, 1u);
+    EXPECT_EQ(right.deallocations, 1u);
+}
@@ -0,0 +1,136 @@
+// BSD 3-Clause License
+// Copyright (c) 2025, 🍀☀🌕🌥 🌊
+// See the LICENSE file in the project root for full license information.
+
+/**
+ * @file object_pool_test.cpp
+ * @brief Unit tests for object_pool synchronization strategies
+ * @since 4.1.0
+ */
+
+#include <gtest/gtest.h>
+
+#include "../../../src/impl/memory/object_pool.h"
+
+#include <atomic>
+#include <memory>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace kcenon::logger::memory;
+
+namespace {
+
+struct tracked_object {
+    static inline std::atomic<int> live{0};
+
+    tracked_object() { live.fetch_add(1); }
+    ~tracked_object() { live.fetch_sub(1); }
+
+    int owner = -1;
+};
+
+object_pool<tracked_object>::config make_config(pool_strategy strategy, std::size_t initial,
+                                                std::size_t max) {
+    object_pool<tracked_object>::config cfg;
+    cfg.strategy = strategy;
+    cfg.initial_size = initial;
+    cfg.max_size = max;
+    return cfg;
+}
+
+class ObjectPoolStrategyTest : public ::testing::TestWithParam<pool_strategy> {};
+
+} // namespace
+
+TEST_P(ObjectPoolStrategyTest, ReusesReleasedObjects) {
+    object_pool<tracked_object> pool(make_config(GetParam(), 2, 8));
+    EXPECT_EQ(pool.strategy(), GetParam());
+
+    auto a = pool.acquire();
+    tracked_object* raw = a.get();
+    pool.release(std::move(a));
+
+    auto stats = pool.get_statistics();
+    EXPECT_EQ(stats.total_size, 2u);
+    EXPECT_EQ(stats.available_count, 2u);
+
+    // Both strategies hand back a pooled object rather than a new one
+    std::set<tracked_object*> seen;
+    auto b = pool.acquire();
+    auto c = pool.acquire();
+    seen.insert(b.get());
+    seen.insert(c.get());
+    EXPECT_EQ(seen.count(raw), 1u);
+    EXPECT_EQ(pool.get_statistics().available_count, 0u);
+}
+
+TEST_P(ObjectPoolStrategyTest, GrowsAndCapsAtMaxSize) {
+    object_pool<tracked_object> pool(make_config(GetParam(), 0, 2));
+
+    std::vector<std::unique_ptr<tracked_object>> held;
+    for (int i = 0; i < 4; ++i) {
+        held.push_back(pool.acquire());
+        ASSERT_NE(held.back(), nullptr);
+    }
+    EXPECT_EQ(pool.get_statistics().total_size, 2u);
+
+    for (auto& obj : held) {
+        pool.release(std::move(obj));
+    }
+    EXPECT_EQ(pool.get_statistics().available_count, 2u);
+}
+
+TEST_P(ObjectPoolStrategyTest, ClearAndDestructionFreeObjects) {
+    const int before = tracked_object::live.load();
+    {
+        object_pool<tracked_object> pool(make_config(GetParam(), 16, 32));
+        EXPECT_EQ(tracked_object::live.load() - before, 16);
+
+        pool.clear();
+        EXPECT_EQ(tracked_object::live.load(), before);
+        EXPECT_EQ(pool.get_statistics().available_count, 0u);
+
+        pool.release(std::make_unique<tracked_object>());
+        pool.release(std::make_unique<tracked_object>());
+    }
+    EXPECT_EQ(tracked_object::live.load(), before);
+}
+
+TEST_P(ObjectPoolStrategyTest, ConcurrentAcquireReleaseNeverSharesObjects) {
+    constexpr int threads = 8;
+    constexpr int iterations = 20000;
+    object_pool<tracked_object> pool(make_config(GetParam(), 4, 16));
+    std::atomic<int> conflicts{0};
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&pool, &conflicts, t] {
+            for (int i = 0; i < iterations; ++i) {
+                auto obj = pool.acquire();
+                if (obj->owner != -1) {
+                    conflicts.fetch_add(1);
+                }
+                obj->owner = t;
+                std::this_thread::yield();
+                if (obj->owner != t) {
+                    conflicts.fetch_add(1);
+                }
+                obj->owner = -1;
+                pool.release(std::move(obj));
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+
+    EXPECT_EQ(conflicts.load(), 0);
+    const auto stats = pool.get_statistics();
+    EXPECT_LE(stats.available_count, 16u);
+    EXPECT_EQ(stats.in_use_count, stats.total_size - stats.available_count);
+}
+
+INSTANTIATE_TEST_SUITE_P(Strategies, ObjectPoolStrategyTest,
+                         ::testing::Values(pool_strategy::mutex, pool_strategy::lock_free));
@@ -18,6 +18,7 @@
 #include <chrono>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -41,6 +42,11 @@ public:
         return common::ok();
     }
 
+    common::VoidResult write_batch(std::span<const log_entry> entries) override {
+        batch_call_count_++;
+        return log_writer_interface::write_batch(entries);
+    }
+
     common::VoidResult flush() override {
         flush_count_++;
         return common::ok();
@@ -57,6 +63,7 @@ public:
     }
 
     int flush_count() const { return flush_count_; }
+    int batch_call_count() const { return batch_call_count_; }
 
     std::vector<std::string> get_messages() const {
         std::lock_guard<std::mutex> lock(mutex_);
@@ -68,6 +75,7 @@ private:
     std::vector<std::string> messages_;
     int write_count_ = 0;
     std::atomic<int> flush_count_{0};
+    std::atomic<int> batch_call_count_{0};
     std::atomic<bool> healthy_{true};
 };
 
@@ -350,3 +358,38 @@ TEST_F(BatchWriterTest, PreservesMessageContent) {
     EXPECT_EQ(messages[0], "hello world");
     EXPECT_EQ(messages[1], "error occurred");
 }
+
+// =============================================================================
+// Batch forwarding
+// =============================================================================
+
+TEST_F(BatchWriterTest, FlushForwardsOneBatchCall) {
+    for (int i = 0; i < 5; ++i) {
+        writer_->write(log_entry(log_level::info, "msg" + std::to_string(i)));
+    }
+
+    // One full batch reaches the wrapped writer through a single write_batch call
+    EXPECT_EQ(mock_ptr_->batch_call_count(), 1);
+    EXPECT_EQ(mock_ptr_->write_count(), 5);
+}
+
+TEST_F(BatchWriterTest, WriteBatchSplitsAtMaxBatchSize) {
+    std::vector<log_entry> entries;
+    for (int i = 0; i < 12; ++i) {
+        entries.emplace_back(log_level::info, "batch" + std::to_string(i));
+    }
+
+    auto result = writer_->write_batch(entries);
+    EXPECT_TRUE(result.is_ok());
+
+    // Two full batches of 5 are flushed, 2 entries stay queued
+    EXPECT_EQ(mock_ptr_->batch_call_count(), 2);
+    EXPECT_EQ(writer_->get_current_batch_size(), 2u);
+
+    writer_->flush();
+    auto messages = mock_ptr_->get_messages();
+    ASSERT_EQ(messages.size(), 12u);
+    for (int i = 0; i < 12; ++i) {
+        EXPECT_EQ(messages[i], "batch" + std::to_string(i));
+    }
+}
@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 
 #include <kcenon/logger/writers/critical_writer.h>
+#include <kcenon/logger/writers/file_writer.h>
 #include <kcenon/logger/interfaces/log_entry.h>
 #include <kcenon/logger/core/error_codes.h>
 
@@ -19,6 +20,10 @@
 #include <vector>
 #include <mutex>
 #include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
 
 using namespace kcenon::logger;
 namespace common = kcenon::common;
@@ -77,6 +82,8 @@ TEST(CriticalWriterConfigTest, DefaultValues) {
     EXPECT_EQ(config.wal_path, "logs/.wal");
     EXPECT_TRUE(config.sync_on_critical);
     EXPECT_EQ(config.critical_write_timeout_ms, 5000u);
+    EXPECT_TRUE(config.group_commit);
+    EXPECT_EQ(config.max_sync_delay_us, 0u);
 }
 
 TEST(CriticalWriterConfigTest, CustomConfig) {
@@ -284,6 +291,118 @@ TEST_F(CriticalWriterTest, WriteAllLevels) {
     EXPECT_EQ(entries.size(), 6u);
 }
 
+// =============================================================================
+// Group commit tests
+// =============================================================================
+
+class CriticalWriterGroupCommitTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        temp_dir_ = std::filesystem::temp_directory_path() / "critical_writer_group_commit_test";
+        std::filesystem::create_directories(temp_dir_);
+        log_path_ = (temp_dir_ / "critical.log").string();
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(temp_dir_, ec);
+    }
+
+    std::size_t count_lines() const {
+        std::ifstream file(log_path_);
+        std::size_t lines = 0;
+        for (std::string line; std::getline(file, line);) {
+            ++lines;
+        }
+        return lines;
+    }
+
+    std::filesystem::path temp_dir_;
+    std::string log_path_;
+};
+
+TEST_F(CriticalWriterGroupCommitTest, ConcurrentWritesShareSyncs) {
+    constexpr int threads = 8;
+    constexpr int writes_per_thread = 25;
+
+    critical_writer_config config;
+    config.max_sync_delay_us = 2000;
+    critical_writer writer(std::make_unique<file_writer>(log_path_), config);
+
+    std::atomic<int> failures{0};
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < writes_per_thread; ++i) {
+                log_entry entry(log_level::critical,
+                                "thread " + std::to_string(t) + " write " + std::to_string(i));
+                if (writer.write(entry).is_err()) {
+                    failures.fetch_add(1);
+                }
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    constexpr uint64_t total = threads * writes_per_thread;
+    const auto& stats = writer.get_stats();
+    EXPECT_EQ(failures.load(), 0);
+    EXPECT_EQ(stats.total_critical_writes.load(), total);
+    // Every write is covered by exactly one sync, and they were shared
+    EXPECT_EQ(stats.synced_writes.load(), total);
+    EXPECT_LT(stats.sync_calls.load(), total);
+    EXPECT_GT(stats.max_epoch_writes.load(), 1u);
+    EXPECT_GE(stats.total_sync_wait_us.load(), stats.max_sync_wait_us.load());
+    // Writes had reached the file when write() returned
+    EXPECT_EQ(count_lines(), total);
+}
+
+TEST_F(CriticalWriterGroupCommitTest, LoneWriterDoesNotWaitForBatchDelay) {
+    critical_writer_config config;
+    config.max_sync_delay_us = 2'000'000;
+    critical_writer writer(std::make_unique<file_writer>(log_path_), config);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(writer.write(log_entry(log_level::critical, "alone")).is_ok());
+    }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_LT(elapsed, std::chrono::seconds(1));
+    EXPECT_EQ(writer.get_stats().sync_calls.load(), 3u);
+    EXPECT_EQ(writer.get_stats().max_epoch_writes.load(), 1u);
+}
+
+TEST_F(CriticalWriterGroupCommitTest, SyncFollowsTheOpenFileAcrossRenames) {
+    critical_writer writer(std::make_unique<file_writer>(log_path_), critical_writer_config{});
+    ASSERT_TRUE(writer.write(log_entry(log_level::critical, "before rename")).is_ok());
+
+    // The records keep going to the renamed file, and so must the sync
+    const auto renamed = (temp_dir_ / "critical.log.1").string();
+    std::filesystem::rename(log_path_, renamed);
+    EXPECT_TRUE(writer.write(log_entry(log_level::critical, "after rename")).is_ok());
+    EXPECT_FALSE(std::filesystem::exists(log_path_));
+
+    log_path_ = renamed;
+    EXPECT_EQ(count_lines(), 2u);
+}
+
+TEST_F(CriticalWriterGroupCommitTest, DisabledGroupCommitSyncsEveryWrite) {
+    critical_writer_config config;
+    config.group_commit = false;
+    critical_writer writer(std::make_unique<file_writer>(log_path_), config);
+
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(writer.write(log_entry(log_level::critical, "each")).is_ok());
+    }
+
+    EXPECT_EQ(writer.get_stats().sync_calls.load(), 10u);
+    EXPECT_EQ(writer.get_stats().synced_writes.load(), 10u);
+    EXPECT_EQ(count_lines(), 10u);
+}
+
 // =============================================================================
 // hybrid_writer tests
 // =============================================================================
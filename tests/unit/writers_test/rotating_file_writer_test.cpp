@@ -11,6 +11,7 @@
 #include <gtest/gtest.h>
 
 #include <kcenon/logger/writers/rotating_file_writer.h>
+#include <kcenon/logger/writers/compressed_log_reader.h>
 #include <kcenon/logger/interfaces/log_entry.h>
 
 #include <chrono>
@@ -131,6 +132,42 @@ TEST_F(RotatingFileWriterTest, WriteMultipleEntries) {
     }
 }
 
+TEST_F(RotatingFileWriterTest, WriteBatchPreservesOrder) {
+    std::vector<log_entry> entries;
+    for (int i = 0; i < 10; ++i) {
+        entries.push_back(make_entry("batch " + std::to_string(i)));
+    }
+
+    {
+        rotating_file_writer writer(test_file(), 1024 * 1024, 3);
+        EXPECT_TRUE(writer.write_batch(entries).is_ok());
+        writer.flush();
+    }
+
+    std::ifstream in(test_file());
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    ASSERT_EQ(lines.size(), 10u);
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_NE(lines[i].find("batch " + std::to_string(i)), std::string::npos);
+    }
+}
+
+TEST_F(RotatingFileWriterTest, WriteBatchRotatesMidBatch) {
+    rotating_file_writer writer(test_file(), 50, 5, 1);
+
+    std::vector<log_entry> entries;
+    for (int i = 0; i < 10; ++i) {
+        entries.push_back(make_entry("batched entry number " + std::to_string(i)));
+    }
+    EXPECT_TRUE(writer.write_batch(entries).is_ok());
+    writer.flush();
+
+    EXPECT_GT(count_files_in_dir(), 1u);
+}
+
 // =============================================================================
 // Size-based rotation
 // =============================================================================
@@ -256,3 +293,580 @@ TEST_F(RotatingFileWriterTest, WriteAfterRotationSucceeds) {
     // Verify the main log file exists (content may be buffered)
     EXPECT_TRUE(std::filesystem::exists(test_file()));
 }
+
+// =============================================================================
+// Off-thread rotation
+// =============================================================================
+
+TEST_F(RotatingFileWriterTest, PreparedSegmentsKeepEveryRecordInOrder) {
+    constexpr int total = 300;
+    {
+        // Segments are opened ahead once half full, so most rotations swap
+        rotating_file_writer writer(test_file(), 2000, 100, 1);
+        for (int i = 0; i < total; ++i) {
+            ASSERT_TRUE(writer.write(make_entry("rotated record " + std::to_string(i))).is_ok());
+        }
+        ASSERT_TRUE(writer.flush().is_ok());
+    }
+
+    // Nothing is left at the next segment path once the writer is gone
+    EXPECT_FALSE(std::filesystem::exists(test_file() + ".next"));
+
+    // Oldest backup first, then the live file
+    std::vector<std::string> files;
+    for (int index = 1; std::filesystem::exists(test_file() + "." + std::to_string(index)); ++index) {
+        files.push_back(test_file() + "." + std::to_string(index));
+    }
+    ASSERT_GT(files.size(), 3u);
+    files.push_back(test_file());
+
+    int expected = 0;
+    for (const auto& file : files) {
+        std::ifstream in(file);
+        for (std::string line; std::getline(in, line); ++expected) {
+            ASSERT_NE(line.find("rotated record " + std::to_string(expected) + ""),
+                      std::string::npos) << file << ": " << line;
+        }
+    }
+    EXPECT_EQ(expected, total);
+}
+
+TEST_F(RotatingFileWriterTest, LeftoverNextSegmentBecomesBackup) {
+    {
+        std::ofstream(test_file() + ".next") << "records from a crashed run\n";
+        std::ofstream(test_file("other.log.next"));
+    }
+
+    rotating_file_writer writer(test_file(), 1024 * 1024, 5);
+    rotating_file_writer empty_writer(test_file("other.log"), 1024 * 1024, 5);
+
+    EXPECT_FALSE(std::filesystem::exists(test_file() + ".next"));
+    EXPECT_TRUE(std::filesystem::exists(test_file() + ".1"));
+    EXPECT_FALSE(std::filesystem::exists(test_file("other.log.next")));
+    EXPECT_FALSE(std::filesystem::exists(test_file("other.log.1")));
+}
+
+// =============================================================================
+// Retention
+// =============================================================================
+
+TEST_F(RotatingFileWriterTest, RetentionByTotalBytesKeepsNewestBackups) {
+    retention_options retention;
+    retention.max_total_bytes = 5000;
+    {
+        rotating_file_writer writer(test_file(), 2000, 100, 1, {}, {}, retention);
+        for (int i = 0; i < 400; ++i) {
+            ASSERT_TRUE(writer.write(make_entry("retained record " + std::to_string(i))).is_ok());
+        }
+        ASSERT_TRUE(writer.flush().is_ok());
+    }
+
+    std::uintmax_t total = 0;
+    std::size_t backups = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(temp_dir_)) {
+        if (entry.path().filename() != "test.log") {
+            total += entry.file_size();
+            ++backups;
+        }
+    }
+    EXPECT_LE(total, retention.max_total_bytes);
+    EXPECT_GE(backups, 2u);
+
+    // The surviving backups hold the records just before the live file
+    std::ifstream live(test_file());
+    std::string first_live;
+    std::getline(live, first_live);
+    const auto at = first_live.find("retained record ");
+    ASSERT_NE(at, std::string::npos);
+    const int first_live_record = std::stoi(first_live.substr(at + 16));
+    bool found_previous = false;
+    for (const auto& entry : std::filesystem::directory_iterator(temp_dir_)) {
+        std::ifstream in(entry.path());
+        for (std::string line; std::getline(in, line);) {
+            found_previous |= line.ends_with("retained record " + std::to_string(first_live_record - 1));
+        }
+    }
+    EXPECT_TRUE(found_previous);
+}
+
+TEST_F(RotatingFileWriterTest, RetentionByAgeRemovesExpiredBackupsAtStartup) {
+    const auto now = std::filesystem::file_time_type::clock::now();
+    for (int index = 1; index <= 3; ++index) {
+        const auto backup = test_file() + "." + std::to_string(index);
+        std::ofstream(backup) << "backup " << index << "\n";
+        // .1 and .2 are two days old, .3 an hour old
+        const auto age = index < 3 ? std::chrono::hours(48) : std::chrono::hours(1);
+        std::filesystem::last_write_time(backup, now - age);
+    }
+
+    retention_options retention;
+    retention.max_age = std::chrono::hours(24);
+    rotating_file_writer writer(test_file(), 1024 * 1024, 10, 100, {}, {}, retention);
+
+    EXPECT_FALSE(std::filesystem::exists(test_file() + ".1"));
+    EXPECT_FALSE(std::filesystem::exists(test_file() + ".2"));
+    EXPECT_TRUE(std::filesystem::exists(test_file() + ".3"));
+
+    // Freed indices are reused, lowest first
+    writer.write(make_entry("rotated after startup"));
+    writer.rotate();
+    EXPECT_TRUE(std::filesystem::exists(test_file() + ".1"));
+    EXPECT_TRUE(std::filesystem::exists(test_file() + ".3"));
+}
+
+TEST_F(RotatingFileWriterTest, BackupIndexSkipsIndicesOfCompressedBackups) {
+    std::ofstream(test_file() + ".1.gz") << "compressed";
+    std::ofstream(test_file() + ".2") << "plain";
+
+    rotating_file_writer writer(test_file(), 1024 * 1024, 10);
+    writer.write(make_entry("third generation"));
+    writer.rotate();
+
+    EXPECT_TRUE(std::filesystem::exists(test_file() + ".3"));
+    EXPECT_FALSE(std::filesystem::exists(test_file() + ".1"));
+}
+
+// =============================================================================
+// Compression of rotated segments
+// =============================================================================
+
+namespace {
+
+bool has_gzip_magic(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    unsigned char magic[2] = {};
+    in.read(reinterpret_cast<char*>(magic), 2);
+    return in.gcount() == 2 && magic[0] == 0x1f && magic[1] == 0x8b;
+}
+
+segment_compression_options gzip_compression() {
+    segment_compression_options compression;
+    compression.codec = compression_codec::gzip;
+    compression.cpu_budget = 1.0;
+    return compression;
+}
+
+} // namespace
+
+TEST_F(RotatingFileWriterTest, CompressedSegmentsCountTowardMaxFiles) {
+    if (!is_compression_available(compression_codec::gzip)) {
+        GTEST_SKIP() << "built without zlib";
+    }
+
+    rotating_file_writer writer(test_file(), 2000, 3, 1, {}, gzip_compression());
+    for (int i = 0; i < 300; ++i) {
+        ASSERT_TRUE(writer.write(make_entry("compressed record " + std::to_string(i))).is_ok());
+    }
+    ASSERT_TRUE(writer.flush().is_ok());
+    writer.wait_for_compression();
+
+    std::size_t compressed = 0;
+    std::size_t plain = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(temp_dir_)) {
+        const auto name = entry.path().filename().string();
+        if (name.ends_with(".gz")) {
+            EXPECT_TRUE(has_gzip_magic(entry.path().string())) << name;
+            ++compressed;
+        } else if (name != "test.log" && name != "test.log.next") {
+            ++plain;
+        }
+    }
+    EXPECT_EQ(compressed, 3u);
+    EXPECT_EQ(plain, 0u);
+
+    // The oldest segments were the ones deleted
+    EXPECT_FALSE(std::filesystem::exists(test_file() + ".1.gz"));
+}
+
+TEST_F(RotatingFileWriterTest, BackupsLeftUncompressedAreCompressedAtStartup) {
+    if (!is_compression_available(compression_codec::gzip)) {
+        GTEST_SKIP() << "built without zlib";
+    }
+
+    const auto backup = test_file() + ".1";
+    {
+        std::ofstream out(backup);
+        for (int i = 0; i < 1000; ++i) {
+            out << "earlier run record " << i << "\n";
+        }
+        std::ofstream(backup + ".gz.tmp") << "partial";
+    }
+    const auto modified = std::filesystem::last_write_time(backup) - std::chrono::hours(1);
+    std::filesystem::last_write_time(backup, modified);
+    const auto plain_size = std::filesystem::file_size(backup);
+
+    rotating_file_writer writer(test_file(), 1024 * 1024, 5, 100, {}, gzip_compression());
+    writer.wait_for_compression();
+
+    EXPECT_FALSE(std::filesystem::exists(backup));
+    EXPECT_FALSE(std::filesystem::exists(backup + ".gz.tmp"));
+    ASSERT_TRUE(std::filesystem::exists(backup + ".gz"));
+    EXPECT_TRUE(has_gzip_magic(backup + ".gz"));
+    EXPECT_LT(std::filesystem::file_size(backup + ".gz"), plain_size / 4);
+    EXPECT_EQ(std::filesystem::last_write_time(backup + ".gz"), modified);
+}
+
+// =============================================================================
+// Compressed live output
+// =============================================================================
+
+namespace {
+
+file_output_options compressed_output() {
+    file_output_options output;
+    output.compression = compression_codec::gzip;
+    output.frame_size = 64 * 1024;
+    output.flush_interval = std::chrono::milliseconds(0);
+    return output;
+}
+
+/**
+ * @brief Every frame the reader lists, decompressed and concatenated
+ */
+std::string read_all_frames(compressed_log_reader& reader) {
+    std::string text;
+    for (std::size_t i = 0; i < reader.frames().size(); ++i) {
+        auto frame = reader.read_frame(i);
+        EXPECT_TRUE(frame.has_value()) << frame.error_message();
+        if (frame) {
+            text += frame.value();
+        }
+    }
+    return text;
+}
+
+std::size_t count_records(const std::string& text, const std::string& prefix) {
+    std::size_t count = 0;
+    for (auto at = text.find(prefix); at != std::string::npos; at = text.find(prefix, at + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_F(RotatingFileWriterTest, CompressedOutputIsSeekableByFrame) {
+    if (!is_compression_available(compression_codec::gzip)) {
+        GTEST_SKIP() << "built without zlib";
+    }
+
+    std::uint64_t stored = 0;
+    {
+        file_writer writer(test_file("test.log.gz"), false, nullptr, compressed_output());
+        for (int i = 0; i < 20000; ++i) {
+            ASSERT_TRUE(writer.write(make_entry("framed record " + std::to_string(i))).is_ok());
+        }
+        ASSERT_TRUE(writer.flush().is_ok());
+        stored = writer.get_file_size();
+        EXPECT_EQ(std::filesystem::file_size(test_file("test.log.gz")), stored);
+    }
+    // Closing only appends the index
+    EXPECT_GT(std::filesystem::file_size(test_file("test.log.gz")), stored);
+
+    compressed_log_reader reader;
+    ASSERT_TRUE(reader.open(test_file("test.log.gz")).is_ok());
+    ASSERT_GT(reader.frames().size(), 4u);
+    EXPECT_LT(stored, reader.size() / 4);
+    EXPECT_EQ(reader.skipped_bytes(), 0u);
+
+    const auto text = read_all_frames(reader);
+    ASSERT_EQ(text.size(), reader.size());
+    EXPECT_EQ(count_records(text, "framed record "), 20000u);
+
+    // A range that spans a frame boundary decodes only the frames under it
+    const auto& second = reader.frames()[1];
+    const auto position = second.position - 100;
+    EXPECT_EQ(reader.frame_at(position), 0u);
+    auto range = reader.read(position, 300);
+    ASSERT_TRUE(range.has_value());
+    EXPECT_EQ(range.value(), text.substr(position, 300));
+    EXPECT_EQ(reader.read(reader.size() - 10, 100).value(), text.substr(text.size() - 10));
+}
+
+TEST_F(RotatingFileWriterTest, CompressedOutputLosesOnlyTheTornFrame) {
+    if (!is_compression_available(compression_codec::gzip)) {
+        GTEST_SKIP() << "built without zlib";
+    }
+
+    const auto crashed = test_file("crashed.log.gz");
+    {
+        file_writer writer(test_file("test.log.gz"), false, nullptr, compressed_output());
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(writer.write(make_entry("first frame " + std::to_string(i))).is_ok());
+        }
+        ASSERT_TRUE(writer.flush().is_ok());
+        for (int i = 0; i < 3; ++i) {
+            ASSERT_TRUE(writer.write(make_entry("second frame " + std::to_string(i))).is_ok());
+        }
+        ASSERT_TRUE(writer.flush().is_ok());
+
+        // What a crash leaves: no index, and the last frame only half written
+        std::filesystem::copy_file(test_file("test.log.gz"), crashed);
+        std::filesystem::resize_file(crashed, std::filesystem::file_size(crashed) - 20);
+    }
+
+    {
+        compressed_log_reader reader;
+        ASSERT_TRUE(reader.open(crashed).is_ok());
+        ASSERT_EQ(reader.frames().size(), 1u);
+        EXPECT_GT(reader.skipped_bytes(), 0u);
+        EXPECT_EQ(count_records(read_all_frames(reader), "first frame "), 3u);
+    }
+
+    // A new session appends after the torn frame and indexes its own frames
+    {
+        file_writer writer(crashed, true, nullptr, compressed_output());
+        ASSERT_TRUE(writer.write(make_entry("after restart")).is_ok());
+    }
+    compressed_log_reader reader;
+    ASSERT_TRUE(reader.open(crashed).is_ok());
+    ASSERT_EQ(reader.frames().size(), 2u);
+    const auto text = read_all_frames(reader);
+    EXPECT_EQ(count_records(text, "first frame "), 3u);
+    EXPECT_EQ(count_records(text, "second frame "), 0u);
+    EXPECT_EQ(count_records(text, "after restart"), 1u);
+}
+
+TEST_F(RotatingFileWriterTest, CompressedOutputSkipsFramesWithImpossibleSizes) {
+    if (!is_compression_available(compression_codec::gzip)) {
+        GTEST_SKIP() << "built without zlib";
+    }
+
+    const auto damaged = test_file("damaged.log.gz");
+    {
+        file_writer writer(test_file("test.log.gz"), false, nullptr, compressed_output());
+        ASSERT_TRUE(writer.write(make_entry("first frame")).is_ok());
+        ASSERT_TRUE(writer.flush().is_ok());
+        ASSERT_TRUE(writer.write(make_entry("second frame")).is_ok());
+        ASSERT_TRUE(writer.flush().is_ok());
+        std::filesystem::copy_file(test_file("test.log.gz"), damaged);
+    }
+
+    // No index, and the first header claims a 4 GiB frame
+    {
+        std::fstream file(damaged, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(20);
+        file.write("\xff\xff\xff\xff", 4);
+    }
+
+    compressed_log_reader reader;
+    ASSERT_TRUE(reader.open(damaged).is_ok());
+    ASSERT_EQ(reader.frames().size(), 1u);
+    EXPECT_GT(reader.skipped_bytes(), 0u);
+    EXPECT_EQ(count_records(read_all_frames(reader), "second frame"), 1u);
+}
+
+TEST_F(RotatingFileWriterTest, CompressedOutputRejectsUnsupportedCodec) {
+    auto output = compressed_output();
+    output.compression = compression_codec::zstd;
+    file_writer writer(test_file(), false, nullptr, output);
+
+    EXPECT_FALSE(writer.is_open());
+    EXPECT_TRUE(writer.write(make_entry("never written")).is_err());
+    EXPECT_FALSE(std::filesystem::exists(test_file()));
+}
+
+// =============================================================================
+// Direct (raw file descriptor) output
+// =============================================================================
+
+#if !defined(_WIN32)
+
+namespace {
+
+file_output_options direct_output(std::size_t buffer_size = 1024 * 1024,
+                                  file_output_mode mode = file_output_mode::direct) {
+    file_output_options output;
+    output.mode = mode;
+    output.buffer_size = buffer_size;
+    output.flush_interval = std::chrono::milliseconds(0);
+    return output;
+}
+
+std::size_t count_lines(const std::filesystem::path& path) {
+    std::ifstream in(path);
+    std::size_t lines = 0;
+    for (std::string line; std::getline(in, line);) {
+        ++lines;
+    }
+    return lines;
+}
+
+} // namespace
+
+TEST_F(RotatingFileWriterTest, DirectOutputBuffersUntilFlush) {
+    file_writer writer(test_file(), true, nullptr, direct_output());
+    ASSERT_EQ(writer.get_output_mode(), file_output_mode::direct);
+
+    EXPECT_TRUE(writer.write(make_entry("buffered")).is_ok());
+    EXPECT_GT(writer.get_file_size(), 0u);
+    EXPECT_EQ(std::filesystem::file_size(test_file()), 0u);
+
+    EXPECT_TRUE(writer.flush().is_ok());
+    EXPECT_EQ(std::filesystem::file_size(test_file()), writer.get_file_size());
+    EXPECT_TRUE(writer.is_healthy());
+}
+
+TEST_F(RotatingFileWriterTest, DirectOutputWritesOutWhenBufferFills) {
+    file_writer writer(test_file(), true, nullptr, direct_output(4096));
+
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(writer.write(make_entry("filling the user-space buffer " + std::to_string(i))).is_ok());
+    }
+    // Everything up to the last full buffer has reached the file
+    const auto on_disk = std::filesystem::file_size(test_file());
+    EXPECT_GE(on_disk, 4096u);
+    EXPECT_LT(on_disk, writer.get_file_size());
+
+    writer.close();
+    EXPECT_EQ(count_lines(test_file()), 200u);
+}
+
+TEST_F(RotatingFileWriterTest, DirectOutputAppendsAndCountsExistingBytes) {
+    {
+        std::ofstream out(test_file());
+        out << "existing line\n";
+    }
+    file_writer writer(test_file(), true, nullptr, direct_output());
+    EXPECT_EQ(writer.get_file_size(), 14u);
+
+    std::vector<log_entry> entries;
+    for (int i = 0; i < 5; ++i) {
+        entries.push_back(make_entry("appended " + std::to_string(i)));
+    }
+    EXPECT_TRUE(writer.write_batch(entries).is_ok());
+    writer.close();
+
+    EXPECT_EQ(count_lines(test_file()), 6u);
+}
+
+TEST_F(RotatingFileWriterTest, DirectOutputKeepsRecordsInTheirGeneration) {
+    for (auto mode : {file_output_mode::direct, file_output_mode::io_uring,
+                      file_output_mode::mmap}) {
+        SCOPED_TRACE(static_cast<int>(mode));
+        std::filesystem::remove_all(temp_dir_);
+        std::filesystem::create_directories(temp_dir_);
+        {
+            rotating_file_writer writer(test_file(), 200, 50, 1, direct_output(4096, mode));
+            for (int i = 0; i < 40; ++i) {
+                ASSERT_TRUE(writer.write(make_entry("rotated record " + std::to_string(i))).is_ok());
+            }
+        }
+
+        // No record is lost or duplicated across generations, and none exceeds
+        // max_size by more than the record that crossed it
+        std::size_t total = 0;
+        for (const auto& entry : std::filesystem::directory_iterator(temp_dir_)) {
+            total += count_lines(entry.path());
+            EXPECT_LT(std::filesystem::file_size(entry.path()), 400u);
+        }
+        EXPECT_EQ(total, 40u);
+        EXPECT_GT(count_files_in_dir(), 1u);
+    }
+}
+
+TEST_F(RotatingFileWriterTest, IoUringOutputKeepsOrderAcrossBuffers) {
+    {
+        file_writer writer(test_file(), false, nullptr,
+                           direct_output(4096, file_output_mode::io_uring));
+        // Falls back to direct where io_uring is unavailable; output is the same
+        EXPECT_NE(writer.get_output_mode(), file_output_mode::stream);
+
+        std::vector<log_entry> batch;
+        for (int i = 0; i < 2000; ++i) {
+            batch.push_back(make_entry("uring record " + std::to_string(i)));
+            if (batch.size() == 50) {
+                ASSERT_TRUE(writer.write_batch(batch).is_ok());
+                batch.clear();
+            }
+        }
+        ASSERT_TRUE(writer.flush().is_ok());
+        EXPECT_EQ(std::filesystem::file_size(test_file()), writer.get_file_size());
+        EXPECT_TRUE(writer.is_healthy());
+    }
+
+    std::ifstream in(test_file());
+    int expected = 0;
+    for (std::string line; std::getline(in, line); ++expected) {
+        ASSERT_NE(line.find("uring record " + std::to_string(expected) + ""), std::string::npos)
+            << line;
+    }
+    EXPECT_EQ(expected, 2000);
+}
+
+TEST_F(RotatingFileWriterTest, SyncOnCriticalWritesThroughTheBuffer) {
+    for (auto mode : {file_output_mode::stream, file_output_mode::direct,
+                      file_output_mode::io_uring}) {
+        SCOPED_TRACE(static_cast<int>(mode));
+        auto output = direct_output(1024 * 1024, mode);
+        output.sync_on_critical = true;
+        file_writer writer(test_file(), false, nullptr, output);
+
+        ASSERT_TRUE(writer.write(make_entry("buffered info")).is_ok());
+        ASSERT_TRUE(writer.write(log_entry(log_level::critical, "durable")).is_ok());
+        EXPECT_EQ(std::filesystem::file_size(test_file()), writer.get_file_size());
+
+        ASSERT_TRUE(writer.write(make_entry("after")).is_ok());
+        EXPECT_TRUE(writer.sync().is_ok());
+        EXPECT_EQ(count_lines(test_file()), 3u);
+    }
+}
+
+TEST_F(RotatingFileWriterTest, MmapOutputTruncatesToContentOnClose) {
+    auto output = direct_output(0, file_output_mode::mmap);
+    output.mmap_extent = 64 * 1024;
+
+    for (int generation = 0; generation < 2; ++generation) {
+        // The second pass appends to the truncated first one
+        file_writer writer(test_file(), true, nullptr, output);
+        ASSERT_EQ(writer.get_output_mode(), file_output_mode::mmap);
+
+        for (int i = 0; i < 3000; ++i) {
+            ASSERT_TRUE(writer.write(make_entry("mapped record " + std::to_string(i))).is_ok());
+        }
+        ASSERT_TRUE(writer.flush().is_ok());
+
+        // Past several remaps, the visible size stays within a step of the content
+        const auto visible = std::filesystem::file_size(test_file());
+        EXPECT_GE(visible, writer.get_file_size());
+        EXPECT_LT(visible - writer.get_file_size(), output.mmap_extent);
+        EXPECT_GT(visible, 2 * output.mmap_extent);
+        EXPECT_TRUE(writer.sync().is_ok());
+
+        const auto written = writer.get_file_size();
+        writer.close();
+        EXPECT_EQ(std::filesystem::file_size(test_file()), written);
+    }
+
+    std::ifstream in(test_file());
+    int line_number = 0;
+    for (std::string line; std::getline(in, line); ++line_number) {
+        ASSERT_NE(line.find("mapped record " + std::to_string(line_number % 3000)),
+                  std::string::npos) << line;
+    }
+    EXPECT_EQ(line_number, 6000);
+}
+
+TEST_F(RotatingFileWriterTest, MmapOutputTrimsPaddingLeftByACrash) {
+    // A run that never reached close() leaves zero padding after its records
+    const std::string records = "first record\nsecond record\n";
+    {
+        std::ofstream out(test_file(), std::ios::binary);
+        out << records << std::string(100000, '\0');
+    }
+
+    auto output = direct_output(0, file_output_mode::mmap);
+    {
+        file_writer writer(test_file(), true, nullptr, output);
+        EXPECT_EQ(writer.get_file_size(), records.size());
+        ASSERT_TRUE(writer.write(make_entry("appended record")).is_ok());
+    }
+
+    std::ifstream in(test_file(), std::ios::binary);
+    const std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(content.find('\0'), std::string::npos);
+    EXPECT_EQ(content.rfind(records, 0), 0u);
+    EXPECT_EQ(count_lines(test_file()), 3u);
+}
+
+#endif // !_WIN32